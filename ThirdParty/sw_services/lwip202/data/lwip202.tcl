@@ -573,6 +573,11 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define PBUF_POOL_SIZE $pbuf_pool_size"
 	puts $lwipopts_fd "\#define PBUF_POOL_BUFSIZE $pbuf_pool_bufsize"
 	puts $lwipopts_fd "\#define PBUF_LINK_HLEN $pbuf_link_hlen"
+	# the GEM RX buffer pool hands out custom pbufs
+	set gem_rx_pool [common::get_property CONFIG.gem_rx_buffer_pool_size $libhandle]
+	if {$gem_rx_pool > 0} {
+		puts $lwipopts_fd "\#define LWIP_SUPPORT_CUSTOM_PBUF 1"
+	}
 	puts $lwipopts_fd ""
 
 	# ARP options
@@ -646,6 +651,11 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define TCP_SYNMAXRTX $tcp_synmaxrtx"
 	puts $lwipopts_fd "\#define TCP_QUEUE_OOSEQ $tcp_queue_ooseq"
 	puts $lwipopts_fd "\#define TCP_SND_QUEUELEN   16 * TCP_SND_BUF/TCP_MSS"
+	# large sends are enabled per netif by the GEM adapter
+	set gem_tso [common::get_property CONFIG.gem_tso $libhandle]
+	if {$gem_tso == true} {
+		puts $lwipopts_fd "\#define LWIP_TCP_TSO 1"
+	}
 
 	set have_ethonzynq 0
 	foreach emac $emac_periphs_list {
@@ -665,11 +675,6 @@ proc generate_lwip_opts {libhandle} {
 			if {$checksum_txoption != 2} {
 				error "ERROR: Wrong Tx cheksum options. The selected Tx checksum does not match with the HW supported Tx csum offload option"
 				"" "mdt_error"
-			} else {
-				set tx_full_csum [expr ![common::get_property CONFIG.tcp_ip_tx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP $tx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_IP $tx_full_csum"
 			}
 		}
 		set rx_full_csum_temp [common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]
@@ -677,11 +682,6 @@ proc generate_lwip_opts {libhandle} {
 			if {$checksum_rxoption != 2} {
 				error "ERROR: Wrong Rx cheksum options. The selected Rx checksum does not match with the HW supported Rx csum offload option"
 				"" "mdt_error"
-			} else {
-				set rx_full_csum [expr ![common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP $rx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP $rx_full_csum"
 			}
 		}
 
@@ -690,9 +690,6 @@ proc generate_lwip_opts {libhandle} {
 			if {$checksum_txoption != 1} {
 				error "ERROR: Wrong Tx cheksum options. The selected Tx checksum does not match with the HW supported Tx csum offload option"
 				"" "mdt_error"
-			} else {
-				set tx_csum [expr ![common::get_property CONFIG.tcp_tx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_csum"
 			}
 		}
 		set rx_csum_temp [common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]
@@ -700,23 +697,18 @@ proc generate_lwip_opts {libhandle} {
 			if {$checksum_rxoption != 1} {
 				error "ERROR: Wrong Rx cheksum options. The selected Rx checksum does not match with the HW supported Rx csum offload option"
 				"" "mdt_error"
-			} else {
-				set rx_csum [expr ![common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_csum"
 			}
 		}
 
-		if {$tx_full_csum_temp == false && $tx_csum_temp == false} {
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	1"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	1"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	1"
-		}
-
-		if {$rx_full_csum_temp == false && $rx_csum_temp == false} {
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  1"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
-		}
+		# Software checksums stay compiled in; the adapter switches off
+		# the ones the MAC handles, per netif
+		puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	1"
+		puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	1"
+		puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	1"
+		puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  1"
+		puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
+		puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
+		puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
 		if {$tx_full_csum_temp == true} {
 			puts $lwipopts_fd "\#define LWIP_FULL_CSUM_OFFLOAD_TX  1"
 		}
@@ -739,12 +731,15 @@ proc generate_lwip_opts {libhandle} {
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
 		} else {
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	0"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	0"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	0"
+			# GEM offload is negotiated per netif by xemacpsif, frames
+			# the GEM did not verify are still checked in software
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	1"
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	1"
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	1"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  1"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
+			puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
 			puts $lwipopts_fd "\#define LWIP_FULL_CSUM_OFFLOAD_RX  1"
 			puts $lwipopts_fd "\#define LWIP_FULL_CSUM_OFFLOAD_TX  1"
 		}
@@ -1377,6 +1372,19 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_COALESCE $ncoalesce"
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
+		set ndelay [common::get_property CONFIG.n_tx_coalesce_delay $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_N_TX_COALESCE_DELAY $ndelay"
+		set ndelay [common::get_property CONFIG.n_rx_coalesce_delay $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE_DELAY $ndelay"
+		puts $fd ""
+	}
+	if {$have_axi_ethernet == 1 || $have_ps_ethernet == 1} {
+		set poll_mode [common::get_property CONFIG.rx_poll_mode $libhandle]
+		if {$poll_mode == true} {
+			puts $fd "\#define XLWIP_CONFIG_RX_POLL_MODE 1"
+		}
+		set poll_budget [common::get_property CONFIG.rx_poll_budget $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_RX_POLL_BUDGET $poll_budget"
 		puts $fd ""
 	}
 	if {$have_ps_ethernet == 1} {
@@ -1387,6 +1395,30 @@ proc generate_adapterconfig_include {libhandle} {
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
 		puts $fd ""
+
+		set watermark [common::get_property CONFIG.gem_tx_reclaim_watermark $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_TX_RECLAIM_WATERMARK $watermark"
+		set batched_reclaim [common::get_property CONFIG.gem_tx_batched_reclaim $libhandle]
+		if {$batched_reclaim == true} {
+			puts $fd "\#define XLWIP_CONFIG_TX_BATCHED_RECLAIM 1"
+		}
+		set moderation [common::get_property CONFIG.gem_rx_intr_moderation $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_GEM_RX_INTR_MODERATION $moderation"
+		set moderation [common::get_property CONFIG.gem_tx_intr_moderation $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_GEM_TX_INTR_MODERATION $moderation"
+		set rx_pool [common::get_property CONFIG.gem_rx_buffer_pool_size $libhandle]
+		if {$rx_pool > 0} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_RX_POOL_SIZE $rx_pool"
+		}
+		set priority_queues [common::get_property CONFIG.gem_priority_queues $libhandle]
+		if {$priority_queues == true} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_PRIORITY_QUEUES 1"
+		}
+		set gem_tso [common::get_property CONFIG.gem_tso $libhandle]
+		if {$gem_tso == true} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_TSO 1"
+		}
+		puts $fd ""
 	}
 
 	puts $fd "\#endif"
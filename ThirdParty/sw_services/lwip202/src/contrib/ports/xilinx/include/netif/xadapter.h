@@ -72,8 +72,27 @@ struct netif *	xemac_add(struct netif *netif,
 	unsigned mac_baseaddr);
 #if defined (__arm__) || defined (__aarch64__)
 void xemacpsif_resetrx_on_no_rxdata(struct netif *netif);
+void xemacpsif_tx_reclaim(struct netif *netif);
 #endif
 
+/*
+ * Checksum offload. Adapters report what their MAC computes on TX and checks
+ * on RX with xemac_set_csum_offload(), which switches the matching lwIP
+ * software checksums off for that netif only. On RX the adapters mark each
+ * frame the MAC verified in the pbuf flags, and call xemac_rx_csum_check()
+ * before handing it to lwIP so frames the MAC did not verify are still
+ * checked in software. The two pbuf flag bits are not used by lwIP 2.0.2.
+ */
+#define XEMAC_CSUM_IP		0x01U
+#define XEMAC_CSUM_TCP		0x02U
+#define XEMAC_CSUM_UDP		0x04U
+
+#define XEMAC_PBUF_FLAG_CSUM_IP	0x40U	/* IP header checksum verified */
+#define XEMAC_PBUF_FLAG_CSUM_L4	0x80U	/* TCP/UDP checksum verified */
+
+void	xemac_set_csum_offload(struct netif *netif, u32_t hw_tx, u32_t hw_rx);
+s32_t	xemac_rx_csum_check(struct netif *netif, struct pbuf *p);
+
 /* global lwip debug variable used for debugging */
 extern int lwip_runtime_debug;
 
@@ -56,6 +56,29 @@ extern "C" {
 #include "netif/xpqueue.h"
 #include "xlwipconfig.h"
 
+#ifndef XLWIP_CONFIG_N_TX_COALESCE_DELAY
+#define XLWIP_CONFIG_N_TX_COALESCE_DELAY	1
+#endif
+#ifndef XLWIP_CONFIG_N_RX_COALESCE_DELAY
+#define XLWIP_CONFIG_N_RX_COALESCE_DELAY	1
+#endif
+
+/*
+ * With XLWIP_CONFIG_RX_POLL_MODE the RX DMA interrupt only schedules
+ * xaxiemacif_input(), which then harvests at most XAXIEMACIF_RX_POLL_BUDGET
+ * frames from the RX BD ring per call, with the ring interrupts left
+ * disabled until a poll finds the ring drained. Not used with the FIFO.
+ */
+#if defined(XLWIP_CONFIG_RX_POLL_MODE) && \
+	!defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO)
+#define XAXIEMACIF_RX_POLL
+#endif
+#ifdef XLWIP_CONFIG_RX_POLL_BUDGET
+#define XAXIEMACIF_RX_POLL_BUDGET	XLWIP_CONFIG_RX_POLL_BUDGET
+#else
+#define XAXIEMACIF_RX_POLL_BUDGET	64
+#endif
+
 void 	xaxiemacif_setmac(u32_t index, u8_t *addr);
 u8_t*	xaxiemacif_getmac(u32_t index);
 err_t 	xaxiemacif_init(struct netif *netif);
@@ -86,6 +109,11 @@ typedef struct {
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
 	void *tx_bdspace;
+
+#ifdef XAXIEMACIF_RX_POLL
+	/* set by the RX ISR, cleared once a poll drains the RX BD ring */
+	volatile u8_t rx_polling;
+#endif
 } xaxiemacif_s;
 
 extern xaxiemacif_s xaxiemacif;
@@ -100,6 +128,9 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring);
 XStatus init_axi_dma(struct xemac_s *xemac);
 XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
 #endif
+#ifdef XAXIEMACIF_RX_POLL
+s32_t xaxiemacif_rx_poll(struct xemac_s *xemac, s32_t budget);
+#endif
 
 #ifdef __cplusplus
 }
@@ -57,8 +57,15 @@ extern "C" {
 #include "xuartps.h"
 #include "xscugic.h"
 #include "xemacps.h"		/* defines XEmacPs API */
+#include "xtime_l.h"
+
+/* XTime exists on Cortex-R5 only when a TTC is the sleep timer */
+#if !defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR)
+#define XEMACPSIF_TX_LATENCY_STATS
+#endif
 
 #include "netif/xpqueue.h"
+#include "netif/xspscq.h"
 #include "xlwipconfig.h"
 
 #define ZYNQ_EMACPS_0_BASEADDR 0xE000B000
@@ -87,6 +94,53 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/* Max number of received packets handed to lwIP per receive queue drain */
+#ifndef XEMACPSIF_RX_BATCH
+#define XEMACPSIF_RX_BATCH	16
+#endif
+
+/*
+ * Sent TX BDs are reclaimed in bulk by low_level_output once the number
+ * of free TX BDs drops to this watermark. With XLWIP_CONFIG_TX_BATCHED_RECLAIM
+ * the TX complete interrupt is left disabled and the watermark, together
+ * with xemacpsif_tx_reclaim() called from a periodic timer, is the only way
+ * sent pbufs are released.
+ */
+#ifdef XLWIP_CONFIG_TX_RECLAIM_WATERMARK
+#define XEMACPSIF_TX_RECLAIM_WATERMARK	XLWIP_CONFIG_TX_RECLAIM_WATERMARK
+#else
+#define XEMACPSIF_TX_RECLAIM_WATERMARK	(XLWIP_CONFIG_N_TX_DESC / 4)
+#endif
+
+/*
+ * With XLWIP_CONFIG_RX_POLL_MODE the receive interrupt only schedules
+ * xemacpsif_input(), which then harvests at most XEMACPSIF_RX_POLL_BUDGET
+ * frames from the RX BD rings per call, with the interrupt left disabled
+ * until a poll finds the rings drained.
+ */
+#ifdef XLWIP_CONFIG_RX_POLL_BUDGET
+#define XEMACPSIF_RX_POLL_BUDGET	XLWIP_CONFIG_RX_POLL_BUDGET
+#else
+#define XEMACPSIF_RX_POLL_BUDGET	64
+#endif
+
+#ifndef XLWIP_CONFIG_GEM_RX_INTR_MODERATION
+#define XLWIP_CONFIG_GEM_RX_INTR_MODERATION	0
+#endif
+#ifndef XLWIP_CONFIG_GEM_TX_INTR_MODERATION
+#define XLWIP_CONFIG_GEM_TX_INTR_MODERATION	0
+#endif
+
+/*
+ * With XLWIP_CONFIG_GEM_PRIORITY_QUEUES, GEM revisions that have priority
+ * queues carry bulk traffic on queue 0 and latency sensitive traffic on
+ * queue 1, in both directions. Received frames are steered to queue 1 by
+ * the GEM screeners; frames to be sent are steered by the adapter using the
+ * same rules (see xemacpsif_set_priority_screener()).
+ */
+#define XEMACPSIF_BULK_QUEUE	0
+#define XEMACPSIF_PRIO_QUEUE	1
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
@@ -95,14 +149,27 @@ s32_t 	xemacpsif_input(struct netif *netif);
 /* xaxiemacif_hw.c */
 void 	xemacps_error_handler(XEmacPs * Temac);
 
+/* TX path statistics, maintained per netif */
+typedef struct {
+	u32_t bds_inflight;		/* BDs currently owned by the GEM */
+	u32_t bds_inflight_max;		/* high water mark of bds_inflight */
+	u32_t reclaim_runs;		/* reclaim passes that freed BDs */
+	u32_t bds_reclaimed;		/* BDs returned to the free pool */
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	XTime reclaim_latency_max;	/* worst submit to reclaim time */
+	u64 reclaim_latency_sum;	/* summed over bds_reclaimed */
+#endif
+	u32_t no_space_drops;		/* frames dropped for lack of BDs */
+} xemacpsif_txstats_s;
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
 typedef struct {
 	XEmacPs emacps;
 
-	/* queue to store overflow packets */
-	pq_queue_t *recv_q;
+	/* lock-free queue of received packets, filled by the RX ISR */
+	spsc_queue_t *recv_q;
 	pq_queue_t *send_q;
 
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
@@ -111,11 +178,38 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+	xemacpsif_txstats_s txstats;
+
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+	/* RX BDs are waiting for a buffer from the RX buffer pool */
+	volatile u8_t rx_starved;
+#endif
+
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+	/* set by the RX ISR, cleared once a poll drains the RX BD rings */
+	volatile u8_t rx_polling;
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	/* queue 1 state, valid only when prio_queues is set */
+	u8_t prio_queues;
+	XEmacPs_BdRing rxq1_ring;
+	XEmacPs_BdRing txq1_ring;
+	void *rxq1_bdspace;
+	void *txq1_bdspace;
+	spsc_queue_t *recv_prio_q;
+	XEmacPs_Screener prio_rules[XEMACPS_MAX_SCREENERS];
+#endif
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
 
 s32_t	is_tx_space_available(xemacpsif_s *emac);
+void	xemacpsif_tx_reclaim(struct netif *netif);
+xemacpsif_txstats_s *xemacpsif_get_txstats(struct netif *netif);
+err_t	xemacpsif_set_priority_screener(struct netif *netif, u8_t index,
+					XEmacPs_Screener *screener);
 
 /* xemacpsif_dma.c */
 
@@ -123,7 +217,12 @@ void  process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring);
 u32_t phy_setup (XEmacPs *xemacpsp, u32_t phy_addr);
 void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
-XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
+XStatus emacps_sgsend(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring,
+							struct pbuf *p);
+XEmacPs_BdRing *select_txring(xemacpsif_s *xemacpsif, struct pbuf *p);
+#if LWIP_TCP_TSO
+u16_t tso_header_len(struct pbuf *p);
+#endif
 void emacps_recv_handler(void *arg);
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
@@ -140,6 +239,9 @@ void init_emacps_on_error (xemacpsif_s *xemacps, struct netif *netif);
 void clean_dma_txdescs(struct xemac_s *xemac);
 void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif);
 void reset_dma(struct xemac_s *xemac);
+void setup_tx_reclaim_mode(xemacpsif_s *xemacpsif);
+void setup_intr_moderation(xemacpsif_s *xemacpsif);
+s32_t xemacpsif_rx_poll(struct xemac_s *xemac, s32_t budget);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,82 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+#ifndef __LWIP_SPSC_QUEUE_H_
+#define __LWIP_SPSC_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xil_types.h"
+
+/*
+ * Single-producer/single-consumer queue of pbuf pointers.
+ *
+ * The producer (typically the EMAC receive ISR) only ever writes head and
+ * the consumer (xemacpsif_input) only ever writes tail. Both indices are
+ * free running and published with release semantics, so neither side has
+ * to disable interrupts to access the queue. The queue size must be a
+ * power of two so that the slot index is a simple mask of the running
+ * index.
+ */
+#ifndef SPSC_QUEUE_SIZE
+#define SPSC_QUEUE_SIZE		4096
+#endif
+#define SPSC_QUEUE_MASK		(SPSC_QUEUE_SIZE - 1)
+
+#if (SPSC_QUEUE_SIZE & SPSC_QUEUE_MASK) != 0
+#error "SPSC_QUEUE_SIZE must be a power of two"
+#endif
+
+/* Largest L1 data cache line across the supported ARM cores */
+#define SPSC_CACHELINE_SIZE	64
+
+typedef struct {
+	/* written by the producer only */
+	u32 head __attribute__ ((aligned (SPSC_CACHELINE_SIZE)));
+	/* written by the consumer only */
+	u32 tail __attribute__ ((aligned (SPSC_CACHELINE_SIZE)));
+	void *data[SPSC_QUEUE_SIZE] __attribute__ ((aligned (SPSC_CACHELINE_SIZE)));
+} spsc_queue_t;
+
+spsc_queue_t*	spsc_create_queue(void);
+int		spsc_enqueue(spsc_queue_t *q, void *p);
+void*		spsc_dequeue(spsc_queue_t *q);
+u32		spsc_dequeue_batch(spsc_queue_t *q, void **p, u32 max);
+u32		spsc_qlength(spsc_queue_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
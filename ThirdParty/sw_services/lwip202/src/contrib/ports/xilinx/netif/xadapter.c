@@ -47,6 +47,8 @@
 #include "lwip/tcp.h"
 #include "lwip/udp.h"
 #include "lwip/priv/tcp_priv.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/prot/udp.h"
 
 #include "netif/etharp.h"
 #include "netif/xadapter.h"
@@ -250,3 +252,201 @@ xemacif_input(struct netif *netif)
 
 	return n_packets;
 }
+
+/*
+ * xemac_set_csum_offload():
+ *
+ * Switches lwIP software checksum generation (hw_tx) and checking (hw_rx)
+ * off on this netif for the protocols the MAC handles, given as a
+ * combination of XEMAC_CSUM_* flags. ICMP checksums are always left to
+ * lwIP. Needs LWIP_CHECKSUM_CTRL_PER_NETIF, otherwise the global
+ * CHECKSUM_GEN_x/CHECKSUM_CHECK_x settings apply.
+ */
+void
+xemac_set_csum_offload(struct netif *netif, u32_t hw_tx, u32_t hw_rx)
+{
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	u16_t flags = NETIF_CHECKSUM_ENABLE_ALL;
+
+	if (hw_tx & XEMAC_CSUM_IP)
+		flags &= ~NETIF_CHECKSUM_GEN_IP;
+	if (hw_tx & XEMAC_CSUM_TCP)
+		flags &= ~NETIF_CHECKSUM_GEN_TCP;
+	if (hw_tx & XEMAC_CSUM_UDP)
+		flags &= ~NETIF_CHECKSUM_GEN_UDP;
+	if (hw_rx & XEMAC_CSUM_IP)
+		flags &= ~NETIF_CHECKSUM_CHECK_IP;
+	if (hw_rx & XEMAC_CSUM_TCP)
+		flags &= ~NETIF_CHECKSUM_CHECK_TCP;
+	if (hw_rx & XEMAC_CSUM_UDP)
+		flags &= ~NETIF_CHECKSUM_CHECK_UDP;
+
+	NETIF_SET_CHECKSUM_CTRL(netif, flags);
+#else
+	(void)netif;
+	(void)hw_tx;
+	(void)hw_rx;
+#endif
+}
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+/*
+ * Verifies the TCP or UDP checksum of the transport segment starting 'off'
+ * bytes into the frame. The frame has been trimmed to the IP length.
+ */
+static s32_t
+rx_l4_csum_ok(struct pbuf *p, u16_t off, u8_t proto, u16_t l4len,
+		const ip_addr_t *src, const ip_addr_t *dest)
+{
+	u16_t csum;
+
+	if (proto == IP_PROTO_UDP) {
+		struct udp_hdr *udphdr;
+
+		if ((l4len < UDP_HLEN) || (p->len < (off + UDP_HLEN)))
+			return 1;
+		udphdr = (struct udp_hdr *)((u8_t *)p->payload + off);
+		/* a zero UDP checksum means none was sent */
+		if (udphdr->chksum == 0)
+			return 1;
+	}
+
+	pbuf_header(p, -(s16_t)off);
+	csum = ip_chksum_pseudo(p, proto, l4len, src, dest);
+	pbuf_header(p, (s16_t)off);
+
+	return (csum == 0);
+}
+
+#if LWIP_IPV4
+static s32_t
+rx_csum_check_ip4(struct netif *netif, struct pbuf *p, u16_t off, u8_t hw)
+{
+	struct ip_hdr *iphdr;
+	ip_addr_t src, dest;
+	u16_t hlen, len;
+	u8_t proto;
+
+	if (p->len < (off + IP_HLEN))
+		return 1;
+	iphdr = (struct ip_hdr *)((u8_t *)p->payload + off);
+	hlen = IPH_HL(iphdr) * 4;
+	len = lwip_ntohs(IPH_LEN(iphdr));
+	/* malformed headers are left to ip4_input */
+	if ((hlen < IP_HLEN) || (p->len < (off + hlen)) || (len < hlen) ||
+			(p->tot_len < (off + len)))
+		return 1;
+
+	if (!(hw & XEMAC_PBUF_FLAG_CSUM_IP) &&
+		!(netif->chksum_flags & NETIF_CHECKSUM_CHECK_IP)) {
+		if (inet_chksum(iphdr, hlen) != 0)
+			return 0;
+	}
+
+	/* fragments can only be checked after reassembly */
+	if ((hw & XEMAC_PBUF_FLAG_CSUM_L4) ||
+		((IPH_OFFSET(iphdr) & PP_HTONS(IP_OFFMASK | IP_MF)) != 0))
+		return 1;
+
+	proto = IPH_PROTO(iphdr);
+	if (!((proto == IP_PROTO_TCP) &&
+			!(netif->chksum_flags & NETIF_CHECKSUM_CHECK_TCP)) &&
+		!((proto == IP_PROTO_UDP) &&
+			!(netif->chksum_flags & NETIF_CHECKSUM_CHECK_UDP)))
+		return 1;
+
+	/* drop Ethernet padding, as ip4_input would */
+	pbuf_realloc(p, off + len);
+	ip_addr_copy_from_ip4(src, iphdr->src);
+	ip_addr_copy_from_ip4(dest, iphdr->dest);
+	return rx_l4_csum_ok(p, off + hlen, proto, len - hlen, &src, &dest);
+}
+#endif
+
+#if LWIP_IPV6
+static s32_t
+rx_csum_check_ip6(struct netif *netif, struct pbuf *p, u16_t off, u8_t hw)
+{
+	struct ip6_hdr *ip6hdr;
+	ip_addr_t src, dest;
+	u16_t plen;
+	u8_t nexth;
+
+	if ((hw & XEMAC_PBUF_FLAG_CSUM_L4) || (p->len < (off + IP6_HLEN)))
+		return 1;
+	ip6hdr = (struct ip6_hdr *)((u8_t *)p->payload + off);
+	plen = lwip_ntohs(IP6H_PLEN(ip6hdr));
+	nexth = IP6H_NEXTH(ip6hdr);
+	if (p->tot_len < (off + IP6_HLEN + plen))
+		return 1;
+
+	/* segments behind extension headers are not looked at here */
+	if (!((nexth == IP6_NEXTH_TCP) &&
+			!(netif->chksum_flags & NETIF_CHECKSUM_CHECK_TCP)) &&
+		!((nexth == IP6_NEXTH_UDP) &&
+			!(netif->chksum_flags & NETIF_CHECKSUM_CHECK_UDP)))
+		return 1;
+
+	pbuf_realloc(p, off + IP6_HLEN + plen);
+	ip_addr_copy_from_ip6(src, ip6hdr->src);
+	ip_addr_copy_from_ip6(dest, ip6hdr->dest);
+	return rx_l4_csum_ok(p, off + IP6_HLEN, nexth, plen, &src, &dest);
+}
+#endif
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
+/*
+ * xemac_rx_csum_check():
+ *
+ * Called by the adapters for each received frame (starting with the
+ * Ethernet header) before it is handed to lwIP. Checks that are switched
+ * off on this netif are done here in software for frames the MAC did not
+ * verify, as recorded in the XEMAC_PBUF_FLAG_CSUM_x pbuf flags, which are
+ * then cleared. Returns 0 if the frame has a bad checksum and must be
+ * dropped.
+ */
+s32_t
+xemac_rx_csum_check(struct netif *netif, struct pbuf *p)
+{
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	u8_t hw = p->flags & (XEMAC_PBUF_FLAG_CSUM_IP | XEMAC_PBUF_FLAG_CSUM_L4);
+	u16_t off = SIZEOF_ETH_HDR;
+	u16_t type;
+
+	p->flags &= ~(XEMAC_PBUF_FLAG_CSUM_IP | XEMAC_PBUF_FLAG_CSUM_L4);
+
+	/* nothing to do if lwIP checks everything itself */
+	if ((netif->chksum_flags & (NETIF_CHECKSUM_CHECK_IP |
+			NETIF_CHECKSUM_CHECK_TCP | NETIF_CHECKSUM_CHECK_UDP)) ==
+		(NETIF_CHECKSUM_CHECK_IP | NETIF_CHECKSUM_CHECK_TCP |
+			NETIF_CHECKSUM_CHECK_UDP))
+		return 1;
+	if (hw == (XEMAC_PBUF_FLAG_CSUM_IP | XEMAC_PBUF_FLAG_CSUM_L4))
+		return 1;
+	if (p->len < SIZEOF_ETH_HDR)
+		return 1;
+
+	type = ((struct eth_hdr *)p->payload)->type;
+	if (type == PP_HTONS(ETHTYPE_VLAN)) {
+		if (p->len < (SIZEOF_ETH_HDR + SIZEOF_VLAN_HDR))
+			return 1;
+		type = ((struct eth_vlan_hdr *)((u8_t *)p->payload +
+						SIZEOF_ETH_HDR))->tpid;
+		off += SIZEOF_VLAN_HDR;
+	}
+
+#if LWIP_IPV4
+	if (type == PP_HTONS(ETHTYPE_IP))
+		return rx_csum_check_ip4(netif, p, off, hw);
+#endif
+#if LWIP_IPV6
+	if (type == PP_HTONS(ETHTYPE_IPV6))
+		return rx_csum_check_ip6(netif, p, off, hw);
+#endif
+	return 1;
+#else
+	(void)netif;
+	p->flags &= ~(XEMAC_PBUF_FLAG_CSUM_IP | XEMAC_PBUF_FLAG_CSUM_L4);
+	return 1;
+#endif
+}
@@ -85,6 +85,23 @@
 #define IFNAME0 't'
 #define IFNAME1 'e'
 
+/* Checksums computed and checked by the MAC, see xemac_set_csum_offload() */
+#if LWIP_FULL_CSUM_OFFLOAD_TX==1
+#define XAXIEMACIF_TX_CSUM	(XEMAC_CSUM_IP | XEMAC_CSUM_TCP | XEMAC_CSUM_UDP)
+#elif LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
+#define XAXIEMACIF_TX_CSUM	XEMAC_CSUM_TCP
+#else
+#define XAXIEMACIF_TX_CSUM	0
+#endif
+
+#if LWIP_FULL_CSUM_OFFLOAD_RX==1
+#define XAXIEMACIF_RX_CSUM	(XEMAC_CSUM_IP | XEMAC_CSUM_TCP | XEMAC_CSUM_UDP)
+#elif LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+#define XAXIEMACIF_RX_CSUM	XEMAC_CSUM_TCP
+#else
+#define XAXIEMACIF_RX_CSUM	0
+#endif
+
 #if LWIP_IGMP
 static err_t xaxiemacif_mac_filter_update (struct netif *netif,
 								ip_addr_t *group, u8_t action);
@@ -240,7 +257,9 @@ static err_t xaxiemacif_output(struct netif *netif, struct pbuf *p,
  * This function should be called when a packet is ready to be read
  * from the interface. It uses the function low_level_input() that
  * should handle the actual reception of bytes from the network
- * interface.
+ * interface. In polling mode (XLWIP_CONFIG_RX_POLL_MODE) the receive queue
+ * is refilled from the RX BD ring here, up to XAXIEMACIF_RX_POLL_BUDGET
+ * frames per call.
  *
  * Returns the number of packets read (max 1 packet on success,
  * 0 if there are no packets)
@@ -251,20 +270,38 @@ int xaxiemacif_input(struct netif *netif)
 {
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
+#ifdef XAXIEMACIF_RX_POLL
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	s32_t budget = XAXIEMACIF_RX_POLL_BUDGET;
+#endif
 	SYS_ARCH_DECL_PROTECT(lev);
 
 #if !NO_SYS
 	while (1)
 #endif
 	{
+#ifdef XAXIEMACIF_RX_POLL
+		if (xaxiemacif->rx_polling && (budget > 0) &&
+			(pq_qlength(xaxiemacif->recv_q) == 0)) {
+			budget -= xaxiemacif_rx_poll(xemac, budget);
+		}
+#endif
 		/* move received packet into a new pbuf */
 		SYS_ARCH_PROTECT(lev);
 		p = low_level_input(netif);
 		SYS_ARCH_UNPROTECT(lev);
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL)
+		if (p == NULL) {
+#if defined(XAXIEMACIF_RX_POLL) && !NO_SYS
+			/* budget used up with frames pending, come back later */
+			if (xaxiemacif->rx_polling) {
+				sys_sem_signal(&xemac->sem_rx_data_available);
+			}
+#endif
 			return 0;
+		}
 
 		/* points to packet payload, which starts with an Ethernet header */
 		ethhdr = p->payload;
@@ -286,6 +323,16 @@ int xaxiemacif_input(struct netif *netif)
 			case ETHTYPE_PPPOEDISC:
 			case ETHTYPE_PPPOE:
 #endif /* PPPOE_SUPPORT */
+				/* software checks for what the MAC did not verify */
+				if (!xemac_rx_csum_check(netif, p)) {
+#if LINK_STATS
+					lwip_stats.link.chkerr++;
+					lwip_stats.link.drop++;
+#endif /* LINK_STATS */
+					pbuf_free(p);
+					p = NULL;
+					break;
+				}
 				/* full packet send to tcpip_thread to process */
 				if (netif->input(p, netif) != ERR_OK) {
 					LWIP_DEBUGF(NETIF_DEBUG, ("xaxiemacif_input: IP input error\r\n"));
@@ -327,6 +374,9 @@ static err_t low_level_init(struct netif *netif)
 	xemac->type = xemac_type_axi_ethernet;
 
 	xaxiemacif->send_q = NULL;
+#ifdef XAXIEMACIF_RX_POLL
+	xaxiemacif->rx_polling = 0;
+#endif
 	xaxiemacif->recv_q = pq_create_queue();
 	if (!xaxiemacif->recv_q)
 		return ERR_MEM;
@@ -373,6 +423,9 @@ static err_t low_level_init(struct netif *netif)
 		/* initialize the DMA engine */
 		init_axi_dma(xemac);
 #endif
+		/* checksum offload is only available with the DMA engine */
+		xemac_set_csum_offload(netif, XAXIEMACIF_TX_CSUM,
+						XAXIEMACIF_RX_CSUM);
 	} else if (XAxiEthernet_IsFifo(&xaxiemacif->axi_ethernet)) {
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO
 		/* initialize the locallink FIFOs */
@@ -42,9 +42,9 @@
 #include "semphr.h"
 #include "timers.h"
 #endif
-#include "lwip/sys.h"
 #endif
 
+#include "lwip/sys.h"
 #include "lwip/stats.h"
 #include "lwip/inet_chksum.h"
 
@@ -165,6 +165,17 @@ static inline u16_t extract_packet_len(XAxiDma_Bd *rxbd) {
     return packet_len;
 }
 
+/* Full checksum offload status in the RX APP2 word */
+#define XAE_FULL_CSUM_STATUS_MASK	0x00000038
+#define XAE_FULL_CSUM_STATUS_SHIFT	3
+#define XAE_IP_TCP_CSUM_VALIDATED	0x00000002
+#define XAE_IP_UDP_CSUM_VALIDATED	0x00000003
+
+static inline u32_t extract_fullcsum_status(XAxiDma_Bd *rxbd) {
+	return (XAxiDma_BdRead(rxbd, XAXIDMA_BD_USR2_OFFSET) &
+		XAE_FULL_CSUM_STATUS_MASK) >> XAE_FULL_CSUM_STATUS_SHIFT;
+}
+
 static inline u16_t extract_csum(XAxiDma_Bd *rxbd) {
     u16_t csum = XAxiDma_BdRead(rxbd, XAXIDMA_BD_USR3_OFFSET) & 0xffff;
     return csum;
@@ -374,11 +385,120 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 	}
 }
 
-static void axidma_recv_handler(void *arg)
+/*
+ * Hands up to 'budget' received frames over to the receive queue and gives
+ * the ring fresh pbufs. Returns the number of frames harvested.
+ */
+static s32_t process_rx_bds(xaxiemacif_s *xaxiemacif, XAxiDma_BdRing *rxring,
+								s32_t budget)
 {
 	struct pbuf *p;
-	u32 irq_status, i, timeOut;
 	XAxiDma_Bd *rxbd, *rxbdset;
+	u32 bd_processed;
+	u32 rx_bytes;
+	u32 i;
+
+	bd_processed = XAxiDma_BdRingFromHw(rxring, (u32)budget, &rxbdset);
+	if (bd_processed == 0) {
+		return 0;
+	}
+
+	for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
+		p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
+		/* Adjust the buffer size to the actual number of bytes received.*/
+		rx_bytes = extract_packet_len(rxbd);
+		pbuf_realloc(p, rx_bytes);
+
+#ifdef USE_JUMBO_FRAMES
+#ifndef __aarch64__
+		XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
+						XAE_MAX_JUMBO_FRAME_SIZE);
+#endif
+#else
+#ifndef __aarch64__
+		XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
+#endif
+#endif
+
+#if LWIP_FULL_CSUM_OFFLOAD_RX==1
+		/* record whether the MAC verified the checksums */
+		switch (extract_fullcsum_status(rxbd)) {
+		case XAE_IP_TCP_CSUM_VALIDATED:
+		case XAE_IP_UDP_CSUM_VALIDATED:
+			p->flags |= (XEMAC_PBUF_FLAG_CSUM_IP |
+					XEMAC_PBUF_FLAG_CSUM_L4);
+			break;
+		default:
+			break;
+		}
+#endif
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+		/* Verify for partial checksum offload case. Frames that
+		 * fail are checked again in software before lwIP sees
+		 * them.
+		 */
+		if (!is_checksum_valid(rxbd, p)) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
+		} else {
+			p->flags |= XEMAC_PBUF_FLAG_CSUM_L4;
+		}
+#endif
+		/* store it in the receive queue,
+		 * where it'll be processed by a different handler
+		 */
+		if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			pbuf_free(p);
+		}
+		rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+	}
+	/* free up the BD's */
+	XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
+	/* return all the processed bd's back to the stack */
+	/* setup_rx_bds -> use XAxiDma_BdRingGetFreeCnt */
+	setup_rx_bds(rxring);
+	return (s32_t)bd_processed;
+}
+
+#ifdef XAXIEMACIF_RX_POLL
+/*
+ * xaxiemacif_rx_poll():
+ *
+ * Harvests up to 'budget' received frames from the RX BD ring. In polling
+ * mode, once a poll finds the ring drained before the budget is used up
+ * the RX ring interrupts are re-enabled, so the adapter goes back to
+ * interrupt driven operation when the link is idle.
+ * Returns the number of frames harvested.
+ */
+s32_t xaxiemacif_rx_poll(struct xemac_s *xemac, s32_t budget)
+{
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	s32_t n_frames = 0;
+	s32_t n;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	do {
+		n = process_rx_bds(xaxiemacif, rxring, budget - n_frames);
+		n_frames += n;
+	} while ((n > 0) && (n_frames < budget));
+	if (xaxiemacif->rx_polling && (n_frames < budget)) {
+		xaxiemacif->rx_polling = 0;
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n_frames;
+}
+#endif
+
+static void axidma_recv_handler(void *arg)
+{
+	u32 irq_status, timeOut;
 	struct xemac_s *xemac;
 	xaxiemacif_s *xaxiemacif;
 	XAxiDma_BdRing *rxring;
@@ -426,53 +546,24 @@ static void axidma_recv_handler(void *arg)
 	 * to handle the processed BDs and then raise the according flag.
 	 */
 	if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
-		u32 bd_processed;
-		u32 rx_bytes;
-
-		bd_processed = XAxiDma_BdRingFromHw(rxring, XAXIDMA_ALL_BDS, &rxbdset);
-
-		for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
-			p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
-			/* Adjust the buffer size to the actual number of bytes received.*/
-			rx_bytes = extract_packet_len(rxbd);
-			pbuf_realloc(p, rx_bytes);
-
-#ifdef USE_JUMBO_FRAMES
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
-							XAE_MAX_JUMBO_FRAME_SIZE);
-#endif
-#else
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
-#endif
-#endif
-
-#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
-			/* Verify for partial checksum offload case */
-			if (!is_checksum_valid(rxbd, p)) {
-				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
-			}
+#ifdef XAXIEMACIF_RX_POLL
+		/*
+		 * Leave the harvesting to xaxiemacif_input(), which polls the
+		 * ring with its interrupts off until it runs dry.
+		 */
+		xaxiemacif->rx_polling = 1;
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+#ifdef OS_IS_FREERTOS
+		xInsideISR--;
 #endif
-				pbuf_free(p);
-			}
-			rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
-		}
-		/* free up the BD's */
-		XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
-		/* return all the processed bd's back to the stack */
-		/* setup_rx_bds -> use XAxiDma_BdRingGetFreeCnt */
-		setup_rx_bds(rxring);
+		return;
+#else
+		(void)process_rx_bds(xaxiemacif, rxring, XAXIDMA_ALL_BDS);
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
 #endif
 	}
 	XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
@@ -774,13 +865,13 @@ XStatus init_axi_dma(struct xemac_s *xemac)
 	}
 
 	status = XAxiDma_BdRingSetCoalesce(txringptr, XLWIP_CONFIG_N_TX_COALESCE,
-							0x1);
+					XLWIP_CONFIG_N_TX_COALESCE_DELAY);
 	if (status != XST_SUCCESS) {
 		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting coalescing settings\r\n"));
 		return ERR_IF;
 	}
 	status = XAxiDma_BdRingSetCoalesce(rxringptr, XLWIP_CONFIG_N_RX_COALESCE,
-						0x1);
+					XLWIP_CONFIG_N_RX_COALESCE_DELAY);
 	if (status != XST_SUCCESS) {
 		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting coalescing settings\r\n"));
 		return ERR_IF;
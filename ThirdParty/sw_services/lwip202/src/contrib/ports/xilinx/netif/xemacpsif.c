@@ -107,14 +107,14 @@ int32_t lExpireCounter = 0;
  * this function also assumes that there are available BD's
  */
 static err_t _unbuffered_low_level_output(xemacpsif_s *xemacpsif,
-													struct pbuf *p)
+						XEmacPs_BdRing *txring, struct pbuf *p)
 {
 	XStatus status = 0;
 
 #if ETH_PAD_SIZE
 	pbuf_header(p, -ETH_PAD_SIZE);	/* drop the padding word */
 #endif
-	status = emacps_sgsend(xemacpsif, p);
+	status = emacps_sgsend(xemacpsif, txring, p);
 	if (status != XST_SUCCESS) {
 #if LINK_STATS
 	lwip_stats.link.drop++;
@@ -147,28 +147,43 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	SYS_ARCH_DECL_PROTECT(lev);
     err_t err;
     s32_t freecnt;
+    s32_t n_pbufs;
+    struct pbuf *q;
     XEmacPs_BdRing *txring;
 
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 
+	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
+		n_pbufs++;
+#if LWIP_TCP_TSO
+	/* the headers of a large send take a BD of their own unless they
+	   fill the first pbuf, as counted by emacps_sgsend() */
+	if ((p->tso_mss != 0) && (tso_header_len(p) < p->len))
+		n_pbufs++;
+#endif
+
 	SYS_ARCH_PROTECT(lev);
 
-	/* check if space is available to send */
-    freecnt = is_tx_space_available(xemacpsif);
-    if (freecnt <= 5) {
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	/* priority frames go out on their own GEM queue */
+	txring = select_txring(xemacpsif, p);
+
+	/* reap sent BDs in bulk once the free count hits the watermark */
+	freecnt = XEmacPs_BdRingGetFreeCnt(txring);
+	if ((freecnt <= XEMACPSIF_TX_RECLAIM_WATERMARK) || (freecnt < n_pbufs)) {
 		process_sent_bds(xemacpsif, txring);
+		freecnt = XEmacPs_BdRingGetFreeCnt(txring);
 	}
 
-    if (is_tx_space_available(xemacpsif)) {
-		_unbuffered_low_level_output(xemacpsif, p);
+	if (freecnt >= n_pbufs) {
+		_unbuffered_low_level_output(xemacpsif, txring, p);
 		err = ERR_OK;
 	} else {
 #if LINK_STATS
 		lwip_stats.link.drop++;
 #endif
-		printf("pack dropped, no space\r\n");
+		xemacpsif->txstats.no_space_drops++;
+		LWIP_DEBUGF(NETIF_DEBUG, ("pack dropped, no space\r\n"));
 		err = ERR_MEM;
 	}
 
@@ -176,28 +191,6 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	return err;
 }
 
-/*
- * low_level_input():
- *
- * Should allocate a pbuf and transfer the bytes of the incoming
- * packet from the interface into the pbuf.
- *
- */
-static struct pbuf * low_level_input(struct netif *netif)
-{
-	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
-	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
-	struct pbuf *p;
-
-	/* see if there is data to process */
-	if (pq_qlength(xemacpsif->recv_q) == 0)
-		return NULL;
-
-	/* return one packet from receive q */
-	p = (struct pbuf *)pq_dequeue(xemacpsif->recv_q);
-	return p;
-}
-
 /*
  * xemacpsif_output():
  *
@@ -218,74 +211,116 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
  * xemacpsif_input():
  *
  * This function should be called when a packet is ready to be read
- * from the interface. It uses the function low_level_input() that
- * should handle the actual reception of bytes from the network
- * interface.
+ * from the interface. Received packets are drained from the lock-free
+ * receive queue in batches of up to XEMACPSIF_RX_BATCH, so the EMAC
+ * interrupt stays enabled while packets are handed over to lwIP.
+ * In polling mode (XLWIP_CONFIG_RX_POLL_MODE) the queue is refilled from the
+ * RX BD rings here, up to XEMACPSIF_RX_POLL_BUDGET frames per call.
  *
- * Returns the number of packets read (max 1 packet on success,
- * 0 if there are no packets)
+ * Returns the number of packets read (0 if there are no packets)
  *
  */
 
 s32_t xemacpsif_input(struct netif *netif)
 {
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	struct pbuf *pbufs[XEMACPSIF_RX_BATCH];
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
-	SYS_ARCH_DECL_PROTECT(lev);
+	u32_t n_pbufs;
+	u32_t i;
+	s32_t n_packets = 0;
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+	s32_t budget = XEMACPSIF_RX_POLL_BUDGET;
+#endif
 
 #ifdef OS_IS_FREERTOS
 	while (1)
 #endif
 	{
-		/* move received packet into a new pbuf */
-		SYS_ARCH_PROTECT(lev);
-		p = low_level_input(netif);
-		SYS_ARCH_UNPROTECT(lev);
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+		if (xemacpsif->rx_polling && (budget > 0) &&
+			(spsc_qlength(xemacpsif->recv_q) < XEMACPSIF_RX_BATCH)) {
+			budget -= xemacpsif_rx_poll(xemac, (budget < XEMACPSIF_RX_BATCH) ?
+						budget : XEMACPSIF_RX_BATCH);
+		}
+#endif
+		n_pbufs = 0;
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+		/* frames received on the priority queue are handed over first */
+		n_pbufs = spsc_dequeue_batch(xemacpsif->recv_prio_q,
+					(void **)pbufs, XEMACPSIF_RX_BATCH);
+#endif
+		if (n_pbufs == 0) {
+			n_pbufs = spsc_dequeue_batch(xemacpsif->recv_q,
+					(void **)pbufs, XEMACPSIF_RX_BATCH);
+		}
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL) {
-			return 0;
+		if (n_pbufs == 0) {
+#if defined(XLWIP_CONFIG_RX_POLL_MODE) && !NO_SYS
+			/* budget used up with frames pending, come back later */
+			if (xemacpsif->rx_polling) {
+				sys_sem_signal(&xemac->sem_rx_data_available);
+			}
+#endif
+			return n_packets;
 		}
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-	#if LINK_STATS
-		lwip_stats.link.recv++;
-	#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-	#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-	#endif
-	#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-	#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
-					pbuf_free(p);
-					p = NULL;
-				}
-				break;
+		for (i = 0; i < n_pbufs; i++) {
+			p = pbufs[i];
+
+			/* points to packet payload, which starts with an Ethernet header */
+			ethhdr = p->payload;
 
-			default:
+		#if LINK_STATS
+			lwip_stats.link.recv++;
+		#endif /* LINK_STATS */
+
+			/* software checks for what the GEM did not verify */
+			if (!xemac_rx_csum_check(netif, p)) {
+		#if LINK_STATS
+				lwip_stats.link.chkerr++;
+				lwip_stats.link.drop++;
+		#endif /* LINK_STATS */
 				pbuf_free(p);
-				p = NULL;
-				break;
+				continue;
+			}
+
+			switch (htons(ethhdr->type)) {
+				/* IP or ARP packet? */
+				case ETHTYPE_IP:
+				case ETHTYPE_ARP:
+		#if LWIP_IPV6
+				/*IPv6 Packet?*/
+				case ETHTYPE_IPV6:
+		#endif
+		#if PPPOE_SUPPORT
+					/* PPPoE packet? */
+				case ETHTYPE_PPPOEDISC:
+				case ETHTYPE_PPPOE:
+		#endif /* PPPOE_SUPPORT */
+					/* full packet send to tcpip_thread to process */
+					if (netif->input(p, netif) != ERR_OK) {
+						LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+						pbuf_free(p);
+						p = NULL;
+					}
+					break;
+
+				default:
+					pbuf_free(p);
+					p = NULL;
+					break;
+			}
 		}
+		n_packets += n_pbufs;
 	}
 
-	return 1;
+	return n_packets;
 }
 
-
 #if defined(OS_IS_FREERTOS) && defined(__arm__) && !defined(ARMR5)
 void vTimerCallback( TimerHandle_t pxTimer )
 {
@@ -307,6 +342,7 @@ static err_t low_level_init(struct netif *netif)
 	struct xemac_s *xemac;
 	xemacpsif_s *xemacpsif;
 	u32 dmacrreg;
+	u32 options;
 
 	s32_t status = XST_SUCCESS;
 
@@ -328,10 +364,21 @@ static err_t low_level_init(struct netif *netif)
 	xemac->topology_index = xtopology_find_index(mac_address);
 	xemac->type = xemac_type_emacps;
 
+	memset(&xemacpsif->txstats, 0, sizeof(xemacpsif->txstats));
 	xemacpsif->send_q = NULL;
-	xemacpsif->recv_q = pq_create_queue();
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+	xemacpsif->rx_polling = 0;
+#endif
+	xemacpsif->recv_q = spsc_create_queue();
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	memset(xemacpsif->prio_rules, 0, sizeof(xemacpsif->prio_rules));
+	xemacpsif->prio_queues = 0;
+	xemacpsif->recv_prio_q = spsc_create_queue();
+	if (!xemacpsif->recv_prio_q)
+		return ERR_MEM;
+#endif
 
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
@@ -374,6 +421,23 @@ static err_t low_level_init(struct netif *netif)
 	/* initialize the mac */
 	init_emacps(xemacpsif, netif);
 
+	/* the GEM computes and checks IP, TCP and UDP checksums when enabled */
+	options = XEmacPs_GetOptions(&xemacpsif->emacps);
+	xemac_set_csum_offload(netif,
+		(options & XEMACPS_TX_CHKSUM_ENABLE_OPTION) ?
+			(XEMAC_CSUM_IP | XEMAC_CSUM_TCP | XEMAC_CSUM_UDP) : 0,
+		(options & XEMACPS_RX_CHKSUM_ENABLE_OPTION) ?
+			(XEMAC_CSUM_IP | XEMAC_CSUM_TCP | XEMAC_CSUM_UDP) : 0);
+
+#if LWIP_TCP_TSO && defined(XLWIP_CONFIG_GEM_TSO)
+	/* lwIP may then hand over TCP segments of up to TCP_TSO_MAX_LEN,
+	 * which the GEM cuts to MSS; the per-segment checksums are its job */
+	if ((options & XEMACPS_TX_CHKSUM_ENABLE_OPTION) &&
+		XEmacPs_IsLsoCapable(&xemacpsif->emacps)) {
+		netif->flags |= NETIF_FLAG_TSO;
+	}
+#endif
+
 	dmacrreg = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
 														XEMACPS_DMACR_OFFSET);
 	dmacrreg = dmacrreg | (0x00000010);
@@ -394,6 +458,8 @@ static err_t low_level_init(struct netif *netif)
 	setup_isr(xemac);
 	init_dma(xemac);
 	start_emacps(xemacpsif);
+	setup_tx_reclaim_mode(xemacpsif);
+	setup_intr_moderation(xemacpsif);
 
 	/* replace the state in netif (currently the emac baseaddress)
 	 * with the mac instance pointer.
@@ -429,6 +495,8 @@ void HandleEmacPsError(struct xemac_s *xemac)
 	setup_isr(xemac);
 	init_dma(xemac);
 	start_emacps(xemacpsif);
+	setup_tx_reclaim_mode(xemacpsif);
+	setup_intr_moderation(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -490,7 +558,18 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	multicast_mac_addr[5] = ip_addr[15];
 
 	/* Wait till all sent packets are acknowledged from HW */
-	while(txring->HwCnt);
+#ifdef XLWIP_CONFIG_TX_BATCHED_RECLAIM
+	while(XEmacPs_BdRingGetHwCnt(txring)) {
+		xemacpsif_tx_reclaim(netif);
+	}
+#else
+	while(XEmacPs_BdRingGetHwCnt(txring));
+#endif
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	while (xemacpsif->prio_queues && XEmacPs_BdRingGetHwCnt(&xemacpsif->txq1_ring)) {
+		xemacpsif_tx_reclaim(netif);
+	}
+#endif
 
 	SYS_ARCH_DECL_PROTECT(lev);
 
@@ -513,6 +592,8 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 
 	/* Start Ethernet */
 	XEmacPs_Start(&xemacpsif->emacps);
+	setup_tx_reclaim_mode(xemacpsif);
+	setup_intr_moderation(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -597,7 +678,18 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	multicast_mac_addr[5] = ip_addr[3];
 
 	/* Wait till all sent packets are acknowledged from HW */
-	while(txring->HwCnt);
+#ifdef XLWIP_CONFIG_TX_BATCHED_RECLAIM
+	while(XEmacPs_BdRingGetHwCnt(txring)) {
+		xemacpsif_tx_reclaim(netif);
+	}
+#else
+	while(XEmacPs_BdRingGetHwCnt(txring));
+#endif
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	while (xemacpsif->prio_queues && XEmacPs_BdRingGetHwCnt(&xemacpsif->txq1_ring)) {
+		xemacpsif_tx_reclaim(netif);
+	}
+#endif
 
 	SYS_ARCH_DECL_PROTECT(lev);
 
@@ -620,6 +712,8 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 
 	/* Start Ethernet */
 	XEmacPs_Start(&xemacpsif->emacps);
+	setup_tx_reclaim_mode(xemacpsif);
+	setup_intr_moderation(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -34,6 +34,7 @@
 #include "lwip/stats.h"
 #include "lwip/sys.h"
 #include "lwip/inet_chksum.h"
+#include "lwip/prot/tcp.h"
 
 #include "netif/xadapter.h"
 #include "netif/xemacpsif.h"
@@ -67,6 +68,60 @@
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
 static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
 
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+/* Time at which each TX BD was handed to the GEM, for reclaim latency */
+static XTime tx_bd_timestamp[4*XLWIP_CONFIG_N_TX_DESC];
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+/* Same bookkeeping for the queue 1 (priority) rings */
+static UINTPTR txq1_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
+static UINTPTR rxq1_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+static XTime txq1_bd_timestamp[4*XLWIP_CONFIG_N_TX_DESC];
+#endif
+#endif
+
+/* Cache line size used to merge adjacent TX flush ranges */
+#define TX_FLUSH_CACHELINE	64
+
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "The GEM RX buffer pool needs LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+/*
+ * Dedicated RX buffer pool. Buffers are cache line aligned and invalidated
+ * once when the pool is set up. From then on only the bytes of a buffer the
+ * CPU could have pulled into its cache, i.e. the received frame, are
+ * invalidated again: on reception and when the buffer is freed back to the
+ * pool. Received frames are handed to lwIP as custom pbufs whose free
+ * function puts the buffer back on the pool free list, refilling RX BDs
+ * that could not be given a buffer earlier.
+ */
+#define RXBUF_CACHELINE		64
+#ifdef ZYNQMP_USE_JUMBO
+#define RXBUF_FRAME_SIZE	MAX_FRAME_SIZE_JUMBO
+#else
+#define RXBUF_FRAME_SIZE	XEMACPS_MAX_FRAME_SIZE
+#endif
+#define RXBUF_SIZE	((RXBUF_FRAME_SIZE + RXBUF_CACHELINE - 1) & \
+						~(RXBUF_CACHELINE - 1))
+
+typedef struct rxbuf_s {
+	struct pbuf_custom pc;		/* must be first */
+	struct rxbuf_s *next;
+	xemacpsif_s *owner;
+	u32_t rx_len;			/* bytes possibly held in the cache */
+	u8_t *data;
+} rxbuf_t;
+
+static u8_t rxbuf_data[XLWIP_CONFIG_GEM_RX_POOL_SIZE][RXBUF_SIZE]
+				__attribute__ ((aligned (RXBUF_CACHELINE)));
+static rxbuf_t rxbuf_pool[XLWIP_CONFIG_GEM_RX_POOL_SIZE];
+static rxbuf_t *rxbuf_free_list;
+static u32_t rxbuf_pool_ready;
+#endif
+
 static s32_t emac_intr_num;
 
 /******************************************************************************
@@ -193,6 +248,57 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+/*
+ * The pbuf and timestamp bookkeeping of each BD ring lives in the static
+ * arrays above. These return the part that belongs to the given ring.
+ */
+static inline
+UINTPTR *get_txpbufs_storage(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
+{
+	u32_t index = get_base_index_txpbufsstorage (xemacpsif);
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (txring == &xemacpsif->txq1_ring) {
+		return &txq1_pbufs_storage[index];
+	}
+#else
+	(void)txring;
+#endif
+	return &tx_pbufs_storage[index];
+}
+
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+static inline
+XTime *get_tx_timestamps(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
+{
+	u32_t index = get_base_index_txpbufsstorage (xemacpsif);
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (txring == &xemacpsif->txq1_ring) {
+		return &txq1_bd_timestamp[index];
+	}
+#else
+	(void)txring;
+#endif
+	return &tx_bd_timestamp[index];
+}
+#endif
+
+static inline
+UINTPTR *get_rxpbufs_storage(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	u32_t index = get_base_index_rxpbufsstorage (xemacpsif);
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (rxring == &xemacpsif->rxq1_ring) {
+		return &rxq1_pbufs_storage[index];
+	}
+#else
+	(void)rxring;
+#endif
+	return &rx_pbufs_storage[index];
+}
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -203,9 +309,19 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 	u32_t bdindex;
 	struct pbuf *p;
 	u32 *temp;
-	u32_t index;
+	UINTPTR *pbufs_storage;
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	XTime *timestamps;
+	XTime now;
+	XTime latency;
+#endif
+	xemacpsif_txstats_s *txstats = &xemacpsif->txstats;
 
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	pbufs_storage = get_txpbufs_storage(xemacpsif, txring);
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	timestamps = get_tx_timestamps(xemacpsif, txring);
+	XTime_GetTime(&now);
+#endif
 
 	while (1) {
 		/* obtain processed BD's */
@@ -227,16 +343,28 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			} else {
 				*temp = 0x80000000;
 			}
-			dsb();
-			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
+			p = (struct pbuf *)pbufs_storage[bdindex];
 			if (p != NULL) {
 				pbuf_free(p);
 			}
-			tx_pbufs_storage[index + bdindex] = 0;
+			pbufs_storage[bdindex] = 0;
+
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+			latency = now - timestamps[bdindex];
+			txstats->reclaim_latency_sum += latency;
+			if (latency > txstats->reclaim_latency_max) {
+				txstats->reclaim_latency_max = latency;
+			}
+#endif
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
 			n_pbufs_freed--;
-			dsb();
 		}
+		/* one barrier for the whole batch of BD updates */
+		dsb();
+
+		txstats->reclaim_runs++;
+		txstats->bds_reclaimed += n_bds;
+		txstats->bds_inflight -= n_bds;
 
 		status = XEmacPs_BdRingFree(txring, n_bds, txbdset);
 		if (status != XST_SUCCESS) {
@@ -246,6 +374,186 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 	return;
 }
 
+/*
+ * xemacpsif_tx_reclaim():
+ *
+ * Reclaims all BDs the GEM has finished sending. It is meant to be called
+ * at regular intervals from an application timer when the TX complete
+ * interrupt is disabled (XLWIP_CONFIG_TX_BATCHED_RECLAIM), so that sent
+ * pbufs are released even when the TX path goes idle.
+ */
+void xemacpsif_tx_reclaim(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	XEmacPs_BdRing *txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	process_sent_bds(xemacpsif, txring);
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		process_sent_bds(xemacpsif, &xemacpsif->txq1_ring);
+	}
+#endif
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+xemacpsif_txstats_s *xemacpsif_get_txstats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	return &xemacpsif->txstats;
+}
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+/*
+ * Checks an outgoing frame against the priority screener rules, the same
+ * way the GEM screeners check received frames. Only the first pbuf of the
+ * chain is looked at; lwIP always builds the Ethernet, IP and UDP headers
+ * in one pbuf.
+ */
+static s32_t match_prio_rules(xemacpsif_s *xemacpsif, struct pbuf *p)
+{
+	u8_t *frame = (u8_t *)p->payload + ETH_PAD_SIZE;
+	s32_t len = (s32_t)p->len - ETH_PAD_SIZE;
+	XEmacPs_Screener *rule;
+	u16_t ethtype;
+	u16_t udpport = 0;
+	u8_t vlanpri = 0;
+	u8_t is_vlan = 0;
+	u8_t is_udp = 0;
+	s32_t off = SIZEOF_ETH_HDR;
+	s32_t ihl;
+	u32_t i;
+
+	if (len < SIZEOF_ETH_HDR) {
+		return 0;
+	}
+	ethtype = (u16_t)((frame[12] << 8) | frame[13]);
+	if ((ethtype == ETHTYPE_VLAN) && (len >= (SIZEOF_ETH_HDR + 4))) {
+		is_vlan = 1;
+		vlanpri = frame[14] >> 5;
+		ethtype = (u16_t)((frame[16] << 8) | frame[17]);
+		off += 4;
+	}
+	if ((ethtype == ETHTYPE_IP) && (len >= (off + IP_HLEN))) {
+		ihl = (frame[off] & 0x0F) * 4;
+		/* only the first fragment carries the UDP header */
+		if ((frame[off + 9] == IP_PROTO_UDP) &&
+			(((frame[off + 6] & 0x1F) | frame[off + 7]) == 0) &&
+			(len >= (off + ihl + 4))) {
+			udpport = (u16_t)((frame[off + ihl + 2] << 8) |
+						frame[off + ihl + 3]);
+			is_udp = 1;
+		}
+	}
+
+	for (i = 0; i < XEMACPS_MAX_SCREENERS; i++) {
+		rule = &xemacpsif->prio_rules[i];
+		if (rule->MatchFlags == 0) {
+			continue;
+		}
+		if ((rule->MatchFlags & XEMACPS_SCREEN_MATCH_ETHTYPE) &&
+			(rule->EtherType != ethtype)) {
+			continue;
+		}
+		if ((rule->MatchFlags & XEMACPS_SCREEN_MATCH_VLANPRI) &&
+			((!is_vlan) || (rule->VlanPriority != vlanpri))) {
+			continue;
+		}
+		if ((rule->MatchFlags & XEMACPS_SCREEN_MATCH_UDPPORT) &&
+			((!is_udp) || (rule->UdpPort != udpport))) {
+			continue;
+		}
+		return 1;
+	}
+	return 0;
+}
+#endif
+
+/*
+ * select_txring():
+ *
+ * Returns the TX BD ring a frame is to be sent on. It must be called before
+ * the ETH_PAD_SIZE padding is dropped from the frame.
+ */
+XEmacPs_BdRing *select_txring(xemacpsif_s *xemacpsif, struct pbuf *p)
+{
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues && match_prio_rules(xemacpsif, p)) {
+		return &xemacpsif->txq1_ring;
+	}
+#else
+	(void)p;
+#endif
+	return &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+}
+
+/*
+ * xemacpsif_set_priority_screener():
+ *
+ * Installs screener rule 'index' so that frames matching it use GEM queue 1
+ * in both directions. A rule with no match flags removes the entry.
+ * Returns ERR_IF when priority queuing is not in use on this interface and
+ * ERR_ARG for a rule the GEM screeners can not express.
+ */
+err_t xemacpsif_set_priority_screener(struct netif *netif, u8_t index,
+					XEmacPs_Screener *screener)
+{
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	XEmacPs_Screener rule;
+	LONG status;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (!xemacpsif->prio_queues) {
+		return ERR_IF;
+	}
+	if ((index >= XEMACPS_MAX_SCREENERS) || (screener == NULL) ||
+		(screener->VlanPriority > 7)) {
+		return ERR_ARG;
+	}
+	rule = *screener;
+	rule.QueueNum = XEMACPSIF_PRIO_QUEUE;
+
+	SYS_ARCH_PROTECT(lev);
+	status = XEmacPs_SetScreener(&xemacpsif->emacps, index, &rule);
+	if (status == XST_SUCCESS) {
+		xemacpsif->prio_rules[index] = rule;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return (status == XST_SUCCESS) ? ERR_OK : ERR_ARG;
+#else
+	(void)netif;
+	(void)index;
+	(void)screener;
+	return ERR_IF;
+#endif
+}
+
+/*
+ * setup_tx_reclaim_mode():
+ *
+ * In batched reclaim mode the TX complete interrupt is disabled once the
+ * GEM has been started, so that sent BDs are only reaped in bulk.
+ */
+void setup_tx_reclaim_mode(xemacpsif_s *xemacpsif)
+{
+#ifdef XLWIP_CONFIG_TX_BATCHED_RECLAIM
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_TXCOMPL_MASK);
+	if (xemacpsif->emacps.Version > 2) {
+		XEmacPs_IntQ1Disable(&xemacpsif->emacps,
+						XEMACPS_INTQ1SR_TXCOMPL_MASK);
+	}
+#else
+	(void)xemacpsif;
+#endif
+}
+
 void emacps_send_handler(void *arg)
 {
 	struct xemac_s *xemac;
@@ -263,76 +571,207 @@ void emacps_send_handler(void *arg)
 
 	/* If Transmit done interrupt is asserted, process completed BD's */
 	process_sent_bds(xemacpsif, txringptr);
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		process_sent_bds(xemacpsif, &xemacpsif->txq1_ring);
+	}
+#endif
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
 }
 
-XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
+#if LWIP_TCP_TSO
+/*
+ * Length of the Ethernet, IPv4 and TCP headers of a large send. The GEM
+ * expects them, and nothing else, in the first BD of the frame. Returns 0
+ * if they are not all in the first pbuf.
+ */
+u16_t tso_header_len(struct pbuf *p)
+{
+	u8_t *hdr = (u8_t *)p->payload;
+	u16_t len = SIZEOF_ETH_HDR - ETH_PAD_SIZE;
+
+	if (((hdr[12] << 8) | hdr[13]) == ETHTYPE_VLAN) {
+		len += SIZEOF_VLAN_HDR;
+	}
+	if ((u32_t)len + IP_HLEN > p->len) {
+		return 0;
+	}
+	len += (hdr[len] & 0x0F) * 4;
+	if ((u32_t)len + TCP_HLEN > p->len) {
+		return 0;
+	}
+	len += (hdr[len + 12] >> 4) * 4;
+	if (len > p->len) {
+		return 0;
+	}
+	return len;
+}
+#endif
+
+XStatus emacps_sgsend(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring,
+							struct pbuf *p)
 {
 	struct pbuf *q;
 	s32_t n_pbufs;
+	s32_t n_bds;
+	s32_t i;
+	u16_t split = 0;
+	UINTPTR addr;
+	u32_t len;
 	XEmacPs_Bd *txbdset, *txbd, *last_txbd = NULL;
 	XEmacPs_Bd *temp_txbd;
 	XStatus status;
-	XEmacPs_BdRing *txring;
 	u32_t bdindex;
 	u32_t lev;
-	u32_t index;
+	UINTPTR *pbufs_storage;
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	XTime *timestamps;
+	XTime now;
+#endif
 	u32_t max_fr_size;
+	UINTPTR flush_start = 0;
+	UINTPTR flush_end = 0;
+	xemacpsif_txstats_s *txstats = &xemacpsif->txstats;
 
 	lev = mfcpsr();
 	mtcpsr(lev | 0x000000C0);
 
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
-
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	pbufs_storage = get_txpbufs_storage(xemacpsif, txring);
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	timestamps = get_tx_timestamps(xemacpsif, txring);
+#endif
 
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
 		n_pbufs++;
+	n_bds = n_pbufs;
+
+#if LWIP_TCP_TSO
+	/* a large send carries its headers in a BD of their own */
+	if (p->tso_mss != 0) {
+		split = tso_header_len(p);
+		if (split == 0) {
+			mtcpsr(lev);
+			LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: TSO headers not in first pbuf\r\n"));
+			return XST_FAILURE;
+		}
+		if (split < p->len) {
+			n_bds++;
+		} else {
+			split = 0;
+		}
+		/* payload BDs are not cut at the frame size, only at the BD
+		   length limit; the GEM cuts the frames at the MSS */
+		for (q = p; q != NULL; q = q->next) {
+			len = q->len;
+			if (q == p) {
+				len -= split;
+			}
+			if (len > XEMACPS_TXBUF_LEN_MASK) {
+				mtcpsr(lev);
+				LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: TSO pbuf too long for a BD\r\n"));
+				return XST_FAILURE;
+			}
+		}
+	}
+#endif
 
 	/* obtain as many BD's */
-	status = XEmacPs_BdRingAlloc(txring, n_pbufs, &txbdset);
+	status = XEmacPs_BdRingAlloc(txring, n_bds, &txbdset);
 	if (status != XST_SUCCESS) {
 		mtcpsr(lev);
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error allocating TxBD\r\n"));
 		return XST_FAILURE;
 	}
 
-	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
+	for(q = p, i = 0, txbd = txbdset; q != NULL; i++) {
 		bdindex = XEMACPS_BD_TO_INDEX(txring, txbd);
-		if (tx_pbufs_storage[index + bdindex] != 0) {
+		if (pbufs_storage[bdindex] != 0) {
 			mtcpsr(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("PBUFS not available\r\n"));
 			return XST_FAILURE;
 		}
 
+		/* the headers of a large send are split off the first pbuf */
+		addr = (UINTPTR)q->payload;
+		len = q->len;
+		if ((q == p) && (split != 0)) {
+			if (i == 0) {
+				len = split;
+			} else {
+				addr += split;
+				len -= split;
+			}
+		}
+
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		   time. The size of the data in each pbuf is kept in the ->len
-		   variable. */
+		   variable. A payload whose first cache line touches or
+		   overlaps the current flush range is merged into it; any
+		   other payload starts a new range, so no bytes between two
+		   buffers are flushed. */
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheFlushRange((UINTPTR)q->payload, (UINTPTR)q->len);
+			if ((flush_end != 0) &&
+				(addr >= flush_start) &&
+				((addr & ~(UINTPTR)(TX_FLUSH_CACHELINE - 1)) <=
+				((flush_end + TX_FLUSH_CACHELINE - 1) &
+				~(UINTPTR)(TX_FLUSH_CACHELINE - 1)))) {
+				if ((addr + len) > flush_end) {
+					flush_end = addr + len;
+				}
+			} else {
+				if (flush_end != 0) {
+					Xil_DCacheFlushRange(flush_start,
+							flush_end - flush_start);
+				}
+				flush_start = addr;
+				flush_end = flush_start + len;
+			}
 		}
 
-		XEmacPs_BdSetAddressTx(txbd, (UINTPTR)q->payload);
+		XEmacPs_BdSetAddressTx(txbd, addr);
 
 #ifdef ZYNQMP_USE_JUMBO
 		max_fr_size = MAX_FRAME_SIZE_JUMBO - 18;
 #else
 		max_fr_size = XEMACPS_MAX_FRAME_SIZE - 18;
 #endif
-		if (q->len > max_fr_size)
+#if LWIP_TCP_TSO
+		if ((p->tso_mss != 0) && (i > 0))
+			XEmacPs_BdSetLength(txbd, len & XEMACPS_TXBUF_LEN_MASK);
+		else
+#endif
+		if (len > max_fr_size)
 			XEmacPs_BdSetLength(txbd, max_fr_size & 0x3FFF);
 		else
-			XEmacPs_BdSetLength(txbd, q->len & 0x3FFF);
+			XEmacPs_BdSetLength(txbd, len & 0x3FFF);
+
+#if LWIP_TCP_TSO
+		/* LSO mode in the header BD, MSS in the first payload BD */
+		if (p->tso_mss != 0) {
+			if (i == 0) {
+				XEmacPs_BdSetTso(txbd, XEMACPS_LSO_TSO);
+			} else if (i == 1) {
+				XEmacPs_BdSetMss(txbd, p->tso_mss);
+			}
+		}
+#endif
 
-		tx_pbufs_storage[index + bdindex] = (UINTPTR)q;
+		/* both BDs of a split pbuf hold a reference on it */
+		pbufs_storage[bdindex] = (UINTPTR)q;
 
 		pbuf_ref(q);
 		last_txbd = txbd;
 		XEmacPs_BdClearLast(txbd);
 		txbd = XEmacPs_BdRingNext(txring, txbd);
+		if ((q != p) || (split == 0) || (i != 0)) {
+			q = q->next;
+		}
+	}
+	if (flush_end != 0) {
+		Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
 	}
 	XEmacPs_BdSetLast(last_txbd);
 	/* For fragmented packets, remember the 1st BD allocated for the 1st
@@ -342,21 +781,34 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	temp_txbd = txbdset;
 	txbd = txbdset;
 	txbd = XEmacPs_BdRingNext(txring, txbd);
-	q = p->next;
-	for(; q != NULL; q = q->next) {
+	for (i = 1; i < n_bds; i++) {
 		XEmacPs_BdClearTxUsed(txbd);
-		dsb();
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
+	/* All fragments must be visible before the first BD is released */
+	dsb();
 	XEmacPs_BdClearTxUsed(temp_txbd);
 	dsb();
 
-	status = XEmacPs_BdRingToHw(txring, n_pbufs, txbdset);
+	status = XEmacPs_BdRingToHw(txring, n_bds, txbdset);
 	if (status != XST_SUCCESS) {
 		mtcpsr(lev);
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error submitting TxBD\r\n"));
 		return XST_FAILURE;
 	}
+
+#ifdef XEMACPSIF_TX_LATENCY_STATS
+	XTime_GetTime(&now);
+	for (i = 0, txbd = txbdset; i < n_bds; i++) {
+		bdindex = XEMACPS_BD_TO_INDEX(txring, txbd);
+		timestamps[bdindex] = now;
+		txbd = XEmacPs_BdRingNext(txring, txbd);
+	}
+#endif
+	txstats->bds_inflight += n_bds;
+	if (txstats->bds_inflight > txstats->bds_inflight_max) {
+		txstats->bds_inflight_max = txstats->bds_inflight;
+	}
 	/* Start transmit */
 	XEmacPs_WriteReg((xemacpsif->emacps).Config.BaseAddress,
 	XEMACPS_NWCTRL_OFFSET,
@@ -367,6 +819,97 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	return status;
 }
 
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+static void rxbuf_pool_init(void)
+{
+	u32_t i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	if (rxbuf_pool_ready == 0) {
+		rxbuf_free_list = NULL;
+		for (i = 0; i < XLWIP_CONFIG_GEM_RX_POOL_SIZE; i++) {
+			rxbuf_pool[i].data = rxbuf_data[i];
+			rxbuf_pool[i].rx_len = 0;
+			rxbuf_pool[i].owner = NULL;
+			rxbuf_pool[i].next = rxbuf_free_list;
+			rxbuf_free_list = &rxbuf_pool[i];
+		}
+		Xil_DCacheInvalidateRange((UINTPTR)rxbuf_data, sizeof(rxbuf_data));
+		rxbuf_pool_ready = 1;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static void rxbuf_free(struct pbuf *p)
+{
+	rxbuf_t *buf = (rxbuf_t *)p;
+	xemacpsif_s *xemacpsif = buf->owner;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	/* drop whatever lwIP may have read or written back into the cache */
+	if ((buf->rx_len != 0) &&
+		(xemacpsif->emacps.Config.IsCacheCoherent == 0)) {
+		Xil_DCacheInvalidateRange((UINTPTR)buf->data, buf->rx_len);
+	}
+	buf->rx_len = 0;
+
+	SYS_ARCH_PROTECT(lev);
+	buf->next = rxbuf_free_list;
+	rxbuf_free_list = buf;
+	if (xemacpsif->rx_starved) {
+		xemacpsif->rx_starved = 0;
+		setup_rx_bds(xemacpsif, &XEmacPs_GetRxRing(&xemacpsif->emacps));
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+		if (xemacpsif->prio_queues) {
+			setup_rx_bds(xemacpsif, &xemacpsif->rxq1_ring);
+		}
+#endif
+	}
+	SYS_ARCH_UNPROTECT(lev);
+}
+#endif
+
+/*
+ * Returns a pbuf for an RX BD, with no part of its payload left in the
+ * data cache, or NULL when no buffer is available.
+ */
+static struct pbuf *alloc_rx_pbuf(xemacpsif_s *xemacpsif)
+{
+	struct pbuf *p;
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+	rxbuf_t *buf;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	buf = rxbuf_free_list;
+	if (buf != NULL) {
+		rxbuf_free_list = buf->next;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+	if (buf == NULL) {
+		return NULL;
+	}
+	buf->owner = xemacpsif;
+	buf->pc.custom_free_function = rxbuf_free;
+	p = pbuf_alloced_custom(PBUF_RAW, RXBUF_FRAME_SIZE, PBUF_REF, &buf->pc,
+						buf->data, RXBUF_SIZE);
+#else
+#ifdef ZYNQMP_USE_JUMBO
+	p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
+	if ((p != NULL) && (xemacpsif->emacps.Config.IsCacheCoherent == 0)) {
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
+	}
+#else
+	p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
+	if ((p != NULL) && (xemacpsif->emacps.Config.IsCacheCoherent == 0)) {
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
+	}
+#endif
+#endif
+	return p;
+}
+
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 {
 	XEmacPs_Bd *rxbd;
@@ -375,24 +918,25 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32_t freebds;
 	u32_t bdindex;
 	u32 *temp;
-	u32_t index;
+	UINTPTR *pbufs_storage;
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
+	pbufs_storage = get_rxpbufs_storage(xemacpsif, rxring);
 
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
 		freebds--;
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
-#else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
-#endif
+		p = alloc_rx_pbuf(xemacpsif);
 		if (!p) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
 #endif
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+			/* refilled as soon as a buffer comes back to the pool */
+			xemacpsif->rx_starved = 1;
+#else
 			printf("unable to alloc pbuf in recv_handler\r\n");
+#endif
 			return;
 		}
 		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
@@ -415,15 +959,6 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
 			return;
 		}
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
 		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
 		temp = (u32 *)rxbd;
 		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
@@ -436,47 +971,35 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 		dsb();
 
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+		pbufs_storage[bdindex] = (UINTPTR)p;
 	}
 }
 
-void emacps_recv_handler(void *arg)
+/*
+ * Hands up to 'budget' frames received on one RX BD ring over to the given
+ * receive queue and gives the ring fresh pbufs. Returns the number of
+ * frames harvested.
+ */
+static s32_t process_rx_ring(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring,
+				spsc_queue_t *recv_q, s32_t budget)
 {
 	struct pbuf *p;
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
-	xemacpsif_s *xemacpsif;
-	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
 	s32_t rx_bytes, k;
 	u32_t bdindex;
-	u32_t regval;
-	u32_t index;
-	u32_t gigeversion;
-
-	xemac = (struct xemac_s *)(arg);
-	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
-
-#ifdef OS_IS_FREERTOS
-	xInsideISR++;
-#endif
+	u32_t rx_csum_offload;
+	UINTPTR *pbufs_storage;
+	s32_t n_frames = 0;
 
-	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
-	/*
-	 * If Reception done interrupt is asserted, call RX call back function
-	 * to handle the processed BDs and then raise the according flag.
-	 */
-	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
-	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
-	if (gigeversion <= 2) {
-			resetrx_on_no_rxdata(xemacpsif);
-	}
+	pbufs_storage = get_rxpbufs_storage(xemacpsif, rxring);
+	rx_csum_offload = XEmacPs_GetOptions(&xemacpsif->emacps) &
+					XEMACPS_RX_CHKSUM_ENABLE_OPTION;
 
-	while(1) {
+	while (n_frames < budget) {
 
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring,
+					(u32)(budget - n_frames), &rxbdset);
 		if (bd_processed <= 0) {
 			break;
 		}
@@ -484,7 +1007,7 @@ void emacps_recv_handler(void *arg)
 		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
 
 			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+			p = (struct pbuf *)pbufs_storage[bdindex];
 
 			/*
 			 * Adjust the buffer size to the actual number of bytes received.
@@ -495,11 +1018,38 @@ void emacps_recv_handler(void *arg)
 			rx_bytes = XEmacPs_BdGetLength(curbdptr);
 #endif
 			pbuf_realloc(p, rx_bytes);
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+			/*
+			 * Only the received bytes are invalidated, here against
+			 * lines fetched speculatively during the DMA, and again
+			 * when lwIP frees the buffer.
+			 */
+			((rxbuf_t *)p)->rx_len = (u32_t)rx_bytes;
+			if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+				Xil_DCacheInvalidateRange((UINTPTR)p->payload,
+							(UINTPTR)rx_bytes);
+			}
+#endif
+
+			/* record which checksums the GEM verified */
+			if (rx_csum_offload) {
+				switch (XEmacPs_BdGetRxCsumStatus(curbdptr)) {
+				case XEMACPS_RXBUF_CSUM_IP_TCP:
+				case XEMACPS_RXBUF_CSUM_IP_UDP:
+					p->flags |= XEMAC_PBUF_FLAG_CSUM_L4;
+					/* fall through */
+				case XEMACPS_RXBUF_CSUM_IP:
+					p->flags |= XEMAC_PBUF_FLAG_CSUM_IP;
+					break;
+				default:
+					break;
+				}
+			}
 
 			/* store it in the receive queue,
 			 * where it'll be processed by a different handler
 			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+			if (spsc_enqueue(recv_q, (void*)p) < 0) {
 #if LINK_STATS
 				lwip_stats.link.memerr++;
 				lwip_stats.link.drop++;
@@ -511,10 +1061,136 @@ void emacps_recv_handler(void *arg)
 		/* free up the BD's */
 		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
 		setup_rx_bds(xemacpsif, rxring);
-#if !NO_SYS
-		sys_sem_signal(&xemac->sem_rx_data_available);
+		n_frames += bd_processed;
+	}
+	return n_frames;
+}
+
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+static void rx_intr_disable(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	if ((xemacpsif->emacps.Version > 2) &&
+		(xemacpsif->emacps.RxQ1Ready != 0U)) {
+		XEmacPs_IntQ1Disable(&xemacpsif->emacps,
+						XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+
+static void rx_intr_enable(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	if ((xemacpsif->emacps.Version > 2) &&
+		(xemacpsif->emacps.RxQ1Ready != 0U)) {
+		XEmacPs_IntQ1Enable(&xemacpsif->emacps,
+						XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+#endif
+
+/*
+ * xemacpsif_rx_poll():
+ *
+ * Harvests up to 'budget' received frames from the RX BD rings, priority
+ * ring first. In polling mode, once a poll finds the rings drained before
+ * the budget is used up the receive interrupt is re-enabled, so the adapter
+ * goes back to interrupt driven operation when the link is idle.
+ * Returns the number of frames harvested.
+ */
+s32_t xemacpsif_rx_poll(struct xemac_s *xemac, s32_t budget)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	s32_t n_frames = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		n_frames = process_rx_ring(xemacpsif, &xemacpsif->rxq1_ring,
+					xemacpsif->recv_prio_q, budget);
+	}
+#endif
+	n_frames += process_rx_ring(xemacpsif,
+				&XEmacPs_GetRxRing(&xemacpsif->emacps),
+				xemacpsif->recv_q, budget - n_frames);
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+	if (xemacpsif->rx_polling && (n_frames < budget)) {
+		xemacpsif->rx_polling = 0;
+		rx_intr_enable(xemacpsif);
+	}
+#endif
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n_frames;
+}
+
+/*
+ * setup_intr_moderation():
+ *
+ * Programs the GEM interrupt moderation delays configured for the adapter.
+ * GEM revisions without moderation registers are left untouched.
+ */
+void setup_intr_moderation(xemacpsif_s *xemacpsif)
+{
+#if (XLWIP_CONFIG_GEM_RX_INTR_MODERATION > 0) || \
+	(XLWIP_CONFIG_GEM_TX_INTR_MODERATION > 0)
+	(void)XEmacPs_SetIntrModeration(&xemacpsif->emacps,
+				XLWIP_CONFIG_GEM_RX_INTR_MODERATION,
+				XLWIP_CONFIG_GEM_TX_INTR_MODERATION);
+#else
+	(void)xemacpsif;
+#endif
+}
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	XEmacPs_BdRing *rxring;
+	u32_t regval;
+	u32_t gigeversion;
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
 #endif
+
+	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+	/*
+	 * If Reception done interrupt is asserted, call RX call back function
+	 * to handle the processed BDs and then raise the according flag.
+	 */
+	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
+	if (gigeversion <= 2) {
+			resetrx_on_no_rxdata(xemacpsif);
+	}
+
+#ifdef XLWIP_CONFIG_RX_POLL_MODE
+	/*
+	 * Leave the harvesting to xemacpsif_input(), which polls the rings
+	 * with the receive interrupt off until they run dry.
+	 */
+	(void)rxring;
+	rx_intr_disable(xemacpsif);
+	xemacpsif->rx_polling = 1;
+#else
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	/* priority frames are handed over first */
+	if (xemacpsif->prio_queues) {
+		(void)process_rx_ring(xemacpsif, &xemacpsif->rxq1_ring,
+				xemacpsif->recv_prio_q, XLWIP_CONFIG_N_RX_DESC);
 	}
+#endif
+	(void)process_rx_ring(xemacpsif, rxring, xemacpsif->recv_q,
+						XLWIP_CONFIG_N_RX_DESC);
+#endif
+#if !NO_SYS
+	sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -529,6 +1205,7 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 
 	txringptr = &XEmacPs_GetTxRing(&xemacpsif->emacps);
+	xemacpsif->txstats.bds_inflight = 0;
 
 	XEmacPs_BdClear(&bdtemplate);
 	XEmacPs_BdSetStatus(&bdtemplate, XEMACPS_TXBUF_USED_MASK);
@@ -540,7 +1217,90 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 			(UINTPTR) xemacpsif->tx_bdspace, BD_ALIGNMENT,
 				 XLWIP_CONFIG_N_TX_DESC);
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		XEmacPs_BdRingCreate(&xemacpsif->txq1_ring,
+				(UINTPTR) xemacpsif->txq1_bdspace,
+				(UINTPTR) xemacpsif->txq1_bdspace, BD_ALIGNMENT,
+					 XLWIP_CONFIG_N_TX_DESC);
+		XEmacPs_BdRingClone(&xemacpsif->txq1_ring, &bdtemplate,
+							XEMACPS_SEND);
+	}
+#endif
+}
+
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+/*
+ * init_prio_dma():
+ *
+ * Sets up the queue 1 RX and TX rings and points the GEM at all four rings:
+ * queue 0 carries bulk traffic and queue 1 priority traffic. Screener rules
+ * installed earlier are programmed again, as a GEM reset clears them.
+ */
+static XStatus init_prio_dma(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_Bd bdtemplate;
+	XStatus status;
+	u32_t dmacrreg;
+	u32_t i;
+
+	XEmacPs_BdClear(&bdtemplate);
+	status = XEmacPs_BdRingCreate(&xemacpsif->rxq1_ring,
+				(UINTPTR) xemacpsif->rxq1_bdspace,
+				(UINTPTR) xemacpsif->rxq1_bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_RX_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up RxBD space for queue 1\r\n"));
+		return status;
+	}
+	status = XEmacPs_BdRingClone(&xemacpsif->rxq1_ring, &bdtemplate,
+							XEMACPS_RECV);
+	if (status != XST_SUCCESS) {
+		return status;
+	}
+
+	XEmacPs_BdSetStatus(&bdtemplate, XEMACPS_TXBUF_USED_MASK);
+	status = XEmacPs_BdRingCreate(&xemacpsif->txq1_ring,
+				(UINTPTR) xemacpsif->txq1_bdspace,
+				(UINTPTR) xemacpsif->txq1_bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_TX_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up TxBD space for queue 1\r\n"));
+		return status;
+	}
+	status = XEmacPs_BdRingClone(&xemacpsif->txq1_ring, &bdtemplate,
+							XEMACPS_SEND);
+	if (status != XST_SUCCESS) {
+		return status;
+	}
+
+	setup_rx_bds(xemacpsif, &xemacpsif->rxq1_ring);
+
+	/* queue 1 buffers are the same size as the queue 0 ones */
+	dmacrreg = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
+						XEMACPS_DMACR_OFFSET);
+	XEmacPs_SetQ1RxBufSize(&xemacpsif->emacps,
+		((dmacrreg & XEMACPS_DMACR_RXBUF_MASK) >> XEMACPS_DMACR_RXBUF_SHIFT) *
+						XEMACPS_RX_BUF_UNIT);
+
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr,
+					XEMACPSIF_BULK_QUEUE, XEMACPS_RECV);
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->rxq1_ring.BaseBdAddr,
+					XEMACPSIF_PRIO_QUEUE, XEMACPS_RECV);
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr,
+					XEMACPSIF_BULK_QUEUE, XEMACPS_SEND);
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->txq1_ring.BaseBdAddr,
+					XEMACPSIF_PRIO_QUEUE, XEMACPS_SEND);
+
+	for (i = 0; i < XEMACPS_MAX_SCREENERS; i++) {
+		if (xemacpsif->prio_rules[i].MatchFlags != 0) {
+			(void)XEmacPs_SetScreener(&xemacpsif->emacps, (u8)i,
+						&xemacpsif->prio_rules[i]);
+		}
+	}
+	return XST_SUCCESS;
 }
+#endif
 
 XStatus init_dma(struct xemac_s *xemac)
 {
@@ -552,7 +1312,7 @@ XStatus init_dma(struct xemac_s *xemac)
 	s32_t i;
 	u32_t bdindex;
 	volatile UINTPTR tempaddress;
-	u32_t index;
+	UINTPTR *pbufs_storage;
 	u32_t gigeversion;
 	XEmacPs_Bd *bdtxterminate;
 	XEmacPs_Bd *bdrxterminate;
@@ -579,8 +1339,10 @@ XStatus init_dma(struct xemac_s *xemac)
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	xemacpsif->prio_queues = (gigeversion > 2) ? 1 : 0;
+#endif
 	/*
 	 * The BDs need to be allocated in uncached memory. Hence the 1 MB
 	 * address range allocated for Bd_Space is made uncached
@@ -603,6 +1365,8 @@ XStatus init_dma(struct xemac_s *xemac)
 
 	rxringptr = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 	txringptr = &XEmacPs_GetTxRing(&xemacpsif->emacps);
+	pbufs_storage = get_rxpbufs_storage(xemacpsif, rxringptr);
+	xemacpsif->txstats.bds_inflight = 0;
 	LWIP_DEBUGF(NETIF_DEBUG, ("rxringptr: 0x%08x\r\n", rxringptr));
 	LWIP_DEBUGF(NETIF_DEBUG, ("txringptr: 0x%08x\r\n", txringptr));
 
@@ -620,6 +1384,11 @@ XStatus init_dma(struct xemac_s *xemac)
 		tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
 		bdtxterminate = (XEmacPs_Bd *)tempaddress;
 		bd_space_index += 0x10000;
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+		/* with priority queuing these hold the queue 1 rings instead */
+		xemacpsif->rxq1_bdspace = (void *)bdrxterminate;
+		xemacpsif->txq1_bdspace = (void *)bdtxterminate;
+#endif
 	}
 
 	LWIP_DEBUGF(NETIF_DEBUG, ("rx_bdspace: %p \r\n", xemacpsif->rx_bdspace));
@@ -680,12 +1449,12 @@ XStatus init_dma(struct xemac_s *xemac)
 	/*
 	 * Allocate RX descriptors, 1 RxBD at a time.
 	 */
-	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
-#else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+	rxbuf_pool_init();
+	xemacpsif->rx_starved = 0;
 #endif
+	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
+		p = alloc_rx_pbuf(xemacpsif);
 		if (!p) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
@@ -718,45 +1487,46 @@ XStatus init_dma(struct xemac_s *xemac)
 		temp++;
 		*temp = 0;
 		dsb();
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
 
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
-	}
-	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
-	if (gigeversion > 2) {
-		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
-	}else {
-		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 0, XEMACPS_SEND);
+		pbufs_storage[bdindex] = (UINTPTR)p;
 	}
-	if (gigeversion > 2)
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		status = init_prio_dma(xemacpsif);
+		if (status != XST_SUCCESS) {
+			return ERR_IF;
+		}
+	} else
+#endif
 	{
-		/*
-		 * This version of GEM supports priority queuing and the current
-		 * dirver is using tx priority queue 1 and normal rx queue for
-		 * packet transmit and receive. The below code ensure that the
-		 * other queue pointers are parked to known state for avoiding
-		 * the controller to malfunction by fetching the descriptors
-		 * from these queues.
-		 */
-		XEmacPs_BdClear(bdrxterminate);
-		XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
-						XEMACPS_RXBUF_WRAP_MASK));
-		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
-				   (UINTPTR)bdrxterminate);
-		XEmacPs_BdClear(bdtxterminate);
-		XEmacPs_BdSetStatus(bdtxterminate, (XEMACPS_TXBUF_USED_MASK |
-						XEMACPS_TXBUF_WRAP_MASK));
-		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
-				   (UINTPTR)bdtxterminate);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
+		if (gigeversion > 2) {
+			XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
+		}else {
+			XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 0, XEMACPS_SEND);
+		}
+		if (gigeversion > 2)
+		{
+			/*
+			 * This version of GEM supports priority queuing and the current
+			 * dirver is using tx priority queue 1 and normal rx queue for
+			 * packet transmit and receive. The below code ensure that the
+			 * other queue pointers are parked to known state for avoiding
+			 * the controller to malfunction by fetching the descriptors
+			 * from these queues.
+			 */
+			XEmacPs_BdClear(bdrxterminate);
+			XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
+							XEMACPS_RXBUF_WRAP_MASK));
+			XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
+					   (UINTPTR)bdrxterminate);
+			XEmacPs_BdClear(bdtxterminate);
+			XEmacPs_BdSetStatus(bdtxterminate, (XEMACPS_TXBUF_USED_MASK |
+							XEMACPS_TXBUF_WRAP_MASK));
+			XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
+					   (UINTPTR)bdtxterminate);
+		}
 	}
 
 
@@ -816,42 +1586,62 @@ void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif)
 void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 {
 	s32_t index;
-	s32_t index1;
+	UINTPTR *pbufs_storage;
 	struct pbuf *p;
 
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
-
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
-			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
-		}
-	}
+	free_onlytx_pbufs(xemacpsif);
+#ifdef XLWIP_CONFIG_GEM_RX_POOL_SIZE
+	/* the rings are being torn down, buffers must not refill them */
+	xemacpsif->rx_starved = 0;
+#endif
 
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		p = (struct pbuf *)rx_pbufs_storage[index];
+	pbufs_storage = get_rxpbufs_storage(xemacpsif,
+				&XEmacPs_GetRxRing(&xemacpsif->emacps));
+	for (index = 0; index < XLWIP_CONFIG_N_RX_DESC; index++) {
+		p = (struct pbuf *)pbufs_storage[index];
 		pbuf_free(p);
-
 	}
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		pbufs_storage = get_rxpbufs_storage(xemacpsif,
+						&xemacpsif->rxq1_ring);
+		for (index = 0; index < XLWIP_CONFIG_N_RX_DESC; index++) {
+			p = (struct pbuf *)pbufs_storage[index];
+			if (p != NULL) {
+				pbuf_free(p);
+				pbufs_storage[index] = 0;
+			}
+		}
+	}
+#endif
 }
 
-void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
+static void free_ring_tx_pbufs(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	s32_t index;
-	s32_t index1;
+	UINTPTR *pbufs_storage;
 	struct pbuf *p;
 
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
+	pbufs_storage = get_txpbufs_storage(xemacpsif, txring);
+	for (index = 0; index < XLWIP_CONFIG_N_TX_DESC; index++) {
+		if (pbufs_storage[index] != 0) {
+			p = (struct pbuf *)pbufs_storage[index];
 			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
+			pbufs_storage[index] = 0;
 		}
 	}
 }
 
+void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
+{
+	free_ring_tx_pbufs(xemacpsif, &XEmacPs_GetTxRing(&xemacpsif->emacps));
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		free_ring_tx_pbufs(xemacpsif, &xemacpsif->txq1_ring);
+	}
+#endif
+}
+
 /* reset Tx and Rx DMA pointers after XEmacPs_Stop */
 void reset_dma(struct xemac_s *xemac)
 {
@@ -864,6 +1654,28 @@ void reset_dma(struct xemac_s *xemac)
 	XEmacPs_BdRingPtrReset(txringptr, xemacpsif->tx_bdspace);
 	XEmacPs_BdRingPtrReset(rxringptr, xemacpsif->rx_bdspace);
 
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+	if (xemacpsif->prio_queues) {
+		XEmacPs_BdRingPtrReset(&xemacpsif->txq1_ring,
+						xemacpsif->txq1_bdspace);
+		XEmacPs_BdRingPtrReset(&xemacpsif->rxq1_ring,
+						xemacpsif->rxq1_bdspace);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps),
+				xemacpsif->emacps.RxBdRing.BaseBdAddr,
+				XEMACPSIF_BULK_QUEUE, XEMACPS_RECV);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps),
+				xemacpsif->rxq1_ring.BaseBdAddr,
+				XEMACPSIF_PRIO_QUEUE, XEMACPS_RECV);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps),
+				xemacpsif->emacps.TxBdRing.BaseBdAddr,
+				XEMACPSIF_BULK_QUEUE, XEMACPS_SEND);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps),
+				xemacpsif->txq1_ring.BaseBdAddr,
+				XEMACPSIF_PRIO_QUEUE, XEMACPS_SEND);
+		return;
+	}
+#endif
+
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
 	if (gigeversion > 2) {
 		txqueuenum = 1;
@@ -0,0 +1,125 @@
+/******************************************************************************
+*
+* Copyright (C) 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+#include <stdlib.h>
+
+#include "netif/xspscq.h"
+#include "xlwipconfig.h"
+#include "xil_printf.h"
+
+/* One receive queue per GEM instance, two with priority queuing */
+#ifdef XLWIP_CONFIG_GEM_PRIORITY_QUEUES
+#define NUM_SPSC_QUEUES	8
+#else
+#define NUM_SPSC_QUEUES	4
+#endif
+
+static spsc_queue_t spsc_queue[NUM_SPSC_QUEUES];
+
+spsc_queue_t *
+spsc_create_queue(void)
+{
+	static int i;
+	spsc_queue_t *q = NULL;
+
+	if (i >= NUM_SPSC_QUEUES) {
+		xil_printf("ERR: Max SPSC Queues allocated\n\r");
+		return q;
+	}
+
+	q = &spsc_queue[i++];
+	q->head = q->tail = 0;
+
+	return q;
+}
+
+/*
+ * Producer side. Must only be called from a single context (the RX ISR).
+ * The slot is filled before the new head is published so the consumer
+ * never sees a stale pointer.
+ */
+int
+spsc_enqueue(spsc_queue_t *q, void *p)
+{
+	u32 head = q->head;
+	u32 tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+
+	if ((head - tail) == SPSC_QUEUE_SIZE)
+		return -1;
+
+	q->data[head & SPSC_QUEUE_MASK] = p;
+	__atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+void*
+spsc_dequeue(spsc_queue_t *q)
+{
+	void *p;
+
+	if (spsc_dequeue_batch(q, &p, 1) == 0)
+		return NULL;
+
+	return p;
+}
+
+/*
+ * Consumer side. Copies up to max entries into p and releases all of
+ * the consumed slots back to the producer with a single tail update.
+ * Returns the number of entries dequeued.
+ */
+u32
+spsc_dequeue_batch(spsc_queue_t *q, void **p, u32 max)
+{
+	u32 tail = q->tail;
+	u32 head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+	u32 n = head - tail;
+	u32 i;
+
+	if (n > max)
+		n = max;
+
+	for (i = 0; i < n; i++)
+		p[i] = q->data[(tail + i) & SPSC_QUEUE_MASK];
+
+	__atomic_store_n(&q->tail, tail + n, __ATOMIC_RELEASE);
+
+	return n;
+}
+
+u32
+spsc_qlength(spsc_queue_t *q)
+{
+	return __atomic_load_n(&q->head, __ATOMIC_ACQUIRE) -
+		__atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+}
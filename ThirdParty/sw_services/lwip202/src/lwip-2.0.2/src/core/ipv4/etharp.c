@@ -996,6 +996,12 @@ etharp_query(struct netif *netif, const ip4_addr_t *ipaddr, struct pbuf *q)
     /* entry is still pending, queue the given packet 'q' */
     struct pbuf *p;
     int copy_needed = 0;
+#if LWIP_TCP_TSO
+    /* large sends are not queued; TCP sends them again once resolved */
+    if (q->tso_mss != 0) {
+      return ERR_MEM;
+    }
+#endif /* LWIP_TCP_TSO */
     /* IF q includes a PBUF_REF, PBUF_POOL or PBUF_RAM, we have no choice but
      * to copy the whole queue into a new PBUF_RAM (see bug #11400)
      * PBUF_ROMs can be left as they are, since ROM must not get changed. */
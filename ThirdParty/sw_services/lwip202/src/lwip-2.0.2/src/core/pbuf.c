@@ -325,6 +325,9 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
       }
       q->type = type;
       q->flags = 0;
+#if LWIP_TCP_TSO
+      q->tso_mss = 0;
+#endif /* LWIP_TCP_TSO */
       q->next = NULL;
       /* make previous pbuf point to this pbuf */
       r->next = q;
@@ -400,6 +403,9 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
   p->ref = 1;
   /* set flags */
   p->flags = 0;
+#if LWIP_TCP_TSO
+  p->tso_mss = 0;
+#endif /* LWIP_TCP_TSO */
   LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_TRACE, ("pbuf_alloc(length=%"U16_F") == %p\n", length, (void *)p));
   return p;
 }
@@ -466,6 +472,9 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
     p->pbuf.payload = NULL;
   }
   p->pbuf.flags = PBUF_FLAG_IS_CUSTOM;
+#if LWIP_TCP_TSO
+  p->pbuf.tso_mss = 0;
+#endif /* LWIP_TCP_TSO */
   p->pbuf.len = p->pbuf.tot_len = length;
   p->pbuf.type = type;
   p->pbuf.ref = 1;
@@ -97,7 +97,12 @@
 #endif
 
 /* Forward declarations.*/
+#if LWIP_TCP_TSO
+static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_seg *last, struct tcp_pcb *pcb, struct netif *netif);
+static struct tcp_seg *tcp_tso_last(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif, u32_t wnd);
+#else /* LWIP_TCP_TSO */
 static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif);
+#endif /* LWIP_TCP_TSO */
 
 /** Allocate a pbuf and create a tcphdr at p->payload, used for output
  * functions other than the default tcp_output -> tcp_output_segment
@@ -998,6 +1003,9 @@ err_t
 tcp_output(struct tcp_pcb *pcb)
 {
   struct tcp_seg *seg, *useg;
+#if LWIP_TCP_TSO
+  struct tcp_seg *last;
+#endif /* LWIP_TCP_TSO */
   u32_t wnd, snd_nxt;
   err_t err;
   struct netif *netif;
@@ -1124,12 +1132,22 @@ tcp_output(struct tcp_pcb *pcb)
 #if TCP_OVERSIZE_DBGCHECK
     seg->oversize_left = 0;
 #endif /* TCP_OVERSIZE_DBGCHECK */
+#if LWIP_TCP_TSO
+    last = tcp_tso_last(seg, pcb, netif, wnd);
+    err = tcp_output_segment(seg, last, pcb, netif);
+#else /* LWIP_TCP_TSO */
     err = tcp_output_segment(seg, pcb, netif);
+#endif /* LWIP_TCP_TSO */
     if (err != ERR_OK) {
       /* segment could not be sent, for whatever reason */
       pcb->flags |= TF_NAGLEMEMERR;
       return err;
     }
+#if LWIP_TCP_TSO
+    /* the segments of a large send are queued as if sent one by one */
+    for (;;) {
+      u8_t tso_done = (seg == last);
+#endif /* LWIP_TCP_TSO */
     pcb->unsent = seg->next;
     if (pcb->state != SYN_SENT) {
       pcb->flags &= ~(TF_ACK_DELAY | TF_ACK_NOW);
@@ -1169,6 +1187,13 @@ tcp_output(struct tcp_pcb *pcb)
     } else {
       tcp_seg_free(seg);
     }
+#if LWIP_TCP_TSO
+      if (tso_done) {
+        break;
+      }
+      seg = pcb->unsent;
+    }
+#endif /* LWIP_TCP_TSO */
     seg = pcb->unsent;
   }
 output_done:
@@ -1183,19 +1208,150 @@ output_done:
   return ERR_OK;
 }
 
+#if LWIP_TCP_TSO
+/**
+ * Called by tcp_output() to find how many unsent segments, starting with
+ * seg, can go out as one large send on a netif that segments TCP packets
+ * in hardware. All but the last segment must be full sized, and all must
+ * be contiguous, carry the same options and fit into the send window.
+ *
+ * @param seg the first unsent segment, known to fit into the window
+ * @param pcb the tcp_pcb for the TCP connection
+ * @param netif the netif used to send the segments
+ * @param wnd the current send window
+ * @return the last segment of the large send (seg if there is none)
+ */
+static struct tcp_seg *
+tcp_tso_last(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif, u32_t wnd)
+{
+  struct tcp_seg *last = seg;
+  struct tcp_seg *next;
+  u32_t tso_len;
+  u16_t mss;
+
+  if (((netif->flags & NETIF_FLAG_TSO) == 0) || IP_IS_V6(&pcb->remote_ip) ||
+      (seg->p->ref != 1)) {
+    return seg;
+  }
+  mss = pcb->mss - LWIP_TCP_OPT_LENGTH(seg->flags);
+  tso_len = seg->len;
+  while ((last->len == mss) &&
+         ((TCPH_FLAGS(last->tcphdr) & (TCP_SYN | TCP_FIN | TCP_RST | TCP_PSH)) == 0)) {
+    next = last->next;
+    if ((next == NULL) || (next->len == 0) || (next->len > mss) ||
+        (next->flags != seg->flags) || (next->p->ref != 1) ||
+        ((TCPH_FLAGS(next->tcphdr) & (TCP_SYN | TCP_FIN | TCP_RST)) != 0) ||
+        (lwip_ntohl(next->tcphdr->seqno) != lwip_ntohl(last->tcphdr->seqno) + last->len) ||
+        (lwip_ntohl(next->tcphdr->seqno) - pcb->lastack + next->len > wnd) ||
+        (tso_len + next->len > TCP_TSO_MAX_LEN)) {
+      break;
+    }
+    tso_len += next->len;
+    last = next;
+  }
+  return last;
+}
+
+/**
+ * Undoes tcp_tso_chain(). The netif keeps its own references on the
+ * PBUF_REF pbufs it still needs.
+ */
+static void
+tcp_tso_unchain(struct tcp_seg *seg, struct pbuf *tail)
+{
+  struct pbuf *q, *next;
+  u16_t added = 0;
+
+  for (q = tail->next; q != NULL; q = next) {
+    next = q->next;
+    added += q->len;
+    q->next = NULL;
+    pbuf_free(q);
+  }
+  tail->next = NULL;
+  for (q = seg->p; q != NULL; q = q->next) {
+    q->tot_len -= added;
+  }
+  seg->p->tso_mss = 0;
+}
+
+/**
+ * Appends the payload of the segments following seg up to last to the
+ * pbuf chain of seg, as PBUF_REF pbufs, for a large send.
+ *
+ * @return the last pbuf of seg's own chain, to be passed to
+ *         tcp_tso_unchain() once sent, or NULL if out of memory
+ */
+static struct pbuf *
+tcp_tso_chain(struct tcp_seg *seg, struct tcp_seg *last)
+{
+  struct tcp_seg *s;
+  struct pbuf *tail, *q, *r, *end;
+  u16_t skip;
+  u16_t added = 0;
+
+  for (tail = seg->p; tail->next != NULL; tail = tail->next);
+  end = tail;
+  for (s = seg->next; s != last->next; s = s->next) {
+    /* data starts behind the TCP header of the segment */
+    skip = (u16_t)(((u8_t *)s->tcphdr - (u8_t *)s->p->payload) + TCPH_HDRLEN(s->tcphdr) * 4);
+    for (q = s->p; q != NULL; q = q->next) {
+      if (q->len <= skip) {
+        skip -= q->len;
+        continue;
+      }
+      r = pbuf_alloc(PBUF_RAW, (u16_t)(q->len - skip), PBUF_REF);
+      if (r == NULL) {
+        for (r = tail->next; r != NULL; r = q) {
+          q = r->next;
+          r->next = NULL;
+          pbuf_free(r);
+        }
+        tail->next = NULL;
+        return NULL;
+      }
+      r->payload = (u8_t *)q->payload + skip;
+      skip = 0;
+      end->next = r;
+      end = r;
+      added += r->len;
+    }
+  }
+  /* restore the tot_len invariant along the extended chain */
+  for (q = seg->p; q != tail->next; q = q->next) {
+    q->tot_len += added;
+  }
+  for (r = tail->next; r != NULL; r = r->next) {
+    r->tot_len = added;
+    added -= r->len;
+  }
+  return tail;
+}
+#endif /* LWIP_TCP_TSO */
+
 /**
  * Called by tcp_output() to actually send a TCP segment over IP.
  *
  * @param seg the tcp_seg to send
+ * @param last the last segment to go out together with seg as one large
+ *        send, seg itself for a single segment (LWIP_TCP_TSO only)
  * @param pcb the tcp_pcb for the TCP connection used to send the segment
  * @param netif the netif used to send the segment
  */
 static err_t
+#if LWIP_TCP_TSO
+tcp_output_segment(struct tcp_seg *seg, struct tcp_seg *last, struct tcp_pcb *pcb, struct netif *netif)
+#else /* LWIP_TCP_TSO */
 tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif)
+#endif /* LWIP_TCP_TSO */
 {
   err_t err;
   u16_t len;
   u32_t *opts;
+#if LWIP_TCP_TSO
+  struct pbuf *tail = NULL;
+  struct tcp_seg *s;
+#endif /* LWIP_TCP_TSO */
 
   if (seg->p->ref != 1) {
     /* This can happen if the pbuf of this segment is still referenced by the
@@ -1318,10 +1474,30 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif
 #endif /* CHECKSUM_GEN_TCP */
   TCP_STATS_INC(tcp.xmit);
 
+#if LWIP_TCP_TSO
+  if (last != seg) {
+    tail = tcp_tso_chain(seg, last);
+    if (tail == NULL) {
+      /* out of PBUF_REF pbufs, tcp_output() retries later */
+      return ERR_MEM;
+    }
+    seg->p->tso_mss = seg->len;
+    for (s = seg->next; s != last->next; s = s->next) {
+      MIB2_STATS_INC(mib2.tcpoutsegs);
+      TCP_STATS_INC(tcp.xmit);
+    }
+  }
+#endif /* LWIP_TCP_TSO */
+
   NETIF_SET_HWADDRHINT(netif, &(pcb->addr_hint));
   err = ip_output_if(seg->p, &pcb->local_ip, &pcb->remote_ip, pcb->ttl,
     pcb->tos, IP_PROTO_TCP, netif);
   NETIF_SET_HWADDRHINT(netif, NULL);
+#if LWIP_TCP_TSO
+  if (tail != NULL) {
+    tcp_tso_unchain(seg, tail);
+  }
+#endif /* LWIP_TCP_TSO */
   return err;
 }
 
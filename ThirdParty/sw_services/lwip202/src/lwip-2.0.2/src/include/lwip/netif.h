@@ -99,6 +99,12 @@ extern "C" {
 /** If set, the netif has MLD6 capability.
  * Set by the netif driver in its init function. */
 #define NETIF_FLAG_MLD6         0x40U
+#if LWIP_TCP_TSO
+/** If set, the netif segments TCP packets with pbuf->tso_mss set in
+ * hardware (see LWIP_TCP_TSO).
+ * Set by the netif driver in its init function. */
+#define NETIF_FLAG_TSO          0x80U
+#endif /* LWIP_TCP_TSO */
 
 /**
  * @}
@@ -1333,6 +1333,23 @@
 #define LWIP_WND_SCALE                  0
 #define TCP_RCV_SCALE                   0
 #endif
+
+/**
+ * LWIP_TCP_TSO==1: Let tcp_output() pass runs of consecutive full sized
+ * segments to a netif with NETIF_FLAG_TSO as one large send, which the
+ * hardware splits into frames of pbuf->tso_mss payload bytes (IPv4 only).
+ * The netif must generate the IP and TCP checksums.
+ */
+#if !defined LWIP_TCP_TSO || defined __DOXYGEN__
+#define LWIP_TCP_TSO                    0
+#endif
+
+/**
+ * TCP_TSO_MAX_LEN: Maximum number of TCP payload bytes in one large send.
+ */
+#if !defined TCP_TSO_MAX_LEN || defined __DOXYGEN__
+#define TCP_TSO_MAX_LEN                 0xFF00
+#endif
 /**
  * @}
  */
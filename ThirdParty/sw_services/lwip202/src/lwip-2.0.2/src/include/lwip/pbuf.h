@@ -170,6 +170,12 @@ struct pbuf {
    * the stack itself, or pbuf->next pointers from a chain.
    */
   u16_t ref;
+
+#if LWIP_TCP_TSO
+  /** payload bytes per frame when the netif is to segment this TCP packet
+   * (0 for a normal packet), only valid in the first pbuf of a chain */
+  u16_t tso_mss;
+#endif /* LWIP_TCP_TSO */
 };
 
 
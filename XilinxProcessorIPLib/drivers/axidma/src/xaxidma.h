@@ -281,6 +281,16 @@
 *   to receive data at any time. Otherwise, the RX channel refuses to
 *   accept any data if it has no RX BDs.
 *
+* <b> Cyclic Streaming </b>
+*
+* For continuous streams, such as data converter capture, a BD ring can be
+* set up once over a contiguous buffer with XAxiDma_StreamSetup() and run in
+* cyclic mode. The application then takes completed regions of the buffer
+* with XAxiDma_StreamAcquire() and gives them back with
+* XAxiDma_StreamRelease(). The BDs are re-armed by clearing their status
+* word only; the channel is never stopped and no BD is rewritten. Do not use
+* XAxiDma_BdRingFromHw() and XAxiDma_BdRingFree() on a streaming ring.
+*
 * <b> Examples </b>
 *
 * We provide five examples to show how to use the driver API:
@@ -476,6 +486,11 @@
 *      adk   13/11/17 Fixed CR#989455 multi-channel interrupt example fails on A53.
 * 9.6  rsp   01/11/18 Fixed CR#976392 In XAxiDma struct use UINTPTR for RegBase.
 *                     In XAxiDma_LookupConfigBaseAddr() use UINTPTR for Baseaddr.
+* 9.7  ag    10/16/26 Added cyclic streaming with a zero-copy window API,
+*                     XAxiDma_StreamSetup(), XAxiDma_StreamAcquire() and
+*                     XAxiDma_StreamRelease().
+*      ag    10/16/26 Added XIL_TRACE_ID_AXIDMA_* trace points for BDs given
+*                     to and returned by hardware.
 * </pre>
 *
 ******************************************************************************/
@@ -69,6 +69,10 @@
 * 9.6   rsp  01/11/18  Use UINTPTR for all RegBase instances CR#976392
 *       rsp  01/17/18  Use virtual address for register read/write.
 *                      In _BdRingCreate() assign VA to BdaRestart CR#976392
+* 9.7   ag   10/16/26  Alloc, UnAlloc, ToHw, FromHw and Free are done by the
+*		       common BD ring engine, which flushes and invalidates
+*		       the BDs of a call in at most two cache maintenance
+*		       ranges instead of one per BD, and keeps ring statistics.
 *
 * </pre>
 ******************************************************************************/
@@ -76,6 +80,7 @@
 /***************************** Include Files *********************************/
 
 #include "xaxidma_bdring.h"
+#include "xil_trace.h"
 
 /************************** Constant Definitions *****************************/
 /* Use 100 milliseconds for 100 MHz
@@ -105,71 +110,19 @@
 #define XAXIDMA_VIRT_TO_PHYS(BdPtr) \
 	((UINTPTR)(BdPtr) + (RingPtr->FirstBdPhysAddr - RingPtr->FirstBdAddr))
 
-/******************************************************************************
- * Move the BdPtr argument ahead an arbitrary number of BDs wrapping around
- * to the beginning of the ring if needed.
- *
- * We know if a wraparound should occur if the new BdPtr is greater than
- * the high address in the ring OR if the new BdPtr crosses the 0xFFFFFFFF
- * to 0 boundary.
- *
- * @param	RingPtr is the ring BdPtr appears in
- * @param	BdPtr on input is the starting BD position and on output is the
- *		final BD position
- * @param	NumBd is the number of BD spaces to increment
- *
- * @returns	None
- *
- * @note	This function can be used only when DMA is in SG mode
- *
- *****************************************************************************/
-#define XAXIDMA_RING_SEEKAHEAD(RingPtr, BdPtr, NumBd)                \
-    {                                                                \
-        UINTPTR Addr = (UINTPTR)(void *)(BdPtr);                                     \
-                                                                     \
-        Addr += ((RingPtr)->Separation * (NumBd));                   \
-        if ((Addr > (RingPtr)->LastBdAddr) || ((UINTPTR)(BdPtr) > Addr)) \
-        {                                                            \
-            Addr -= (RingPtr)->Length;                               \
-        }                                                            \
-                                                                     \
-        (BdPtr) = (XAxiDma_Bd*)(void *)Addr;                                 \
-    }
-/******************************************************************************
- * Move the BdPtr argument backwards an arbitrary number of BDs wrapping
- * around to the end of the ring if needed.
- *
- * We know if a wraparound should occur if the new BdPtr is less than
- * the base address in the ring OR if the new BdPtr crosses the 0xFFFFFFFF
- * to 0 boundary.
- *
- * @param	RingPtr is the ring BdPtr appears in
- * @param	BdPtr on input is the starting BD position and on output is the
- *		final BD position
- * @param	NumBd is the number of BD spaces to increment
- *
- * @returns	None
- *
- * @note	This function can be used only when DMA is in SG mode
- *
- *****************************************************************************/
-#define XAXIDMA_RING_SEEKBACK(RingPtr, BdPtr, NumBd)                  \
-    {                                                                 \
-        UINTPTR Addr = (UINTPTR)(BdPtr);                                      \
-                                                                      \
-        Addr -= ((RingPtr)->Separation * (NumBd));                    \
-        if ((Addr < (RingPtr)->FirstBdAddr) || ((UINTPTR)(BdPtr) < Addr)) \
-        {                                                             \
-            Addr += (RingPtr)->Length;                                \
-        }                                                             \
-                                                                      \
-        (BdPtr) = (XAxiDma_Bd*)Addr;                                  \
-    }
-
 /************************** Function Prototypes ******************************/
 
+static u32 XAxiDma_BdStatus(void *Owner, UINTPTR BdPtr);
+static s32 XAxiDma_BdToHw(void *Owner, UINTPTR BdPtr, u32 Position);
+
 /************************** Variable Definitions *****************************/
 
+/* BD layout for the common BD ring engine */
+static const XBdRing_Ops XAxiDma_BdOps = {
+	XAxiDma_BdStatus,
+	XAxiDma_BdToHw
+};
+
 
 /*****************************************************************************/
 /**
@@ -349,6 +302,8 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	int i;
 	UINTPTR BdVirtAddr;
 	UINTPTR BdPhysAddr;
+	u32 Flags = 0U;
+	s32 Status;
 
 	if (BdCount <= 0) {
 
@@ -363,11 +318,11 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	 * from doing anything
 	 */
 	RingPtr->AllCnt = 0;
-	RingPtr->FreeCnt = 0;
-	RingPtr->HwCnt = 0;
-	RingPtr->PreCnt = 0;
-	RingPtr->PostCnt = 0;
+	RingPtr->Core.AllCnt = 0;
+	XBdRing_Reset(&RingPtr->Core);
 	RingPtr->Cyclic = 0;
+	RingPtr->StreamBlockLen = 0;
+	RingPtr->StreamHeld = 0;
 
 	/* Make sure Alignment parameter meets minimum requirements */
 	if (Alignment < XAXIDMA_BD_MINIMUM_ALIGNMENT) {
@@ -402,15 +357,21 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	RingPtr->Separation =
 		(sizeof(XAxiDma_Bd) + (Alignment - 1)) & ~(Alignment - 1);
 
-	/* Must make sure the ring doesn't span address 0x00000000. If it does,
-	 * then the next/prev BD traversal macros will fail.
+	/* The engine makes sure the ring doesn't span address 0x00000000. If
+	 * it does, then the next/prev BD traversal macros will fail.
 	 */
-	if (VirtAddr > (VirtAddr + (RingPtr->Separation * BdCount) - 1)) {
+#ifdef __aarch64__
+	Flags |= XBDRING_FLAG_NOCACHE;
+#endif
+	Status = XBdRing_Create(&RingPtr->Core, VirtAddr,
+				(u32)RingPtr->Separation, (u32)BdCount,
+				&XAxiDma_BdOps, RingPtr, Flags);
+	if (Status != XST_SUCCESS) {
 
 		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCreate: BD space cross "
 			"0x0\r\n");
 
-		return XST_DMA_SG_LIST_ERROR;
+		return Status;
 	}
 
 	/* Initial ring setup:
@@ -466,12 +427,6 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	RingPtr->Length = RingPtr->LastBdAddr - RingPtr->FirstBdAddr +
 		RingPtr->Separation;
 	RingPtr->AllCnt = BdCount;
-	RingPtr->FreeCnt = BdCount;
-	RingPtr->FreeHead = (XAxiDma_Bd *) VirtAddr;
-	RingPtr->PreHead = (XAxiDma_Bd *) VirtAddr;
-	RingPtr->HwHead = (XAxiDma_Bd *) VirtAddr;
-	RingPtr->HwTail = (XAxiDma_Bd *) VirtAddr;
-	RingPtr->PostHead = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->BdaRestart = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->CyclicBd = (XAxiDma_Bd *) malloc(sizeof(XAxiDma_Bd));
 
@@ -527,10 +482,11 @@ int XAxiDma_BdRingClone(XAxiDma_BdRing * RingPtr, XAxiDma_Bd * SrcBdPtr)
 	}
 
 	/* Can't do this function with some of the BDs in use */
-	if (RingPtr->FreeCnt != RingPtr->AllCnt) {
+	if (XAxiDma_BdRingGetFreeCnt(RingPtr) != RingPtr->AllCnt) {
 
 		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingClone: some bds already "
-			"in use %d/%d\r\n",RingPtr->FreeCnt, RingPtr->AllCnt);
+			"in use %d/%d\r\n", XAxiDma_BdRingGetFreeCnt(RingPtr),
+			RingPtr->AllCnt);
 
 		return XST_DMA_SG_LIST_ERROR;
 	}
@@ -580,6 +536,7 @@ int XAxiDma_StartBdRingHw(XAxiDma_BdRing * RingPtr)
 {
 	UINTPTR RegBase;
 	int RingIndex = RingPtr->RingIndex;
+	XAxiDma_Bd *HwTail;
 
 	if (!XAxiDma_BdRingHwIsStarted(RingPtr)) {
 		/* Start the hardware
@@ -597,9 +554,11 @@ int XAxiDma_StartBdRingHw(XAxiDma_BdRing * RingPtr)
 		/* If there are unprocessed BDs then we want the channel to begin
 		 * processing right away
 		 */
-		if (RingPtr->HwCnt > 0) {
+		if (XAxiDma_BdRingGetHwCnt(RingPtr) > 0) {
 
-			XAXIDMA_CACHE_INVALIDATE(RingPtr->HwTail);
+			HwTail = (XAxiDma_Bd *)
+				XBdRing_GetHwTail(&RingPtr->Core);
+			XAXIDMA_CACHE_INVALIDATE(HwTail);
 			if (RingPtr->Cyclic) {
 				XAxiDma_WriteReg(RingPtr->ChanBase,
 						 XAXIDMA_TDESC_OFFSET,
@@ -611,35 +570,35 @@ int XAxiDma_StartBdRingHw(XAxiDma_BdRing * RingPtr)
 				return XST_SUCCESS;
 			}
 
-			if ((XAxiDma_BdRead(RingPtr->HwTail,
+			if ((XAxiDma_BdRead(HwTail,
 				    XAXIDMA_BD_STS_OFFSET) &
 				XAXIDMA_BD_STS_COMPLETE_MASK) == 0) {
 				if (RingPtr->IsRxChannel) {
 					if (!RingIndex) {
 						XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK));
 						if (RingPtr->Addr_ext)
 							XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 					}
 					else {
 						XAxiDma_WriteReg(RingPtr->ChanBase,
 							(XAXIDMA_RX_TDESC0_OFFSET +
 							(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-							(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK ));
+							(XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK ));
 						if (RingPtr->Addr_ext)
 							XAxiDma_WriteReg(RingPtr->ChanBase,
 								(XAXIDMA_RX_TDESC0_MSB_OFFSET +
 								(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 					}
 				}
 				else {
 					XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK));
 					if (RingPtr->Addr_ext)
 						XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 				}
 			}
 		}
@@ -865,19 +824,15 @@ int XAxiDma_BdRingAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 	}
 
 	/* Enough free BDs available for the request? */
-	if (RingPtr->FreeCnt < NumBd) {
+	if (XBdRing_Alloc(&RingPtr->Core, (u32)NumBd,
+			  (UINTPTR *)(void *)BdSetPtr) != XST_SUCCESS) {
 		xdbg_printf(XDBG_DEBUG_ERROR,
-		"Not enough BDs to alloc %d/%d\r\n", NumBd, RingPtr->FreeCnt);
+		"Not enough BDs to alloc %d/%d\r\n", NumBd,
+		XAxiDma_BdRingGetFreeCnt(RingPtr));
 
 		return XST_FAILURE;
 	}
 
-	/* Set the return argument and move FreeHead forward */
-	*BdSetPtr = RingPtr->FreeHead;
-	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->FreeHead, NumBd);
-	RingPtr->FreeCnt -= NumBd;
-	RingPtr->PreCnt += NumBd;
-
 	return XST_SUCCESS;
 }
 /*****************************************************************************/
@@ -948,8 +903,6 @@ int XAxiDma_BdRingAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 int XAxiDma_BdRingUnAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 	XAxiDma_Bd * BdSetPtr)
 {
-	XAxiDma_Bd *TmpBd;
-
 	if (NumBd <= 0) {
 
 		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingUnAlloc: negative BD"
@@ -958,33 +911,18 @@ int XAxiDma_BdRingUnAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 		return XST_INVALID_PARAM;
 	}
 
-	/* Enough BDs in the preprocessing state for the request? */
-	if (RingPtr->PreCnt < NumBd) {
-		xdbg_printf(XDBG_DEBUG_ERROR,
-		"Pre-allocated BDs less than requested %d/%d\r\n",
-		RingPtr->PreCnt, NumBd);
-
-		return XST_FAILURE;
-	}
-
-	/* The last BD in the BD set must has the FreeHead as its next BD.
-	 * Otherwise, this is not a valid operation.
+	/* Enough BDs in the preprocessing state for the request, and the
+	 * last BD in the BD set has the FreeHead as its next BD?
 	 */
-	TmpBd = BdSetPtr;
-	XAXIDMA_RING_SEEKAHEAD(RingPtr, TmpBd, NumBd);
-
-	if (TmpBd != RingPtr->FreeHead) {
+	if (XBdRing_UnAlloc(&RingPtr->Core, (u32)NumBd,
+			    (UINTPTR)(void *)BdSetPtr) != XST_SUCCESS) {
 		xdbg_printf(XDBG_DEBUG_ERROR,
-		    "Unalloc does not go back to free head\r\n");
+		    "Unalloc of %d BDs does not go back to free head\r\n",
+		    NumBd);
 
 		return XST_FAILURE;
 	}
 
-	/* Set the return argument and move FreeHead backward */
-	XAXIDMA_RING_SEEKBACK(RingPtr, RingPtr->FreeHead, NumBd);
-	RingPtr->FreeCnt += NumBd;
-	RingPtr->PreCnt -= NumBd;
-
 	return XST_SUCCESS;
 }
 /*****************************************************************************/
@@ -1023,10 +961,8 @@ int XAxiDma_BdRingUnAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 	XAxiDma_Bd * BdSetPtr)
 {
-	XAxiDma_Bd *CurBdPtr;
-	int i;
-	u32 BdCr;
-	u32 BdSts;
+	XAxiDma_Bd *HwTail;
+	int Status;
 	int RingIndex = RingPtr->RingIndex;
 
 	if (NumBd < 0) {
@@ -1042,86 +978,18 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 		return XST_SUCCESS;
 	}
 
-	/* Make sure we are in sync with XAxiDma_BdRingAlloc() */
-	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
-		return XST_DMA_SG_LIST_ERROR;
-	}
-
-	CurBdPtr = BdSetPtr;
-	BdCr = XAxiDma_BdGetCtrl(CurBdPtr);
-	BdSts = XAxiDma_BdGetSts(CurBdPtr);
-
-	/* In case of Tx channel, the first BD should have been marked
-	 * as start-of-frame
-	 */
-	if (!(RingPtr->IsRxChannel) && !(BdCr & XAXIDMA_BD_CTRL_TXSOF_MASK)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "Tx first BD does not have "
-								"SOF\r\n");
-
-		return XST_FAILURE;
-	}
-
-	/* Clear the completed status bit
+	/* Check, clear the completed status bit of and flush each BD, the
+	 * engine makes sure we are in sync with XAxiDma_BdRingAlloc()
 	 */
-	for (i = 0; i < NumBd - 1; i++) {
-
-		/* Make sure the length value in the BD is non-zero. */
-		if (XAxiDma_BdGetLength(CurBdPtr,
-				RingPtr->MaxTransferLen) == 0) {
-
-			xdbg_printf(XDBG_DEBUG_ERROR, "0 length bd\r\n");
-
-			return XST_FAILURE;
-		}
-
-		BdSts &=  ~XAXIDMA_BD_STS_COMPLETE_MASK;
-		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
-
-		/* Flush the current BD so DMA core could see the updates */
-		XAXIDMA_CACHE_FLUSH(CurBdPtr);
-
-		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr, CurBdPtr));
-		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
-		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
-	}
-
-	/* In case of Tx channel, the last BD should have EOF bit set */
-	if (!(RingPtr->IsRxChannel) && !(BdCr & XAXIDMA_BD_CTRL_TXEOF_MASK)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "Tx last BD does not have "
-								"EOF\r\n");
-
-		return XST_FAILURE;
-	}
-
-	/* Make sure the length value in the last BD is non-zero. */
-	if (XAxiDma_BdGetLength(CurBdPtr,
-			RingPtr->MaxTransferLen) == 0) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "0 length bd\r\n");
+	Status = XBdRing_ToHw(&RingPtr->Core, (u32)NumBd,
+			      (UINTPTR)(void *)BdSetPtr);
+	if (Status != XST_SUCCESS) {
 
-		return XST_FAILURE;
+		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
+		return Status;
 	}
-
-	/* The last BD should also have the completed status bit cleared
-	 */
-	BdSts &= ~XAXIDMA_BD_STS_COMPLETE_MASK;
-	XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
-
-	/* Flush the last BD so DMA core could see the updates */
-	XAXIDMA_CACHE_FLUSH(CurBdPtr);
-	DATA_SYNC;
-
-	/* This set has completed pre-processing, adjust ring pointers and
-	 * counters
-	 */
-	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
-	RingPtr->PreCnt -= NumBd;
-	RingPtr->HwTail = CurBdPtr;
-	RingPtr->HwCnt += NumBd;
+	XIL_TRACE_INSTANT(XIL_TRACE_ID_AXIDMA_TOHW, NumBd);
+	HwTail = (XAxiDma_Bd *)XBdRing_GetHwTail(&RingPtr->Core);
 
 	/* If it is running, signal the engine to begin processing */
 	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
@@ -1139,29 +1007,29 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 			if (RingPtr->IsRxChannel) {
 				if (!RingIndex) {
 					XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK));
 					if (RingPtr->Addr_ext)
 						XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 				}
 				else {
 					XAxiDma_WriteReg(RingPtr->ChanBase,
 						(XAXIDMA_RX_TDESC0_OFFSET +
 						(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-						(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK ));
+						(XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK ));
 					if (RingPtr->Addr_ext)
 						XAxiDma_WriteReg(RingPtr->ChanBase,
 							(XAXIDMA_RX_TDESC0_MSB_OFFSET +
 							(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-							UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+							UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 				}
 			}
 			else {
 				XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(HwTail) & XAXIDMA_DESC_LSB_MASK));
 				if (RingPtr->Addr_ext)
 					XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(HwTail)));
 			}
 	}
 
@@ -1243,100 +1111,32 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 			     XAxiDma_Bd ** BdSetPtr)
 {
-	XAxiDma_Bd *CurBdPtr;
+	UINTPTR BdSet;
 	int BdCount;
-	int BdPartialCount;
-	u32 BdSts;
-	u32 BdCr;
-
-	CurBdPtr = RingPtr->HwHead;
-	BdCount = 0;
-	BdPartialCount = 0;
-	BdSts = 0;
-	BdCr = 0;
 
-	/* If no BDs in work group, then there's nothing to search */
-	if (RingPtr->HwCnt == 0) {
+	if (BdLimit <= 0) {
 		*BdSetPtr = (XAxiDma_Bd *)NULL;
 
 		return 0;
 	}
 
-	if (BdLimit > RingPtr->HwCnt) {
-		BdLimit = RingPtr->HwCnt;
-	}
-
-	/* Starting at HwHead, keep moving forward in the list until:
+	/* Starting at the head of the BDs given to hardware, the common BD
+	 * ring engine keeps moving forward in the list until:
 	 *  - A BD is encountered with its completed bit clear in the status
 	 *    word which means hardware has not completed processing of that
 	 *    BD.
-	 *  - RingPtr->HwTail is reached
+	 *  - All BDs given to hardware have been examined
 	 *  - The number of requested BDs has been processed
+	 * and returns only BDs of whole packets, so the BDs of a packet whose
+	 * last BD was not reached are left for the next call.
 	 */
-
-	while (BdCount < BdLimit) {
-		/* Read the status */
-		XAXIDMA_CACHE_INVALIDATE(CurBdPtr);
-		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
-		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
-
-		/* If the hardware still hasn't processed this BD then we are
-		 * done
-		 */
-		if (!(BdSts & XAXIDMA_BD_STS_COMPLETE_MASK)) {
-			break;
-		}
-
-		BdCount++;
-
-		/* Hardware has processed this BD so check the "last" bit. If
-		 * it is clear, then there are more BDs for the current packet.
-		 * Keep a count of these partial packet BDs.
-		 *
-		 * For tx BDs, EOF bit is in the control word
-		 * For rx BDs, EOF bit is in the status word
-		 */
-		if (((!(RingPtr->IsRxChannel) &&
-		(BdCr & XAXIDMA_BD_CTRL_TXEOF_MASK)) ||
-		((RingPtr->IsRxChannel) && (BdSts &
-			XAXIDMA_BD_STS_RXEOF_MASK)))) {
-
-			BdPartialCount = 0;
-		}
-		else {
-			BdPartialCount++;
-		}
-
-		/* Reached the end of the work group */
-		if (CurBdPtr == RingPtr->HwTail) {
-			break;
-		}
-
-		/* Move on to the next BD in work group */
-		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr, CurBdPtr));
-	}
-
-	/* Subtract off any partial packet BDs found */
-	BdCount -= BdPartialCount;
-
-	/* If BdCount is non-zero then BDs were found to return. Set return
-	 * parameters, update pointers and counters, return success
-	 */
-	if (BdCount) {
-		*BdSetPtr = RingPtr->HwHead;
-		if (!RingPtr->Cyclic) {
-			RingPtr->HwCnt -= BdCount;
-			RingPtr->PostCnt += BdCount;
-		}
-		XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
-
-		return BdCount;
+	BdCount = (int)XBdRing_FromHw(&RingPtr->Core, (u32)BdLimit, &BdSet);
+	*BdSetPtr = (XAxiDma_Bd *)(void *)BdSet;
+	if (BdCount != 0) {
+		XIL_TRACE_INSTANT(XIL_TRACE_ID_AXIDMA_FROMHW, BdCount);
 	}
-	else {
-		*BdSetPtr = (XAxiDma_Bd *)NULL;
 
-		return 0;
-	}
+	return BdCount;
 }
 /*****************************************************************************/
 /**
@@ -1380,22 +1180,18 @@ int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 	}
 
 	/* Make sure we are in sync with XAxiDma_BdRingFromHw() */
-	if ((RingPtr->PostCnt < NumBd) || (RingPtr->PostHead != BdSetPtr)) {
+	if (XBdRing_Free(&RingPtr->Core, (u32)NumBd,
+			 (UINTPTR)(void *)BdSetPtr) != XST_SUCCESS) {
 
 		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingFree: Error free BDs: "
 		"post count %d to free %d, PostHead %x to free ptr %x\r\n",
-			RingPtr->PostCnt, NumBd,
-			(UINTPTR)RingPtr->PostHead,
+			(int)XBdRing_GetPostCnt(&RingPtr->Core), NumBd,
+			(UINTPTR)XBdRing_GetPostHead(&RingPtr->Core),
 			(UINTPTR)BdSetPtr);
 
 		return XST_DMA_SG_LIST_ERROR;
 	}
 
-	/* Update pointers and counters */
-	RingPtr->FreeCnt += NumBd;
-	RingPtr->PostCnt -= NumBd;
-	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PostHead, NumBd);
-
 	return XST_SUCCESS;
 }
 /*****************************************************************************/
@@ -1457,70 +1253,25 @@ int XAxiDma_BdRingCheck(XAxiDma_BdRing * RingPtr)
 		return XST_DMA_SG_LIST_ERROR;
 	}
 
-	/* Verify internal pointers point to correct memory space */
-	AddrV = (UINTPTR) RingPtr->FreeHead;
-	if ((AddrV < RingPtr->FirstBdAddr) || (AddrV > RingPtr->LastBdAddr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: FreeHead wrong "
-		"%x, should be in range of %x/%x\r\n",
-		    (unsigned int)AddrV,
-		    (unsigned int)RingPtr->FirstBdAddr,
-			(unsigned int)RingPtr->LastBdAddr);
-
-		return XST_DMA_SG_LIST_ERROR;
-	}
-
-	AddrV = (UINTPTR) RingPtr->PreHead;
-	if ((AddrV < RingPtr->FirstBdAddr) || (AddrV > RingPtr->LastBdAddr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: PreHead wrong %x, "
-			"should be in range of %x/%x\r\n",
-		    (unsigned int)AddrV,
-		    (unsigned int)RingPtr->FirstBdAddr,
-			(unsigned int)RingPtr->LastBdAddr);
-
-		return XST_DMA_SG_LIST_ERROR;
-	}
-
-	AddrV = (UINTPTR) RingPtr->HwHead;
-	if ((AddrV < RingPtr->FirstBdAddr) || (AddrV > RingPtr->LastBdAddr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: HwHead wrong %x, "
-			"should be in range of %x/%x\r\n",
-		    (unsigned int)AddrV,
-		    (unsigned int)RingPtr->FirstBdAddr,
-			(unsigned int)RingPtr->LastBdAddr);
-
-		return XST_DMA_SG_LIST_ERROR;
-	}
-
-	AddrV = (UINTPTR) RingPtr->HwTail;
-	if ((AddrV < RingPtr->FirstBdAddr) || (AddrV > RingPtr->LastBdAddr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: HwTail wrong %x, "
-			"should be in range of %x/%x\r\n",
-		    (unsigned int)AddrV,
-		    (unsigned int)RingPtr->FirstBdAddr,
-			(unsigned int)RingPtr->LastBdAddr);
-
-		return XST_DMA_SG_LIST_ERROR;
-	}
-
-	AddrV = (UINTPTR) RingPtr->PostHead;
-	if ((AddrV < RingPtr->FirstBdAddr) || (AddrV > RingPtr->LastBdAddr)) {
+	/* Verify internal indexes point to BDs in the ring */
+	if ((RingPtr->Core.FreeIdx >= (u32)RingPtr->AllCnt) ||
+	    (RingPtr->Core.PreIdx >= (u32)RingPtr->AllCnt) ||
+	    (RingPtr->Core.HwIdx >= (u32)RingPtr->AllCnt) ||
+	    (RingPtr->Core.HwTailIdx >= (u32)RingPtr->AllCnt) ||
+	    (RingPtr->Core.PostIdx >= (u32)RingPtr->AllCnt)) {
 
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: PostHead wrong "
-		"%x, should be in range of %x/%x\r\n",
-		    (unsigned int)AddrV,
-		    (unsigned int)RingPtr->FirstBdAddr,
-			(unsigned int)RingPtr->LastBdAddr);
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: BD index out of "
+			"range of %d BDs\r\n", RingPtr->AllCnt);
 
 		return XST_DMA_SG_LIST_ERROR;
 	}
 
 	/* Verify internal counters add up */
-	if ((RingPtr->HwCnt + RingPtr->PreCnt + RingPtr->FreeCnt +
-	     RingPtr->PostCnt) != RingPtr->AllCnt) {
+	if ((XBdRing_GetFreeCnt(&RingPtr->Core) > (u32)RingPtr->AllCnt) ||
+	    ((XBdRing_GetHwCnt(&RingPtr->Core) +
+	      XBdRing_GetPreCnt(&RingPtr->Core) +
+	      XBdRing_GetFreeCnt(&RingPtr->Core) +
+	      XBdRing_GetPostCnt(&RingPtr->Core)) != (u32)RingPtr->AllCnt)) {
 
 		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingCheck: internal counter "
 			"error\r\n");
@@ -1609,4 +1360,103 @@ void XAxiDma_BdRingDumpRegs(XAxiDma_BdRing *RingPtr) {
 
 	xil_printf("\r\n");
 }
+
+/*****************************************************************************/
+/**
+ * Report the state of a BD to the BD ring engine. The completed bit in the
+ * status word marks the BD done. The end of packet bit is in the control word
+ * of tx BDs and in the status word of rx BDs.
+ *
+ * @param	Owner is the BD ring the BD is in.
+ * @param	BdPtr is the BD to operate on.
+ *
+ * @return	XBDRING_BD_DONE and XBDRING_BD_LAST as they apply to the BD.
+ *
+ *****************************************************************************/
+static u32 XAxiDma_BdStatus(void *Owner, UINTPTR BdPtr)
+{
+	XAxiDma_BdRing *RingPtr = (XAxiDma_BdRing *)Owner;
+	u32 BdSts;
+	u32 Status = 0U;
+
+	BdSts = XAxiDma_BdRead(BdPtr, XAXIDMA_BD_STS_OFFSET);
+	if (BdSts & XAXIDMA_BD_STS_COMPLETE_MASK) {
+		Status |= XBDRING_BD_DONE;
+	}
+
+	if (RingPtr->IsRxChannel) {
+		if (BdSts & XAXIDMA_BD_STS_RXEOF_MASK) {
+			Status |= XBDRING_BD_LAST;
+		}
+	}
+	else if (XAxiDma_BdRead(BdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET) &
+		 XAXIDMA_BD_CTRL_TXEOF_MASK) {
+		Status |= XBDRING_BD_LAST;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Prepare a BD for hardware on behalf of XAxiDma_BdRingToHw(). The BD must
+ * have a non-zero length, and in a tx set the first BD must mark the start
+ * and the last BD the end of a packet. The completed status bit is cleared.
+ *
+ * @param	Owner is the BD ring the BD is in.
+ * @param	BdPtr is the BD to operate on.
+ * @param	Position tells whether the BD is the first and/or the last BD
+ *		of the set.
+ *
+ * @return
+ *		- XST_SUCCESS if the BD can be given to hardware
+ *		- XST_FAILURE if the BD is rejected
+ *
+ *****************************************************************************/
+static s32 XAxiDma_BdToHw(void *Owner, UINTPTR BdPtr, u32 Position)
+{
+	XAxiDma_BdRing *RingPtr = (XAxiDma_BdRing *)Owner;
+	u32 BdCr;
+
+	BdCr = XAxiDma_BdRead(BdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
+
+	/* In case of Tx channel, the first BD should have been marked
+	 * as start-of-frame and the last BD should have EOF bit set
+	 */
+	if (!(RingPtr->IsRxChannel)) {
+		if ((Position & XBDRING_BD_FIRST) &&
+		    !(BdCr & XAXIDMA_BD_CTRL_TXSOF_MASK)) {
+
+			xdbg_printf(XDBG_DEBUG_ERROR, "Tx first BD does not "
+				"have SOF\r\n");
+
+			return XST_FAILURE;
+		}
+
+		if ((Position & XBDRING_BD_END) &&
+		    !(BdCr & XAXIDMA_BD_CTRL_TXEOF_MASK)) {
+
+			xdbg_printf(XDBG_DEBUG_ERROR, "Tx last BD does not "
+				"have EOF\r\n");
+
+			return XST_FAILURE;
+		}
+	}
+
+	/* Make sure the length value in the BD is non-zero. */
+	if (XAxiDma_BdGetLength(BdPtr, RingPtr->MaxTransferLen) == 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "0 length bd\r\n");
+
+		return XST_FAILURE;
+	}
+
+	/* Clear the completed status bit */
+	XAxiDma_BdWrite(BdPtr, XAXIDMA_BD_STS_OFFSET,
+			XAxiDma_BdRead(BdPtr, XAXIDMA_BD_STS_OFFSET) &
+			~XAXIDMA_BD_STS_COMPLETE_MASK);
+
+	return XST_SUCCESS;
+}
+
 /** @} */
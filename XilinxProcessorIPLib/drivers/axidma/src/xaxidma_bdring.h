@@ -69,6 +69,12 @@
 *		       backward compatibility.
 * 9.2   vak  15/04/16  Fixed the compilation warnings in axidma driver
 * 9.7   rsp  01/11/18  Use UINTPTR instead of u32 for ChanBase CR#976392
+* 9.7   ag   10/16/26  The BD ring bookkeeping is done by the common BD ring
+*		       engine (xil_bdring.h). The group heads and counters of
+*		       XAxiDma_BdRing are replaced by an XBdRing, added
+*		       XAxiDma_BdRingGetHwCnt() and XAxiDma_BdRingGetStats().
+*       ag   10/16/26  Added cyclic streaming, XAxiDma_StreamSetup(),
+*		       XAxiDma_StreamAcquire() and XAxiDma_StreamRelease().
 *
 * </pre>
 *
@@ -85,6 +91,7 @@ extern "C" {
 
 #include "xstatus.h"
 #include "xaxidma_bd.h"
+#include "xil_bdring.h"
 #include <stdlib.h>
 
 /************************** Constant Definitions *****************************/
@@ -121,22 +128,31 @@ typedef struct {
 	u32 Length;		/**< Total size of ring in bytes */
 	UINTPTR Separation;		/**< Number of bytes between the starting
 				     address of adjacent BDs */
-	XAxiDma_Bd *FreeHead;	/**< First BD in the free group */
-	XAxiDma_Bd *PreHead;	/**< First BD in the pre-work group */
-	XAxiDma_Bd *HwHead;	/**< First BD in the work group */
-	XAxiDma_Bd *HwTail;	/**< Last BD in the work group */
-	XAxiDma_Bd *PostHead;	/**< First BD in the post-work group */
 	XAxiDma_Bd *BdaRestart;	/**< BD to load when channel is started */
 	XAxiDma_Bd *CyclicBd;	/**< Useful for Cyclic DMA operations */
-	int FreeCnt;		/**< Number of allocatable BDs in free group */
-	int PreCnt;		/**< Number of BDs in pre-work group */
-	int HwCnt;		/**< Number of BDs in work group */
-	int PostCnt;		/**< Number of BDs in post-work group */
 	int AllCnt;		/**< Total Number of BDs for channel */
 	int RingIndex;		/**< Ring Index */
 	int Cyclic;		/**< Check for cyclic DMA Mode */
+	XBdRing Core;		/**< BD groups, counters and statistics */
+	UINTPTR StreamBuf;	/**< Buffer of a streaming ring */
+	u32 StreamBlockLen;	/**< Bytes per BD, 0 if not streaming */
+	u32 StreamIdx;		/**< Next BD to hand to the application */
+	u32 StreamRelIdx;	/**< Oldest BD held by the application */
+	u32 StreamHeld;		/**< BDs held by the application */
+	u32 StreamOverruns;	/**< Times the channel caught up with the
+				     held BDs */
 } XAxiDma_BdRing;
 
+/** Region of a streaming ring held by the application, see
+ * XAxiDma_StreamAcquire()
+ */
+typedef struct {
+	UINTPTR BufAddr;	/**< Address of the first byte */
+	u32 Length;		/**< Number of bytes */
+	u32 BdIdx;		/**< Index of the first BD in the ring */
+	u32 NumBd;		/**< Number of BDs in the region */
+} XAxiDma_StreamWindow;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -217,7 +233,43 @@ typedef struct {
 *		This function is used only when system is configured as SG mode
 *
 *****************************************************************************/
-#define XAxiDma_BdRingGetFreeCnt(RingPtr)  ((RingPtr)->FreeCnt)
+#define XAxiDma_BdRingGetFreeCnt(RingPtr)  \
+		((int)XBdRing_GetFreeCnt(&(RingPtr)->Core))
+
+/****************************************************************************/
+/**
+* Return the number of BDs given to hardware with XAxiDma_BdRingToHw() and
+* not yet returned by XAxiDma_BdRingFromHw().
+*
+* @param	RingPtr is the BD ring to operate on.
+*
+* @return	The number of BDs owned by hardware.
+*
+* @note
+* 		C-style signature:
+*		int XAxiDma_BdRingGetHwCnt(XAxiDma_BdRing* RingPtr)
+*		This function is used only when system is configured as SG mode
+*
+*****************************************************************************/
+#define XAxiDma_BdRingGetHwCnt(RingPtr)  \
+		((int)XBdRing_GetHwCnt(&(RingPtr)->Core))
+
+/****************************************************************************/
+/**
+* Copy the statistics kept for the BD ring, see XBdRing_Stats.
+*
+* @param	RingPtr is the BD ring to operate on.
+* @param	StatsPtr is the XBdRing_Stats to fill in.
+*
+* @note
+* 		C-style signature:
+*		void XAxiDma_BdRingGetStats(XAxiDma_BdRing* RingPtr,
+*					    XBdRing_Stats *StatsPtr)
+*		This function is used only when system is configured as SG mode
+*
+*****************************************************************************/
+#define XAxiDma_BdRingGetStats(RingPtr, StatsPtr)  \
+		XBdRing_GetStats(&(RingPtr)->Core, (StatsPtr))
 
 
 /****************************************************************************/
@@ -505,7 +557,24 @@ typedef struct {
 *
 *****************************************************************************/
 #define XAxiDma_BdRingEnableCyclicDMA(RingPtr)			\
-		(RingPtr->Cyclic = 1)
+		((RingPtr)->Cyclic = 1,					\
+		 (RingPtr)->Core.Flags |= XBDRING_FLAG_CYCLIC)
+
+/****************************************************************************/
+/**
+* Get the number of times the channel of a streaming ring caught up with the
+* BDs held by the application.
+*
+* @param	RingPtr is the channel instance to operate on.
+*
+* @return	Number of overruns since XAxiDma_StreamSetup().
+*
+* @note
+*		C-style signature:
+*		u32 XAxiDma_StreamGetOverruns(XAxiDma_BdRing* RingPtr)
+*
+*****************************************************************************/
+#define XAxiDma_StreamGetOverruns(RingPtr)	((RingPtr)->StreamOverruns)
 
 /****************************************************************************/
 
@@ -534,6 +603,16 @@ int XAxiDma_BdRingSetCoalesce(XAxiDma_BdRing * RingPtr, u32 Counter, u32 Timer);
 void XAxiDma_BdRingGetCoalesce(XAxiDma_BdRing * RingPtr,
 		u32 *CounterPtr, u32 *TimerPtr);
 
+/*
+ * Cyclic streaming functions xaxidma_stream.c
+ */
+int XAxiDma_StreamSetup(XAxiDma_BdRing *RingPtr, UINTPTR BufAddr,
+		u32 BlockLen);
+int XAxiDma_StreamAcquire(XAxiDma_BdRing *RingPtr, u32 BdLimit,
+		XAxiDma_StreamWindow *WinPtr);
+int XAxiDma_StreamRelease(XAxiDma_BdRing *RingPtr,
+		XAxiDma_StreamWindow *WinPtr);
+
 /* The following functions are for debug only
  */
 int XAxiDma_BdRingCheck(XAxiDma_BdRing * RingPtr);
@@ -0,0 +1,361 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_stream.c
+* @addtogroup axidma_v9_5
+* @{
+*
+* This file implements cyclic streaming on top of a BD ring. The BDs of the
+* ring are set up once over one contiguous buffer and the channel then runs
+* in cyclic mode, going round the ring without software intervention. The
+* application takes completed regions of the buffer out of the ring as
+* windows with XAxiDma_StreamAcquire() and gives them back with
+* XAxiDma_StreamRelease(). Releasing a window only clears the status word of
+* its BDs; the descriptors are never rewritten and the channel never stops.
+*
+* On an S2MM (RX) ring a window holds received data. On an MM2S (TX) ring a
+* window is a region the channel has read, which the application may refill
+* before releasing it. The data cache of the buffer is left to the
+* application, as for the other BD ring functions.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 9.7   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xaxidma.h"
+
+/************************** Constant Definitions *****************************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/************************** Function Prototypes ******************************/
+
+
+/************************** Variable Definitions *****************************/
+
+
+/*****************************************************************************/
+/**
+* Set up a BD ring for cyclic streaming over a contiguous buffer. Every BD of
+* the ring is given one block of the buffer, in order, and all BDs are given
+* to hardware. On a TX ring each block is sent as one packet. The channel is
+* switched to cyclic mode; call XAxiDma_BdRingStart() to start streaming.
+*
+* The buffer must be XAxiDma_BdRingGetCnt() * BlockLen bytes. On a TX ring
+* the application fills and flushes it before the channel is started.
+*
+* @param	RingPtr is a pointer to the created and cloned descriptor ring
+*		instance to be worked on.
+* @param	BufAddr is the physical address of the buffer.
+* @param	BlockLen is the number of bytes per BD. It may not exceed the
+*		maximum transfer length of the channel.
+*
+* @return
+*		- XST_SUCCESS if the ring is set up.
+*		- XST_DMA_SG_NO_LIST if the ring has not been created.
+*		- XST_DEVICE_IS_STARTED if the channel is running.
+*		- XST_DMA_SG_LIST_ERROR if some BDs are in use.
+*		- XST_INVALID_PARAM if BlockLen or BufAddr is not valid for the
+*		channel.
+*
+* @note		Windows are handed out in virtual addresses, which are
+*		assumed to be the same as the physical ones.
+*
+******************************************************************************/
+int XAxiDma_StreamSetup(XAxiDma_BdRing *RingPtr, UINTPTR BufAddr,
+			u32 BlockLen)
+{
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *BdCurPtr;
+	UINTPTR Addr;
+	int Index;
+	int Status;
+
+	if (RingPtr->AllCnt == 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "StreamSetup: no bds\r\n");
+
+		return XST_DMA_SG_NO_LIST;
+	}
+
+	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "StreamSetup: bd ring started "
+			"already, cannot do\r\n");
+
+		return XST_DEVICE_IS_STARTED;
+	}
+
+	if (XAxiDma_BdRingGetFreeCnt(RingPtr) != RingPtr->AllCnt) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "StreamSetup: some bds already "
+			"in use %d/%d\r\n", XAxiDma_BdRingGetFreeCnt(RingPtr),
+			RingPtr->AllCnt);
+
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	if ((BlockLen == 0) || (BlockLen > RingPtr->MaxTransferLen)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "StreamSetup: invalid block "
+			"length %d\r\n", (int)BlockLen);
+
+		return XST_INVALID_PARAM;
+	}
+
+	Status = XAxiDma_BdRingAlloc(RingPtr, RingPtr->AllCnt, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	BdCurPtr = BdPtr;
+	Addr = BufAddr;
+	for (Index = 0; Index < RingPtr->AllCnt; Index++) {
+		Status = (int)XAxiDma_BdSetBufAddr(BdCurPtr, Addr);
+		if (Status == XST_SUCCESS) {
+			Status = XAxiDma_BdSetLength(BdCurPtr, BlockLen,
+						     RingPtr->MaxTransferLen);
+		}
+		if (Status != XST_SUCCESS) {
+			(void)XAxiDma_BdRingUnAlloc(RingPtr, RingPtr->AllCnt,
+						    BdPtr);
+			return XST_INVALID_PARAM;
+		}
+
+		if (RingPtr->IsRxChannel) {
+			XAxiDma_BdSetCtrl(BdCurPtr, 0);
+		} else {
+			XAxiDma_BdSetCtrl(BdCurPtr, XAXIDMA_BD_CTRL_TXSOF_MASK |
+					  XAXIDMA_BD_CTRL_TXEOF_MASK);
+		}
+		XAxiDma_BdWrite(BdCurPtr, XAXIDMA_BD_STS_OFFSET, 0);
+
+		Addr += BlockLen;
+		BdCurPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(RingPtr, BdCurPtr);
+	}
+
+	XAxiDma_BdRingEnableCyclicDMA(RingPtr);
+	Status = XAxiDma_BdRingToHw(RingPtr, RingPtr->AllCnt, BdPtr);
+	if (Status != XST_SUCCESS) {
+		(void)XAxiDma_BdRingUnAlloc(RingPtr, RingPtr->AllCnt, BdPtr);
+		return Status;
+	}
+
+	XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_CR_OFFSET,
+		XAxiDma_ReadReg(RingPtr->ChanBase, XAXIDMA_CR_OFFSET) |
+		XAXIDMA_CR_CYCLIC_MASK);
+
+	RingPtr->StreamBuf = BufAddr;
+	RingPtr->StreamBlockLen = BlockLen;
+	RingPtr->StreamIdx = 0;
+	RingPtr->StreamRelIdx = 0;
+	RingPtr->StreamHeld = 0;
+	RingPtr->StreamOverruns = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Take the next completed region of a streaming ring. The window covers
+* consecutive completed BDs, up to BdLimit of them. It ends early at the end
+* of the buffer and, on an RX ring, after a BD the stream filled only in
+* part (the packet ended there).
+*
+* Windows are taken in buffer order and stay with the application until
+* they are given back with XAxiDma_StreamRelease(), which must be done in
+* the same order. The channel keeps running meanwhile; if it catches up with
+* the oldest window still held, the data of the held windows may be
+* overwritten (RX) or sent again (TX). This is reported as an overrun.
+*
+* @param	RingPtr is a pointer to the ring set up with
+*		XAxiDma_StreamSetup().
+* @param	BdLimit is the maximum number of BDs in the window.
+* @param	WinPtr is an output parameter, it describes the window.
+*
+* @return
+*		- XST_SUCCESS if a window is returned.
+*		- XST_DATA_LOST if a window is returned, but the channel has
+*		caught up with the held windows.
+*		- XST_NO_DATA if nothing new has completed.
+*		- XST_DMA_ERROR if the first BD has an error status.
+*		- XST_DMA_SG_NO_LIST if the ring is not set up for streaming.
+*
+******************************************************************************/
+int XAxiDma_StreamAcquire(XAxiDma_BdRing *RingPtr, u32 BdLimit,
+			  XAxiDma_StreamWindow *WinPtr)
+{
+	XBdRing *CorePtr = &RingPtr->Core;
+	XAxiDma_Bd *BdPtr;
+	u32 Limit;
+	u32 Idx;
+	u32 BdCount = 0;
+	u32 Length = 0;
+	u32 BdLen;
+	u32 BdSts;
+	int Status = XST_SUCCESS;
+
+	if (RingPtr->StreamBlockLen == 0) {
+		return XST_DMA_SG_NO_LIST;
+	}
+
+	/* Stop at the held windows and at the end of the buffer */
+	Limit = CorePtr->AllCnt - RingPtr->StreamHeld;
+	if (Limit > (CorePtr->AllCnt - RingPtr->StreamIdx)) {
+		Limit = CorePtr->AllCnt - RingPtr->StreamIdx;
+	}
+	if (Limit > BdLimit) {
+		Limit = BdLimit;
+	}
+	if (Limit == 0) {
+		return XST_NO_DATA;
+	}
+	XBdRing_InvalidateSpan(CorePtr, RingPtr->StreamIdx, Limit);
+
+	Idx = RingPtr->StreamIdx;
+	while (BdCount < Limit) {
+		BdPtr = (XAxiDma_Bd *)XBdRing_IdxToBd(CorePtr, Idx);
+		BdSts = XAxiDma_BdRead(BdPtr, XAXIDMA_BD_STS_OFFSET);
+		if (!(BdSts & XAXIDMA_BD_STS_COMPLETE_MASK)) {
+			break;
+		}
+		if (BdSts & XAXIDMA_BD_STS_ALL_ERR_MASK) {
+			if (BdCount == 0) {
+				return XST_DMA_ERROR;
+			}
+			break;
+		}
+
+		BdLen = RingPtr->StreamBlockLen;
+		if (RingPtr->IsRxChannel) {
+			BdLen = BdSts & RingPtr->MaxTransferLen;
+		}
+		Length += BdLen;
+		BdCount++;
+		Idx++;
+		if (BdLen != RingPtr->StreamBlockLen) {
+			break;
+		}
+	}
+
+	if (BdCount == 0) {
+		return XST_NO_DATA;
+	}
+
+	WinPtr->BufAddr = RingPtr->StreamBuf +
+		((UINTPTR)RingPtr->StreamIdx * RingPtr->StreamBlockLen);
+	WinPtr->Length = Length;
+	WinPtr->BdIdx = RingPtr->StreamIdx;
+	WinPtr->NumBd = BdCount;
+
+	RingPtr->StreamIdx = XBdRing_IdxAdd(CorePtr, RingPtr->StreamIdx,
+					    BdCount);
+	RingPtr->StreamHeld += BdCount;
+
+	/* The BD just before the oldest held one is the last the channel
+	 * completes before it reaches the held windows.
+	 */
+	if (RingPtr->StreamHeld < CorePtr->AllCnt) {
+		Idx = XBdRing_IdxSub(CorePtr, RingPtr->StreamRelIdx, 1);
+		XBdRing_InvalidateSpan(CorePtr, Idx, 1);
+		BdPtr = (XAxiDma_Bd *)XBdRing_IdxToBd(CorePtr, Idx);
+		if (XAxiDma_BdHwCompleted(BdPtr)) {
+			RingPtr->StreamOverruns++;
+			Status = XST_DATA_LOST;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Give a window taken with XAxiDma_StreamAcquire() back to the channel. The
+* status words of its BDs are cleared so they can be seen completing again;
+* the channel goes on using the BDs on its next round.
+*
+* @param	RingPtr is a pointer to the ring set up with
+*		XAxiDma_StreamSetup().
+* @param	WinPtr is the window to give back. It must be the oldest window
+*		held.
+*
+* @return
+*		- XST_SUCCESS if the window is given back.
+*		- XST_INVALID_PARAM if it is not the oldest window held.
+*
+******************************************************************************/
+int XAxiDma_StreamRelease(XAxiDma_BdRing *RingPtr,
+			  XAxiDma_StreamWindow *WinPtr)
+{
+	XBdRing *CorePtr = &RingPtr->Core;
+	u32 Idx;
+	u32 i;
+
+	if ((WinPtr->BdIdx != RingPtr->StreamRelIdx) ||
+	    (WinPtr->NumBd == 0) || (WinPtr->NumBd > RingPtr->StreamHeld)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "StreamRelease: window %d/%d "
+			"is not the oldest held\r\n", (int)WinPtr->BdIdx,
+			(int)WinPtr->NumBd);
+
+		return XST_INVALID_PARAM;
+	}
+
+	Idx = WinPtr->BdIdx;
+	for (i = 0; i < WinPtr->NumBd; i++) {
+		XAxiDma_BdWrite(XBdRing_IdxToBd(CorePtr, Idx),
+				XAXIDMA_BD_STS_OFFSET, 0);
+		Idx = XBdRing_IdxAdd(CorePtr, Idx, 1);
+	}
+	XBdRing_FlushSpan(CorePtr, WinPtr->BdIdx, WinPtr->NumBd);
+
+	RingPtr->StreamRelIdx = Idx;
+	RingPtr->StreamHeld -= WinPtr->NumBd;
+
+	return XST_SUCCESS;
+}
+/** @} */
@@ -0,0 +1,291 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxivdma_frmq.c
+* @addtogroup axivdma_v6_5
+* @{
+*
+* Implementation of the frame queue on top of a VDMA channel. See
+* xaxivdma_frmq.h for the usage.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.5   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xaxivdma_frmq.h"
+#include "xaxivdma_i.h"
+
+/*****************************************************************************/
+/**
+ * Set up the frame queue of a channel and park the channel on its first
+ * frame.
+ *
+ * @param FrmQPtr is the pointer to the frame queue to set up
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ * @param Direction is the DMA channel, use XAXIVDMA_READ or XAXIVDMA_WRITE
+ * @param BufferAddrSet is the array of frame store addresses given to
+ *        XAxiVdma_DmaSetBufferAddr()
+ * @param Policy is XVIDC_FRMQ_FIFO or XVIDC_FRMQ_LATEST
+ *
+ * @return
+ * - XST_SUCCESS if the queue is running
+ * - XST_INVALID_PARAM if the channel is invalid or has too few frames
+ * - XST_FAILURE if the channel could not be parked
+ *
+ * @note
+ * The channel must be started. At least two frame stores are needed, three
+ * for the write channel so that a frame is ready while another is read.
+ * The general callback of the channel is replaced, use
+ * XAxiVdma_FrmQSetCallBack() to be notified of frames.
+ *****************************************************************************/
+int XAxiVdma_FrmQInitialize(XAxiVdma_FrmQ *FrmQPtr, XAxiVdma *InstancePtr,
+        u16 Direction, const UINTPTR *BufferAddrSet, XVidC_FrmQPolicy Policy)
+{
+	XAxiVdma_Channel *Channel;
+	XAxiVdma_FrameCounter FrameCounter;
+	int Status;
+
+	Xil_AssertNonvoid(FrmQPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XAXIVDMA_DEVICE_READY);
+	Xil_AssertNonvoid(BufferAddrSet != NULL);
+
+	Channel = XAxiVdma_GetChannel(InstancePtr, Direction);
+	if (!Channel || !Channel->IsValid || (Channel->NumFrames < 2) ||
+	    (Channel->NumFrames > (XAXIVDMA_FRM_MAX + 1))) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "FrmQInitialize: invalid channel %d\r\n", Direction);
+
+		return XST_INVALID_PARAM;
+	}
+
+	FrmQPtr->InstancePtr = InstancePtr;
+	FrmQPtr->Direction = Direction;
+	FrmQPtr->CallBack = NULL;
+	FrmQPtr->CallBackRef = NULL;
+	XVidC_FrmQInit(&FrmQPtr->Queue, BufferAddrSet,
+	    (u32)Channel->NumFrames, Policy);
+
+	/* The first frame goes to the VDMA, for reading as if published */
+	(void)XVidC_FrmQAcquireWrite(&FrmQPtr->Queue, &FrmQPtr->HwFrame);
+	if (Direction == XAXIVDMA_READ) {
+		XVidC_FrmQPublish(&FrmQPtr->Queue, FrmQPtr->HwFrame);
+		(void)XVidC_FrmQAcquireRead(&FrmQPtr->Queue, &FrmQPtr->HwFrame);
+	}
+
+	Status = XAxiVdma_StartParking(InstancePtr, (int)FrmQPtr->HwFrame,
+	    Direction);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	/* Interrupt on every frame */
+	XAxiVdma_GetFrameCounter(InstancePtr, &FrameCounter);
+	if (Direction == XAXIVDMA_READ) {
+		FrameCounter.ReadFrameCount = 1;
+		FrameCounter.ReadDelayTimerCount = 0;
+	}
+	else {
+		FrameCounter.WriteFrameCount = 1;
+		FrameCounter.WriteDelayTimerCount = 0;
+	}
+	if (FrameCounter.ReadFrameCount == 0) {
+		FrameCounter.ReadFrameCount = 1;
+	}
+	if (FrameCounter.WriteFrameCount == 0) {
+		FrameCounter.WriteFrameCount = 1;
+	}
+	Status = XAxiVdma_SetFrameCounter(InstancePtr, &FrameCounter);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XAxiVdma_SetCallBack(InstancePtr, XAXIVDMA_HANDLER_GENERAL,
+	    (void *)XAxiVdma_FrmQIntrCallBack, FrmQPtr, Direction);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	XAxiVdma_IntrEnable(InstancePtr, XAXIVDMA_IXR_FRMCNT_MASK, Direction);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Install a callback invoked in the frame count interrupt after the channel
+ * has been moved to the next frame.
+ *
+ * @param FrmQPtr is the pointer to the frame queue
+ * @param CallBack is the callback, NULL for none
+ * @param CallBackRef is passed to the callback
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmQSetCallBack(XAxiVdma_FrmQ *FrmQPtr,
+        XAxiVdma_FrmQCallBack CallBack, void *CallBackRef)
+{
+	Xil_AssertVoid(FrmQPtr != NULL);
+
+	FrmQPtr->CallBackRef = CallBackRef;
+	FrmQPtr->CallBack = CallBack;
+}
+
+/*****************************************************************************/
+/**
+ * Stop moving the channel between frames. The channel stays parked on its
+ * current frame.
+ *
+ * @param FrmQPtr is the pointer to the frame queue
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmQStop(XAxiVdma_FrmQ *FrmQPtr)
+{
+	Xil_AssertVoid(FrmQPtr != NULL);
+
+	XAxiVdma_IntrDisable(FrmQPtr->InstancePtr, XAXIVDMA_IXR_FRMCNT_MASK,
+	    FrmQPtr->Direction);
+}
+
+/*****************************************************************************/
+/**
+ * Acquire a frame without waiting. For the write channel this is a frame
+ * captured by the VDMA, for the read channel a frame to render into.
+ *
+ * @param FrmQPtr is the pointer to the frame queue
+ * @param Index is set to the acquired frame, see XAxiVdma_FrmQGetAddr()
+ *
+ * @return
+ * - XST_SUCCESS if a frame was acquired
+ * - XST_NO_DATA if no captured frame is ready (write channel)
+ * - XST_DEVICE_BUSY if no frame is free (read channel)
+ *
+ * @note
+ * The frame must be handed back with XAxiVdma_FrmQRelease().
+ *****************************************************************************/
+int XAxiVdma_FrmQAcquire(XAxiVdma_FrmQ *FrmQPtr, u32 *Index)
+{
+	Xil_AssertNonvoid(FrmQPtr != NULL);
+	Xil_AssertNonvoid(Index != NULL);
+
+	if (FrmQPtr->Direction == XAXIVDMA_WRITE) {
+		return XVidC_FrmQAcquireRead(&FrmQPtr->Queue, Index);
+	}
+
+	return XVidC_FrmQAcquireWrite(&FrmQPtr->Queue, Index);
+}
+
+/*****************************************************************************/
+/**
+ * Hand back a frame. For the write channel the frame becomes free for the
+ * VDMA, for the read channel it is queued for display.
+ *
+ * @param FrmQPtr is the pointer to the frame queue
+ * @param Index is the frame returned by XAxiVdma_FrmQAcquire()
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmQRelease(XAxiVdma_FrmQ *FrmQPtr, u32 Index)
+{
+	Xil_AssertVoid(FrmQPtr != NULL);
+
+	if (FrmQPtr->Direction == XAXIVDMA_WRITE) {
+		XVidC_FrmQRelease(&FrmQPtr->Queue, Index);
+	}
+	else {
+		XVidC_FrmQPublish(&FrmQPtr->Queue, Index);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * General callback of the channel, installed by XAxiVdma_FrmQInitialize().
+ *
+ * On the write channel the frame just written is published if another frame
+ * can be acquired for the VDMA, otherwise the VDMA writes over it. On the
+ * read channel the VDMA is moved to the next queued frame, if any, and the
+ * frame just shown is freed.
+ *
+ * @param CallBackRef is the pointer to the frame queue
+ * @param InterruptTypes is the mask of pending completion interrupts
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmQIntrCallBack(void *CallBackRef, u32 InterruptTypes)
+{
+	XAxiVdma_FrmQ *FrmQPtr = (XAxiVdma_FrmQ *)CallBackRef;
+	u32 Next;
+
+	if (!(InterruptTypes & XAXIVDMA_IXR_FRMCNT_MASK)) {
+		return;
+	}
+
+	if (FrmQPtr->Direction == XAXIVDMA_WRITE) {
+		if (XVidC_FrmQAcquireWrite(&FrmQPtr->Queue, &Next) ==
+		    XST_SUCCESS) {
+			(void)XAxiVdma_StartParking(FrmQPtr->InstancePtr,
+			    (int)Next, XAXIVDMA_WRITE);
+			XVidC_FrmQPublish(&FrmQPtr->Queue, FrmQPtr->HwFrame);
+			FrmQPtr->HwFrame = Next;
+		}
+		else {
+			XVidC_FrmQRewrite(&FrmQPtr->Queue, FrmQPtr->HwFrame);
+		}
+	}
+	else if (XVidC_FrmQAcquireRead(&FrmQPtr->Queue, &Next) ==
+	    XST_SUCCESS) {
+		(void)XAxiVdma_StartParking(FrmQPtr->InstancePtr, (int)Next,
+		    XAXIVDMA_READ);
+		XVidC_FrmQRelease(&FrmQPtr->Queue, FrmQPtr->HwFrame);
+		FrmQPtr->HwFrame = Next;
+	}
+
+	if (FrmQPtr->CallBack != NULL) {
+		FrmQPtr->CallBack(FrmQPtr->CallBackRef, FrmQPtr->HwFrame);
+	}
+}
+/** @} */
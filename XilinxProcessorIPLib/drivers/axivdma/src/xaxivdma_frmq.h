@@ -0,0 +1,146 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxivdma_frmq.h
+* @addtogroup axivdma_v6_5
+* @{
+*
+* Frame queue on top of a VDMA channel. The channel runs in park mode and is
+* moved to the next frame in its frame count interrupt, the ownership of the
+* frame stores is tracked by an XVidC_FrameQueue (see xvidc_frmq.h).
+*
+* For the write channel the VDMA is the producer: every completed frame is
+* published and the processor, or an accelerator, acquires it with
+* XAxiVdma_FrmQAcquire() and hands it back with XAxiVdma_FrmQRelease().
+* For the read channel the VDMA is the consumer: the processor acquires a
+* frame to render into and XAxiVdma_FrmQRelease() queues it for display,
+* the VDMA keeps showing the current frame until another one is released.
+*
+* The sequence to use the frame queue is:
+*  1. Configure the channel with XAxiVdma_DmaConfig() and
+*     XAxiVdma_DmaSetBufferAddr() and start it with XAxiVdma_DmaStart().
+*  2. Call XAxiVdma_FrmQInitialize() with the same frame store addresses.
+*     It parks the channel, sets its frame counter to one and installs the
+*     general callback of the channel.
+*  3. Connect XAxiVdma_WriteIntrHandler() or XAxiVdma_ReadIntrHandler() to
+*     the interrupt controller.
+*
+* Acquire and release never wait and may be called from any context other
+* than the VDMA interrupt. The park pointer is sampled by the VDMA at frame
+* start, the interrupt must therefore be serviced within the vertical
+* blanking. Cache maintenance of the frames is left to the application.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.5   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XAXIVDMA_FRMQ_H_     /* Prevent circular inclusions */
+#define XAXIVDMA_FRMQ_H_     /* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xaxivdma.h"
+#include "xvidc_frmq.h"
+
+/**************************** Type Definitions *******************************/
+
+/*****************************************************************************/
+/**
+ * Callback type for the frame queue, invoked in the frame count interrupt
+ * after the channel has been moved to the next frame.
+ *
+ * @param   CallBackRef is the reference given to XAxiVdma_FrmQSetCallBack()
+ * @param   HwFrame is the frame the channel works on from the next frame
+ *          start
+ *****************************************************************************/
+typedef void (*XAxiVdma_FrmQCallBack) (void *CallBackRef, u32 HwFrame);
+
+/**
+ * The frame queue of a VDMA channel.
+ */
+typedef struct {
+    XVidC_FrameQueue Queue;         /**< Ownership of the frame stores */
+    XAxiVdma *InstancePtr;          /**< VDMA the queue works on */
+    u16 Direction;                  /**< XAXIVDMA_WRITE or XAXIVDMA_READ */
+    u32 HwFrame;                    /**< Frame the channel is parked on */
+    XAxiVdma_FrmQCallBack CallBack; /**< Frame callback, may be NULL */
+    void *CallBackRef;              /**< Frame callback reference */
+} XAxiVdma_FrmQ;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*****************************************************************************/
+/**
+ * Get the address of a frame store of the queue.
+ *
+ * @param FrmQPtr is the pointer to the frame queue
+ * @param Index is the frame returned by XAxiVdma_FrmQAcquire()
+ *
+ * @return
+ *   The frame store address
+ *
+ * @note
+ * C-style signature:
+ *   UINTPTR XAxiVdma_FrmQGetAddr(XAxiVdma_FrmQ *FrmQPtr, u32 Index)
+ *****************************************************************************/
+#define XAxiVdma_FrmQGetAddr(FrmQPtr, Index) \
+	XVidC_FrmQGetAddr(&(FrmQPtr)->Queue, (Index))
+
+/************************** Function Prototypes ******************************/
+
+int XAxiVdma_FrmQInitialize(XAxiVdma_FrmQ *FrmQPtr, XAxiVdma *InstancePtr,
+        u16 Direction, const UINTPTR *BufferAddrSet, XVidC_FrmQPolicy Policy);
+void XAxiVdma_FrmQSetCallBack(XAxiVdma_FrmQ *FrmQPtr,
+        XAxiVdma_FrmQCallBack CallBack, void *CallBackRef);
+void XAxiVdma_FrmQStop(XAxiVdma_FrmQ *FrmQPtr);
+int XAxiVdma_FrmQAcquire(XAxiVdma_FrmQ *FrmQPtr, u32 *Index);
+void XAxiVdma_FrmQRelease(XAxiVdma_FrmQ *FrmQPtr, u32 Index);
+void XAxiVdma_FrmQIntrCallBack(void *CallBackRef, u32 InterruptTypes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/** @} */
@@ -48,6 +48,7 @@
 * 1.0   vnsld   22/10/14 First release
 * 1.1   adk     10/05/16 Fixed CR#951040 race condition in the recv path when
 *                        source and destination points to the same buffer.
+* 1.2   ag      10/16/26 Clear the transfer queues in XCsuDma_CfgInitialize().
 * </pre>
 *
 ******************************************************************************/
@@ -101,6 +102,8 @@ s32 XCsuDma_CfgInitialize(XCsuDma *InstancePtr, XCsuDma_Config *CfgPtr,
 
 	XCsuDma_Reset();
 
+	(void)memset((void *)InstancePtr->Queue, 0, sizeof(InstancePtr->Queue));
+
 	InstancePtr->IsReady = (u32)(XIL_COMPONENT_IS_READY);
 
 	return (XST_SUCCESS);
@@ -59,6 +59,24 @@
 * This driver will not support handling of interrupts user should write handler
 * to handle the interrupts.
 *
+* <b> Transfer Queue </b>
+*
+* XCsuDma_Transfer() programs one command and XCsuDma_WaitForDone() spins on
+* its completion. The transfer queue in xcsudma_queue.c keeps up to
+* XCSUDMA_QUEUE_DEPTH commands per channel instead, issues the next one as
+* soon as the previous completes and reports each completion through a
+* callback. SRC and DST queues run independently, so a memory to SSS to
+* memory stream keeps both channels busy while software prepares the next
+* buffer.
+*
+* XCsuDma_QueueTransfer() adds a command, XCsuDma_QueuePoll() (or
+* XCsuDma_QueueIntrHandler() with the DONE interrupts enabled) retires the
+* completed ones and XCsuDma_QueueWait() blocks until a channel has no more
+* than a given number of commands outstanding. Buffers handed to the queue
+* must not be touched by the processor until their callback has run or the
+* wait has returned. XCsuDma_Transfer() must not be used on a channel while
+* it has queued commands.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -106,6 +124,7 @@
 * 1.2   adk     11/22/17 Added peripheral test app support for CSUDMA driver.
 *	adk	09/03/18 Added new API XCsuDma_64BitTransfer() useful for 64-bit
 *			 dma transfers through PMU processor(CR#996201).
+*	ag	10/16/26 Added transfer queue with completion callbacks.
 * </pre>
 *
 ******************************************************************************/
@@ -137,6 +156,12 @@ typedef enum {
 }XCsuDma_Channel;
 /*@}*/
 
+/** @name Transfer queue
+ * @{
+ */
+#define XCSUDMA_QUEUE_DEPTH	8U	/**< Commands queued per channel */
+/*@}*/
+
 /** @name CSU_DMA pause types
  * @{
  */
@@ -333,6 +358,39 @@ typedef struct {
 				  *  of the device's registers */
 } XCsuDma_Config;
 
+/**
+* Callback invoked when a queued command completes.
+*
+* @param	CallBackRef is the reference given to XCsuDma_QueueTransfer().
+* @param	Channel is the channel the command ran on.
+* @param	Addr is the address of the completed command.
+* @param	Size is the number of 4 byte words of the completed command.
+*/
+typedef void (*XCsuDma_DoneHandler) (void *CallBackRef,
+				XCsuDma_Channel Channel, UINTPTR Addr, u32 Size);
+
+/**
+* One command of the transfer queue.
+*/
+typedef struct {
+	UINTPTR Addr;			/**< Start address */
+	u32 Size;			/**< Number of 4 byte words */
+	u8 EnDataLast;			/**< Assert data_inp_last at the end */
+	XCsuDma_DoneHandler Handler;	/**< Completion callback or NULL */
+	void *CallBackRef;		/**< Callback reference */
+} XCsuDma_QueueEntry;
+
+/**
+* Transfer queue of one channel. Entry[Head] is the oldest command, it is
+* with the hardware when Issued is set.
+*/
+typedef struct {
+	XCsuDma_QueueEntry Entry[XCSUDMA_QUEUE_DEPTH]; /**< Command ring */
+	u32 Head;			/**< Oldest command */
+	u32 Count;			/**< Commands in the ring */
+	u32 Issued;			/**< Entry[Head] is programmed */
+} XCsuDma_Queue;
+
 
 /******************************************************************************/
 /**
@@ -345,6 +403,8 @@ typedef struct {
 	XCsuDma_Config Config;		/**< Hardware configuration */
 	u32 IsReady;			/**< Device and the driver instance
 					  *  are initialized */
+	XCsuDma_Queue Queue[2];		/**< Transfer queues indexed by
+					  *  XCsuDma_Channel */
 }XCsuDma;
 
 
@@ -418,6 +478,16 @@ u32 XCsuDma_GetIntrMask(XCsuDma *InstancePtr, XCsuDma_Channel Channel);
 
 s32 XCsuDma_SelfTest(XCsuDma *InstancePtr);
 
+/* Transfer queue related functions in xcsudma_queue.c */
+void XCsuDma_QueueReset(XCsuDma *InstancePtr);
+s32 XCsuDma_QueueTransfer(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+			UINTPTR Addr, u32 Size, u8 EnDataLast,
+			XCsuDma_DoneHandler Handler, void *CallBackRef);
+u32 XCsuDma_QueuePoll(XCsuDma *InstancePtr);
+void XCsuDma_QueueWait(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+			u32 MaxPending);
+void XCsuDma_QueueIntrHandler(void *CallBackRef);
+
 /******************************************************************************/
 
 #ifdef __cplusplus
@@ -0,0 +1,308 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xcsudma_queue.c
+* @addtogroup csudma_v1_2
+* @{
+*
+* This file contains the transfer queue of the CSU_DMA driver. Each channel
+* keeps a ring of commands of which the oldest one is programmed into the
+* hardware; when it completes the next one is programmed before the
+* completion callback runs. Please see xcsudma.h for more details of the
+* driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ---------------------------------------------------
+* 1.2   ag      10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xcsudma.h"
+
+/************************** Function Prototypes ******************************/
+
+static void XCsuDma_QueueIssue(XCsuDma *InstancePtr, XCsuDma_Channel Channel);
+static u32 XCsuDma_QueueService(XCsuDma *InstancePtr,
+				XCsuDma_Channel Channel);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function empties the transfer queues of both channels.
+*
+* @param	InstancePtr is a pointer to XCsuDma instance to be worked on.
+*
+* @return	None.
+*
+* @note		Commands already programmed are not stopped, call this only
+*		when both channels are idle. XCsuDma_CfgInitialize() leaves
+*		the queues empty.
+*
+******************************************************************************/
+void XCsuDma_QueueReset(XCsuDma *InstancePtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+
+	InstancePtr->Queue[XCSUDMA_SRC_CHANNEL].Head = 0U;
+	InstancePtr->Queue[XCSUDMA_SRC_CHANNEL].Count = 0U;
+	InstancePtr->Queue[XCSUDMA_SRC_CHANNEL].Issued = 0U;
+	InstancePtr->Queue[XCSUDMA_DST_CHANNEL].Head = 0U;
+	InstancePtr->Queue[XCSUDMA_DST_CHANNEL].Count = 0U;
+	InstancePtr->Queue[XCSUDMA_DST_CHANNEL].Issued = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a command to the transfer queue of a channel. The
+* command is programmed at once when the channel has nothing outstanding,
+* otherwise when the commands ahead of it have completed.
+*
+* @param	InstancePtr is a pointer to XCsuDma instance to be worked on.
+* @param	Channel represents the type of channel either it is Source or
+*		Destination.
+*		Source channel      - XCSUDMA_SRC_CHANNEL
+*		Destination Channel - XCSUDMA_DST_CHANNEL
+* @param	Addr is the word aligned start address of the data to be read
+*		(SRC) or written (DST).
+* @param	Size is the number of 4 byte words to be transferred.
+* @param	EnDataLast asserts data_inp_last at the end of the command,
+*		see XCsuDma_Transfer().
+* @param	Handler is called when the command has completed, or NULL.
+* @param	CallBackRef is passed to Handler.
+*
+* @return
+*		- XST_SUCCESS if the command was queued.
+*		- XST_DEVICE_BUSY if the queue of the channel is full.
+*
+* @note		Cache maintenance of the buffer is done by XCsuDma_Transfer()
+*		when the command is programmed.
+*
+******************************************************************************/
+s32 XCsuDma_QueueTransfer(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+			UINTPTR Addr, u32 Size, u8 EnDataLast,
+			XCsuDma_DoneHandler Handler, void *CallBackRef)
+{
+	XCsuDma_Queue *Queue;
+	XCsuDma_QueueEntry *Entry;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Channel == (XCSUDMA_SRC_CHANNEL)) ||
+					(Channel == (XCSUDMA_DST_CHANNEL)));
+	Xil_AssertNonvoid(((Addr) & (u64)(XCSUDMA_ADDR_LSB_MASK)) == (u64)0x00);
+	Xil_AssertNonvoid(Size <= (u32)(XCSUDMA_SIZE_MAX));
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+					(u32)(XIL_COMPONENT_IS_READY));
+
+	Queue = &InstancePtr->Queue[Channel];
+
+	if (Queue->Count == XCSUDMA_QUEUE_DEPTH) {
+		(void)XCsuDma_QueueService(InstancePtr, Channel);
+		if (Queue->Count == XCSUDMA_QUEUE_DEPTH) {
+			return (s32)(XST_DEVICE_BUSY);
+		}
+	}
+
+	Entry = &Queue->Entry[(Queue->Head + Queue->Count) %
+					XCSUDMA_QUEUE_DEPTH];
+	Entry->Addr = Addr;
+	Entry->Size = Size;
+	Entry->EnDataLast = EnDataLast;
+	Entry->Handler = Handler;
+	Entry->CallBackRef = CallBackRef;
+	Queue->Count += 1U;
+
+	(void)XCsuDma_QueueService(InstancePtr, Channel);
+
+	return (s32)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retires the completed commands of both channels, programs
+* the next queued ones and calls the completion callbacks. The DST channel
+* is serviced first so that its command is ready before the SRC channel
+* feeds the SSS.
+*
+* @param	InstancePtr is a pointer to XCsuDma instance to be worked on.
+*
+* @return	Number of commands that completed.
+*
+* @note		Callbacks may queue new commands.
+*
+******************************************************************************/
+u32 XCsuDma_QueuePoll(XCsuDma *InstancePtr)
+{
+	u32 Done;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+					(u32)(XIL_COMPONENT_IS_READY));
+
+	Done = XCsuDma_QueueService(InstancePtr, XCSUDMA_DST_CHANNEL);
+	Done += XCsuDma_QueueService(InstancePtr, XCSUDMA_SRC_CHANNEL);
+
+	return Done;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function polls the transfer queues until a channel has no more than
+* MaxPending commands outstanding.
+*
+* @param	InstancePtr is a pointer to XCsuDma instance to be worked on.
+* @param	Channel represents the type of channel either it is Source or
+*		Destination.
+*		Source channel      - XCSUDMA_SRC_CHANNEL
+*		Destination Channel - XCSUDMA_DST_CHANNEL
+* @param	MaxPending is the number of commands that may remain, 0 waits
+*		for the channel to drain.
+*
+* @return	None.
+*
+* @note		The other channel is serviced as well while waiting.
+*
+******************************************************************************/
+void XCsuDma_QueueWait(XCsuDma *InstancePtr, XCsuDma_Channel Channel,
+			u32 MaxPending)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid((Channel == (XCSUDMA_SRC_CHANNEL)) ||
+					(Channel == (XCSUDMA_DST_CHANNEL)));
+	Xil_AssertVoid(InstancePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+
+	while (InstancePtr->Queue[Channel].Count > MaxPending) {
+		(void)XCsuDma_QueuePoll(InstancePtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the transfer queue. It should be
+* connected to the CSU_DMA interrupt with the DONE interrupt of the used
+* channels enabled through XCsuDma_EnableIntr().
+*
+* @param	CallBackRef is a pointer to the XCsuDma instance.
+*
+* @return	None.
+*
+* @note		When the queue is driven by this handler, commands queued
+*		from outside the callbacks must be queued with the CSU_DMA
+*		interrupt disabled.
+*
+******************************************************************************/
+void XCsuDma_QueueIntrHandler(void *CallBackRef)
+{
+	Xil_AssertVoid(CallBackRef != NULL);
+
+	(void)XCsuDma_QueuePoll((XCsuDma *)CallBackRef);
+}
+
+/*****************************************************************************/
+/**
+*
+* Program the oldest command of a channel queue. A stale DONE status is
+* acknowledged first so that only the completion of this command is seen.
+*
+******************************************************************************/
+static void XCsuDma_QueueIssue(XCsuDma *InstancePtr, XCsuDma_Channel Channel)
+{
+	XCsuDma_Queue *Queue = &InstancePtr->Queue[Channel];
+	XCsuDma_QueueEntry *Entry = &Queue->Entry[Queue->Head];
+
+	XCsuDma_IntrClear(InstancePtr, Channel, XCSUDMA_IXR_DONE_MASK);
+	Queue->Issued = 1U;
+	XCsuDma_Transfer(InstancePtr, Channel, Entry->Addr, Entry->Size,
+					Entry->EnDataLast);
+}
+
+/*****************************************************************************/
+/**
+*
+* Retire the programmed command of a channel if it has completed and keep
+* the channel busy with the next one. Returns 1 if a command completed.
+*
+******************************************************************************/
+static u32 XCsuDma_QueueService(XCsuDma *InstancePtr,
+				XCsuDma_Channel Channel)
+{
+	XCsuDma_Queue *Queue = &InstancePtr->Queue[Channel];
+	XCsuDma_QueueEntry Entry;
+	u32 Done = 0U;
+
+	if ((Queue->Issued != 0U) &&
+	    ((XCsuDma_IntrGetStatus(InstancePtr, Channel) &
+			(u32)(XCSUDMA_IXR_DONE_MASK)) != 0U)) {
+		XCsuDma_IntrClear(InstancePtr, Channel, XCSUDMA_IXR_DONE_MASK);
+
+		/* The callback may queue into the slot being freed */
+		Entry = Queue->Entry[Queue->Head];
+		Queue->Head = (Queue->Head + 1U) % XCSUDMA_QUEUE_DEPTH;
+		Queue->Count -= 1U;
+		Queue->Issued = 0U;
+
+		if (Queue->Count != 0U) {
+			XCsuDma_QueueIssue(InstancePtr, Channel);
+		}
+
+		if (Entry.Handler != NULL) {
+			Entry.Handler(Entry.CallBackRef, Channel, Entry.Addr,
+					Entry.Size);
+		}
+		Done = 1U;
+	}
+
+	if ((Queue->Issued == 0U) && (Queue->Count != 0U)) {
+		XCsuDma_QueueIssue(InstancePtr, Channel);
+	}
+
+	return Done;
+}
+/** @} */
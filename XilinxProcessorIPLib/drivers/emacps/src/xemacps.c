@@ -54,6 +54,9 @@
 * 3.1  hk   08/10/15 Update upper 32 bit tx and rx queue ptr registers
 * 3.5  hk   08/14/17 Update cache coherency information of the interface in
 *                    its config structure.
+* 3.7  ag   10/16/26 Program RX Q1 base in XEmacPs_SetQueuePtr and clear the
+*                    screening registers on reset.
+*      ag   10/16/26 Enable the RX Q1 interrupt only when a RX Q1 ring is set.
 *
 * </pre>
 ******************************************************************************/
@@ -206,9 +209,15 @@ void XEmacPs_Start(XEmacPs *InstancePtr)
 	XEMACPS_IXR_RX_ERR_MASK | (u32)XEMACPS_IXR_FRAMERX_MASK |
 	(u32)XEMACPS_IXR_TXCOMPL_MASK));
 
-	/* Enable TX Q1 Interrupts */
-	if (InstancePtr->Version > 2)
-		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_ALL_MASK);
+	/* Enable TX Q1 Interrupts, and RX Q1 ones if a RX Q1 ring is set */
+	if (InstancePtr->Version > 2) {
+		Reg = (u32)XEMACPS_INTQ1SR_TXCOMPL_MASK |
+			(u32)XEMACPS_INTQ1SR_TXERR_MASK;
+		if (InstancePtr->RxQ1Ready != 0U) {
+			Reg |= (u32)XEMACPS_INTQ1SR_RXCOMPL_MASK;
+		}
+		XEmacPs_IntQ1Enable(InstancePtr, Reg);
+	}
 
 	/* Mark as started */
 	InstancePtr->IsStarted = XIL_COMPONENT_IS_STARTED;
@@ -310,6 +319,7 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 	/* Stop the device and reset hardware */
 	XEmacPs_Stop(InstancePtr);
 	InstancePtr->Options = XEMACPS_DEFAULT_OPTIONS;
+	InstancePtr->RxQ1Ready = 0U;
 
 	InstancePtr->Version = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress, 0xFC);
 
@@ -393,6 +403,16 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 		(void)XEmacPs_SetTypeIdCheck(InstancePtr, 0x00000000U, i);
 	}
 
+	/* Route all received frames to queue 0 */
+	if (InstancePtr->Version > 2) {
+		for (i = 0U; i < (u8)XEMACPS_MAX_SCREENERS; i++) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREEN_T1_OFFSET + ((u32)i * (u32)4), 0x0U);
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREEN_T2_OFFSET + ((u32)i * (u32)4), 0x0U);
+		}
+	}
+
 	/* clear all counters */
 	for (i = 0U; i < (u8)((XEMACPS_LAST_OFFSET - XEMACPS_OCTTXL_OFFSET) / 4U);
 	     i++) {
@@ -471,9 +491,16 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 		}
 	}
 	 else {
-		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
-			XEMACPS_TXQ1BASE_OFFSET,
-			(QPtr & ULONG64_LO_MASK));
+		if (Direction == XEMACPS_SEND) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_TXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+			InstancePtr->RxQ1Ready = 1U;
+		}
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
@@ -330,6 +330,15 @@
  * 3.6   rb   09/08/17 HwCnt variable (in XEmacPs_BdRing structure) is
  *		       changed to volatile.
  *		       Add API XEmacPs_BdRingPtrReset() to reset pointers
+ * 3.7   ag   10/16/26 Added XEmacPs_SetScreener() to route received frames
+ *                     to the priority queue and XEmacPs_SetQ1RxBufSize().
+ *                     XEmacPs_SetQueuePtr() programs the RX Q1 base for
+ *                     queue 1 receive rings. RX Q1 frame received
+ *                     interrupts call the receive handler and are only
+ *                     enabled once a RX Q1 ring is set.
+ *       ag   10/16/26 Added XIL_TRACE_ID_EMACPS_* trace points for the
+ *                     interrupt status and BDs given to and returned by
+ *                     hardware.
  *
  * </pre>
  *
@@ -522,6 +531,33 @@ typedef void (*XEmacPs_ErrHandler) (void *CallBackRef, u8 Direction,
 
 /*@}*/
 
+/** @name Screener match flags
+ *
+ * Match flags for XEmacPs_Screener. EtherType and VLAN priority matches
+ * are done by a type 2 screener, the UDP destination port match by a
+ * type 1 screener. A single screener entry can therefore match on UDP
+ * port or on EtherType/VLAN priority, but not on both.
+ * @{
+ */
+#define XEMACPS_SCREEN_MATCH_ETHTYPE	0x01U /**< Match EtherType */
+#define XEMACPS_SCREEN_MATCH_VLANPRI	0x02U /**< Match VLAN priority */
+#define XEMACPS_SCREEN_MATCH_UDPPORT	0x04U /**< Match UDP destination
+						port */
+/*@}*/
+
+/**
+ * This typedef describes one receive screener entry, routing matching
+ * frames to a priority queue.
+ */
+typedef struct {
+	u8 QueueNum;		/**< Queue matching frames are routed to */
+	u8 MatchFlags;		/**< XEMACPS_SCREEN_MATCH_* flags, 0 disables
+				     the entry */
+	u8 VlanPriority;	/**< VLAN priority (PCP) to match, 0 - 7 */
+	u16 EtherType;		/**< EtherType to match */
+	u16 UdpPort;		/**< UDP destination port to match */
+} XEmacPs_Screener;
+
 /**
  * This typedef contains configuration information for a device.
  */
@@ -559,6 +595,7 @@ typedef struct XEmacPs_Instance {
 	u32 MaxMtuSize;
 	u32 MaxFrameSize;
 	u32 MaxVlanFrameSize;
+	u32 RxQ1Ready;		/* RX Q1 ring base is programmed */
 
 } XEmacPs;
 
@@ -801,6 +838,12 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
 
+LONG XEmacPs_SetScreener(XEmacPs *InstancePtr, u8 Index,
+			 XEmacPs_Screener *ScreenerPtr);
+void XEmacPs_SetQ1RxBufSize(XEmacPs *InstancePtr, u32 BufSize);
+LONG XEmacPs_SetIntrModeration(XEmacPs *InstancePtr, u8 RxDelay, u8 TxDelay);
+u32 XEmacPs_IsLsoCapable(XEmacPs *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,6 +69,8 @@
  *                     Disable extended mode. Perform all 64 bit changes under
  *                     check for arch64.
  * 3.2   hk   11/18/15 Change BD typedef and number of words.
+ * 3.7   ag   10/16/26 Added XEmacPs_BdGetRxCsumStatus.
+ * 3.7   ag   10/16/26 Added XEmacPs_BdSetTso and XEmacPs_BdSetMss.
  *
  * </pre>
  *
@@ -794,6 +796,73 @@ typedef u32 XEmacPs_Bd[XEMACPS_BD_NUM_WORDS];
     XEMACPS_RXBUF_SOF_MASK)!=0U ? TRUE : FALSE)
 
 
+/*****************************************************************************/
+/**
+ * Get the checksum offload status of a received frame. It is only valid
+ * when RX checksum offload is enabled. Frames with a bad IP, TCP or UDP
+ * checksum are dropped by the hardware in that mode, so the status tells
+ * which checksums were checked and found to be correct.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @return One of XEMACPS_RXBUF_CSUM_NONE, XEMACPS_RXBUF_CSUM_IP,
+ *         XEMACPS_RXBUF_CSUM_IP_TCP or XEMACPS_RXBUF_CSUM_IP_UDP.
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdGetRxCsumStatus(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdGetRxCsumStatus(BdPtr)                           \
+    (XEmacPs_BdRead((BdPtr), XEMACPS_BD_STAT_OFFSET) &            \
+    XEMACPS_RXBUF_CSUM_MASK)
+
+
+/*****************************************************************************/
+/**
+ * Set the large send offload mode of a transmit frame. The BD must be the
+ * first BD of the frame and hold only the Ethernet, IP and TCP or UDP
+ * headers. The header checksums are generated by the GEM, so TX checksum
+ * offload must be enabled.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ * @param  Mode is XEMACPS_LSO_NONE, XEMACPS_LSO_UFO or XEMACPS_LSO_TSO
+ *
+ * @note
+ * C-style signature:
+ *    void XEmacPs_BdSetTso(XEmacPs_Bd* BdPtr, u32 Mode)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdSetTso(BdPtr, Mode)                              \
+    (XEmacPs_BdWrite((BdPtr), XEMACPS_BD_STAT_OFFSET,             \
+    (XEmacPs_BdRead((BdPtr), XEMACPS_BD_STAT_OFFSET) &            \
+    ~(XEMACPS_TXBUF_LSO_MASK | XEMACPS_TXBUF_TCPSEQSRC_MASK)) |   \
+    (((u32)(Mode) << XEMACPS_TXBUF_LSO_SHIFT) &                   \
+    XEMACPS_TXBUF_LSO_MASK)))
+
+
+/*****************************************************************************/
+/**
+ * Set the maximum segment size (TSO) or maximum fragment size (UFO) of a
+ * large send. The BD must be the second BD of the frame, the first BD of
+ * its payload.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ * @param  Mss is the segment payload size in bytes
+ *
+ * @note
+ * C-style signature:
+ *    void XEmacPs_BdSetMss(XEmacPs_Bd* BdPtr, u32 Mss)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdSetMss(BdPtr, Mss)                               \
+    (XEmacPs_BdWrite((BdPtr), XEMACPS_BD_STAT_OFFSET,             \
+    (XEmacPs_BdRead((BdPtr), XEMACPS_BD_STAT_OFFSET) &            \
+    ~XEMACPS_TXBUF_MSS_MASK) |                                    \
+    (((u32)(Mss) << XEMACPS_TXBUF_MSS_SHIFT) &                    \
+    XEMACPS_TXBUF_MSS_MASK)))
+
+
 /************************** Function Prototypes ******************************/
 
 #ifdef __cplusplus
@@ -59,6 +59,10 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.6   rb   09/08/17 Add XEmacPs_BdRingPtrReset() API to reset BD ring
 * 		      pointers
+* 3.7   ag   10/16/26 Alloc, UnAlloc, ToHw, FromHw and Free are done by the
+*		      common BD ring engine, which also keeps ring statistics.
+*		      The TX and RX BD layouts are described to it by
+*		      XEmacPs_TxBdOps and XEmacPs_RxBdOps.
 *
 * </pre>
 ******************************************************************************/
@@ -70,6 +74,7 @@
 #include "xemacps_hw.h"
 #include "xemacps_bd.h"
 #include "xemacps_bdring.h"
+#include "xil_trace.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -102,70 +107,31 @@
 #define XEMACPS_VIRT_TO_PHYS(BdPtr) \
     ((UINTPTR)(BdPtr) - (RingPtr->BaseBdAddr - RingPtr->PhysBaseAddr))
 
-/****************************************************************************
- * Move the BdPtr argument ahead an arbitrary number of BDs wrapping around
- * to the beginning of the ring if needed.
- *
- * We know if a wrapaound should occur if the new BdPtr is greater than
- * the high address in the ring OR if the new BdPtr crosses over the
- * 0xFFFFFFFF to 0 boundary. The latter test is a valid one since we do not
- * allow a BD space to span this boundary.
- *
- * @param RingPtr is the ring BdPtr appears in
- * @param BdPtr on input is the starting BD position and on output is the
- *        final BD position
- * @param NumBd is the number of BD spaces to increment
- *
- ****************************************************************************/
-#define XEMACPS_RING_SEEKAHEAD(RingPtr, BdPtr, NumBd)                  \
-    {                                                                   \
-        UINTPTR Addr = (UINTPTR)(void *)(BdPtr);                        \
-                                                                        \
-        Addr += ((RingPtr)->Separation * (NumBd));                        \
-        if ((Addr > (RingPtr)->HighBdAddr) || ((UINTPTR)(void *)(BdPtr) > Addr))  \
-        {                                                               \
-            Addr -= (RingPtr)->Length;                                  \
-        }                                                               \
-                                                                        \
-        (BdPtr) = (XEmacPs_Bd*)(void *)Addr;                                     \
-    }
-
-/****************************************************************************
- * Move the BdPtr argument backwards an arbitrary number of BDs wrapping
- * around to the end of the ring if needed.
- *
- * We know if a wrapaound should occur if the new BdPtr is less than
- * the base address in the ring OR if the new BdPtr crosses over the
- * 0xFFFFFFFF to 0 boundary. The latter test is a valid one since we do not
- * allow a BD space to span this boundary.
- *
- * @param RingPtr is the ring BdPtr appears in
- * @param BdPtr on input is the starting BD position and on output is the
- *        final BD position
- * @param NumBd is the number of BD spaces to increment
- *
- ****************************************************************************/
-#define XEMACPS_RING_SEEKBACK(RingPtr, BdPtr, NumBd)                   \
-    {                                                                   \
-        UINTPTR Addr = (UINTPTR)(void *)(BdPtr);                                  \
-                                                                        \
-        Addr -= ((RingPtr)->Separation * (NumBd));                        \
-        if ((Addr < (RingPtr)->BaseBdAddr) || ((UINTPTR)(void*)(BdPtr) < Addr))  \
-        {                                                               \
-            Addr += (RingPtr)->Length;                                  \
-        }                                                               \
-                                                                        \
-        (BdPtr) = (XEmacPs_Bd*)(void*)Addr;                                     \
-    }
-
 
 /************************** Function Prototypes ******************************/
 
 static void XEmacPs_BdSetRxWrap(UINTPTR BdPtr);
 static void XEmacPs_BdSetTxWrap(UINTPTR BdPtr);
+static u32 XEmacPs_TxBdStatus(void *Owner, UINTPTR BdPtr);
+static u32 XEmacPs_RxBdStatus(void *Owner, UINTPTR BdPtr);
 
 /************************** Variable Definitions *****************************/
 
+/*
+ * BD layouts for the common BD ring engine. The GEM sets the used bit only in
+ * the first TX BD of a frame once it is sent, and the new bit in each RX BD
+ * it fills. BDs are kept in uncached memory, so no cache maintenance is done.
+ */
+static const XBdRing_Ops XEmacPs_TxBdOps = {
+	XEmacPs_TxBdStatus,
+	NULL
+};
+
+static const XBdRing_Ops XEmacPs_RxBdOps = {
+	XEmacPs_RxBdStatus,
+	NULL
+};
+
 /*****************************************************************************/
 /**
  * Using a memory segment allocated by the caller, create and setup the BD list
@@ -207,15 +173,15 @@ LONG XEmacPs_BdRingCreate(XEmacPs_BdRing * RingPtr, UINTPTR PhysAddr,
 	UINTPTR BdPhyAddr;
 	UINTPTR VirtAddrLoc = VirtAddr;
 
+	LONG Status;
+
 	/* In case there is a failure prior to creating list, make sure the
 	 * following attributes are 0 to prevent calls to other functions
 	 * from doing anything.
 	 */
 	RingPtr->AllCnt = 0U;
-	RingPtr->FreeCnt = 0U;
-	RingPtr->HwCnt = 0U;
-	RingPtr->PreCnt = 0U;
-	RingPtr->PostCnt = 0U;
+	RingPtr->Core.AllCnt = 0U;
+	XBdRing_Reset(&RingPtr->Core);
 
 	/* Make sure Alignment parameter meets minimum requirements */
 	if (Alignment < (u32)XEMACPS_DMABD_MINIMUM_ALIGNMENT) {
@@ -240,11 +206,16 @@ LONG XEmacPs_BdRingCreate(XEmacPs_BdRing * RingPtr, UINTPTR PhysAddr,
 	/* Figure out how many bytes will be between the start of adjacent BDs */
 	RingPtr->Separation = ((u32)sizeof(XEmacPs_Bd));
 
-	/* Must make sure the ring doesn't span address 0x00000000. If it does,
-	 * then the next/prev BD traversal macros will fail.
+	/* The engine makes sure the ring doesn't span address 0x00000000. If it
+	 * does, then the next/prev BD traversal macros will fail. The layout is
+	 * set by XEmacPs_BdRingClone() once the direction is known.
 	 */
-	if (VirtAddrLoc > ((VirtAddrLoc + (RingPtr->Separation * BdCount)) - (u32)1)) {
-		return (LONG)(XST_DMA_SG_LIST_ERROR);
+	Status = (LONG)XBdRing_Create(&RingPtr->Core, VirtAddrLoc,
+				      RingPtr->Separation, BdCount,
+				      &XEmacPs_RxBdOps, RingPtr,
+				      XBDRING_FLAG_NOCACHE);
+	if (Status != (LONG)XST_SUCCESS) {
+		return Status;
 	}
 
 	/* Initial ring setup:
@@ -268,12 +239,6 @@ LONG XEmacPs_BdRingCreate(XEmacPs_BdRing * RingPtr, UINTPTR PhysAddr,
 	RingPtr->Length =
 		((RingPtr->HighBdAddr - RingPtr->BaseBdAddr) + RingPtr->Separation);
 	RingPtr->AllCnt = (u32)BdCount;
-	RingPtr->FreeCnt = (u32)BdCount;
-	RingPtr->FreeHead = (XEmacPs_Bd *)(void *)VirtAddrLoc;
-	RingPtr->PreHead = (XEmacPs_Bd *)VirtAddrLoc;
-	RingPtr->HwHead = (XEmacPs_Bd *)VirtAddrLoc;
-	RingPtr->HwTail = (XEmacPs_Bd *)VirtAddrLoc;
-	RingPtr->PostHead = (XEmacPs_Bd *)VirtAddrLoc;
 	RingPtr->BdaRestart = (XEmacPs_Bd *)(void *)PhysAddr;
 
 	return (LONG)(XST_SUCCESS);
@@ -321,7 +286,7 @@ LONG XEmacPs_BdRingClone(XEmacPs_BdRing * RingPtr, XEmacPs_Bd * SrcBdPtr,
 	}
 
 	/* Can't do this function with some of the BDs in use */
-	if (RingPtr->FreeCnt != RingPtr->AllCnt) {
+	if (XBdRing_GetFreeCnt(&RingPtr->Core) != RingPtr->AllCnt) {
 		return (LONG)(XST_DMA_SG_LIST_ERROR);
 	}
 
@@ -342,9 +307,14 @@ LONG XEmacPs_BdRingClone(XEmacPs_BdRing * RingPtr, XEmacPs_Bd * SrcBdPtr,
 
 	if (Direction == XEMACPS_RECV) {
 		XEmacPs_BdSetRxWrap(CurBd);
+		RingPtr->Core.Ops = &XEmacPs_RxBdOps;
+		RingPtr->Core.Flags = XBDRING_FLAG_NOCACHE;
 	}
 	else {
 		XEmacPs_BdSetTxWrap(CurBd);
+		RingPtr->Core.Ops = &XEmacPs_TxBdOps;
+		RingPtr->Core.Flags = XBDRING_FLAG_NOCACHE |
+				      XBDRING_FLAG_DONE_FIRST;
 	}
 
 	return (LONG)(XST_SUCCESS);
@@ -427,16 +397,11 @@ LONG XEmacPs_BdRingAlloc(XEmacPs_BdRing * RingPtr, u32 NumBd,
 			 XEmacPs_Bd ** BdSetPtr)
 {
 	LONG Status;
-	/* Enough free BDs available for the request? */
-	if (RingPtr->FreeCnt < NumBd) {
-		Status = (LONG)(XST_FAILURE);
-	} else {
-	/* Set the return argument and move FreeHead forward */
-	*BdSetPtr = RingPtr->FreeHead;
-	XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->FreeHead, NumBd);
-	RingPtr->FreeCnt -= NumBd;
-	RingPtr->PreCnt += NumBd;
-		Status = (LONG)(XST_SUCCESS);
+	UINTPTR BdSet;
+
+	Status = (LONG)XBdRing_Alloc(&RingPtr->Core, NumBd, &BdSet);
+	if (Status == (LONG)XST_SUCCESS) {
+		*BdSetPtr = (XEmacPs_Bd *)(void *)BdSet;
 	}
 	return Status;
 }
@@ -506,22 +471,11 @@ LONG XEmacPs_BdRingAlloc(XEmacPs_BdRing * RingPtr, u32 NumBd,
 LONG XEmacPs_BdRingUnAlloc(XEmacPs_BdRing * RingPtr, u32 NumBd,
 			   XEmacPs_Bd * BdSetPtr)
 {
-	LONG Status;
-	(void) BdSetPtr;
 	Xil_AssertNonvoid(RingPtr != NULL);
 	Xil_AssertNonvoid(BdSetPtr != NULL);
 
-	/* Enough BDs in the free state for the request? */
-	if (RingPtr->PreCnt < NumBd) {
-		Status = (LONG)(XST_FAILURE);
-	} else {
-	/* Set the return argument and move FreeHead backward */
-		XEMACPS_RING_SEEKBACK(RingPtr, (RingPtr->FreeHead), NumBd);
-	RingPtr->FreeCnt += NumBd;
-	RingPtr->PreCnt -= NumBd;
-		Status = (LONG)(XST_SUCCESS);
-	}
-	return Status;
+	return (LONG)XBdRing_UnAlloc(&RingPtr->Core, NumBd,
+				     (UINTPTR)(void *)BdSetPtr);
 }
 
 
@@ -554,31 +508,9 @@ LONG XEmacPs_BdRingUnAlloc(XEmacPs_BdRing * RingPtr, u32 NumBd,
 LONG XEmacPs_BdRingToHw(XEmacPs_BdRing * RingPtr, u32 NumBd,
 			XEmacPs_Bd * BdSetPtr)
 {
-	XEmacPs_Bd *CurBdPtr;
-	u32 i;
-	LONG Status;
-	/* if no bds to process, simply return. */
-	if (0U == NumBd){
-		Status = (LONG)(XST_SUCCESS);
-	} else {
-	/* Make sure we are in sync with XEmacPs_BdRingAlloc() */
-	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr)) {
-			Status = (LONG)(XST_DMA_SG_LIST_ERROR);
-		} else {
-	CurBdPtr = BdSetPtr;
-			for (i = 0U; i < NumBd; i++) {
-				CurBdPtr = (XEmacPs_Bd *)((void *)XEmacPs_BdRingNext(RingPtr, CurBdPtr));
-	}
-	/* Adjust ring pointers & counters */
-	XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
-	RingPtr->PreCnt -= NumBd;
-	RingPtr->HwTail = CurBdPtr;
-	RingPtr->HwCnt += NumBd;
-
-			Status = (LONG)(XST_SUCCESS);
-		}
-	}
-	return Status;
+	XIL_TRACE_INSTANT(XIL_TRACE_ID_EMACPS_TOHW, NumBd);
+	return (LONG)XBdRing_ToHw(&RingPtr->Core, NumBd,
+				  (UINTPTR)(void *)BdSetPtr);
 }
 
 
@@ -651,77 +583,15 @@ LONG XEmacPs_BdRingToHw(XEmacPs_BdRing * RingPtr, u32 NumBd,
 u32 XEmacPs_BdRingFromHwTx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 				 XEmacPs_Bd ** BdSetPtr)
 {
-	XEmacPs_Bd *CurBdPtr;
-	u32 BdStr = 0U;
+	UINTPTR BdSet;
 	u32 BdCount;
-	u32 BdPartialCount;
-	u32 Sop = 0U;
-	u32 Status;
-	u32 BdLimitLoc = BdLimit;
-	CurBdPtr = RingPtr->HwHead;
-	BdCount = 0U;
-	BdPartialCount = 0U;
-
-	/* If no BDs in work group, then there's nothing to search */
-	if (RingPtr->HwCnt == 0x00000000U) {
-		*BdSetPtr = NULL;
-		Status = 0U;
-	} else {
-
-		if (BdLimitLoc > RingPtr->HwCnt){
-			BdLimitLoc = RingPtr->HwCnt;
-	}
-	/* Starting at HwHead, keep moving forward in the list until:
-	 *  - A BD is encountered with its new/used bit set which means
-	 *    hardware has not completed processing of that BD.
-	 *  - RingPtr->HwTail is reached and RingPtr->HwCnt is reached.
-	 *  - The number of requested BDs has been processed
-	 */
-		while (BdCount < BdLimitLoc) {
-		/* Read the status */
-			if(CurBdPtr != NULL){
-		BdStr = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_STAT_OFFSET);
-			}
-
-			if ((Sop == 0x00000000U) && ((BdStr & XEMACPS_TXBUF_USED_MASK)!=0x00000000U)){
-				Sop = 1U;
-			}
-			if (Sop == 0x00000001U) {
-			BdCount++;
-			BdPartialCount++;
-		}
 
-		/* hardware has processed this BD so check the "last" bit.
-		 * If it is clear, then there are more BDs for the current
-		 * packet. Keep a count of these partial packet BDs.
-		 */
-			if ((Sop == 0x00000001U) && ((BdStr & XEMACPS_TXBUF_LAST_MASK)!=0x00000000U)) {
-				Sop = 0U;
-				BdPartialCount = 0U;
-		}
-
-		/* Move on to next BD in work group */
-		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
-	}
-
-	/* Subtract off any partial packet BDs found */
-        BdCount -= BdPartialCount;
-
-	/* If BdCount is non-zero then BDs were found to return. Set return
-	 * parameters, update pointers and counters, return success
-	 */
-		if (BdCount > 0x00000000U) {
-		*BdSetPtr = RingPtr->HwHead;
-		RingPtr->HwCnt -= BdCount;
-		RingPtr->PostCnt += BdCount;
-		XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
-			Status = (BdCount);
-		} else {
-			*BdSetPtr = NULL;
-			Status = 0U;
+	BdCount = XBdRing_FromHw(&RingPtr->Core, BdLimit, &BdSet);
+	*BdSetPtr = (XEmacPs_Bd *)(void *)BdSet;
+	if (BdCount != 0U) {
+		XIL_TRACE_INSTANT(XIL_TRACE_ID_EMACPS_FROMHW_TX, BdCount);
 	}
-	}
-	return Status;
+	return BdCount;
 }
 
 
@@ -795,73 +665,15 @@ u32 XEmacPs_BdRingFromHwTx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 u32 XEmacPs_BdRingFromHwRx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 				 XEmacPs_Bd ** BdSetPtr)
 {
-	XEmacPs_Bd *CurBdPtr;
-	u32 BdStr = 0U;
+	UINTPTR BdSet;
 	u32 BdCount;
-	u32 BdPartialCount;
-	u32 Status;
-
-	CurBdPtr = RingPtr->HwHead;
-	BdCount = 0U;
-	BdPartialCount = 0U;
-
-	/* If no BDs in work group, then there's nothing to search */
-	if (RingPtr->HwCnt == 0x00000000U) {
-		*BdSetPtr = NULL;
-		Status = 0U;
-	} else {
-
-	/* Starting at HwHead, keep moving forward in the list until:
-	 *  - A BD is encountered with its new/used bit set which means
-	 *    hardware has completed processing of that BD.
-	 *  - RingPtr->HwTail is reached and RingPtr->HwCnt is reached.
-	 *  - The number of requested BDs has been processed
-	 */
-	while (BdCount < BdLimit) {
-
-		/* Read the status */
-			if(CurBdPtr!=NULL){
-		BdStr = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_STAT_OFFSET);
-			}
-			if ((!(XEmacPs_BdIsRxNew(CurBdPtr)))==TRUE) {
-			break;
-		}
-
-		BdCount++;
-
-		/* hardware has processed this BD so check the "last" bit. If
-                 * it is clear, then there are more BDs for the current packet.
-                 * Keep a count of these partial packet BDs.
-		 */
-			if ((BdStr & XEMACPS_RXBUF_EOF_MASK)!=0x00000000U) {
-				BdPartialCount = 0U;
-			} else {
-			BdPartialCount++;
-		}
-
-		/* Move on to next BD in work group */
-		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
-	}
 
-	/* Subtract off any partial packet BDs found */
-	BdCount -= BdPartialCount;
-
-	/* If BdCount is non-zero then BDs were found to return. Set return
-	 * parameters, update pointers and counters, return success
-	 */
-		if (BdCount > 0x00000000U) {
-		*BdSetPtr = RingPtr->HwHead;
-		RingPtr->HwCnt -= BdCount;
-		RingPtr->PostCnt += BdCount;
-		XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
-			Status = (BdCount);
-	}
-	else {
-		*BdSetPtr = NULL;
-			Status = 0U;
+	BdCount = XBdRing_FromHw(&RingPtr->Core, BdLimit, &BdSet);
+	*BdSetPtr = (XEmacPs_Bd *)(void *)BdSet;
+	if (BdCount != 0U) {
+		XIL_TRACE_INSTANT(XIL_TRACE_ID_EMACPS_FROMHW_RX, BdCount);
 	}
-}
-	return Status;
+	return BdCount;
 }
 
 
@@ -888,23 +700,8 @@ u32 XEmacPs_BdRingFromHwRx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 LONG XEmacPs_BdRingFree(XEmacPs_BdRing * RingPtr, u32 NumBd,
 			XEmacPs_Bd * BdSetPtr)
 {
-	LONG Status;
-	/* if no bds to process, simply return. */
-	if (0x00000000U == NumBd){
-		Status = (LONG)(XST_SUCCESS);
-	} else {
-	/* Make sure we are in sync with XEmacPs_BdRingFromHw() */
-	if ((RingPtr->PostCnt < NumBd) || (RingPtr->PostHead != BdSetPtr)) {
-			Status = (LONG)(XST_DMA_SG_LIST_ERROR);
-		} else {
-	/* Update pointers and counters */
-	RingPtr->FreeCnt += NumBd;
-	RingPtr->PostCnt -= NumBd;
-	XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->PostHead, NumBd);
-			Status = (LONG)(XST_SUCCESS);
-		}
-	}
-	return Status;
+	return (LONG)XBdRing_Free(&RingPtr->Core, NumBd,
+				  (UINTPTR)(void *)BdSetPtr);
 }
 
 
@@ -960,35 +757,21 @@ LONG XEmacPs_BdRingCheck(XEmacPs_BdRing * RingPtr, u8 Direction)
 		return (LONG)(XST_DMA_SG_LIST_ERROR);
 	}
 
-	/* Verify internal pointers point to correct memory space */
-	AddrV = (UINTPTR) RingPtr->FreeHead;
-	if ((AddrV < RingPtr->BaseBdAddr) || (AddrV > RingPtr->HighBdAddr)) {
-		return (LONG)(XST_DMA_SG_LIST_ERROR);
-	}
-
-	AddrV = (UINTPTR) RingPtr->PreHead;
-	if ((AddrV < RingPtr->BaseBdAddr) || (AddrV > RingPtr->HighBdAddr)) {
-		return (LONG)(XST_DMA_SG_LIST_ERROR);
-	}
-
-	AddrV = (UINTPTR) RingPtr->HwHead;
-	if ((AddrV < RingPtr->BaseBdAddr) || (AddrV > RingPtr->HighBdAddr)) {
-		return (LONG)(XST_DMA_SG_LIST_ERROR);
-	}
-
-	AddrV = (UINTPTR) RingPtr->HwTail;
-	if ((AddrV < RingPtr->BaseBdAddr) || (AddrV > RingPtr->HighBdAddr)) {
-		return (LONG)(XST_DMA_SG_LIST_ERROR);
-	}
-
-	AddrV = (UINTPTR) RingPtr->PostHead;
-	if ((AddrV < RingPtr->BaseBdAddr) || (AddrV > RingPtr->HighBdAddr)) {
+	/* Verify internal indexes point to BDs in the ring */
+	if ((RingPtr->Core.FreeIdx >= RingPtr->AllCnt) ||
+	    (RingPtr->Core.PreIdx >= RingPtr->AllCnt) ||
+	    (RingPtr->Core.HwIdx >= RingPtr->AllCnt) ||
+	    (RingPtr->Core.HwTailIdx >= RingPtr->AllCnt) ||
+	    (RingPtr->Core.PostIdx >= RingPtr->AllCnt)) {
 		return (LONG)(XST_DMA_SG_LIST_ERROR);
 	}
 
 	/* Verify internal counters add up */
-	if ((RingPtr->HwCnt + RingPtr->PreCnt + RingPtr->FreeCnt +
-	     RingPtr->PostCnt) != RingPtr->AllCnt) {
+	if ((XBdRing_GetFreeCnt(&RingPtr->Core) > RingPtr->AllCnt) ||
+	    ((XBdRing_GetHwCnt(&RingPtr->Core) +
+	      XBdRing_GetPreCnt(&RingPtr->Core) +
+	      XBdRing_GetFreeCnt(&RingPtr->Core) +
+	      XBdRing_GetPostCnt(&RingPtr->Core)) != RingPtr->AllCnt)) {
 		return (LONG)(XST_DMA_SG_LIST_ERROR);
 	}
 
@@ -1077,10 +860,13 @@ static void XEmacPs_BdSetTxWrap(UINTPTR BdPtr)
 
 /*****************************************************************************/
 /**
- * Reset BD ring head and tail pointers.
+ * Reset BD ring head and tail pointers to the first BD of the ring. The
+ * number of BDs in each group is kept, so the BDs given to hardware, such as
+ * those of a full RX ring, stay with hardware.
  *
  * @param RingPtr is the instance to be worked on.
- * @param VirtAddr is the virtual base address of the user memory region.
+ * @param VirtAddr is the virtual base address of the user memory region,
+ *        which must be the one the ring was created with.
  *
  * @note
  * Should be called after XEmacPs_Stop()
@@ -1092,11 +878,64 @@ static void XEmacPs_BdSetTxWrap(UINTPTR BdPtr)
  *****************************************************************************/
 void XEmacPs_BdRingPtrReset(XEmacPs_BdRing * RingPtr, void *virtaddrloc)
 {
-	RingPtr->FreeHead = virtaddrloc;
-	RingPtr->PreHead = virtaddrloc;
-	RingPtr->HwHead = virtaddrloc;
-	RingPtr->HwTail = virtaddrloc;
-	RingPtr->PostHead = virtaddrloc;
+	Xil_AssertVoid((UINTPTR)virtaddrloc == RingPtr->BaseBdAddr);
+
+	XBdRing_Rewind(&RingPtr->Core);
+}
+
+/*****************************************************************************/
+/**
+ * Report the state of a TX BD to the BD ring engine. The used bit, set by the
+ * GEM in the first BD of a frame once it is sent, marks the BD done.
+ *
+ * @param  Owner is the BD ring the BD is in.
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @return XBDRING_BD_DONE and XBDRING_BD_LAST as they apply to the BD.
+ *
+ *****************************************************************************/
+static u32 XEmacPs_TxBdStatus(void *Owner, UINTPTR BdPtr)
+{
+	u32 BdStr;
+	u32 Status = 0U;
+
+	(void)Owner;
+	BdStr = XEmacPs_BdRead(BdPtr, XEMACPS_BD_STAT_OFFSET);
+	if ((BdStr & XEMACPS_TXBUF_USED_MASK) != 0x00000000U) {
+		Status |= XBDRING_BD_DONE;
+	}
+	if ((BdStr & XEMACPS_TXBUF_LAST_MASK) != 0x00000000U) {
+		Status |= XBDRING_BD_LAST;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Report the state of an RX BD to the BD ring engine. The new bit, set by the
+ * GEM in each BD it fills, marks the BD done; the end of frame bit marks the
+ * last BD of a frame.
+ *
+ * @param  Owner is the BD ring the BD is in.
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @return XBDRING_BD_DONE and XBDRING_BD_LAST as they apply to the BD.
+ *
+ *****************************************************************************/
+static u32 XEmacPs_RxBdStatus(void *Owner, UINTPTR BdPtr)
+{
+	u32 Status = 0U;
+
+	(void)Owner;
+	if ((XEmacPs_BdRead(BdPtr, XEMACPS_BD_ADDR_OFFSET) &
+	     XEMACPS_RXBUF_NEW_MASK) != 0x00000000U) {
+		Status |= XBDRING_BD_DONE;
+	}
+	if ((XEmacPs_BdRead(BdPtr, XEMACPS_BD_STAT_OFFSET) &
+	     XEMACPS_RXBUF_EOF_MASK) != 0x00000000U) {
+		Status |= XBDRING_BD_LAST;
+	}
+	return Status;
 }
 
 /** @} */
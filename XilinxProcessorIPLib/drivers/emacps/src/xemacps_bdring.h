@@ -49,6 +49,10 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.6   rb   09/08/17 HwCnt variable (in XEmacPs_BdRing structure) is
 *		      changed to volatile.
+* 3.7   ag   10/16/26 The BD ring bookkeeping is done by the common BD ring
+*		      engine (xil_bdring.h). The group heads and counters of
+*		      XEmacPs_BdRing are replaced by an XBdRing, added
+*		      XEmacPs_BdRingGetHwCnt() and XEmacPs_BdRingGetStats().
 *
 * </pre>
 *
@@ -61,6 +65,9 @@
 extern "C" {
 #endif
 
+/***************************** Include Files *********************************/
+
+#include "xil_bdring.h"
 
 /**************************** Type Definitions *******************************/
 
@@ -73,21 +80,10 @@ typedef struct {
 	u32 RunState;	 /**< Flag to indicate DMA is started */
 	u32 Separation;	 /**< Number of bytes between the starting address
                                   of adjacent BDs */
-	XEmacPs_Bd *FreeHead;
-			     /**< First BD in the free group */
-	XEmacPs_Bd *PreHead;/**< First BD in the pre-work group */
-	XEmacPs_Bd *HwHead; /**< First BD in the work group */
-	XEmacPs_Bd *HwTail; /**< Last BD in the work group */
-	XEmacPs_Bd *PostHead;
-			     /**< First BD in the post-work group */
 	XEmacPs_Bd *BdaRestart;
 			     /**< BDA to load when channel is started */
-
-	volatile u32 HwCnt;    /**< Number of BDs in work group */
-	u32 PreCnt;     /**< Number of BDs in pre-work group */
-	u32 FreeCnt;    /**< Number of allocatable BDs in the free group */
-	u32 PostCnt;    /**< Number of BDs in post-work group */
 	u32 AllCnt;     /**< Total Number of BDs for channel */
+	XBdRing Core;	/**< BD groups, counters and statistics */
 } XEmacPs_BdRing;
 
 
@@ -165,7 +161,40 @@ typedef struct {
 *    u32 XEmacPs_BdRingGetFreeCnt(XEmacPs_BdRing* RingPtr)
 *
 *****************************************************************************/
-#define XEmacPs_BdRingGetFreeCnt(RingPtr)   ((RingPtr)->FreeCnt)
+#define XEmacPs_BdRingGetFreeCnt(RingPtr)   \
+	XBdRing_GetFreeCnt(&(RingPtr)->Core)
+
+/****************************************************************************/
+/**
+* Return the number of BDs given to hardware with XEmacPs_BdRingToHw() and
+* not yet returned by XEmacPs_BdRingFromHwTx() or XEmacPs_BdRingFromHwRx().
+*
+* @param  RingPtr is the DMA channel to operate on.
+*
+* @return The number of BDs owned by hardware.
+*
+* @note
+* C-style signature:
+*    u32 XEmacPs_BdRingGetHwCnt(XEmacPs_BdRing* RingPtr)
+*
+*****************************************************************************/
+#define XEmacPs_BdRingGetHwCnt(RingPtr)   XBdRing_GetHwCnt(&(RingPtr)->Core)
+
+/****************************************************************************/
+/**
+* Copy the statistics kept for the ring, see XBdRing_Stats.
+*
+* @param  RingPtr is the DMA channel to operate on.
+* @param  StatsPtr is the XBdRing_Stats to fill in.
+*
+* @note
+* C-style signature:
+*    void XEmacPs_BdRingGetStats(XEmacPs_BdRing* RingPtr,
+*                                XBdRing_Stats *StatsPtr)
+*
+*****************************************************************************/
+#define XEmacPs_BdRingGetStats(RingPtr, StatsPtr)   \
+	XBdRing_GetStats(&(RingPtr)->Core, (StatsPtr))
 
 /****************************************************************************/
 /**
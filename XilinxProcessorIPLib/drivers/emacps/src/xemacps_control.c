@@ -52,6 +52,10 @@
  * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
  * 3.0   hk   02/20/15 Added support for jumbo frames.
  * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+ * 3.7   ag   10/16/26 Added XEmacPs_SetScreener() and
+ *                     XEmacPs_SetQ1RxBufSize() for priority queue support.
+ * 3.7   ag   10/16/26 Added XEmacPs_SetIntrModeration().
+ * 3.7   ag   10/16/26 Added XEmacPs_IsLsoCapable().
  * </pre>
  *****************************************************************************/
 
@@ -1171,4 +1175,185 @@ void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength)
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_DMACR_OFFSET,
 																	Reg);
 }
+
+/*****************************************************************************/
+/**
+* Program a receive screener entry. Frames matching the entry are routed to
+* the receive queue given by ScreenerPtr->QueueNum instead of queue 0.
+*
+* EtherType and VLAN priority matches are programmed into the type 2
+* screening register at Index (using the type 2 EtherType register with the
+* same index), a UDP destination port match into the type 1 screening
+* register at Index. An entry with no match flags disables both registers
+* at Index.
+*
+* @param InstancePtr is a pointer to the XEmacPs instance to be worked on.
+* @param Index is the screener entry to program, 0 to
+*        XEMACPS_MAX_SCREENERS - 1.
+* @param ScreenerPtr is a pointer to the screener entry.
+*
+* @return
+* - XST_SUCCESS if the screener entry was programmed
+* - XST_NO_FEATURE if this GEM revision has no priority queues
+* - XST_INVALID_PARAM if the entry mixes a UDP port match with an
+*   EtherType/VLAN priority match
+*
+* @note
+* Screeners may be updated while the device is running; frames already
+* received are not re-classified.
+*
+******************************************************************************/
+LONG XEmacPs_SetScreener(XEmacPs *InstancePtr, u8 Index,
+			 XEmacPs_Screener *ScreenerPtr)
+{
+	u32 Reg = 0x00000000U;
+	u32 T2Flags = (u32)XEMACPS_SCREEN_MATCH_ETHTYPE |
+			(u32)XEMACPS_SCREEN_MATCH_VLANPRI;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(ScreenerPtr != NULL);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_MAX_SCREENERS);
+	Xil_AssertNonvoid(ScreenerPtr->VlanPriority <= 7U);
+
+	if (InstancePtr->Version <= 2U) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (((ScreenerPtr->MatchFlags & T2Flags) != 0x00U) &&
+		((ScreenerPtr->MatchFlags & XEMACPS_SCREEN_MATCH_UDPPORT) != 0x00U)) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		/* Type 1: UDP destination port */
+		if ((ScreenerPtr->MatchFlags & XEMACPS_SCREEN_MATCH_UDPPORT) != 0x00U) {
+			Reg = ((u32)ScreenerPtr->QueueNum &
+					XEMACPS_SCREEN_T1_QUEUE_MASK) |
+				(((u32)ScreenerPtr->UdpPort <<
+					XEMACPS_SCREEN_T1_UDP_SHIFT) &
+					XEMACPS_SCREEN_T1_UDP_MASK) |
+				XEMACPS_SCREEN_T1_UDPEN_MASK;
+		}
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_SCREEN_T1_OFFSET + ((u32)Index * (u32)4), Reg);
+
+		/* Type 2: EtherType and/or VLAN priority */
+		Reg = 0x00000000U;
+		if ((ScreenerPtr->MatchFlags & T2Flags) != 0x00U) {
+			Reg = (u32)ScreenerPtr->QueueNum &
+					XEMACPS_SCREEN_T2_QUEUE_MASK;
+		}
+		if ((ScreenerPtr->MatchFlags & XEMACPS_SCREEN_MATCH_VLANPRI) != 0x00U) {
+			Reg |= (((u32)ScreenerPtr->VlanPriority <<
+					XEMACPS_SCREEN_T2_VLANPRI_SHIFT) &
+					XEMACPS_SCREEN_T2_VLANPRI_MASK) |
+				XEMACPS_SCREEN_T2_VLANEN_MASK;
+		}
+		if ((ScreenerPtr->MatchFlags & XEMACPS_SCREEN_MATCH_ETHTYPE) != 0x00U) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREEN_T2_ETHTYPE_OFFSET +
+				((u32)Index * (u32)4), (u32)ScreenerPtr->EtherType);
+			Reg |= (((u32)Index << XEMACPS_SCREEN_T2_ETHIDX_SHIFT) &
+					XEMACPS_SCREEN_T2_ETHIDX_MASK) |
+				XEMACPS_SCREEN_T2_ETHEN_MASK;
+		}
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_SCREEN_T2_OFFSET + ((u32)Index * (u32)4), Reg);
+
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Set the size of the receive buffers used by receive queue 1. The size of
+* the queue 0 buffers is set in the DMACR register by the driver.
+*
+* @param InstancePtr is a pointer to the XEmacPs instance to be worked on.
+* @param BufSize is the receive buffer size in bytes. It is rounded up to
+*        a multiple of XEMACPS_RX_BUF_UNIT.
+*
+* @return None
+*
+* @note
+* Only GEM revisions with priority queues (Version > 2) have this register.
+*
+******************************************************************************/
+void XEmacPs_SetQ1RxBufSize(XEmacPs *InstancePtr, u32 BufSize)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->Version > 2U);
+
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+		XEMACPS_RXQ1BUFSIZE_OFFSET,
+		((BufSize / (u32)XEMACPS_RX_BUF_UNIT) +
+		(((BufSize % (u32)XEMACPS_RX_BUF_UNIT) != (u32)0) ? 1U : 0U)));
+}
+
+/*****************************************************************************/
+/**
+* Set the interrupt moderation delays. After a frame has been received
+* (transmitted), the receive (transmit) complete interrupt is held back for
+* the given delay so that frames arriving in the meantime are reported with
+* a single interrupt.
+*
+* @param InstancePtr is a pointer to the XEmacPs instance to be worked on.
+* @param RxDelay is the receive interrupt delay, in units of 800 ns at
+*        1 Gbps (8 us at 100 Mbps, 80 us at 10 Mbps). 0 disables receive
+*        interrupt moderation.
+* @param TxDelay is the transmit interrupt delay, in the same units.
+*        0 disables transmit interrupt moderation.
+*
+* @return
+* - XST_SUCCESS if the moderation delays were set
+* - XST_NO_FEATURE if this GEM revision has no interrupt moderation
+*
+******************************************************************************/
+LONG XEmacPs_SetIntrModeration(XEmacPs *InstancePtr, u8 RxDelay, u8 TxDelay)
+{
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version <= 2U) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_INTMOD_OFFSET,
+			((u32)RxDelay & XEMACPS_INTMOD_RX_MASK) |
+			(((u32)TxDelay << XEMACPS_INTMOD_TX_SHIFT) &
+				XEMACPS_INTMOD_TX_MASK));
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Check whether this GEM can do TCP segmentation and UDP fragmentation
+* offload (see XEmacPs_BdSetTso()). The capability is a synthesis option, so
+* it is read from the design configuration registers.
+*
+* @param InstancePtr is a pointer to the XEmacPs instance to be worked on.
+*
+* @return
+* - TRUE if large send offload is available
+* - FALSE otherwise
+*
+******************************************************************************/
+u32 XEmacPs_IsLsoCapable(XEmacPs *InstancePtr)
+{
+	u32 Status = FALSE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version > 2U) {
+		if ((XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_DCFG6_OFFSET) & XEMACPS_DCFG6_LSO_MASK) != 0U) {
+			Status = TRUE;
+		}
+	}
+	return Status;
+}
 /** @} */
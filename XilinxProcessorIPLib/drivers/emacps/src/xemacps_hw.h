@@ -61,6 +61,12 @@
 *                    Remove "used bit set" from TX error interrupt masks.
 * 3.1  hk   08/10/15 Update upper 32 bit tx and rx queue ptr register offsets.
 * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+* 3.7   ag   10/16/26 Added RX Q1 buffer size, RX Q1 interrupt and
+*                    screening type 1/type 2 register definitions.
+* 3.7   ag   10/16/26 Added RX buffer descriptor checksum status masks.
+* 3.7   ag   10/16/26 Added interrupt moderation register definitions.
+* 3.7   ag   10/16/26 Added design configuration 6 register and TX buffer
+*                     descriptor large send offload definitions.
 * </pre>
 *
 ******************************************************************************/
@@ -83,6 +89,8 @@ extern "C" {
 #define XEMACPS_MAX_MAC_ADDR     4U   /**< Maxmum number of mac address
                                            supported */
 #define XEMACPS_MAX_TYPE_ID      4U   /**< Maxmum number of type id supported */
+#define XEMACPS_MAX_SCREENERS    4U   /**< Maximum number of type 1 and of
+					   type 2 screening registers */
 
 #ifdef __aarch64__
 #define XEMACPS_BD_ALIGNMENT     64U   /**< Minimum buffer descriptor alignment
@@ -153,6 +161,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_TXPAUSE_OFFSET       0x0000003CU /**< TX Pause Time reg */
 
 #define XEMACPS_JUMBOMAXLEN_OFFSET   0x00000048U /**< Jumbo max length reg */
+#define XEMACPS_INTMOD_OFFSET        0x0000005CU /**< Interrupt moderation
+                                                      reg */
 
 #define XEMACPS_HASHL_OFFSET         0x00000080U /**< Hash Low address reg */
 #define XEMACPS_HASHH_OFFSET         0x00000084U /**< Hash High address reg */
@@ -296,12 +306,17 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_PTPP_RXNANOSEC_OFFSET 0x000001FCU /**< 1588 PTP peer receive
 						      nanosecond counter */
 
+#define XEMACPS_DCFG6_OFFSET         0x00000294U /**< Design configuration
+                                                      6 reg */
+
 #define XEMACPS_INTQ1_STS_OFFSET     0x00000400U /**< Interrupt Q1 Status
 							reg */
 #define XEMACPS_TXQ1BASE_OFFSET	     0x00000440U /**< TX Q1 Base address
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 DMA buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -312,6 +327,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
+#define XEMACPS_SCREEN_T1_OFFSET     0x00000500U /**< Screening type 1
+							reg 0 */
+#define XEMACPS_SCREEN_T2_OFFSET     0x00000540U /**< Screening type 2
+							reg 0 */
+#define XEMACPS_SCREEN_T2_ETHTYPE_OFFSET 0x000006E0U /**< Screening type 2
+							EtherType reg 0 */
 
 /* Define some bit positions for registers. */
 
@@ -463,12 +484,65 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Frame received OK on
+							  RX Q1 */
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
-					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
+					 (u32)XEMACPS_INTQ1SR_TXERR_MASK | \
+					 (u32)XEMACPS_INTQ1SR_RXCOMPL_MASK)
 
 /*@}*/
 
+/**
+ * @name Screening type 1 register bit definitions
+ * Type 1 screeners route frames on the IP DS/TC field or the UDP
+ * destination port.
+ * @{
+ */
+#define XEMACPS_SCREEN_T1_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCREEN_T1_DSTC_MASK	0x00000FF0U /**< DS/TC match value */
+#define XEMACPS_SCREEN_T1_DSTC_SHIFT	4U
+#define XEMACPS_SCREEN_T1_UDP_MASK	0x0FFFF000U /**< UDP port match value */
+#define XEMACPS_SCREEN_T1_UDP_SHIFT	12U
+#define XEMACPS_SCREEN_T1_DSTCEN_MASK	0x10000000U /**< Enable DS/TC match */
+#define XEMACPS_SCREEN_T1_UDPEN_MASK	0x20000000U /**< Enable UDP port match */
+/*@}*/
+
+/**
+ * @name Screening type 2 register bit definitions
+ * Type 2 screeners route frames on the VLAN priority and/or the EtherType
+ * held in one of the screening type 2 EtherType registers.
+ * @{
+ */
+#define XEMACPS_SCREEN_T2_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCREEN_T2_VLANPRI_MASK	0x00000070U /**< VLAN priority */
+#define XEMACPS_SCREEN_T2_VLANPRI_SHIFT	4U
+#define XEMACPS_SCREEN_T2_VLANEN_MASK	0x00000100U /**< Enable VLAN match */
+#define XEMACPS_SCREEN_T2_ETHIDX_MASK	0x00000E00U /**< EtherType reg index */
+#define XEMACPS_SCREEN_T2_ETHIDX_SHIFT	9U
+#define XEMACPS_SCREEN_T2_ETHEN_MASK	0x00001000U /**< Enable EtherType
+							  match */
+/*@}*/
+
+/**
+ * @name Interrupt moderation register bit definitions
+ * The delays are in units of 800 ns at 1 Gbps, 8 us at 100 Mbps and 80 us
+ * at 10 Mbps. A delay of 0 disables moderation.
+ * @{
+ */
+#define XEMACPS_INTMOD_RX_MASK		0x000000FFU /**< RX moderation delay */
+#define XEMACPS_INTMOD_TX_MASK		0x00FF0000U /**< TX moderation delay */
+#define XEMACPS_INTMOD_TX_SHIFT		16U
+/*@}*/
+
+/**
+ * @name Design configuration 6 register bit definitions
+ * @{
+ */
+#define XEMACPS_DCFG6_LSO_MASK		0x08000000U /**< TCP/UDP large send
+							 offload present */
+/*@}*/
+
 /**
  * @name interrupts bit definitions
  * Bits definitions are same in XEMACPS_ISR_OFFSET,
@@ -555,6 +629,21 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_TXBUF_NOCRC_MASK 0x00010000U /**< No CRC */
 #define XEMACPS_TXBUF_LAST_MASK  0x00008000U /**< Last buffer */
 #define XEMACPS_TXBUF_LEN_MASK   0x00003FFFU /**< Mask for length field */
+
+/* Large send offload. The LSO mode goes in the first BD of the frame, which
+ * must hold exactly the Ethernet, IP and TCP/UDP headers; the MSS (TSO) or
+ * maximum fragment size (UFO) goes in the second BD.
+ */
+#define XEMACPS_TXBUF_TCPSEQSRC_MASK 0x00080000U /**< TCP sequence number
+						      source, first BD */
+#define XEMACPS_TXBUF_LSO_MASK   0x00060000U /**< LSO mode, first BD */
+#define XEMACPS_TXBUF_LSO_SHIFT  17U
+#define XEMACPS_TXBUF_MSS_MASK   0x3FFF0000U /**< MSS/MFS, second BD */
+#define XEMACPS_TXBUF_MSS_SHIFT  16U
+
+#define XEMACPS_LSO_NONE         0x00000000U /**< No large send offload */
+#define XEMACPS_LSO_UFO          0x00000001U /**< UDP fragmentation offload */
+#define XEMACPS_LSO_TSO          0x00000002U /**< TCP segmentation offload */
 /*
  * @}
  */
@@ -578,6 +667,16 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
                                                       matched */
 #define XEMACPS_RXBUF_IDFOUND_MASK   0x01000000U /**< Type ID matched */
 #define XEMACPS_RXBUF_IDMATCH_MASK   0x00C00000U /**< ID matched mask */
+#define XEMACPS_RXBUF_CSUM_MASK      0x00C00000U /**< Checksum status, replaces
+                                                      the ID match field when
+                                                      RX checksum offload is
+                                                      enabled */
+#define XEMACPS_RXBUF_CSUM_NONE      0x00000000U /**< No checksum checked */
+#define XEMACPS_RXBUF_CSUM_IP        0x00400000U /**< IP header checksum OK */
+#define XEMACPS_RXBUF_CSUM_IP_TCP    0x00800000U /**< IP header and TCP
+                                                      checksums OK */
+#define XEMACPS_RXBUF_CSUM_IP_UDP    0x00C00000U /**< IP header and UDP
+                                                      checksums OK */
 #define XEMACPS_RXBUF_VLAN_MASK      0x00200000U /**< VLAN tagged */
 #define XEMACPS_RXBUF_PRI_MASK       0x00100000U /**< Priority tagged */
 #define XEMACPS_RXBUF_VPRI_MASK      0x000E0000U /**< Vlan priority */
@@ -57,6 +57,10 @@
  * 5.1   sk   11/10/15 Used UINTPTR instead of u32 for Baseaddress CR# 867425.
  *                     Changed the prototypes of XLlFifo_CfgInitialize,
  *                     XLlFifo_Initialize APIs.
+ * 5.2   ag   10/16/26 XLlFifo_iRead_Aligned and XLlFifo_iWrite_Aligned move
+ *                     four words per access over the AXI4 data interface
+ *                     and unroll the AXI4-Lite loop. Added
+ *                     XLlFifo_RxFrames().
  * </pre>
  ******************************************************************************/
 
@@ -70,6 +74,16 @@
 /************************** Constant Definitions *****************************/
 #define FIFO_WIDTH_BYTES 4
 
+/* Words moved by one access of the burst loops */
+#define XLLF_BURST_WORDS 4
+
+/************************** Function Prototypes ******************************/
+
+static void XLlFifo_iReadWords(XLlFifo *InstancePtr, u32 *BufPtr,
+			       unsigned WordCount);
+static void XLlFifo_iWriteWords(XLlFifo *InstancePtr, const u32 *BufPtr,
+				unsigned WordCount);
+
 /*
  * Implementation Notes:
  *
@@ -180,25 +194,15 @@ u32 XLlFifo_iRxGetLen(XLlFifo *InstancePtr)
 int XLlFifo_iRead_Aligned(XLlFifo *InstancePtr, void *BufPtr,
 			     unsigned WordCount)
 {
-	unsigned WordsRemaining = WordCount;
-	u32 *BufPtrIdx = (u32 *)BufPtr;
-
 	xdbg_printf(XDBG_DEBUG_FIFO_RX, "XLlFifo_iRead_Aligned: start\n");
 	Xil_AssertNonvoid(InstancePtr);
 	Xil_AssertNonvoid(BufPtr);
 	/* assert bufer is 32 bit aligned */
-	Xil_AssertNonvoid(((unsigned)BufPtr & 0x3) == 0x0);
+	Xil_AssertNonvoid(((UINTPTR)BufPtr & 0x3) == 0x0);
 	xdbg_printf(XDBG_DEBUG_FIFO_RX, "XLlFifo_iRead_Aligned: after asserts\n");
 
-	while (WordsRemaining) {
-/*		xdbg_printf(XDBG_DEBUG_FIFO_RX,
-			    "XLlFifo_iRead_Aligned: WordsRemaining: %d\n",
-			    WordsRemaining);
-*/
-		*BufPtrIdx = XLlFifo_RxGetWord(InstancePtr);
-		BufPtrIdx++;
-		WordsRemaining--;
-	}
+	XLlFifo_iReadWords(InstancePtr, (u32 *)BufPtr, WordCount);
+
 	xdbg_printf(XDBG_DEBUG_FIFO_RX,
 		    "XLlFifo_iRead_Aligned: returning SUCCESS\n");
 	return XST_SUCCESS;
@@ -286,25 +290,15 @@ void XLlFifo_iTxSetLen(XLlFifo *InstancePtr, u32 Bytes)
 int XLlFifo_iWrite_Aligned(XLlFifo *InstancePtr, void *BufPtr,
 			      unsigned WordCount)
 {
-	unsigned WordsRemaining = WordCount;
-	u32 *BufPtrIdx = (u32 *)BufPtr;
-
 	xdbg_printf(XDBG_DEBUG_FIFO_TX,
 		    "XLlFifo_iWrite_Aligned: Inst: %p; Buff: %p; Count: %d\n",
 		    InstancePtr, BufPtr, WordCount);
 	Xil_AssertNonvoid(InstancePtr);
 	Xil_AssertNonvoid(BufPtr);
 	/* assert bufer is 32 bit aligned */
-	Xil_AssertNonvoid(((unsigned)BufPtr & 0x3) == 0x0);
+	Xil_AssertNonvoid(((UINTPTR)BufPtr & 0x3) == 0x0);
 
-	xdbg_printf(XDBG_DEBUG_FIFO_TX,
-		    "XLlFifo_iWrite_Aligned: WordsRemaining: %d\n",
-		    WordsRemaining);
-	while (WordsRemaining) {
-		XLlFifo_TxPutWord(InstancePtr, *BufPtrIdx);
-		BufPtrIdx++;
-		WordsRemaining--;
-	}
+	XLlFifo_iWriteWords(InstancePtr, (const u32 *)BufPtr, WordCount);
 
 	xdbg_printf(XDBG_DEBUG_FIFO_TX,
 		    "XLlFifo_iWrite_Aligned: returning SUCCESS\n");
@@ -494,4 +488,213 @@ void XLlFifo_Initialize(XLlFifo *InstancePtr, UINTPTR BaseAddress)
 			(XStrm_SetLenFnType)XLlFifo_iTxSetLen,
 			(XStrm_GetVacancyFnType)XLlFifo_iTxVacancy);
 }
+
+/*****************************************************************************/
+/**
+*
+* XLlFifo_RxFrames receives up to <i>NumFrames</i> frames from the receive
+* channel of the FIFO referenced by <i>InstancePtr</i>, one frame into the
+* buffer of each entry of <i>Frames</i>.
+*
+* The occupancy is read once for the whole batch, so the frames received are
+* the ones complete in the FIFO when the function is called. Bytes of a frame
+* that do not fit into the buffer of its entry are dropped.
+*
+* @param    InstancePtr references the FIFO on which to operate.
+*
+* @param    Frames is the array of frame buffers. BufPtr must be 32 bit
+*           aligned. FrameLen is set to the length of the frame received.
+*
+* @param    NumFrames is the number of entries of <i>Frames</i>.
+*
+* @return   The number of frames received, 0 when the FIFO is empty.
+*
+* @note     The core must run in store and forward mode, the default, so
+*           that the occupancy only counts complete frames. The frames must
+*           not be read with XLlFifo_Read() at the same time.
+*
+******************************************************************************/
+u32 XLlFifo_RxFrames(XLlFifo *InstancePtr, XLlFifo_Frame *Frames,
+		     u32 NumFrames)
+{
+	XLlFifo_Frame *Frame;
+	u32 Occupancy;
+	u32 Count = 0;
+	u32 Words;
+	u32 Bytes;
+	u32 Word;
+	u32 i;
+
+	Xil_AssertNonvoid(InstancePtr);
+	Xil_AssertNonvoid(Frames);
+
+	Occupancy = XLlFifo_iRxOccupancy(InstancePtr);
+	while ((Occupancy != 0) && (Count < NumFrames)) {
+		Frame = &Frames[Count];
+		Xil_AssertNonvoid(((UINTPTR)Frame->BufPtr & 0x3) == 0x0);
+
+		Frame->FrameLen = XLlFifo_iRxGetLen(InstancePtr);
+		Words = (Frame->FrameLen + FIFO_WIDTH_BYTES - 1) /
+			FIFO_WIDTH_BYTES;
+		Bytes = (Frame->FrameLen < Frame->BufLen) ?
+			Frame->FrameLen : Frame->BufLen;
+
+		i = Bytes / FIFO_WIDTH_BYTES;
+		XLlFifo_iReadWords(InstancePtr, (u32 *)Frame->BufPtr, i);
+		if ((Bytes % FIFO_WIDTH_BYTES) != 0) {
+			Word = XLlFifo_RxGetWord(InstancePtr);
+			memcpy((u8 *)Frame->BufPtr + (i * FIFO_WIDTH_BYTES),
+			       &Word, Bytes % FIFO_WIDTH_BYTES);
+			i++;
+		}
+
+		/* Drop what did not fit into the buffer */
+		for (; i < Words; i++) {
+			(void)XLlFifo_RxGetWord(InstancePtr);
+		}
+
+		Occupancy = (Words < Occupancy) ? (Occupancy - Words) : 0;
+		Count++;
+	}
+
+	/* Nothing is left for the streamer of the frames read here */
+	InstancePtr->RxStreamer.HeadIndex = InstancePtr->RxStreamer.FifoWidth;
+	InstancePtr->RxStreamer.FrmByteCnt = 0;
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* Read <i>WordCount</i> words from the receive FIFO to the 32 bit aligned
+* buffer <i>BufPtr</i>.
+*
+* Over the AXI4 data interface the words are read four at a time from
+* incrementing addresses of the receive window, with one multiple load on
+* ARM. Over AXI4-Lite the data register is read in an unrolled loop.
+*
+******************************************************************************/
+static void XLlFifo_iReadWords(XLlFifo *InstancePtr, u32 *BufPtr,
+			       unsigned WordCount)
+{
+	UINTPTR Addr;
+	u32 Offset = 0;
+
+	if (InstancePtr->Datainterface) {
+		Addr = (UINTPTR)InstancePtr->Axi4BaseAddress +
+			XLLF_AXI4_RDFD_OFFSET;
+
+		while (WordCount >= XLLF_BURST_WORDS) {
+#if defined (__aarch64__)
+			__asm__ __volatile__(
+				"ldp	x2, x3, [%0]\n"
+				"str	w2, [%1]\n"
+				"lsr	x2, x2, #32\n"
+				"str	w2, [%1, #4]\n"
+				"str	w3, [%1, #8]\n"
+				"lsr	x3, x3, #32\n"
+				"str	w3, [%1, #12]\n"
+				: : "r" (Addr + Offset), "r" (BufPtr)
+				: "x2", "x3", "memory");
+#elif defined (__arm__)
+			__asm__ __volatile__(
+				"ldmia	%0, {r3-r6}\n"
+				"stmia	%1, {r3-r6}\n"
+				: : "r" (Addr + Offset), "r" (BufPtr)
+				: "r3", "r4", "r5", "r6", "memory");
+#else
+			BufPtr[0] = Xil_In32(Addr + Offset);
+			BufPtr[1] = Xil_In32(Addr + Offset + 4);
+			BufPtr[2] = Xil_In32(Addr + Offset + 8);
+			BufPtr[3] = Xil_In32(Addr + Offset + 12);
+#endif
+			Offset = (Offset + (XLLF_BURST_WORDS * 4)) &
+				 (XLLF_AXI4_WINDOW_SIZE - 1);
+			BufPtr += XLLF_BURST_WORDS;
+			WordCount -= XLLF_BURST_WORDS;
+		}
+	} else {
+		Addr = (UINTPTR)InstancePtr->Axi4BaseAddress + XLLF_RDFD_OFFSET;
+
+		while (WordCount >= XLLF_BURST_WORDS) {
+			BufPtr[0] = Xil_In32(Addr);
+			BufPtr[1] = Xil_In32(Addr);
+			BufPtr[2] = Xil_In32(Addr);
+			BufPtr[3] = Xil_In32(Addr);
+			BufPtr += XLLF_BURST_WORDS;
+			WordCount -= XLLF_BURST_WORDS;
+		}
+	}
+
+	while (WordCount) {
+		*BufPtr = Xil_In32(Addr + Offset);
+		BufPtr++;
+		WordCount--;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Write <i>WordCount</i> words from the 32 bit aligned buffer <i>BufPtr</i>
+* to the transmit FIFO, the counterpart of XLlFifo_iReadWords().
+*
+******************************************************************************/
+static void XLlFifo_iWriteWords(XLlFifo *InstancePtr, const u32 *BufPtr,
+				unsigned WordCount)
+{
+	UINTPTR Addr;
+	u32 Offset = 0;
+
+	if (InstancePtr->Datainterface) {
+		Addr = (UINTPTR)InstancePtr->Axi4BaseAddress +
+			XLLF_AXI4_TDFD_OFFSET;
+
+		while (WordCount >= XLLF_BURST_WORDS) {
+#if defined (__aarch64__)
+			__asm__ __volatile__(
+				"ldp	w2, w3, [%1]\n"
+				"ldp	w4, w5, [%1, #8]\n"
+				"orr	x2, x2, x3, lsl #32\n"
+				"orr	x4, x4, x5, lsl #32\n"
+				"stp	x2, x4, [%0]\n"
+				: : "r" (Addr + Offset), "r" (BufPtr)
+				: "x2", "x3", "x4", "x5", "memory");
+#elif defined (__arm__)
+			__asm__ __volatile__(
+				"ldmia	%1, {r3-r6}\n"
+				"stmia	%0, {r3-r6}\n"
+				: : "r" (Addr + Offset), "r" (BufPtr)
+				: "r3", "r4", "r5", "r6", "memory");
+#else
+			Xil_Out32(Addr + Offset, BufPtr[0]);
+			Xil_Out32(Addr + Offset + 4, BufPtr[1]);
+			Xil_Out32(Addr + Offset + 8, BufPtr[2]);
+			Xil_Out32(Addr + Offset + 12, BufPtr[3]);
+#endif
+			Offset = (Offset + (XLLF_BURST_WORDS * 4)) &
+				 (XLLF_AXI4_WINDOW_SIZE - 1);
+			BufPtr += XLLF_BURST_WORDS;
+			WordCount -= XLLF_BURST_WORDS;
+		}
+	} else {
+		Addr = (UINTPTR)InstancePtr->Axi4BaseAddress + XLLF_TDFD_OFFSET;
+
+		while (WordCount >= XLLF_BURST_WORDS) {
+			Xil_Out32(Addr, BufPtr[0]);
+			Xil_Out32(Addr, BufPtr[1]);
+			Xil_Out32(Addr, BufPtr[2]);
+			Xil_Out32(Addr, BufPtr[3]);
+			BufPtr += XLLF_BURST_WORDS;
+			WordCount -= XLLF_BURST_WORDS;
+		}
+	}
+
+	while (WordCount) {
+		Xil_Out32(Addr + Offset, *BufPtr);
+		BufPtr++;
+		WordCount--;
+	}
+}
 /** @} */
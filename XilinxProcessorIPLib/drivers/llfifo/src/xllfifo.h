@@ -98,6 +98,25 @@
  * for two frames. Each frame must be read in by calling iRxGetLen() just
  * prior to reading the data.
  *
+ * XLlFifo_RxFrames() receives the frames waiting in the FIFO into an array
+ * of XLlFifo_Frame, one frame per entry. It reads the occupancy once for
+ * the whole batch instead of once per frame or word:
+ * <pre>
+ *	for (i = 0; i < NUM_FRAMES; i++) {
+ *		Frames[i].BufPtr = RxBuffer[i];
+ *		Frames[i].BufLen = sizeof(RxBuffer[i]);
+ *	}
+ *	Count = XLlFifo_RxFrames(InstancePtr, Frames, NUM_FRAMES);
+ *	for (i = 0; i < Count; i++) {
+ *		// Frames[i].FrameLen bytes received in RxBuffer[i]
+ *	}
+ * </pre>
+ *
+ * XLlFifo_Read(), XLlFifo_Write() and XLlFifo_RxFrames() move the data
+ * four words per access when the core has the AXI4 data interface, with
+ * the multiple register load and store instructions of the processor, and
+ * with unrolled single word accesses over AXI4-Lite.
+ *
  * <h3>Transmit</h3>
  * A frame is transmittted by using the following sequence:<br>
  * 1) XLlFifo_iTxVacancy() one or more times to know the availability of
@@ -187,6 +206,9 @@
  * 5.2 adk    03/07/17 CR#978769 Fix doxygen issues in the driver.
  *		       Updated comments in the usage section as per example code.
  *		       Fix doxygen warnings in the driver.
+ * 5.2  ag    10/16/26 Words are moved in bursts over the AXI4 data
+ *		       interface and in unrolled loops over AXI4-Lite. Added
+ *		       XLlFifo_RxFrames() to receive several frames at once.
  * </pre>
  *
  *****************************************************************************/
@@ -240,6 +262,18 @@ typedef struct XLlFifo_Config {
 	u32 Datainterface;	/**< Type of Datainterface */
 }XLlFifo_Config;
 
+/**
+ * This typedef describes the buffer of one frame for XLlFifo_RxFrames().
+ */
+typedef struct XLlFifo_Frame {
+	void *BufPtr;		/**< Buffer of the frame, 32 bit aligned */
+	u32 BufLen;		/**< Size of the buffer in bytes */
+	u32 FrameLen;		/**< Bytes in the frame received. When larger
+				 *   than BufLen, the bytes that did not fit
+				 *   were dropped.
+				 */
+} XLlFifo_Frame;
+
 /****************************************************************************/
 /**
 *
@@ -726,6 +760,8 @@ u32 XLlFifo_iTxVacancy(XLlFifo *InstancePtr);
 void XLlFifo_iTxSetLen(XLlFifo *InstancePtr, u32 Bytes);
 u32 XLlFifo_RxGetWord(XLlFifo *InstancePtr);
 void XLlFifo_TxPutWord(XLlFifo *InstancePtr, u32 Word);
+u32 XLlFifo_RxFrames(XLlFifo *InstancePtr, XLlFifo_Frame *Frames,
+		     u32 NumFrames);
 
 #ifdef __cplusplus
 }
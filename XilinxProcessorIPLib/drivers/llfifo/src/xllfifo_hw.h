@@ -53,6 +53,7 @@
 *		       XLLF_INT_TFPE_MASK, XLLF_INT_RFPF_MASK and
 *		       XLLF_INT_RFPE_MASK for the new version of the
 *		       AXI4-Stream FIFO core (v2.01a and later)
+* 5.2   ag   10/16/26 Added XLLF_AXI4_WINDOW_SIZE.
 * </pre>
 *
 ******************************************************************************/
@@ -99,6 +100,14 @@ extern "C" {
 
 /*@}*/
 
+/*
+ * Size of the AXI4 data windows. Every address of the window starting at
+ * XLLF_AXI4_TDFD_OFFSET writes the transmit FIFO and every address of the
+ * window starting at XLLF_AXI4_RDFD_OFFSET reads the receive FIFO, so that
+ * incrementing bursts can be used.
+ */
+#define XLLF_AXI4_WINDOW_SIZE	0x00001000
+
 /* Register masks. The following constants define bit locations of various
  * control bits in the registers. Constants are not defined for those registers
  * that have a single bit field representing all 32 bits. For further
@@ -48,6 +48,9 @@
 * 2.00a hbm  01/20/10  Hal phase 1 support, bump up major release
 * 2.02a asa  12/28/11  The function XStrm_Read is changed to reset HeadIndex
 *		       to zero when all the bytes are read.
+* 5.2   ag   10/16/26  XStrm_Read and XStrm_Write move runs of whole FIFO
+*		       words for unaligned buffers through a bounce buffer on
+*		       the stack instead of one word per FIFO access call.
 * </pre>
 ******************************************************************************/
 
@@ -159,6 +162,12 @@
 #define min(x, y) (((x) < (y)) ? (x) : (y))
 #endif
 
+/*
+ * 32 bit words of the bounce buffer used to move runs of whole FIFO words
+ * to and from unaligned buffers.
+ */
+#define XSTRM_BOUNCE_WORDS 32
+
 xdbg_stmnt(u32 _xstrm_ro_value;)
 xdbg_stmnt(u32 _xstrm_buffered;)
 
@@ -303,6 +312,7 @@ void XStrm_Read(XStrm_RxFifoStreamer *InstancePtr, void *BufPtr,
 	unsigned FifoWordsToXfer;
 	unsigned PartialBytes;
 	unsigned i;
+	u32 Bounce[XSTRM_BOUNCE_WORDS];
 
 	while (BytesRemaining) {
 		xdbg_printf(XDBG_DEBUG_FIFO_RX, "XStrm_Read: BytesRemaining: %d\n", BytesRemaining);
@@ -337,7 +347,7 @@ void XStrm_Read(XStrm_RxFifoStreamer *InstancePtr, void *BufPtr,
 		 *      of the fifo into the target buffer.
 		 *   2) Loop back around to transfer the last few bytes.
 		 */
-		else if ((((unsigned)DestPtr & 3) == 0) &&
+		else if ((((UINTPTR)DestPtr & 3) == 0) &&
 			 (BytesRemaining >= InstancePtr->FifoWidth)) {
 			xdbg_printf(XDBG_DEBUG_FIFO_RX, "XStrm_Read: Case 2: DestPtr: %p, BytesRemaining: %d, InstancePtr->FifoWidth: %d\n",
 				    DestPtr, BytesRemaining, InstancePtr->FifoWidth);
@@ -352,6 +362,29 @@ void XStrm_Read(XStrm_RxFifoStreamer *InstancePtr, void *BufPtr,
 			InstancePtr->FrmByteCnt -=
 				FifoWordsToXfer * InstancePtr->FifoWidth;
 		}
+		/* Case 2a: There are no more bytes in the holding buffer and
+		 *          the target buffer is not aligned but the number of
+		 *          bytes remaining is greater than or equal to the fifo
+		 *          width.
+		 *
+		 *   1) Read as many fifo words as the bounce buffer holds and
+		 *      copy them to the target buffer.
+		 *   2) Loop back around to transfer the rest.
+		 */
+		else if (BytesRemaining >= InstancePtr->FifoWidth) {
+			FifoWordsToXfer = min(BytesRemaining / InstancePtr->FifoWidth,
+					      sizeof(Bounce) / InstancePtr->FifoWidth);
+
+			(*(InstancePtr->ReadFn)) (InstancePtr->FifoInstance,
+						Bounce, FifoWordsToXfer);
+			memcpy(DestPtr, Bounce,
+			       FifoWordsToXfer * InstancePtr->FifoWidth);
+			DestPtr += FifoWordsToXfer * InstancePtr->FifoWidth;
+			BytesRemaining -=
+				FifoWordsToXfer * InstancePtr->FifoWidth;
+			InstancePtr->FrmByteCnt -=
+				FifoWordsToXfer * InstancePtr->FifoWidth;
+		}
 		/* Case 3: There are no more bytes in the holding buffer and
 		 *         the number of bytes remaining to transfer is less than
 		 *         the fifo width or
@@ -438,6 +471,7 @@ void XStrm_Write(XStrm_TxFifoStreamer *InstancePtr, void *BufPtr,
 	unsigned FifoWordsToXfer;
 	unsigned PartialBytes;
 	unsigned i;
+	u32 Bounce[XSTRM_BOUNCE_WORDS];
 
 	while (BytesRemaining) {
 		xdbg_printf(XDBG_DEBUG_FIFO_TX,
@@ -469,7 +503,7 @@ void XStrm_Write(XStrm_TxFifoStreamer *InstancePtr, void *BufPtr,
 		 */
 		if ((InstancePtr->TailIndex == 0) &&
 		    (BytesRemaining >= InstancePtr->FifoWidth) &&
-		    (((unsigned)SrcPtr & 3) == 0)) {
+		    (((UINTPTR)SrcPtr & 3) == 0)) {
 			FifoWordsToXfer =
 				BytesRemaining / InstancePtr->FifoWidth;
 
@@ -488,6 +522,27 @@ void XStrm_Write(XStrm_TxFifoStreamer *InstancePtr, void *BufPtr,
 			xdbg_printf(XDBG_DEBUG_FIFO_TX, "XStrm_Write: (end case 2) TailIndex: %d; BytesRemaining: %d; SrcPtr: %p\n",
 				    InstancePtr->TailIndex, BytesRemaining, SrcPtr);
 		}
+		/* Case 2a: There are no bytes in the holding buffer and the
+		 *          source buffer is not aligned but the number of bytes
+		 *          remaining is greater than or equal to the fifo width.
+		 *
+		 *   1) Copy as many fifo words as the bounce buffer holds to it
+		 *      and write them into the fifo.
+		 *   2) Loop back around to transfer the rest.
+		 */
+		else if ((InstancePtr->TailIndex == 0) &&
+			 (BytesRemaining >= InstancePtr->FifoWidth)) {
+			FifoWordsToXfer = min(BytesRemaining / InstancePtr->FifoWidth,
+					      sizeof(Bounce) / InstancePtr->FifoWidth);
+
+			memcpy(Bounce, SrcPtr,
+			       FifoWordsToXfer * InstancePtr->FifoWidth);
+			(*InstancePtr->WriteFn) (InstancePtr->FifoInstance,
+						 Bounce, FifoWordsToXfer);
+			SrcPtr += FifoWordsToXfer * InstancePtr->FifoWidth;
+			BytesRemaining -=
+				FifoWordsToXfer * InstancePtr->FifoWidth;
+		}
 		/* Case 3: The alignment of the "galaxies" didn't occur in
 		 *         Case 2 above, so we must pump the bytes through the
 		 *         holding buffer.
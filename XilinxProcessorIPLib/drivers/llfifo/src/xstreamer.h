@@ -118,6 +118,8 @@
  * 2.00a hbm  01/20/10  Hal phase 1 support, bump up major release
  * 2.02a asa  12/28/11  The macro XStrm_IsRxInternalEmpty is changed to use
  *			FrmByteCnt instead of HeadIndex.
+ * 5.2   ag   10/16/26  Unaligned buffers are read and written in runs of
+ *			FIFO words through a bounce buffer.
  * </pre>
  *
  *****************************************************************************/
@@ -106,6 +106,19 @@
 *
 * </pre>
 *
+* <b> Completion scheduler </b>
+*
+* With many active channels XMcdma_SchedIntrHandler() and
+* XMcdma_SchedTxIntrHandler() take the place of XMcdma_IntrHandler() and
+* XMcdma_TxIntrHandler(). They visit only the channels flagged in the
+* interrupt service register, take up to weight * quantum completed BDs from
+* each one in round-robin order and hand them to the XMCDMA_CHAN_HANDLER_BDDONE
+* callback of the channel, then free them. Channels with more completed BDs
+* than their share are visited again before the handler returns. A weight
+* policy installed with XMcdma_SchedSetPolicy() recomputes the channel
+* weights from the observed backlog every few passes, and for MM2S channels
+* also programs them into the hardware WRR registers.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -139,6 +152,13 @@
 * 1.0   adk 	18/07/17 Initial version.
 * 1.0   adk     09/02/18 Fixed CR#994435 Changes are made in the
 *			 driver tcl file.
+* 1.1   ag      10/16/26 The channel BD chain bookkeeping is done by the
+*			 common BD ring engine (xil_bdring.h). The BD heads
+*			 and counters of XMcdma_ChanCtrl are replaced by an
+*			 XBdRing, added XMcdma_GetChanStats().
+* 1.1   ag      10/16/26 Added the completion scheduler (xmcdma_sched.c),
+*			 which services all channels with pending
+*			 completions in weighted round-robin order.
 ******************************************************************************/
 #ifndef XMCDMA_H_
 #define XMCDMA_H_
@@ -154,6 +174,7 @@ extern "C" {
 #include "xil_assert.h"
 #include "xstatus.h"
 #include "xil_cache.h"
+#include "xil_bdring.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -184,6 +205,7 @@ typedef enum {
         XMCDMA_CHAN_HANDLER_DONE,     /**< For Done Handler */
         XMCDMA_CHAN_HANDLER_ERROR,    /**< For Error Handler */
 	XMCDMA_CHAN_HANDLER_PKTDROP,    /**< For Error Handler */
+	XMCDMA_CHAN_HANDLER_BDDONE,	/**< For Completed BDs Handler */
 } XMcdma_ChanHandler;
 
 typedef void (*XMcdma_DoneHandler) (void *CallBackRef, u32 Chan_Id);
@@ -196,6 +218,8 @@ typedef void (*XMcdma_TxErrorHandler) (void *CallBackRef, u32 Chan_id, u32 Error
 typedef void (*XMcdma_ChanDoneHandler) (void *CallBackRef);
 typedef void (*XMcdma_ChanErrorHandler) (void *CallBackRef, u32 ErrorMask);
 typedef void (*XMcdma_ChanPktDropHandler) (void *CallBackRef);
+typedef void (*XMcdma_ChanBdDoneHandler) (void *CallBackRef, u32 BdCount,
+					  XMcdma_Bd *BdSetPtr);
 
 typedef enum {
 	XMCDMA_FIXED_PRIORITY,
@@ -221,15 +245,9 @@ typedef struct {
 	UINTPTR LastBdAddr;
 	UINTPTR Separation;
 
-	XMcdma_Bd *BdHead;
-	XMcdma_Bd *BdTail;
-	XMcdma_Bd *BdRestart;
-
-	u32 BdCnt;
-	u32 BdPendingCnt;
-	u32 BdSubmitCnt;
-	u32 BdDoneCnt;
+	u32 BdDoneCnt;		/* BDs returned by h/w, not yet freed */
 	u32 Length;
+	XBdRing Core;		/* BD groups, counters and statistics */
 
 	XMcdma_QScheduler Schedulertype;
 
@@ -244,8 +262,30 @@ typedef struct {
 	                                     * interrupt callback */
 	XMcdma_ChanPktDropHandler PktdropHandler;
 	void *PktDropRef;
+	XMcdma_ChanBdDoneHandler BdDoneHandler;/**< Call back for BDs
+						  *  returned by the
+						  *  scheduler */
+	void *BdDoneRef;		/**< To be passed to the BD done
+					     * callback */
+
+	u8 SchedWeight;		/* Scheduler weight, 1 to 15 */
+	u32 SchedDone;		/* BDs returned since the last weight update */
 } XMcdma_ChanCtrl;
 
+/*
+ * Weight policy of the completion scheduler. It returns the new weight, 1 to
+ * 15, of channel Chan given its Backlog and the largest backlog among the
+ * channels of the same direction, see XMcdma_SchedUpdateWeights().
+ */
+typedef u8 (*XMcdma_WeightPolicy) (void *PolicyRef, XMcdma_ChanCtrl *Chan,
+				   u32 Backlog, u32 MaxBacklog);
+
+typedef struct {
+	u32 Quantum;		/* BDs per unit of weight in a round */
+	u32 NextChan;		/* Channel the next round starts at */
+	u32 Carry;		/* Channels that used up their share */
+} XMcdma_Sched;
+
 typedef struct {
 	u32 DeviceId;
 	UINTPTR BaseAddress;
@@ -293,6 +333,12 @@ typedef struct {
 	void *PktDropRef;                 /**< To be passed to the error
 	                                     * interrupt callback */
 
+	XMcdma_Sched TxSched;		/**< MM2S completion scheduler */
+	XMcdma_Sched RxSched;		/**< S2MM completion scheduler */
+	XMcdma_WeightPolicy Policy;	/**< Weight policy, NULL for none */
+	void *PolicyRef;		/**< To be passed to the policy */
+	u32 PolicyInterval;		/**< Passes between weight updates */
+	u32 PolicyPasses;		/**< Passes since the last update */
 } XMcdma;
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -443,7 +489,8 @@ typedef struct {
 * @note         C-style signature:
 *               XMdma_ChanCtrl *XMcdma_GetChanCurBd(XMcdma_ChanCtrl * Chan)
 *****************************************************************************/
-#define XMcdma_GetChanCurBd(Chan)  ((Chan)->BdRestart)
+#define XMcdma_GetChanCurBd(Chan)  \
+		((XMcdma_Bd *)XBdRing_GetFreeHead(&(Chan)->Core))
 
 /*****************************************************************************/
 /**
@@ -458,6 +505,21 @@ typedef struct {
 *****************************************************************************/
 #define XMcdma_GetChanBdDoneCnt(Chan)  ((Chan)->BdDoneCnt)
 
+/*****************************************************************************/
+/**
+* This function copies the statistics kept for the channel BD chain, see
+* XBdRing_Stats.
+*
+* @param        Chan is the MCDMA Channel to Operate on.
+* @param        StatsPtr is the XBdRing_Stats to fill in.
+*
+* @note         C-style signature:
+*               void XMcdma_GetChanStats(XMcdma_ChanCtrl *Chan,
+*                                        XBdRing_Stats *StatsPtr)
+*****************************************************************************/
+#define XMcdma_GetChanStats(Chan, StatsPtr)  \
+		XBdRing_GetStats(&(Chan)->Core, (StatsPtr))
+
 /*****************************************************************************/
 /**
  * This function gets the interrupts that are asserted.
@@ -621,6 +683,8 @@ u32 XMcDma_ChanSubmit(XMcdma_ChanCtrl *Chan, UINTPTR BufAddr, u32 len);
 u32 XMcDma_ChanToHw(XMcdma_ChanCtrl *Chan);
 int XMcdma_BdChainFromHW(XMcdma_ChanCtrl *Chan, u32 BdLimit,
 			 XMcdma_Bd **BdSetPtr);
+int XMcdma_BdChainFree(XMcdma_ChanCtrl *Chan, int BdCount,
+		       XMcdma_Bd *BdSetPtr);
 u32 XMcdma_BdSetBufAddr(XMcdma_Bd *BdPtr, UINTPTR Addr);
 void XMcDma_BdSetCtrl(XMcdma_Bd *BdPtr, u32 Data);
 void XMcDma_DumpBd(XMcdma_Bd* BdPtr);
@@ -632,6 +696,18 @@ s32 XMcdma_SetCallBack(XMcdma *InstancePtr, XMcdma_Handler HandlerType,
 		       void *CallBackFunc, void *CallBackRef);
 /* Per Channel interrupt */
 void XMcdma_ChanIntrHandler(void *Instance);
+
+/* Completion scheduler in xmcdma_sched.c */
+s32 XMcdma_SchedInit(XMcdma *InstancePtr, u32 Quantum);
+u32 XMcdma_SchedService(XMcdma *InstancePtr, u32 Direction, u32 MaxBds);
+void XMcdma_SchedIntrHandler(void *Instance);
+void XMcdma_SchedTxIntrHandler(void *Instance);
+s32 XMcdma_SchedSetChanWeight(XMcdma_ChanCtrl *Chan, u8 Weight);
+s32 XMcdma_SchedSetPolicy(XMcdma *InstancePtr, XMcdma_WeightPolicy Policy,
+			  void *PolicyRef, u32 Interval);
+void XMcdma_SchedUpdateWeights(XMcdma *InstancePtr);
+u8 XMcdma_SchedBacklogPolicy(void *PolicyRef, XMcdma_ChanCtrl *Chan,
+			     u32 Backlog, u32 MaxBacklog);
 s32 XMcdma_ChanSetCallBack(XMcdma_ChanCtrl *Chan, XMcdma_ChanHandler HandlerType,
 			      void *CallBackFunc, void *CallBackRef);
 #ifdef __cplusplus
@@ -44,6 +44,10 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 *  1.0  adk  18/07/17 Initial Version.
+*  1.1  ag   10/16/26 Submit, ToHw, FromHW and Free are done by the common BD
+*		      ring engine, which flushes and invalidates the BDs of a
+*		      call in at most two cache maintenance ranges instead of
+*		      one per BD, and keeps channel statistics.
 ******************************************************************************/
 
 #include "xmcdma.h"
@@ -51,34 +55,13 @@
 #include "xmcdma_bd.h"
 
 
-/******************************************************************************
- * Move the BdPtr argument ahead an arbitrary number of BDs wrapping around
- * to the beginning of the ring if needed.
- *
- * We know if a wraparound should occur if the new BdPtr is greater than
- * the high address in the ring OR if the new BdPtr crosses the 0xFFFFFFFF
- * to 0 boundary.
- *
- * @param	Chan is the mcdma chan BdPtr appears in
- * @param	BdPtr on input is the starting BD position and on output is the
- *		final BD position
- * @param	NumBd is the number of BD spaces to increment
- *
- * @returns	None
- *****************************************************************************/
-#define XMCDMA_CHAN_SEEKAHEAD(Chan, BdPtr, NumBd)                       \
-    {                                                                   \
-        UINTPTR Addr = (UINTPTR)(void *)(BdPtr);                        \
-                                                                        \
-        Addr += (Chan->Separation * (NumBd));                           \
-        if ((Addr > (Chan)->LastBdAddr) || ((UINTPTR)(BdPtr) > Addr))   \
-        {                                                               \
-            Addr -= (Chan)->Length;                              \
-        }                                                               \
-                                                                        \
-        (BdPtr) = (XMcdma_Bd *)(void *)Addr;                            \
-    }
+static u32 XMcdma_BdStatus(void *Owner, UINTPTR BdPtr);
 
+/* BD layout for the common BD ring engine */
+static const XBdRing_Ops XMcdma_BdOps = {
+	XMcdma_BdStatus,
+	NULL
+};
 
 /*****************************************************************************/
 /**
@@ -102,7 +85,7 @@ int XMcdma_UpdateChanCDesc(XMcdma_ChanCtrl *Chan)
 	}
 
 	Offset = (Chan->Chan_id - 1) * XMCDMA_NXTCHAN_OFFSET;
-	BdPtr = (UINTPTR)(void *)Chan->BdHead;
+	BdPtr = XBdRing_GetHwHead(&Chan->Core);
 	XMCDMA_CACHE_FLUSH((UINTPTR)(BdPtr));
 
 	XMcdma_WriteReg(Chan->ChanBase,
@@ -136,6 +119,7 @@ int XMcdma_UpdateChanTDesc(XMcdma_ChanCtrl *Chan)
 	u32 Offset;
 	u32 Chan_id = Chan->Chan_id;
 	u32 Status;
+	UINTPTR BdTail;
 
 	RegBase = Chan->ChanBase;
 	Offset = (Chan->Chan_id - 1) * XMCDMA_NXTCHAN_OFFSET;
@@ -158,21 +142,26 @@ int XMcdma_UpdateChanTDesc(XMcdma_ChanCtrl *Chan)
 	/* Note as started */
 	Chan->ChanState = XMCDMA_CHAN_BUSY;
 
-	if (Chan->BdPendingCnt > 0) {
-		XMCDMA_CACHE_INVALIDATE(Chan->BdTail);
+	if (XBdRing_GetPreCnt(&Chan->Core) > 0) {
+		/* Give all submitted BDs to h/w, flushing them in one go */
+		Status = XBdRing_ToHw(&Chan->Core,
+				      XBdRing_GetPreCnt(&Chan->Core),
+				      XBdRing_GetPreHead(&Chan->Core));
+		if (Status != XST_SUCCESS) {
+			return XST_DMA_ERROR;
+		}
+		BdTail = XBdRing_GetHwTail(&Chan->Core);
 		XMcdma_WriteReg(Chan->ChanBase,
 				(XMCDMA_TDESC_OFFSET + Offset),
-				LOWER_32_BITS((UINTPTR)Chan->BdTail));
+				LOWER_32_BITS(BdTail));
 		if (Chan->ext_addr) {
 #if !defined (__MICROBLAZE__)
 			dsb();
 #endif
 			XMcdma_WriteReg(Chan->ChanBase,
 				  (XMCDMA_TDESC_MSB_OFFSET + Offset),
-				  UPPER_32_BITS((UINTPTR)Chan->BdTail));
+				  UPPER_32_BITS(BdTail));
 		}
-		Chan->BdSubmitCnt += Chan->BdPendingCnt;
-		Chan->BdPendingCnt = 0;
 
 		return XST_SUCCESS;
 	}
@@ -200,15 +189,21 @@ u32 XMcDma_ChanBdCreate(XMcdma_ChanCtrl *Chan, UINTPTR Addr, u32 Count)
 	UINTPTR BdStartAddr;
 	UINTPTR NxtBdAddr;
 	u32 i;
+	u32 Flags = 0;
+	s32 Status;
 
 	if (Count <= 0)
 		return XST_INVALID_PARAM;
 
-	Chan->BdPendingCnt = 0;
-	Chan->BdSubmitCnt = 0;
-	Chan->BdCnt = 0;
 	Chan->BdDoneCnt = 0;
 	Chan->Separation = sizeof(XMcdma_Bd);
+#ifdef __aarch64__
+	Flags = XBDRING_FLAG_NOCACHE;
+#endif
+	Status = XBdRing_Create(&Chan->Core, Addr, Chan->Separation, Count,
+				&XMcdma_BdOps, Chan, Flags);
+	if (Status != XST_SUCCESS)
+		return Status;
 
 	memset((void *)Addr, 0, sizeof(XMcdma_Bd) * Count);
 
@@ -259,14 +254,10 @@ u32 XMcDma_ChanBdCreate(XMcdma_ChanCtrl *Chan, UINTPTR Addr, u32 Count)
 
 
 	Chan->ChanState = XMCDMA_CHAN_IDLE;
-	Chan->BdCnt = Count;
 	Chan->FirstBdAddr = Addr;
 	Chan->LastBdAddr = BdStartAddr;
 	Chan->Length = Chan->LastBdAddr - Chan->FirstBdAddr +
 			       Chan->Separation;
-	Chan->BdHead = (XMcdma_Bd *) Addr;
-	Chan->BdTail = (XMcdma_Bd *) Addr;
-	Chan->BdRestart = (XMcdma_Bd *) Addr;
 
 	return XST_SUCCESS;
 }
@@ -292,7 +283,7 @@ u32 XMcDma_ChanBdCreate(XMcdma_ChanCtrl *Chan, UINTPTR Addr, u32 Count)
 u32 XMcDma_ChanSubmit(XMcdma_ChanCtrl *Chan, UINTPTR BufAddr, u32 len)
 {
 	u32 BdCount = 1;
-	XMcdma_Bd *BdCurPtr = Chan->BdRestart;
+	XMcdma_Bd *BdCurPtr;
 	u32 i;
 	u32 Bdlen = len;
 
@@ -303,9 +294,11 @@ u32 XMcDma_ChanSubmit(XMcdma_ChanCtrl *Chan, UINTPTR BufAddr, u32 len)
 		Bdlen = Chan->MaxTransferLen;
 	}
 
-	if (BdCount > Chan->BdCnt) {
+	if (XBdRing_Alloc(&Chan->Core, BdCount,
+			  (UINTPTR *)(void *)&BdCurPtr) != XST_SUCCESS) {
 		xil_printf("for transfering len bytes required Bd's is %x\n\r", BdCount);
-		xil_printf("User requested only this %x many Bd's\n\r", Chan->BdCnt);
+		xil_printf("User requested only this %x many Bd's\n\r",
+			   XBdRing_GetFreeCnt(&Chan->Core));
 
 		return XST_FAILURE;
 	}
@@ -320,18 +313,12 @@ u32 XMcDma_ChanSubmit(XMcdma_ChanCtrl *Chan, UINTPTR BufAddr, u32 len)
 
 		XMcdma_BdWrite(BdCurPtr, XMCDMA_BD_CTRL_OFFSET, Bdlen);
 
-		Chan->BdTail = BdCurPtr;
-		XMCDMA_CACHE_FLUSH((UINTPTR)(BdCurPtr));
 		BdCurPtr = (XMcdma_Bd *)XMcdma_BdChainNextBd(Chan, BdCurPtr);
 		BufAddr += Bdlen;
 		len -= Bdlen;
 	}
 
-	XMCDMA_CACHE_FLUSH((UINTPTR)(BdCurPtr));
-	DATA_SYNC;
-	Chan->BdRestart = BdCurPtr;
-	Chan->BdPendingCnt += BdCount;
-	Chan->BdCnt -= BdCount;
+	/* The BDs are flushed when XMcDma_ChanToHw() gives them to h/w */
 
 	return XST_SUCCESS;
 }
@@ -396,72 +383,21 @@ u32 XMcDma_ChanToHw(XMcdma_ChanCtrl *Chan)
 *****************************************************************************/
 int XMcdma_BdChainFromHW(XMcdma_ChanCtrl *Chan, u32 BdLimit, XMcdma_Bd **BdSetPtr)
 {
-	XMcdma_Bd *CurBdPtr;
+	UINTPTR BdSet;
 	u32 BdCount;
-	int BdPartialCount;
-	volatile u32 BdSts;
-	volatile u32 BdCr;
-
-	CurBdPtr = Chan->BdHead;
-	BdCount = 0;
-	BdPartialCount = 0;
-	BdSts = 0;
-	BdCr = 0;
-
-	if (Chan->BdSubmitCnt == 0) {
-		*BdSetPtr = NULL;
-
-		return XST_SUCCESS;
-	}
-
-	if (BdLimit > Chan->BdSubmitCnt) {
-		BdLimit = Chan->BdSubmitCnt;
-	}
-
-	while (BdCount < BdLimit) {
-		XMCDMA_CACHE_INVALIDATE((UINTPTR)(CurBdPtr));
-
-		if(!(Chan->IsRxChan)) {
-			BdSts = XMcdma_BdRead(CurBdPtr, XMCDMA_BD_SIDEBAND_STS_OFFSET);
-			BdCr = XMcdma_BdRead(CurBdPtr, XMCDMA_BD_CTRL_OFFSET);
-		} else {
-			BdSts = XMcdma_BdRead(CurBdPtr, XMCDMA_BD_STS_OFFSET);
-		}
-
-		if (!(BdSts & XMCDMA_BD_STS_COMPLETE_MASK))
-			break;
-
-		BdCount++;
-
-		/* Need to handle Tx case as well */
-		if ((!(Chan->IsRxChan) && (BdCr & XMCDMA_BD_CTRL_EOF_MASK)) ||
-		    (Chan->IsRxChan && (BdSts & XMCDMA_BD_STS_RXEOF_MASK))) {
-			BdPartialCount = 0;
-		} else {
-			BdPartialCount++;
-		}
-
-		if (CurBdPtr == Chan->BdTail) {
-			break;
-		}
 
-		CurBdPtr = (XMcdma_Bd *)(XMcdma_BdChainNextBd(Chan, CurBdPtr));
-	}
-
-	BdCount -= BdPartialCount;
+	BdCount = XBdRing_FromHw(&Chan->Core, BdLimit, &BdSet);
+	*BdSetPtr = (XMcdma_Bd *)(void *)BdSet;
+	if (BdCount == 0)
+		return 0;
 
-	if (BdCount) {
-		*BdSetPtr = Chan->BdHead;
-		Chan->BdSubmitCnt -= BdCount;
-		Chan->BdCnt += BdCount;
-		Chan->BdDoneCnt += BdCount;
-		XMCDMA_CHAN_SEEKAHEAD(Chan, Chan->BdHead, BdCount);
+	/* The BDs can be submitted again right away, XMcdma_BdChainFree()
+	 * only clears them.
+	 */
+	(void)XBdRing_Free(&Chan->Core, BdCount, BdSet);
+	Chan->BdDoneCnt += BdCount;
 
-		return BdCount;
-	} else {
-		*BdSetPtr = (XMcdma_Bd *)NULL;
-		return 0;
-	}
+	return BdCount;
 }
 
 /*****************************************************************************/
@@ -730,3 +666,39 @@ void XMcDma_DumpBd(XMcdma_Bd* BdPtr)
 
 	xil_printf("\r\n");
 }
+
+/*****************************************************************************/
+/**
+* This function reports the state of a BD to the BD ring engine. The complete
+* bit is in the sideband status word of Tx BDs and in the status word of Rx
+* BDs. The end of packet bit is in the control word of Tx BDs and in the
+* status word of Rx BDs.
+*
+* @param	Owner is the MCDMA Channel the BD is in.
+* @param	BdPtr is the BD to operate on.
+*
+* @return	XBDRING_BD_DONE and XBDRING_BD_LAST as they apply to the BD.
+*
+******************************************************************************/
+static u32 XMcdma_BdStatus(void *Owner, UINTPTR BdPtr)
+{
+	XMcdma_ChanCtrl *Chan = (XMcdma_ChanCtrl *)Owner;
+	u32 BdSts;
+	u32 Status = 0;
+
+	if (!(Chan->IsRxChan)) {
+		BdSts = XMcdma_BdRead(BdPtr, XMCDMA_BD_SIDEBAND_STS_OFFSET);
+		if (XMcdma_BdRead(BdPtr, XMCDMA_BD_CTRL_OFFSET) &
+		    XMCDMA_BD_CTRL_EOF_MASK)
+			Status |= XBDRING_BD_LAST;
+	} else {
+		BdSts = XMcdma_BdRead(BdPtr, XMCDMA_BD_STS_OFFSET);
+		if (BdSts & XMCDMA_BD_STS_RXEOF_MASK)
+			Status |= XBDRING_BD_LAST;
+	}
+
+	if (BdSts & XMCDMA_BD_STS_COMPLETE_MASK)
+		Status |= XBDRING_BD_DONE;
+
+	return Status;
+}
@@ -44,6 +44,8 @@
 * Ver   Who     Date     Changes
 * ----- ------  -------- ------------------------------------------------------
 * 1.0    adk    18/07/17 Initial version.
+* 1.1    ag     10/16/26 XMcdma_ChanSetCallBack() installs the packet drop
+*			 and the BD done handlers.
 *
 ******************************************************************************/
 
@@ -127,8 +129,11 @@ void XMcdma_ChanIntrHandler(void *Instance)
 * <pre>
 * HandlerType              Callback Function Type
 * -----------------------  --------------------------------------------------
-* XMCDMA_HANDLER_DONE      Channel Done handler
-* XMCDMA_HANDLER_ERROR     Channel Error handler
+* XMCDMA_CHAN_HANDLER_DONE     Channel Done handler
+* XMCDMA_CHAN_HANDLER_ERROR    Channel Error handler
+* XMCDMA_CHAN_HANDLER_PKTDROP  Channel Packet drop handler
+* XMCDMA_CHAN_HANDLER_BDDONE   Channel BDs returned by the completion
+*                              scheduler, see XMcdma_SchedService()
 *
 * </pre>
 *
@@ -155,7 +160,9 @@ s32 XMcdma_ChanSetCallBack(XMcdma_ChanCtrl *Chan, XMcdma_ChanHandler HandlerType
         Xil_AssertNonvoid(CallBackFunc != NULL);
         Xil_AssertNonvoid(CallBackRef != NULL);
         Xil_AssertNonvoid((HandlerType == XMCDMA_CHAN_HANDLER_DONE) ||
-			  (HandlerType == XMCDMA_CHAN_HANDLER_ERROR));
+			  (HandlerType == XMCDMA_CHAN_HANDLER_ERROR) ||
+			  (HandlerType == XMCDMA_CHAN_HANDLER_PKTDROP) ||
+			  (HandlerType == XMCDMA_CHAN_HANDLER_BDDONE));
 
 	/*
          * Calls the respective callback function corresponding to
@@ -176,6 +183,20 @@ s32 XMcdma_ChanSetCallBack(XMcdma_ChanCtrl *Chan, XMcdma_ChanHandler HandlerType
 		Status = (XST_SUCCESS);
 		break;
 
+	case XMCDMA_CHAN_HANDLER_PKTDROP:
+		Chan->PktdropHandler =
+			(XMcdma_ChanPktDropHandler)((void *)CallBackFunc);
+		Chan->PktDropRef = CallBackRef;
+		Status = (XST_SUCCESS);
+		break;
+
+	case XMCDMA_CHAN_HANDLER_BDDONE:
+		Chan->BdDoneHandler =
+			(XMcdma_ChanBdDoneHandler)((void *)CallBackFunc);
+		Chan->BdDoneRef = CallBackRef;
+		Status = (XST_SUCCESS);
+		break;
+
 	default:
 		Status = (XST_INVALID_PARAM);
 		break;
@@ -0,0 +1,542 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xmcdma_sched.c
+* @addtogroup mcdma_v1_0
+* @{
+*
+* This file contains the completion scheduler of the MCDMA driver. It
+* services all channels of a direction that have completed BDs in one pass,
+* in weighted round-robin order, and returns the BDs to the per channel
+* XMCDMA_CHAN_HANDLER_BDDONE callbacks. See xmcdma.h for an overview.
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.1    ag     10/16/26 Initial version.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xmcdma.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XMCDMA_SCHED_MAX_WEIGHT		15U
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Mask of the channels from Chan_id onwards, channel 1 being bit 0.
+ */
+#define XMcdma_SchedMaskFrom(Chan_id) \
+	(~((1U << ((Chan_id) - 1U)) - 1U))
+
+/************************** Function Prototypes ******************************/
+
+static u32 XMcdma_SchedChan(XMcdma_Sched *Sched, XMcdma_ChanCtrl *Chan,
+			    u32 Budget);
+static u32 XMcdma_SchedLowestChan(u32 Mask);
+static void XMcdma_SchedUpdateDir(XMcdma *InstancePtr, u32 IsRx);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes the completion scheduler. All channels get
+* weight 1 and the weights of the MM2S channels are programmed into the
+* hardware.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance to be worked on.
+* @param	Quantum is the number of BDs a channel of weight 1 may return
+*		in one round. A channel of weight W returns up to
+*		W * Quantum BDs before the next channel is visited.
+*
+* @return
+*		- XST_SUCCESS if the scheduler was initialized.
+*		- XST_INVALID_PARAM if Quantum is 0.
+*
+* @note		No policy is installed, see XMcdma_SchedSetPolicy().
+*
+******************************************************************************/
+s32 XMcdma_SchedInit(XMcdma *InstancePtr, u32 Quantum)
+{
+	XMcdma_ChanCtrl *Chan;
+	int Chan_id;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (Quantum == 0U)
+		return XST_INVALID_PARAM;
+
+	InstancePtr->TxSched.Quantum = Quantum;
+	InstancePtr->TxSched.NextChan = 1U;
+	InstancePtr->TxSched.Carry = 0U;
+	InstancePtr->RxSched = InstancePtr->TxSched;
+	InstancePtr->Policy = NULL;
+	InstancePtr->PolicyRef = NULL;
+	InstancePtr->PolicyInterval = 0U;
+	InstancePtr->PolicyPasses = 0U;
+
+	if (InstancePtr->Config.HasMM2S) {
+		for (Chan_id = 1; Chan_id <= InstancePtr->Config.TxNumChannels;
+		     Chan_id++) {
+			Chan = XMcdma_GetMcdmaTxChan(InstancePtr, Chan_id);
+			(void)XMcdma_SchedSetChanWeight(Chan, 1U);
+			Chan->SchedDone = 0U;
+		}
+	}
+
+	if (InstancePtr->Config.HasS2MM) {
+		for (Chan_id = 1; Chan_id <= InstancePtr->Config.RxNumChannels;
+		     Chan_id++) {
+			Chan = XMcdma_GetMcdmaRxChan(InstancePtr, Chan_id);
+			Chan->SchedWeight = 1U;
+			Chan->SchedDone = 0U;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function services the channels of one direction that have completed
+* BDs.
+*
+* Only the channels flagged in the interrupt service register, and the
+* channels that used up their share in an earlier round, are visited. Each
+* visit acknowledges the channel interrupts, calls the error and packet drop
+* callbacks of the channel, and hands up to SchedWeight * Quantum completed
+* BDs to the BD done callback of the channel. The BDs are freed when the
+* callback returns. Rounds start at the channel after the last one visited
+* and are repeated until no channel has work left or MaxBds BDs have been
+* returned.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance to be worked on.
+* @param	Direction is XMCDMA_MEM_TO_DEV (MM2S) or XMCDMA_DEV_TO_MEM
+*		(S2MM).
+* @param	MaxBds is the number of BDs after which the function returns,
+*		0 for no limit. Channels with BDs left are visited first by
+*		the next call.
+*
+* @return	The number of BDs returned to the callbacks.
+*
+* @note		The installed weight policy is run every PolicyInterval
+*		calls.
+*
+******************************************************************************/
+u32 XMcdma_SchedService(XMcdma *InstancePtr, u32 Direction, u32 MaxBds)
+{
+	XMcdma_Sched *Sched;
+	XMcdma_ChanCtrl *Chan;
+	u32 Pending;
+	u32 Round;
+	u32 Chan_id;
+	u32 Budget;
+	u32 Total = 0U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Direction == XMCDMA_MEM_TO_DEV) ||
+			  (Direction == XMCDMA_DEV_TO_MEM));
+
+	if (Direction == XMCDMA_MEM_TO_DEV)
+		Sched = &InstancePtr->TxSched;
+	else
+		Sched = &InstancePtr->RxSched;
+	Xil_AssertNonvoid(Sched->Quantum != 0U);
+
+	do {
+		if (Direction == XMCDMA_MEM_TO_DEV)
+			Pending = XMcdma_ReadReg(InstancePtr->Config.BaseAddress,
+						 XMCDMA_TXINT_SER_OFFSET);
+		else
+			Pending = XMcdma_ReadReg(InstancePtr->Config.BaseAddress,
+						 XMCDMA_RX_OFFSET +
+						 XMCDMA_RXINT_SER_OFFSET);
+		Pending |= Sched->Carry;
+		Sched->Carry = 0U;
+
+		/* Channels from NextChan onwards first, then the others */
+		Round = Pending & XMcdma_SchedMaskFrom(Sched->NextChan);
+		Pending &= ~Round;
+		while ((Round | Pending) != 0U) {
+			if (Round == 0U) {
+				Round = Pending;
+				Pending = 0U;
+			}
+			Chan_id = XMcdma_SchedLowestChan(Round);
+			Round &= Round - 1U;
+
+			if (Direction == XMCDMA_MEM_TO_DEV)
+				Chan = XMcdma_GetMcdmaTxChan(InstancePtr, Chan_id);
+			else
+				Chan = XMcdma_GetMcdmaRxChan(InstancePtr, Chan_id);
+
+			Budget = (u32)Chan->SchedWeight * Sched->Quantum;
+			if ((MaxBds != 0U) && (Budget > MaxBds - Total))
+				Budget = MaxBds - Total;
+
+			Total += XMcdma_SchedChan(Sched, Chan, Budget);
+			Sched->NextChan = (Chan_id % XMCDMA_MAX_CHAN_PER_DEVICE) + 1U;
+
+			if ((MaxBds != 0U) && (Total >= MaxBds)) {
+				/* Not visited in this round, visit them next */
+				Sched->Carry |= Round | Pending;
+				break;
+			}
+		}
+	} while ((Sched->Carry != 0U) && ((MaxBds == 0U) || (Total < MaxBds)));
+
+	if (InstancePtr->Policy != NULL) {
+		InstancePtr->PolicyPasses++;
+		if (InstancePtr->PolicyPasses >= InstancePtr->PolicyInterval)
+			XMcdma_SchedUpdateWeights(InstancePtr);
+	}
+
+	return Total;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the S2MM(RX) interrupt handler of the completion
+* scheduler, it services all S2MM channels, see XMcdma_SchedService().
+*
+* The application is responsible for connecting this function to the
+* interrupt system in place of XMcdma_IntrHandler().
+*
+* @param	Instance is a pointer to the XMcdma instance to be worked on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XMcdma_SchedIntrHandler(void *Instance)
+{
+	(void)XMcdma_SchedService((XMcdma *)Instance, XMCDMA_DEV_TO_MEM, 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the MM2S(TX) interrupt handler of the completion
+* scheduler, it services all MM2S channels, see XMcdma_SchedService().
+*
+* The application is responsible for connecting this function to the
+* interrupt system in place of XMcdma_TxIntrHandler().
+*
+* @param	Instance is a pointer to the XMcdma instance to be worked on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XMcdma_SchedTxIntrHandler(void *Instance)
+{
+	(void)XMcdma_SchedService((XMcdma *)Instance, XMCDMA_MEM_TO_DEV, 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the scheduler weight of a channel. The weight of an
+* MM2S channel is also programmed into the hardware WRR registers.
+*
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	Weight is the weight, 1 to 15.
+*
+* @return
+*		- XST_SUCCESS if the weight was set.
+*		- XST_INVALID_PARAM if Weight is out of range.
+*
+* @note		The hardware uses the MM2S weights only with the WRR
+*		scheduler configured in the core.
+*
+******************************************************************************/
+s32 XMcdma_SchedSetChanWeight(XMcdma_ChanCtrl *Chan, u8 Weight)
+{
+	Xil_AssertNonvoid(Chan != NULL);
+
+	if ((Weight == 0U) || (Weight > XMCDMA_SCHED_MAX_WEIGHT))
+		return XST_INVALID_PARAM;
+
+	if (!Chan->IsRxChan)
+		(void)XMCdma_SetChan_Weight(Chan, Weight);
+	Chan->SchedWeight = Weight;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs the weight policy of the completion scheduler.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance to be worked on.
+* @param	Policy is the policy, XMcdma_SchedBacklogPolicy() or one of the
+*		application, NULL to keep the weights as they are.
+* @param	PolicyRef is passed to the policy.
+* @param	Interval is the number of XMcdma_SchedService() calls between
+*		two runs of the policy.
+*
+* @return
+*		- XST_SUCCESS if the policy was installed.
+*		- XST_INVALID_PARAM if Interval is 0.
+*
+* @note		None.
+*
+******************************************************************************/
+s32 XMcdma_SchedSetPolicy(XMcdma *InstancePtr, XMcdma_WeightPolicy Policy,
+			  void *PolicyRef, u32 Interval)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if ((Policy != NULL) && (Interval == 0U))
+		return XST_INVALID_PARAM;
+
+	InstancePtr->Policy = Policy;
+	InstancePtr->PolicyRef = PolicyRef;
+	InstancePtr->PolicyInterval = Interval;
+	InstancePtr->PolicyPasses = 0U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the weight policy on all channels and applies the
+* weights it returns.
+*
+* The backlog of an MM2S channel is the number of BDs it has with the
+* hardware, the data waiting to be sent. The backlog of an S2MM channel is
+* the number of BDs it returned since the last update, its receive rate.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance to be worked on.
+*
+* @return	None.
+*
+* @note		XMcdma_SchedService() calls it every PolicyInterval calls, it
+*		can also be called by the application.
+*
+******************************************************************************/
+void XMcdma_SchedUpdateWeights(XMcdma *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->PolicyPasses = 0U;
+	if (InstancePtr->Policy == NULL)
+		return;
+
+	if (InstancePtr->Config.HasMM2S)
+		XMcdma_SchedUpdateDir(InstancePtr, 0U);
+	if (InstancePtr->Config.HasS2MM)
+		XMcdma_SchedUpdateDir(InstancePtr, 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is a weight policy that makes the weight of a channel
+* proportional to its backlog, from 1 for an empty backlog to 15 for the
+* largest one.
+*
+* @param	PolicyRef is not used.
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	Backlog is the backlog of the channel.
+* @param	MaxBacklog is the largest backlog of the direction.
+*
+* @return	The new weight of the channel.
+*
+* @note		None.
+*
+******************************************************************************/
+u8 XMcdma_SchedBacklogPolicy(void *PolicyRef, XMcdma_ChanCtrl *Chan,
+			     u32 Backlog, u32 MaxBacklog)
+{
+	u64 Weight;
+
+	(void)PolicyRef;
+	(void)Chan;
+
+	if (MaxBacklog == 0U)
+		return 1U;
+
+	Weight = ((u64)Backlog * (XMCDMA_SCHED_MAX_WEIGHT - 1U) +
+		  (MaxBacklog / 2U)) / MaxBacklog;
+
+	return (u8)(Weight + 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* Visit one channel: acknowledge its interrupts, report errors and packet
+* drops, and return up to Budget completed BDs to its callback.
+*
+* @param	Sched is the scheduler of the channel direction.
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	Budget is the maximum number of BDs to return.
+*
+* @return	The number of BDs returned.
+*
+******************************************************************************/
+static u32 XMcdma_SchedChan(XMcdma_Sched *Sched, XMcdma_ChanCtrl *Chan,
+			    u32 Budget)
+{
+	XMcdma_Bd *BdSetPtr;
+	u32 IrqStatus;
+	int BdCount;
+
+	IrqStatus = XMcdma_ChanGetIrq(Chan);
+	if (IrqStatus != 0U)
+		XMcdma_ChanAckIrq(Chan, IrqStatus);
+
+	if ((IrqStatus & (XMCDMA_IRQ_DELAY_MASK | XMCDMA_IRQ_IOC_MASK)) != 0U)
+		Chan->ChanState = XMCDMA_CHAN_IDLE;
+
+	if ((IrqStatus & XMCDMA_IRQ_ERROR_MASK) != 0U) {
+		Chan->ChanState = XMCDMA_CHAN_PAUSE;
+		if (Chan->ErrorHandler != NULL)
+			Chan->ErrorHandler(Chan->ErrorRef, IrqStatus);
+	}
+
+	if (((IrqStatus & XMCDMA_IRQ_PKTDROP_MASK) != 0U) &&
+	    (Chan->PktdropHandler != NULL))
+		Chan->PktdropHandler(Chan->PktDropRef);
+
+	if (Budget == 0U)
+		return 0U;
+
+	BdCount = XMcdma_BdChainFromHW(Chan, Budget, &BdSetPtr);
+	if (BdCount <= 0)
+		return 0U;
+
+	Chan->SchedDone += (u32)BdCount;
+	if (Chan->BdDoneHandler != NULL)
+		Chan->BdDoneHandler(Chan->BdDoneRef, (u32)BdCount, BdSetPtr);
+	(void)XMcdma_BdChainFree(Chan, BdCount, BdSetPtr);
+
+	/* Its share is used up, there may be more BDs to return */
+	if ((u32)BdCount == Budget)
+		Sched->Carry |= 1U << (Chan->Chan_id - 1U);
+
+	return (u32)BdCount;
+}
+
+/*****************************************************************************/
+/**
+*
+* Get the lowest channel of a mask, channel 1 being bit 0.
+*
+* @param	Mask is the channel mask, not 0.
+*
+* @return	The channel number.
+*
+******************************************************************************/
+static u32 XMcdma_SchedLowestChan(u32 Mask)
+{
+#if defined (__GNUC__)
+	return (u32)__builtin_ctz(Mask) + 1U;
+#else
+	u32 Chan_id = 1U;
+
+	while ((Mask & 1U) == 0U) {
+		Mask >>= 1U;
+		Chan_id++;
+	}
+
+	return Chan_id;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Run the weight policy on the channels of one direction.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance to be worked on.
+* @param	IsRx is 1 for the S2MM channels, 0 for the MM2S channels.
+*
+******************************************************************************/
+static void XMcdma_SchedUpdateDir(XMcdma *InstancePtr, u32 IsRx)
+{
+	u32 Backlog[XMCDMA_MAX_CHAN_PER_DEVICE + 1];
+	XMcdma_ChanCtrl *Chan;
+	u32 MaxBacklog = 0U;
+	int NumChannels;
+	int Chan_id;
+	u8 Weight;
+
+	NumChannels = IsRx ? InstancePtr->Config.RxNumChannels :
+			     InstancePtr->Config.TxNumChannels;
+
+	for (Chan_id = 1; Chan_id <= NumChannels; Chan_id++) {
+		if (IsRx) {
+			Chan = XMcdma_GetMcdmaRxChan(InstancePtr, Chan_id);
+			Backlog[Chan_id] = Chan->SchedDone;
+		} else {
+			Chan = XMcdma_GetMcdmaTxChan(InstancePtr, Chan_id);
+			Backlog[Chan_id] = XBdRing_GetHwCnt(&Chan->Core);
+		}
+		Chan->SchedDone = 0U;
+		if (Backlog[Chan_id] > MaxBacklog)
+			MaxBacklog = Backlog[Chan_id];
+	}
+
+	for (Chan_id = 1; Chan_id <= NumChannels; Chan_id++) {
+		Chan = IsRx ? XMcdma_GetMcdmaRxChan(InstancePtr, Chan_id) :
+			      XMcdma_GetMcdmaTxChan(InstancePtr, Chan_id);
+		Weight = InstancePtr->Policy(InstancePtr->PolicyRef, Chan,
+					     Backlog[Chan_id], MaxBacklog);
+		if (Weight > XMCDMA_SCHED_MAX_WEIGHT)
+			Weight = XMCDMA_SCHED_MAX_WEIGHT;
+		else if (Weight == 0U)
+			Weight = 1U;
+
+		/* Register writes only for weights that changed */
+		if (Weight != Chan->SchedWeight)
+			(void)XMcdma_SchedSetChanWeight(Chan, Weight);
+	}
+}
+
+/** @} */
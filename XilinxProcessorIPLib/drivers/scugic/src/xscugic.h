@@ -179,6 +179,8 @@
 *                     XScuGic_InterruptUnmapFromCpu, These API's can be used
 *                     by applications to unmap specific/all interrupts from
 *                     target CPU.
+*       ag   10/16/26 Added XIL_TRACE_ID_SCUGIC_IRQ trace points around the
+*                     handler call in XScuGic_InterruptHandler.
 *
 * </pre>
 *
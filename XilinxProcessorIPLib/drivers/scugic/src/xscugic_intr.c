@@ -81,6 +81,7 @@
 #include "xil_types.h"
 #include "xil_assert.h"
 #include "xscugic.h"
+#include "xil_trace.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -156,7 +157,9 @@ void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 	     */
 	    TablePtr = &(InstancePtr->Config->HandlerTable[InterruptID]);
 		if(TablePtr != NULL) {
+		XIL_TRACE_BEGIN(XIL_TRACE_ID_SCUGIC_IRQ, InterruptID);
 	        TablePtr->Handler(TablePtr->CallBackRef);
+		XIL_TRACE_END(XIL_TRACE_ID_SCUGIC_IRQ, InterruptID);
 		}
 
 	IntrExit:
@@ -90,6 +90,10 @@
 * 3.4   mn     10/17/17 Use different commands for single and multi block
 *                       transfers
 *       mn     03/02/18 Move UHS macro check to SD card initialization routine
+*       ag     10/16/26 Split filling and programming of the ADMA2 table,
+*                       polled transfers use a task in command queue mode.
+*       ag     10/16/26 Added XSdPs_CmdTransferMode, which takes the transfer
+*                       mode as an argument.
 * </pre>
 *
 ******************************************************************************/
@@ -97,6 +101,7 @@
 /***************************** Include Files *********************************/
 #include "xsdps.h"
 #include "sleep.h"
+#include "xil_trace.h"
 
 /************************** Constant Definitions *****************************/
 #define XSDPS_CMD8_VOL_PATTERN	0x1AAU
@@ -131,7 +136,15 @@
 /************************** Function Prototypes ******************************/
 u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd);
 s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt);
+s32 XSdPs_CmdTransferMode(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+			u16 Mode);
 void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff);
+void XSdPs_FillADMA2DescTbl(XSdPs *InstancePtr, XSdPs_Adma2Descriptor *DescTbl,
+			u32 BlkCnt, const u8 *Buff);
+void XSdPs_SetADMA2DescTblAddr(XSdPs *InstancePtr,
+			const XSdPs_Adma2Descriptor *DescTbl);
+s32 XSdPs_CmdQIssue(XSdPs *InstancePtr, u32 TaskId, u32 Arg, u32 BlkCnt,
+			u8 IsRead, u8 Queued);
 extern s32 XSdPs_Uhs_ModeInit(XSdPs *InstancePtr, u8 Mode);
 static s32 XSdPs_IdentifyCard(XSdPs *InstancePtr);
 static s32 XSdPs_Switch_Voltage(XSdPs *InstancePtr);
@@ -193,6 +206,15 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	InstancePtr->SectorCount = 0;
 	InstancePtr->Mode = XSDPS_DEFAULT_SPEED_MODE;
 	InstancePtr->Config_TapDelay = NULL;
+	InstancePtr->AsyncHead = 0U;
+	InstancePtr->AsyncCount = 0U;
+	InstancePtr->AsyncLock = 0U;
+	InstancePtr->AsyncActive = 0U;
+	InstancePtr->AsyncTbl = 0U;
+	InstancePtr->AsyncPrepared = 0U;
+	InstancePtr->CmdQEnabled = 0U;
+	InstancePtr->CmdQDepth = 0U;
+	InstancePtr->CmdQQueued = 0U;
 
 	/* Disable bus power and issue emmc hw reset */
 	if ((XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
@@ -373,7 +395,8 @@ s32 XSdPs_SdCardInitialize(XSdPs *InstancePtr)
 		}
 	}
 
-	/* CMD0 no response expected */
+	/* CMD0 no response expected, it also ends command queue mode */
+	InstancePtr->CmdQEnabled = 0U;
 	Status = XSdPs_CmdTransfer(InstancePtr, (u32)CMD0, 0U, 0U);
 	if (Status != XST_SUCCESS) {
 		Status = XST_FAILURE;
@@ -1087,8 +1110,37 @@ RETURN_PATH:
 * 		- XST_FAILURE if failure - could be because another transfer
 * 			is in progress or command or data inhibit is set
 *
+* @note		The transfer mode is the one last set in TransferMode.
+*
 ******************************************************************************/
 s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
+{
+	return XSdPs_CmdTransferMode(InstancePtr, Cmd, Arg, BlkCnt,
+			TransferMode);
+}
+
+/*****************************************************************************/
+/**
+* This function does SD command generation with the given transfer mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Cmd is the command to be sent.
+* @param	Arg is the argument to be sent along with the command.
+* 		This could be address or any other information
+* @param	BlkCnt - Block count passed by the user.
+* @param	Mode is the value of the transfer mode register.
+*
+* @return
+* 		- XST_SUCCESS if initialization was successful
+* 		- XST_FAILURE if failure - could be because another transfer
+* 			is in progress or command or data inhibit is set
+*
+* @note		Unlike XSdPs_CmdTransfer, the shared TransferMode is neither
+*		read nor written, so this can be used from interrupt context.
+*
+******************************************************************************/
+s32 XSdPs_CmdTransferMode(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+			u16 Mode)
 {
 	u32 PresentStateReg;
 	u32 CommandReg;
@@ -1098,6 +1150,8 @@ s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	XIL_TRACE_BEGIN(XIL_TRACE_ID_SDPS_CMD, Cmd);
+
 	/*
 	 * Check the command inhibit to make sure no other
 	 * command transfer is in progress
@@ -1150,7 +1204,7 @@ s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 	}
 
 	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_XFER_MODE_OFFSET,
-			(CommandReg << 16) | TransferMode);
+			(CommandReg << 16) | Mode);
 
 	/* Polling for response for now */
 	do {
@@ -1186,6 +1240,7 @@ s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 	Status = XST_SUCCESS;
 
 RETURN_PATH:
+		XIL_TRACE_END(XIL_TRACE_ID_SDPS_CMD, Cmd);
 		return Status;
 
 }
@@ -1255,6 +1310,7 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		case CMD11:
 		case CMD10:
 		case CMD12:
+		case CMD13:
 		case ACMD13:
 		case CMD16:
 			RetVal |= RESP_R1;
@@ -1279,6 +1335,17 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		case ACMD51:
 			RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
 		break;
+		case CMD44:
+		case CMD45:
+			RetVal |= RESP_R1;
+		break;
+		case CMD46:
+		case CMD47:
+			RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
+		break;
+		case CMD48:
+			RetVal |= RESP_R1B;
+		break;
 		case CMD52:
 		case CMD55:
 			RetVal |= RESP_R1;
@@ -1315,6 +1382,14 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	u32 PresentStateReg;
 	u32 StatusReg;
 
+	XIL_TRACE_BEGIN(XIL_TRACE_ID_SDPS_READ, BlkCnt);
+
+	/* The bus belongs to the asynchronous transfers until they are done */
+	if (InstancePtr->AsyncCount != 0U) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
 				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
 				!= XSDPS_CAPS_EMB_SLOT)) {
@@ -1346,7 +1421,14 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 			BlkCnt * XSDPS_BLK_SIZE_512_MASK);
 	}
 
-	if (BlkCnt == 1U) {
+	if (InstancePtr->CmdQEnabled != 0U) {
+		/* CMD17/CMD18 are illegal in command queue mode */
+		Status = XSdPs_CmdQIssue(InstancePtr, 0U, Arg, BlkCnt, 1U, 0U);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	} else if (BlkCnt == 1U) {
 		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
 			XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
@@ -1392,6 +1474,7 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	Status = XST_SUCCESS;
 
 RETURN_PATH:
+	XIL_TRACE_END(XIL_TRACE_ID_SDPS_READ, BlkCnt);
 	return Status;
 }
 
@@ -1417,6 +1500,14 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	u32 PresentStateReg;
 	u32 StatusReg;
 
+	XIL_TRACE_BEGIN(XIL_TRACE_ID_SDPS_WRITE, BlkCnt);
+
+	/* The bus belongs to the asynchronous transfers until they are done */
+	if (InstancePtr->AsyncCount != 0U) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
 				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
 				!= XSDPS_CAPS_EMB_SLOT)) {
@@ -1449,7 +1540,14 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 			BlkCnt * XSDPS_BLK_SIZE_512_MASK);
 	}
 
-	if (BlkCnt == 1U) {
+	if (InstancePtr->CmdQEnabled != 0U) {
+		/* CMD24/CMD25 are illegal in command queue mode */
+		Status = XSdPs_CmdQIssue(InstancePtr, 0U, Arg, BlkCnt, 0U, 0U);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	} else if (BlkCnt == 1U) {
 		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
 
 		/* Send single block write command */
@@ -1495,6 +1593,7 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	Status = XST_SUCCESS;
 
 	RETURN_PATH:
+		XIL_TRACE_END(XIL_TRACE_ID_SDPS_WRITE, BlkCnt);
 		return Status;
 }
 
@@ -1546,12 +1645,37 @@ RETURN_PATH:
 *
 ******************************************************************************/
 void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff)
+{
+	XSdPs_FillADMA2DescTbl(InstancePtr, InstancePtr->Adma2_DescrTbl,
+			BlkCnt, Buff);
+	XSdPs_SetADMA2DescTblAddr(InstancePtr, InstancePtr->Adma2_DescrTbl);
+}
+
+/*****************************************************************************/
+/**
+*
+* API to write an ADMA2 descriptor table for a transfer without handing it
+* to the host controller.
+*
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	DescTbl is the table of XSDPS_ADMA2_DESC_NUM descriptors.
+* @param	BlkCnt - block count.
+* @param	Buff pointer to data buffer.
+*
+* @return	None
+*
+* @note		The block size is taken from the host controller.
+*
+******************************************************************************/
+void XSdPs_FillADMA2DescTbl(XSdPs *InstancePtr, XSdPs_Adma2Descriptor *DescTbl,
+			u32 BlkCnt, const u8 *Buff)
 {
 	u32 TotalDescLines = 0U;
 	u32 DescNum = 0U;
 	u32 BlkSize = 0U;
 
-	/* Setup ADMA2 - Write descriptor table and point ADMA SAR to it */
+	/* Setup ADMA2 - Write descriptor table */
 	BlkSize = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
 					XSDPS_BLK_SIZE_OFFSET);
 	BlkSize = BlkSize & XSDPS_BLK_SIZE_MASK;
@@ -1571,45 +1695,63 @@ void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff)
 
 	for (DescNum = 0U; DescNum < (TotalDescLines-1); DescNum++) {
 #ifdef __aarch64__
-		InstancePtr->Adma2_DescrTbl[DescNum].Address =
+		DescTbl[DescNum].Address =
 				(u64)((UINTPTR)Buff + (DescNum*XSDPS_DESC_MAX_LENGTH));
 #else
-		InstancePtr->Adma2_DescrTbl[DescNum].Address =
+		DescTbl[DescNum].Address =
 				(u32)((UINTPTR)Buff + (DescNum*XSDPS_DESC_MAX_LENGTH));
 #endif
-		InstancePtr->Adma2_DescrTbl[DescNum].Attribute =
+		DescTbl[DescNum].Attribute =
 				XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
 		/* This will write '0' to length field which indicates 65536 */
-		InstancePtr->Adma2_DescrTbl[DescNum].Length =
+		DescTbl[DescNum].Length =
 				(u16)XSDPS_DESC_MAX_LENGTH;
 	}
 
 #ifdef __aarch64__
-	InstancePtr->Adma2_DescrTbl[TotalDescLines-1].Address =
+	DescTbl[TotalDescLines-1].Address =
 			(u64)((UINTPTR)Buff + (DescNum*XSDPS_DESC_MAX_LENGTH));
 #else
-	InstancePtr->Adma2_DescrTbl[TotalDescLines-1].Address =
+	DescTbl[TotalDescLines-1].Address =
 			(u32)((UINTPTR)Buff + (DescNum*XSDPS_DESC_MAX_LENGTH));
 #endif
 
-	InstancePtr->Adma2_DescrTbl[TotalDescLines-1].Attribute =
+	DescTbl[TotalDescLines-1].Attribute =
 			XSDPS_DESC_TRAN | XSDPS_DESC_END | XSDPS_DESC_VALID;
 
-	InstancePtr->Adma2_DescrTbl[TotalDescLines-1].Length =
+	DescTbl[TotalDescLines-1].Length =
 			(u16)((BlkCnt*BlkSize) - (DescNum*XSDPS_DESC_MAX_LENGTH));
 
+	if (InstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange((INTPTR)DescTbl,
+			sizeof(XSdPs_Adma2Descriptor) * XSDPS_ADMA2_DESC_NUM);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* API to point the ADMA of the host controller to a descriptor table.
+*
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	DescTbl is the table written by XSdPs_FillADMA2DescTbl().
+*
+* @return	None
+*
+* @note		None.
+*
+******************************************************************************/
+void XSdPs_SetADMA2DescTblAddr(XSdPs *InstancePtr,
+			const XSdPs_Adma2Descriptor *DescTbl)
+{
 #ifdef __aarch64__
 	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_EXT_OFFSET,
-			(u32)(((u64)&(InstancePtr->Adma2_DescrTbl[0]))>>32));
+			(u32)(((u64)(UINTPTR)DescTbl)>>32));
 #endif
 
 	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
-			(u32)(UINTPTR)&(InstancePtr->Adma2_DescrTbl[0]));
-
-	if (InstancePtr->Config.IsCacheCoherent == 0) {
-		Xil_DCacheFlushRange((INTPTR)&(InstancePtr->Adma2_DescrTbl[0]),
-			sizeof(XSdPs_Adma2Descriptor) * 32U);
-	}
+			(u32)(UINTPTR)DescTbl);
 }
 
 /*****************************************************************************/
@@ -1663,7 +1805,8 @@ s32 XSdPs_MmcCardInitialize(XSdPs *InstancePtr)
 		}
 	}
 
-	/* CMD0 no response expected */
+	/* CMD0 no response expected, it also ends command queue mode */
+	InstancePtr->CmdQEnabled = 0U;
 	Status = XSdPs_CmdTransfer(InstancePtr, CMD0, 0U, 0U);
 	if (Status != XST_SUCCESS) {
 		Status = XST_FAILURE;
@@ -84,8 +84,36 @@
 * descriptor table and hence care will have to be taken to call read/write
 * API's in a loop for large file sizes.
 *
-* Interrupt mode is not supported because it offers no improvement when used
-* with file system.
+* Asynchronous transfers:
+* XSdPs_ReadAsync() and XSdPs_WriteAsync() queue a transfer of up to
+* XSDPS_ASYNC_MAX_BLKCNT blocks and return at once; a callback reports the
+* completion. Up to XSDPS_ASYNC_QUEUE_DEPTH transfers are queued. The ADMA2
+* descriptor table of the next transfer is built while the current one is on
+* the bus and the next command is issued as soon as transfer complete is
+* signalled. Completion is detected by XSdPs_IntrHandler(), which the
+* application connects to the SD interrupt, or by calling XSdPs_AsyncPoll().
+* The interrupt signals are enabled by the driver only while transfers are
+* queued. XSdPs_ReadPolled() and XSdPs_WritePolled() return XST_DEVICE_BUSY
+* while transfers are queued, and no other driver function may be called
+* until XSdPs_AsyncWait() has drained the queue.
+*
+* Scatter-gather transfers:
+* XSdPs_ReadPolledV() and XSdPs_WritePolledV() transfer a list of DMA-able
+* segments to or from consecutive blocks of the card without copying. The
+* caller supplies the ADMA2 descriptor table, so its size, and not the table
+* in the instance, limits the transfer. A segment needs one descriptor per
+* 64KB; the block count of one command is limited to XSDPS_SG_MAX_BLKCNT by
+* the host controller, longer transfers are issued as consecutive commands
+* along the same table, which takes one more descriptor per command.
+*
+* Command queue:
+* eMMC 5.1 devices which report command queue support in EXT_CSD can be
+* switched to command queue mode with XSdPs_CmdQEnable(). The host controller
+* has no command queue engine, the driver queues the tasks itself with
+* CMD44/CMD45 and executes them with CMD46/CMD47. An asynchronous transfer is
+* queued on the device while the transfer ahead of it is moving data, so the
+* device can prepare it. The polled read and write functions use a single
+* task in this mode.
 *
 * eMMC support:
 * SD driver supports SD and eMMC based on the "enable MMC" parameter in SDK.
@@ -94,7 +122,7 @@
 * using 4-bit and high speed mode currently.
 *
 * Features not supported include - card write protect, password setting,
-* lock/unlock, interrupts, SDMA mode, programmed I/O mode and
+* lock/unlock, card interrupts, SDMA mode, programmed I/O mode and
 * 64-bit addressed ADMA2, erase/pre-erase commands.
 *
 * <pre>
@@ -149,6 +177,12 @@
 *       mn     08/17/17 Enabled CCI support for A53 by adding cache coherency
 *                       information.
 *       mn     09/06/17 Resolved compilation errors with IAR toolchain
+* 3.4   ag     10/16/26 Added XIL_TRACE_ID_SDPS_* trace points for commands
+*                       and polled reads and writes.
+*       ag     10/16/26 Added interrupt driven asynchronous reads and writes
+*                       with a request queue, and eMMC command queue mode.
+*       ag     10/16/26 Added scatter-gather reads and writes with a caller
+*                       supplied ADMA2 descriptor table.
 *
 * </pre>
 *
@@ -174,6 +208,14 @@ extern "C" {
 #define XSDPS_CT_ERROR	0x2U	/**< Command timeout flag */
 #define MAX_TUNING_COUNT	40U		/**< Maximum Tuning count */
 
+#define XSDPS_ADMA2_DESC_NUM	32U	/**< Descriptors in an ADMA2 table */
+#define XSDPS_ASYNC_QUEUE_DEPTH	8U	/**< Queued asynchronous transfers */
+#define XSDPS_ASYNC_MAX_BLKCNT	((XSDPS_ADMA2_DESC_NUM * \
+				XSDPS_DESC_MAX_LENGTH) / XSDPS_BLK_SIZE_512_MASK)
+				/**< Blocks in an asynchronous transfer */
+#define XSDPS_SG_MAX_BLKCNT	0xFFFFU	/**< Blocks in one command of a
+					  scatter-gather transfer */
+
 /**************************** Type Definitions *******************************/
 
 typedef void (*XSdPs_ConfigTap) (u32 Bank, u32 DeviceId, u32 CardType);
@@ -210,6 +252,33 @@ typedef struct {
 }  __attribute__((__packed__))XSdPs_Adma2Descriptor;
 #endif
 
+/**
+ * Segment of a scatter-gather transfer
+ */
+typedef struct {
+	void *Base;		/**< Start of the segment, 4 byte aligned */
+	u32 Length;		/**< Length in bytes, a multiple of 4 */
+} XSdPs_IoVec;
+
+/**
+ * Completion callback of an asynchronous transfer. Status is XST_SUCCESS or
+ * XST_FAILURE. It is called from XSdPs_IntrHandler() or XSdPs_AsyncPoll()
+ * and may queue further transfers.
+ */
+typedef void (*XSdPs_AsyncHandler) (void *CallBackRef, s32 Status);
+
+/**
+ * Queued asynchronous transfer
+ */
+typedef struct {
+	u32 Arg;			/**< Card address */
+	u32 BlkCnt;			/**< Number of blocks */
+	const u8 *Buff;			/**< Data buffer */
+	u8 IsRead;			/**< Card to host */
+	XSdPs_AsyncHandler Handler;	/**< Completion callback */
+	void *CallBackRef;		/**< Callback reference */
+} XSdPs_AsyncReq;
+
 /**
  * The XSdPs driver instance data. The user is required to allocate a
  * variable of this type for every SD device in the system. A pointer
@@ -242,6 +311,25 @@ typedef struct {
 #else
 	XSdPs_Adma2Descriptor Adma2_DescrTbl[32] __attribute__ ((aligned(32)));
 #endif
+	/**< ADMA Descriptors of the next asynchronous transfer */
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	XSdPs_Adma2Descriptor Adma2_DescrTblNext[XSDPS_ADMA2_DESC_NUM];
+#pragma data_alignment = 4
+#else
+	XSdPs_Adma2Descriptor Adma2_DescrTblNext[XSDPS_ADMA2_DESC_NUM]
+						__attribute__ ((aligned(32)));
+#endif
+	XSdPs_AsyncReq AsyncReq[XSDPS_ASYNC_QUEUE_DEPTH]; /**< Transfer queue */
+	volatile u32 AsyncHead;	/**< Oldest queued transfer */
+	volatile u32 AsyncCount;	/**< Number of queued transfers */
+	volatile u32 AsyncLock;	/**< Queue is being worked on */
+	u8 AsyncActive;		/**< Oldest transfer is on the bus */
+	u8 AsyncTbl;		/**< Table of the oldest transfer, 1 for Next */
+	u8 AsyncPrepared;	/**< Table of the next transfer is built */
+	u8 CmdQEnabled;		/**< Card is in command queue mode */
+	u8 CmdQDepth;		/**< Tasks the card can queue */
+	u8 CmdQQueued;		/**< Next transfer is queued on the card */
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -265,6 +353,20 @@ s32 XSdPs_MmcCardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_CardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff);
 s32 XSdPs_Set_Mmc_ExtCsd(XSdPs *InstancePtr, u32 Arg);
+s32 XSdPs_ReadAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef);
+s32 XSdPs_WriteAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+			const u8 *Buff, XSdPs_AsyncHandler Handler,
+			void *CallBackRef);
+u32 XSdPs_AsyncPoll(XSdPs *InstancePtr);
+void XSdPs_AsyncWait(XSdPs *InstancePtr, u32 MaxPending);
+void XSdPs_IntrHandler(void *InstancePtr);
+s32 XSdPs_CmdQEnable(XSdPs *InstancePtr);
+s32 XSdPs_CmdQDisable(XSdPs *InstancePtr);
+s32 XSdPs_ReadPolledV(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *Vec,
+			u32 VecCnt, XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt);
+s32 XSdPs_WritePolledV(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *Vec,
+			u32 VecCnt, XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt);
 #if defined (ARMR5) || defined (__aarch64__) || defined (ARMA53_32)
 void XSdPs_Identify_UhsMode(XSdPs *InstancePtr, u8 *ReadBuff);
 void XSdPs_ddr50_tapdelay(u32 Bank, u32 DeviceId, u32 CardType);
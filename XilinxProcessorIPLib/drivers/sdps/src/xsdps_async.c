@@ -0,0 +1,862 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_async.c
+* @addtogroup sdps_v3_4
+* @{
+*
+* Contains the interrupt driven asynchronous transfers and the eMMC command
+* queue mode. The oldest queued transfer is on the bus; the ADMA2 table of the
+* one after it is built, and in command queue mode its task is queued on the
+* card, while the data of the oldest one moves. When transfer complete is
+* signalled the completion callback runs, then the next transfer is issued.
+* See xsdps.h for a detailed description of the device and driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.4   ag     10/16/26 First release
+*       ag     10/16/26 Pass the transfer mode to XSdPs_CmdTransferMode
+*                       instead of setting the shared TransferMode.
+*       ag     10/16/26 Call the completion callback of a transfer before
+*                       the next transfer is issued.
+*       ag     10/16/26 Set the block length before command queue mode is
+*                       entered.
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+
+/************************** Constant Definitions *****************************/
+#define XSDPS_ASYNC_CMD_ERR_MASK	(XSDPS_INTR_ERR_CT_MASK | \
+					XSDPS_INTR_ERR_CCRC_MASK | \
+					XSDPS_INTR_ERR_CEB_MASK | \
+					XSDPS_INTR_ERR_CI_MASK)
+/* Normal (low half) and error (high half) interrupt signals in use */
+#define XSDPS_ASYNC_INTR_SIG_MASK	(((u32)XSDPS_ERROR_INTR_ALL_MASK << 16) | \
+					(u32)XSDPS_INTR_TC_MASK)
+#define XSDPS_ASYNC_TIMEOUT		1000000U	/* Register polls */
+#define XSDPS_CMDQ_QSR_RETRIES		1000U	/* CMD13 polls for a task */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define XSdPs_AsyncTable(InstancePtr, Tbl) \
+	(((Tbl) == 0U) ? (InstancePtr)->Adma2_DescrTbl : \
+			(InstancePtr)->Adma2_DescrTblNext)
+
+/* Consecutive transfers alternate between two task IDs */
+#define XSdPs_AsyncTaskId(InstancePtr, Slot) \
+	(((InstancePtr)->CmdQDepth > 1U) ? ((u32)(Slot) & 1U) : 0U)
+
+/************************** Function Prototypes ******************************/
+u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd);
+s32 XSdPs_CmdTransferMode(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+			u16 Mode);
+void XSdPs_FillADMA2DescTbl(XSdPs *InstancePtr, XSdPs_Adma2Descriptor *DescTbl,
+			u32 BlkCnt, const u8 *Buff);
+void XSdPs_SetADMA2DescTblAddr(XSdPs *InstancePtr,
+			const XSdPs_Adma2Descriptor *DescTbl);
+s32 XSdPs_CmdQIssue(XSdPs *InstancePtr, u32 TaskId, u32 Arg, u32 BlkCnt,
+			u8 IsRead, u8 Queued);
+static s32 XSdPs_AsyncQueue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+			const u8 *Buff, u8 IsRead, XSdPs_AsyncHandler Handler,
+			void *CallBackRef);
+static void XSdPs_AsyncLockQueue(XSdPs *InstancePtr);
+static void XSdPs_AsyncUnlockQueue(XSdPs *InstancePtr);
+static u32 XSdPs_AsyncService(XSdPs *InstancePtr);
+static void XSdPs_AsyncStart(XSdPs *InstancePtr);
+static void XSdPs_AsyncRetire(XSdPs *InstancePtr, s32 Status);
+static s32 XSdPs_AsyncIssue(XSdPs *InstancePtr);
+static void XSdPs_AsyncPrepare(XSdPs *InstancePtr);
+static void XSdPs_AsyncRecover(XSdPs *InstancePtr);
+static void XSdPs_AsyncReset(XSdPs *InstancePtr, u8 Mask);
+static s32 XSdPs_AsyncCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 *Resp);
+static s32 XSdPs_CmdQQueueTask(XSdPs *InstancePtr, u32 TaskId, u32 Arg,
+			u32 BlkCnt, u8 IsRead);
+
+/*****************************************************************************/
+/**
+* This function queues an SD read and returns without waiting for it.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user, 1 to
+*		XSDPS_ASYNC_MAX_BLKCNT.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	Handler is called when the read has completed, or NULL.
+* @param	CallBackRef is passed to Handler.
+*
+* @return
+* 		- XST_SUCCESS if the read was queued
+* 		- XST_DEVICE_BUSY if the queue is full
+* 		- XST_INVALID_PARAM if the block count is out of range
+* 		- XST_FAILURE if the block size could not be set
+*
+* @note		The buffer is invalidated from the data cache here and must
+*		not be accessed until Handler has been called.
+*
+******************************************************************************/
+s32 XSdPs_ReadAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buff != NULL);
+
+	return XSdPs_AsyncQueue(InstancePtr, Arg, BlkCnt, Buff, 1U, Handler,
+			CallBackRef);
+}
+
+/*****************************************************************************/
+/**
+* This function queues an SD write and returns without waiting for it.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user, 1 to
+*		XSDPS_ASYNC_MAX_BLKCNT.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	Handler is called when the write has completed, or NULL.
+* @param	CallBackRef is passed to Handler.
+*
+* @return
+* 		- XST_SUCCESS if the write was queued
+* 		- XST_DEVICE_BUSY if the queue is full
+* 		- XST_INVALID_PARAM if the block count is out of range
+* 		- XST_FAILURE if the block size could not be set
+*
+* @note		The buffer is flushed from the data cache here and must not
+*		be modified until Handler has been called.
+*
+******************************************************************************/
+s32 XSdPs_WriteAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+			const u8 *Buff, XSdPs_AsyncHandler Handler,
+			void *CallBackRef)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buff != NULL);
+
+	return XSdPs_AsyncQueue(InstancePtr, Arg, BlkCnt, Buff, 0U, Handler,
+			CallBackRef);
+}
+
+/*****************************************************************************/
+/**
+* This function retires the completed asynchronous transfers, issues the
+* next queued ones and calls the completion callbacks. It is used instead of
+* XSdPs_IntrHandler() when the SD interrupt is not connected, and may be
+* called while it is.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return	Number of transfers that completed.
+*
+******************************************************************************/
+u32 XSdPs_AsyncPoll(XSdPs *InstancePtr)
+{
+	u32 Done = 0U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XSdPs_AsyncLockQueue(InstancePtr);
+	while (XSdPs_AsyncService(InstancePtr) != 0U) {
+		Done += 1U;
+	}
+	XSdPs_AsyncUnlockQueue(InstancePtr);
+
+	return Done;
+}
+
+/*****************************************************************************/
+/**
+* This function polls the asynchronous transfers until no more than
+* MaxPending of them are queued.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	MaxPending is the number of transfers that may remain, 0 waits
+*		for the queue to drain.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_AsyncWait(XSdPs *InstancePtr, u32 MaxPending)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	while (InstancePtr->AsyncCount > MaxPending) {
+		(void)XSdPs_AsyncPoll(InstancePtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function is the interrupt handler of the asynchronous transfers. The
+* application connects it to the SD interrupt with the instance as callback
+* reference; the driver enables the interrupt signals it needs.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return	None.
+*
+* @note		When the queue is being worked on from the application, the
+*		signals are masked and the queue is serviced once it is left.
+*
+******************************************************************************/
+void XSdPs_IntrHandler(void *InstancePtr)
+{
+	XSdPs *SdPsPtr = (XSdPs *)InstancePtr;
+
+	Xil_AssertVoid(SdPsPtr != NULL);
+	Xil_AssertVoid(SdPsPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (SdPsPtr->AsyncLock != 0U) {
+		XSdPs_WriteReg(SdPsPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, 0U);
+		return;
+	}
+
+	XSdPs_AsyncLockQueue(SdPsPtr);
+	while (XSdPs_AsyncService(SdPsPtr) != 0U) {
+		;
+	}
+	XSdPs_AsyncUnlockQueue(SdPsPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function switches an eMMC device to command queue mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return
+*		- XST_SUCCESS if the device is in command queue mode.
+*		- XST_NO_FEATURE if the device is not an eMMC supporting it.
+*		- XST_DEVICE_BUSY if asynchronous transfers are queued.
+*		- XST_FAILURE if EXT_CSD could not be read or written.
+*
+* @note		The device leaves command queue mode when it is initialized
+*		again.
+*
+******************************************************************************/
+s32 XSdPs_CmdQEnable(XSdPs *InstancePtr)
+{
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	static u8 ExtCsd[512];
+#pragma data_alignment = 4
+#else
+	static u8 ExtCsd[512] __attribute__ ((aligned(32)));
+#endif
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((InstancePtr->CardType != XSDPS_CARD_MMC) &&
+			(InstancePtr->CardType != XSDPS_CHIP_EMMC)) {
+		Status = XST_NO_FEATURE;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->AsyncCount != 0U) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->CmdQEnabled != 0U) {
+		Status = XST_SUCCESS;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_Get_Mmc_ExtCsd(InstancePtr, ExtCsd);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if ((ExtCsd[EXT_CSD_CMDQ_SUPPORT_BYTE] & EXT_CSD_CMDQ_SUPPORTED) == 0U) {
+		Status = XST_NO_FEATURE;
+		goto RETURN_PATH;
+	}
+
+	/* CMD16 is illegal in command queue mode, set the block length now */
+	Status = XSdPs_SetBlkSize(InstancePtr, XSDPS_BLK_SIZE_512_MASK);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_Set_Mmc_ExtCsd(InstancePtr, XSDPS_MMC_CMDQ_EN_ARG);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	InstancePtr->CmdQDepth = (ExtCsd[EXT_CSD_CMDQ_DEPTH_BYTE] &
+			EXT_CSD_CMDQ_DEPTH_MASK) + 1U;
+	InstancePtr->CmdQQueued = 0U;
+	InstancePtr->CmdQEnabled = 1U;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function switches an eMMC device out of command queue mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return
+*		- XST_SUCCESS if the device is not in command queue mode.
+*		- XST_DEVICE_BUSY if asynchronous transfers are queued.
+*		- XST_FAILURE if EXT_CSD could not be written.
+*
+******************************************************************************/
+s32 XSdPs_CmdQDisable(XSdPs *InstancePtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->AsyncCount != 0U) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->CmdQEnabled == 0U) {
+		Status = XST_SUCCESS;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_Set_Mmc_ExtCsd(InstancePtr, XSDPS_MMC_CMDQ_DIS_ARG);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	InstancePtr->CmdQEnabled = 0U;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function executes a data task in command queue mode. The ADMA2 table
+* must have been handed to the host controller.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	TaskId is the task ID, below the queue depth of the device.
+* @param	Arg is the card address of the data.
+* @param	BlkCnt is the number of blocks.
+* @param	IsRead is 1 to read from the card, 0 to write.
+* @param	Queued is 1 if the task has already been queued on the card.
+*
+* @return
+*		- XST_SUCCESS if the data transfer has been started.
+*		- XST_FAILURE if a command failed or the card did not get
+*		the task ready.
+*
+******************************************************************************/
+s32 XSdPs_CmdQIssue(XSdPs *InstancePtr, u32 TaskId, u32 Arg, u32 BlkCnt,
+			u8 IsRead, u8 Queued)
+{
+	u32 Qsr = 0U;
+	u32 Retry;
+	u16 Mode;
+	s32 Status = XST_SUCCESS;
+
+	if (Queued == 0U) {
+		Status = XSdPs_CmdQQueueTask(InstancePtr, TaskId, Arg, BlkCnt,
+				IsRead);
+		if (Status != XST_SUCCESS) {
+			goto RETURN_PATH;
+		}
+	}
+
+	/* Wait for the task to show up in the queue status register */
+	for (Retry = 0U; Retry < XSDPS_CMDQ_QSR_RETRIES; Retry++) {
+		Status = XSdPs_AsyncCmd(InstancePtr, CMD13,
+				InstancePtr->RelCardAddr | XSDPS_CMDQ_SEND_QSR,
+				&Qsr);
+		if ((Status != XST_SUCCESS) ||
+				((Qsr & ((u32)1U << TaskId)) != 0U)) {
+			break;
+		}
+	}
+	if ((Status != XST_SUCCESS) || ((Qsr & ((u32)1U << TaskId)) == 0U)) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Mode = XSDPS_TM_BLK_CNT_EN_MASK |
+		XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+	if (IsRead != 0U) {
+		Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+	}
+
+	Status = XSdPs_CmdTransferMode(InstancePtr,
+			(IsRead != 0U) ? CMD46 : CMD47,
+			TaskId << XSDPS_CMDQ_TASK_ID_SHIFT, BlkCnt, Mode);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Add a transfer to the queue and issue it if the bus is idle.
+*
+******************************************************************************/
+static s32 XSdPs_AsyncQueue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+			const u8 *Buff, u8 IsRead, XSdPs_AsyncHandler Handler,
+			void *CallBackRef)
+{
+	XSdPs_AsyncReq *Req;
+	s32 Status;
+
+	if ((BlkCnt == 0U) || (BlkCnt > XSDPS_ASYNC_MAX_BLKCNT)) {
+		Status = XST_INVALID_PARAM;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->AsyncCount == XSDPS_ASYNC_QUEUE_DEPTH) {
+		(void)XSdPs_AsyncPoll(InstancePtr);
+		if (InstancePtr->AsyncCount == XSDPS_ASYNC_QUEUE_DEPTH) {
+			Status = XST_DEVICE_BUSY;
+			goto RETURN_PATH;
+		}
+	}
+
+	/* Cache maintenance is kept out of the interrupt handler */
+	if (InstancePtr->Config.IsCacheCoherent == 0) {
+		if (IsRead != 0U) {
+			Xil_DCacheInvalidateRange((INTPTR)Buff,
+				BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		} else {
+			Xil_DCacheFlushRange((INTPTR)Buff,
+				BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		}
+	}
+
+	XSdPs_AsyncLockQueue(InstancePtr);
+
+	/* Set block size to 512 if not already set */
+	if ((InstancePtr->AsyncCount == 0U) &&
+			((XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) & XSDPS_BLK_SIZE_MASK) !=
+			XSDPS_BLK_SIZE_512_MASK)) {
+		Status = XSdPs_SetBlkSize(InstancePtr, XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto UNLOCK_PATH;
+		}
+	}
+
+	Req = &InstancePtr->AsyncReq[(InstancePtr->AsyncHead +
+			InstancePtr->AsyncCount) % XSDPS_ASYNC_QUEUE_DEPTH];
+	Req->Arg = Arg;
+	Req->BlkCnt = BlkCnt;
+	Req->Buff = Buff;
+	Req->IsRead = IsRead;
+	Req->Handler = Handler;
+	Req->CallBackRef = CallBackRef;
+	InstancePtr->AsyncCount += 1U;
+
+	if (InstancePtr->AsyncActive == 0U) {
+		XSdPs_AsyncStart(InstancePtr);
+	} else {
+		XSdPs_AsyncPrepare(InstancePtr);
+	}
+	Status = XST_SUCCESS;
+
+UNLOCK_PATH:
+	XSdPs_AsyncUnlockQueue(InstancePtr);
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Keep the interrupt handler off the queue. The interrupt signals are masked
+* and the handler masks them itself should it still run.
+*
+******************************************************************************/
+static void XSdPs_AsyncLockQueue(XSdPs *InstancePtr)
+{
+	InstancePtr->AsyncLock += 1U;
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0U);
+}
+
+/*****************************************************************************/
+/**
+* Leave the queue, enabling the interrupt signals while a transfer is on the
+* bus.
+*
+******************************************************************************/
+static void XSdPs_AsyncUnlockQueue(XSdPs *InstancePtr)
+{
+	InstancePtr->AsyncLock -= 1U;
+	if ((InstancePtr->AsyncLock == 0U) && (InstancePtr->AsyncActive != 0U)) {
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET,
+				XSDPS_ASYNC_INTR_SIG_MASK);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Retire the transfer on the bus if it has completed.
+*
+* @return	1 if a transfer was retired, 0 otherwise.
+*
+******************************************************************************/
+static u32 XSdPs_AsyncService(XSdPs *InstancePtr)
+{
+	u32 StatusReg;
+	s32 Status;
+
+	if (InstancePtr->AsyncActive == 0U) {
+		return 0U;
+	}
+
+	StatusReg = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET);
+	if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+		XSdPs_AsyncRecover(InstancePtr);
+		Status = XST_FAILURE;
+	} else if ((StatusReg & XSDPS_INTR_TC_MASK) != 0U) {
+		/* Write to clear bit */
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
+		Status = XST_SUCCESS;
+	} else {
+		return 0U;
+	}
+
+	XSdPs_AsyncRetire(InstancePtr, Status);
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+* Issue the oldest queued transfer if the bus is idle. A transfer which can
+* not be issued is retired with XST_FAILURE.
+*
+******************************************************************************/
+static void XSdPs_AsyncStart(XSdPs *InstancePtr)
+{
+	if ((InstancePtr->AsyncCount == 0U) || (InstancePtr->AsyncActive != 0U)) {
+		return;
+	}
+
+	if (XSdPs_AsyncIssue(InstancePtr) == XST_SUCCESS) {
+		InstancePtr->AsyncActive = 1U;
+		XSdPs_AsyncPrepare(InstancePtr);
+	} else {
+		XSdPs_AsyncRecover(InstancePtr);
+		XSdPs_AsyncRetire(InstancePtr, XST_FAILURE);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Remove the oldest transfer from the queue, call its completion callback and
+* start the next one. Callbacks thus run in the order of the transfers, also
+* when the next transfer fails to issue.
+*
+******************************************************************************/
+static void XSdPs_AsyncRetire(XSdPs *InstancePtr, s32 Status)
+{
+	XSdPs_AsyncReq *Req = &InstancePtr->AsyncReq[InstancePtr->AsyncHead];
+	XSdPs_AsyncHandler Handler = Req->Handler;
+	void *CallBackRef = Req->CallBackRef;
+
+	InstancePtr->AsyncHead = (InstancePtr->AsyncHead + 1U) %
+			XSDPS_ASYNC_QUEUE_DEPTH;
+	InstancePtr->AsyncCount -= 1U;
+	InstancePtr->AsyncActive = 0U;
+
+	if (Handler != NULL) {
+		Handler(CallBackRef, Status);
+	}
+
+	XSdPs_AsyncStart(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+* Program the ADMA2 table of the oldest transfer and send its command. The
+* table is used as built by XSdPs_AsyncPrepare() when there is one.
+*
+******************************************************************************/
+static s32 XSdPs_AsyncIssue(XSdPs *InstancePtr)
+{
+	XSdPs_AsyncReq *Req = &InstancePtr->AsyncReq[InstancePtr->AsyncHead];
+	XSdPs_Adma2Descriptor *DescTbl;
+	u8 Queued = InstancePtr->CmdQQueued;
+	u16 Mode;
+	s32 Status;
+
+	if (InstancePtr->AsyncPrepared != 0U) {
+		InstancePtr->AsyncTbl ^= 1U;
+		InstancePtr->AsyncPrepared = 0U;
+		DescTbl = XSdPs_AsyncTable(InstancePtr, InstancePtr->AsyncTbl);
+	} else {
+		DescTbl = XSdPs_AsyncTable(InstancePtr, InstancePtr->AsyncTbl);
+		XSdPs_FillADMA2DescTbl(InstancePtr, DescTbl, Req->BlkCnt,
+				Req->Buff);
+	}
+	InstancePtr->CmdQQueued = 0U;
+
+	XSdPs_SetADMA2DescTblAddr(InstancePtr, DescTbl);
+
+	if (InstancePtr->CmdQEnabled != 0U) {
+		Status = XSdPs_CmdQIssue(InstancePtr,
+				XSdPs_AsyncTaskId(InstancePtr, InstancePtr->AsyncHead),
+				Req->Arg, Req->BlkCnt, Req->IsRead, Queued);
+	} else if (Req->BlkCnt == 1U) {
+		Mode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		if (Req->IsRead != 0U) {
+			Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		/* Send single block command */
+		Status = XSdPs_CmdTransferMode(InstancePtr,
+				(Req->IsRead != 0U) ? CMD17 : CMD24, Req->Arg, 1U,
+				Mode);
+	} else {
+		Mode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		if (Req->IsRead != 0U) {
+			Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		/* Send multiple blocks command */
+		Status = XSdPs_CmdTransferMode(InstancePtr,
+				(Req->IsRead != 0U) ? CMD18 : CMD25, Req->Arg,
+				Req->BlkCnt, Mode);
+	}
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+* Build the ADMA2 table of the transfer after the one on the bus and, in
+* command queue mode, queue its task on the card.
+*
+******************************************************************************/
+static void XSdPs_AsyncPrepare(XSdPs *InstancePtr)
+{
+	XSdPs_AsyncReq *Req;
+	u32 Next;
+
+	if ((InstancePtr->AsyncCount < 2U) ||
+			(InstancePtr->AsyncPrepared != 0U)) {
+		return;
+	}
+
+	Next = (InstancePtr->AsyncHead + 1U) % XSDPS_ASYNC_QUEUE_DEPTH;
+	Req = &InstancePtr->AsyncReq[Next];
+
+	XSdPs_FillADMA2DescTbl(InstancePtr,
+			XSdPs_AsyncTable(InstancePtr, InstancePtr->AsyncTbl ^ 1U),
+			Req->BlkCnt, Req->Buff);
+	InstancePtr->AsyncPrepared = 1U;
+
+	if ((InstancePtr->CmdQEnabled != 0U) && (InstancePtr->CmdQDepth > 1U)) {
+		if (XSdPs_CmdQQueueTask(InstancePtr,
+				XSdPs_AsyncTaskId(InstancePtr, Next), Req->Arg,
+				Req->BlkCnt, Req->IsRead) == XST_SUCCESS) {
+			InstancePtr->CmdQQueued = 1U;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* Recover from a failed transfer: clear the status, reset the command and
+* data lines and return the card to the transfer state. In command queue
+* mode the tasks queued on the card are discarded.
+*
+******************************************************************************/
+static void XSdPs_AsyncRecover(XSdPs *InstancePtr)
+{
+	u32 Timeout = XSDPS_ASYNC_TIMEOUT;
+	u32 Resp;
+
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET,
+			((u32)XSDPS_ERROR_INTR_ALL_MASK << 16) |
+			XSDPS_NORM_INTR_ALL_MASK);
+	XSdPs_AsyncReset(InstancePtr, XSDPS_SWRST_CMD_LINE_MASK |
+			XSDPS_SWRST_DAT_LINE_MASK);
+
+	(void)XSdPs_AsyncCmd(InstancePtr, CMD12, 0U, &Resp);
+	if (InstancePtr->CmdQEnabled != 0U) {
+		(void)XSdPs_AsyncCmd(InstancePtr, CMD48,
+				XSDPS_CMDQ_DISCARD_QUEUE, &Resp);
+		InstancePtr->CmdQQueued = 0U;
+	}
+
+	/* Wait for the end of busy */
+	while (((XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_PRES_STATE_OFFSET) & XSDPS_PSR_INHIBIT_DAT_MASK) != 0U)
+			&& (Timeout != 0U)) {
+		Timeout -= 1U;
+	}
+
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET,
+			((u32)XSDPS_ERROR_INTR_ALL_MASK << 16) |
+			XSDPS_NORM_INTR_ALL_MASK);
+}
+
+/*****************************************************************************/
+/**
+* Reset lines of the host controller and wait for the reset to finish.
+*
+******************************************************************************/
+static void XSdPs_AsyncReset(XSdPs *InstancePtr, u8 Mask)
+{
+	u32 Timeout = XSDPS_ASYNC_TIMEOUT;
+
+	XSdPs_WriteReg8(InstancePtr->Config.BaseAddress,
+			XSDPS_SW_RST_OFFSET, Mask);
+	while (((XSdPs_ReadReg8(InstancePtr->Config.BaseAddress,
+			XSDPS_SW_RST_OFFSET) & Mask) != 0U) && (Timeout != 0U)) {
+		Timeout -= 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Send a command without data. Unlike XSdPs_CmdTransfer() only the command
+* complete status is touched, so it may be used while data is moving.
+*
+******************************************************************************/
+static s32 XSdPs_AsyncCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 *Resp)
+{
+	u32 BaseAddress = InstancePtr->Config.BaseAddress;
+	u32 Timeout = XSDPS_ASYNC_TIMEOUT;
+	u32 StatusReg;
+	u32 ErrorReg;
+	s32 Status = XST_FAILURE;
+
+	while ((XSdPs_ReadReg(BaseAddress, XSDPS_PRES_STATE_OFFSET) &
+			XSDPS_PSR_INHIBIT_CMD_MASK) != 0U) {
+		Timeout -= 1U;
+		if (Timeout == 0U) {
+			goto RETURN_PATH;
+		}
+	}
+
+	XSdPs_WriteReg(BaseAddress, XSDPS_ARGMT_OFFSET, Arg);
+	XSdPs_WriteReg(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET,
+			XSDPS_INTR_CC_MASK);
+
+	/* The transfer mode of a transfer in progress is left alone */
+	XSdPs_WriteReg16(BaseAddress, XSDPS_CMD_OFFSET,
+			(u16)(XSdPs_FrameCmd(InstancePtr, Cmd) & 0x3FFFU));
+
+	do {
+		StatusReg = XSdPs_ReadReg(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET);
+		ErrorReg = (StatusReg >> 16) & XSDPS_ASYNC_CMD_ERR_MASK;
+		if (ErrorReg != 0U) {
+			/* Write to clear error bits */
+			XSdPs_WriteReg(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET,
+					ErrorReg << 16);
+			XSdPs_AsyncReset(InstancePtr, XSDPS_SWRST_CMD_LINE_MASK);
+			goto RETURN_PATH;
+		}
+		Timeout -= 1U;
+		if (Timeout == 0U) {
+			goto RETURN_PATH;
+		}
+	} while ((StatusReg & XSDPS_INTR_CC_MASK) == 0U);
+
+	/* Write to clear bit */
+	XSdPs_WriteReg(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET,
+			XSDPS_INTR_CC_MASK);
+	*Resp = XSdPs_ReadReg(BaseAddress, XSDPS_RESP0_OFFSET);
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Queue a task on the card with CMD44 and CMD45.
+*
+******************************************************************************/
+static s32 XSdPs_CmdQQueueTask(XSdPs *InstancePtr, u32 TaskId, u32 Arg,
+			u32 BlkCnt, u8 IsRead)
+{
+	u32 Param = (TaskId << XSDPS_CMDQ_TASK_ID_SHIFT) | (BlkCnt & 0xFFFFU);
+	u32 Resp;
+	s32 Status;
+
+	if (IsRead != 0U) {
+		Param |= XSDPS_CMDQ_DIR_READ;
+	}
+
+	Status = XSdPs_AsyncCmd(InstancePtr, CMD44, Param, &Resp);
+	if (Status == XST_SUCCESS) {
+		Status = XSdPs_AsyncCmd(InstancePtr, CMD45, Arg, &Resp);
+	}
+
+	return Status;
+}
+/** @} */
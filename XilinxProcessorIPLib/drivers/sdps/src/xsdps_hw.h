@@ -663,6 +663,7 @@ extern "C" {
 #define CMD10	 0x0A00U
 #define CMD11	 0x0B00U
 #define CMD12	 0x0C00U
+#define CMD13	 0x0D00U
 #define ACMD13	 (XSDPS_APP_CMD_PREFIX + 0x0D00U)
 #define CMD16	 0x1000U
 #define CMD17	 0x1100U
@@ -676,6 +677,11 @@ extern "C" {
 #define CMD41	 0x2900U
 #define ACMD41	 (XSDPS_APP_CMD_PREFIX + 0x2900U)
 #define ACMD42	 (XSDPS_APP_CMD_PREFIX + 0x2A00U)
+#define CMD44	 0x2C00U
+#define CMD45	 0x2D00U
+#define CMD46	 0x2E00U
+#define CMD47	 0x2F00U
+#define CMD48	 0x3000U
 #define ACMD51	 (XSDPS_APP_CMD_PREFIX + 0x3300U)
 #define CMD52	 0x3400U
 #define CMD55	 0x3700U
@@ -905,6 +911,25 @@ extern "C" {
 					 | ((u32)EXT_CSD_RST_N_FUN_BYTE << 16) \
 					 | ((u32)EXT_CSD_RST_N_FUN_PERM_EN << 8))
 
+#define EXT_CSD_CMDQ_MODE_EN_BYTE	15U
+#define EXT_CSD_CMDQ_DEPTH_BYTE		307U
+#define EXT_CSD_CMDQ_SUPPORT_BYTE	308U
+#define EXT_CSD_CMDQ_DEPTH_MASK		0x1FU	/* Queue depth minus one */
+#define EXT_CSD_CMDQ_SUPPORTED		0x1U
+
+#define XSDPS_MMC_CMDQ_EN_ARG		(((u32)XSDPS_EXT_CSD_WRITE_BYTE << 24) \
+					 | ((u32)EXT_CSD_CMDQ_MODE_EN_BYTE << 16) \
+					 | ((u32)1U << 8))
+
+#define XSDPS_MMC_CMDQ_DIS_ARG		(((u32)XSDPS_EXT_CSD_WRITE_BYTE << 24) \
+					 | ((u32)EXT_CSD_CMDQ_MODE_EN_BYTE << 16))
+
+/* Command queue task arguments, CMD44 to CMD48 */
+#define XSDPS_CMDQ_DIR_READ		0x40000000U	/* CMD44 data direction */
+#define XSDPS_CMDQ_TASK_ID_SHIFT	16U
+#define XSDPS_CMDQ_SEND_QSR		0x00008000U	/* CMD13 returns QSR */
+#define XSDPS_CMDQ_DISCARD_QUEUE	0x1U		/* CMD48 opcode */
+
 #define XSDPS_MMC_DELAY_FOR_SWITCH	1000U
 
 /* @} */
@@ -75,6 +75,8 @@
 *                       operations when it is enabled.
 *       mn     08/22/17 Updated for Word Access System support
 * 3.4   mn     01/22/18 Separated out SDR104 and HS200 clock defines
+*       ag     10/16/26 XSdPs_SetBlkSize sends no CMD16 in eMMC command queue
+*                       mode.
 *
 * </pre>
 *
@@ -117,6 +119,10 @@ extern u16 TransferMode;
 *
 * @return	None
 *
+* @note		CMD16 is illegal in eMMC command queue mode, where the block
+*		length is 512 bytes as set by XSdPs_CmdQEnable(). Only the host
+*		block size is set then, and other sizes fail.
+*
 ******************************************************************************/
 s32 XSdPs_SetBlkSize(XSdPs *InstancePtr, u16 BlkSize)
 {
@@ -136,17 +142,23 @@ s32 XSdPs_SetBlkSize(XSdPs *InstancePtr, u16 BlkSize)
 		goto RETURN_PATH;
 	}
 
+	if (InstancePtr->CmdQEnabled != 0U) {
+		if (BlkSize != XSDPS_BLK_SIZE_512_MASK) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	} else {
+		/* Send block write command */
+		Status = XSdPs_CmdTransfer(InstancePtr, CMD16, BlkSize, 0U);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
 
-	/* Send block write command */
-	Status = XSdPs_CmdTransfer(InstancePtr, CMD16, BlkSize, 0U);
-	if (Status != XST_SUCCESS) {
-		Status = XST_FAILURE;
-		goto RETURN_PATH;
+		Status = (s32)XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XSDPS_RESP0_OFFSET);
 	}
 
-	Status = (s32)XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
-			XSDPS_RESP0_OFFSET);
-
 	/* Set block size to the value passed */
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress, XSDPS_BLK_SIZE_OFFSET,
 			 BlkSize & XSDPS_BLK_SIZE_MASK);
@@ -0,0 +1,404 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_sg.c
+* @addtogroup sdps_v3_4
+* @{
+*
+* Contains the scatter-gather reads and writes. The segments are mapped into
+* an ADMA2 descriptor table supplied by the caller, which is cut into chains
+* of at most XSDPS_SG_MAX_BLKCNT blocks; each chain is moved by one command.
+* See xsdps.h for a detailed description of the device and driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.4   ag     10/16/26 First release
+*       ag     10/16/26 Pass the transfer mode to XSdPs_CmdTransferMode and
+*                       the block count to the trace points
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+#include "xil_trace.h"
+
+/************************** Constant Definitions *****************************/
+/* Bytes in one chain of the descriptor table */
+#define XSDPS_SG_CHAIN_LENGTH	(XSDPS_SG_MAX_BLKCNT * XSDPS_BLK_SIZE_512_MASK)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt);
+void XSdPs_SetADMA2DescTblAddr(XSdPs *InstancePtr,
+			const XSdPs_Adma2Descriptor *DescTbl);
+s32 XSdPs_CmdQIssue(XSdPs *InstancePtr, u32 TaskId, u32 Arg, u32 BlkCnt,
+			u8 IsRead, u8 Queued);
+static s32 XSdPs_XferPolledV(XSdPs *InstancePtr, u32 Arg,
+			const XSdPs_IoVec *Vec, u32 VecCnt,
+			XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt, u8 IsRead);
+static s32 XSdPs_SgBuild(XSdPs *InstancePtr, XSdPs_Adma2Descriptor *DescTbl,
+			u32 DescCnt, const XSdPs_IoVec *Vec, u32 VecCnt,
+			u32 *DescNum);
+s32 XSdPs_CmdTransferMode(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+			u16 Mode);
+static s32 XSdPs_SgIssue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 IsRead);
+
+/*****************************************************************************/
+/**
+* This function performs a scatter-gather SD read in polled mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	Vec is the list of segments, filled in order from Arg on.
+* @param	VecCnt is the number of segments.
+* @param	DescTbl is the ADMA2 descriptor table to use, 8 byte aligned
+*		and not cached or cache line aligned.
+* @param	DescCnt is the number of descriptors in DescTbl.
+*
+* @return
+* 		- XST_SUCCESS if the read was successful
+* 		- XST_INVALID_PARAM if a segment is misaligned or the total
+* 		length is not a multiple of 512 bytes
+* 		- XST_BUFFER_TOO_SMALL if DescTbl has too few descriptors
+* 		- XST_DEVICE_BUSY if asynchronous transfers are queued
+* 		- XST_FAILURE if failure - could be because another transfer
+* 		is in progress or command or data inhibit is set
+*
+******************************************************************************/
+s32 XSdPs_ReadPolledV(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *Vec,
+			u32 VecCnt, XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Vec != NULL);
+	Xil_AssertNonvoid(DescTbl != NULL);
+
+	return XSdPs_XferPolledV(InstancePtr, Arg, Vec, VecCnt, DescTbl,
+			DescCnt, 1U);
+}
+
+/*****************************************************************************/
+/**
+* This function performs a scatter-gather SD write in polled mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	Vec is the list of segments, written in order from Arg on.
+* @param	VecCnt is the number of segments.
+* @param	DescTbl is the ADMA2 descriptor table to use, 8 byte aligned
+*		and not cached or cache line aligned.
+* @param	DescCnt is the number of descriptors in DescTbl.
+*
+* @return
+* 		- XST_SUCCESS if the write was successful
+* 		- XST_INVALID_PARAM if a segment is misaligned or the total
+* 		length is not a multiple of 512 bytes
+* 		- XST_BUFFER_TOO_SMALL if DescTbl has too few descriptors
+* 		- XST_DEVICE_BUSY if asynchronous transfers are queued
+* 		- XST_FAILURE if failure - could be because another transfer
+* 		is in progress or command or data inhibit is set
+*
+******************************************************************************/
+s32 XSdPs_WritePolledV(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *Vec,
+			u32 VecCnt, XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Vec != NULL);
+	Xil_AssertNonvoid(DescTbl != NULL);
+
+	return XSdPs_XferPolledV(InstancePtr, Arg, Vec, VecCnt, DescTbl,
+			DescCnt, 0U);
+}
+
+/*****************************************************************************/
+/**
+* Move the segments with one command per chain of the descriptor table.
+*
+******************************************************************************/
+static s32 XSdPs_XferPolledV(XSdPs *InstancePtr, u32 Arg,
+			const XSdPs_IoVec *Vec, u32 VecCnt,
+			XSdPs_Adma2Descriptor *DescTbl, u32 DescCnt, u8 IsRead)
+{
+	s32 Status;
+	u32 PresentStateReg;
+	u32 StatusReg;
+	u32 DescNum;
+	u32 Desc;
+	u32 Next;
+	u32 Bytes;
+	u32 BlkCnt;
+	u32 VecNum;
+#ifdef XIL_TRACE_ENABLE
+	u32 TotalBlkCnt;
+
+	/* Blocks of the whole list, as traced by the other transfer paths */
+	Bytes = 0U;
+	for (VecNum = 0U; VecNum < VecCnt; VecNum++) {
+		Bytes += Vec[VecNum].Length;
+	}
+	TotalBlkCnt = Bytes / XSDPS_BLK_SIZE_512_MASK;
+#endif
+
+	XIL_TRACE_BEGIN((IsRead != 0U) ? XIL_TRACE_ID_SDPS_READ :
+			XIL_TRACE_ID_SDPS_WRITE, TotalBlkCnt);
+
+	/* The bus belongs to the asynchronous transfers until they are done */
+	if (InstancePtr->AsyncCount != 0U) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
+	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
+				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
+				!= XSDPS_CAPS_EMB_SLOT)) {
+		if(InstancePtr->Config.CardDetect != 0U) {
+			/* Check status to ensure card is initialized */
+			PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSDPS_PRES_STATE_OFFSET);
+			if ((PresentStateReg & XSDPS_PSR_CARD_INSRT_MASK) == 0x0U) {
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+		}
+	}
+
+	/* Set block size to 512 if not already set */
+	if ((XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) & XSDPS_BLK_SIZE_MASK) !=
+			XSDPS_BLK_SIZE_512_MASK) {
+		Status = XSdPs_SetBlkSize(InstancePtr,
+			XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	Status = XSdPs_SgBuild(InstancePtr, DescTbl, DescCnt, Vec, VecCnt,
+			&DescNum);
+	if (Status != XST_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->Config.IsCacheCoherent == 0) {
+		for (VecNum = 0U; VecNum < VecCnt; VecNum++) {
+			if (IsRead != 0U) {
+				Xil_DCacheInvalidateRange((INTPTR)Vec[VecNum].Base,
+					Vec[VecNum].Length);
+			} else {
+				Xil_DCacheFlushRange((INTPTR)Vec[VecNum].Base,
+					Vec[VecNum].Length);
+			}
+		}
+	}
+
+	for (Desc = 0U; Desc < DescNum; Desc = Next) {
+		/* Length of the chain up to the next end descriptor */
+		Bytes = 0U;
+		Next = Desc;
+		do {
+			Bytes += (DescTbl[Next].Length == 0U) ?
+				XSDPS_DESC_MAX_LENGTH : DescTbl[Next].Length;
+			Next += 1U;
+		} while ((DescTbl[Next - 1U].Attribute & XSDPS_DESC_END) == 0U);
+		BlkCnt = Bytes / XSDPS_BLK_SIZE_512_MASK;
+
+		XSdPs_SetADMA2DescTblAddr(InstancePtr, &DescTbl[Desc]);
+
+		Status = XSdPs_SgIssue(InstancePtr, Arg, BlkCnt, IsRead);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		/* Check for transfer complete */
+		do {
+			StatusReg = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+						XSDPS_NORM_INTR_STS_OFFSET);
+			if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+				/* Write to clear error bits */
+				XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+						XSDPS_ERR_INTR_STS_OFFSET,
+						XSDPS_ERROR_INTR_ALL_MASK);
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+		} while((StatusReg & XSDPS_INTR_TC_MASK) == 0U);
+
+		/* Write to clear bit */
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
+
+		/* Standard capacity cards are byte addressed */
+		Arg += (InstancePtr->HCS != 0U) ? BlkCnt :
+				(BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	}
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	XIL_TRACE_END((IsRead != 0U) ? XIL_TRACE_ID_SDPS_READ :
+			XIL_TRACE_ID_SDPS_WRITE, TotalBlkCnt);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Map the segments into the descriptor table. A segment takes a descriptor
+* per 64KB, and a descriptor is cut where a chain reaches
+* XSDPS_SG_MAX_BLKCNT blocks; the last descriptor of each chain has the end
+* attribute.
+*
+******************************************************************************/
+static s32 XSdPs_SgBuild(XSdPs *InstancePtr, XSdPs_Adma2Descriptor *DescTbl,
+			u32 DescCnt, const XSdPs_IoVec *Vec, u32 VecCnt,
+			u32 *DescNum)
+{
+	UINTPTR Addr;
+	u32 Remain;
+	u32 Length;
+	u32 ChainLength = 0U;
+	u32 VecNum;
+	u32 Num = 0U;
+	s32 Status;
+
+	for (VecNum = 0U; VecNum < VecCnt; VecNum++) {
+		Addr = (UINTPTR)Vec[VecNum].Base;
+		Remain = Vec[VecNum].Length;
+		if ((Remain == 0U) || ((Remain & 0x3U) != 0U) ||
+				((Addr & 0x3U) != 0U)) {
+			Status = XST_INVALID_PARAM;
+			goto RETURN_PATH;
+		}
+
+		while (Remain != 0U) {
+			if (Num == DescCnt) {
+				Status = XST_BUFFER_TOO_SMALL;
+				goto RETURN_PATH;
+			}
+
+			Length = (Remain < XSDPS_DESC_MAX_LENGTH) ? Remain :
+					XSDPS_DESC_MAX_LENGTH;
+			if (Length > (XSDPS_SG_CHAIN_LENGTH - ChainLength)) {
+				Length = XSDPS_SG_CHAIN_LENGTH - ChainLength;
+			}
+
+#ifdef __aarch64__
+			DescTbl[Num].Address = (u64)Addr;
+#else
+			DescTbl[Num].Address = (u32)Addr;
+#endif
+			DescTbl[Num].Attribute = XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+			/* This will write '0' to length field which indicates 65536 */
+			DescTbl[Num].Length = (u16)Length;
+
+			ChainLength += Length;
+			if (ChainLength == XSDPS_SG_CHAIN_LENGTH) {
+				DescTbl[Num].Attribute |= XSDPS_DESC_END;
+				ChainLength = 0U;
+			}
+
+			Addr += Length;
+			Remain -= Length;
+			Num += 1U;
+		}
+	}
+
+	if ((Num == 0U) || ((ChainLength % XSDPS_BLK_SIZE_512_MASK) != 0U)) {
+		Status = XST_INVALID_PARAM;
+		goto RETURN_PATH;
+	}
+	DescTbl[Num - 1U].Attribute |= XSDPS_DESC_END;
+
+	if (InstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange((INTPTR)DescTbl,
+			sizeof(XSdPs_Adma2Descriptor) * Num);
+	}
+
+	*DescNum = Num;
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Send the command which moves one chain.
+*
+******************************************************************************/
+static s32 XSdPs_SgIssue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 IsRead)
+{
+	s32 Status;
+	u16 Mode;
+
+	if (InstancePtr->CmdQEnabled != 0U) {
+		/* Single task, the block commands are illegal in this mode */
+		Status = XSdPs_CmdQIssue(InstancePtr, 0U, Arg, BlkCnt, IsRead, 0U);
+	} else if (BlkCnt == 1U) {
+		Mode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		if (IsRead != 0U) {
+			Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		/* Send single block command */
+		Status = XSdPs_CmdTransferMode(InstancePtr,
+				(IsRead != 0U) ? CMD17 : CMD24, Arg, BlkCnt, Mode);
+	} else {
+		Mode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		if (IsRead != 0U) {
+			Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		/* Send multiple blocks command */
+		Status = XSdPs_CmdTransferMode(InstancePtr,
+				(IsRead != 0U) ? CMD18 : CMD25, Arg, BlkCnt, Mode);
+	}
+
+	return Status;
+}
+/** @} */
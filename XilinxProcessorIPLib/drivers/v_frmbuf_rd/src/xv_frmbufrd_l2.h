@@ -100,6 +100,17 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Frame Queue </b>
+*
+* XVFrmbufRd_FrmQInitialize() hands the core a set of frame buffers tracked by
+* a frame queue (see xvidc_frmq.h). The application acquires a free frame with
+* XVFrmbufRd_FrmQAcquire(), fills it and queues it for display with
+* XVFrmbufRd_FrmQRelease(), neither of which waits. In the frame done
+* interrupt the core is given the next queued frame and the frame it has read
+* is freed; when nothing is queued the core reads the same frame again. The
+* frame queue installs the frame done callback, only the done interrupt must
+* be enabled.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -121,6 +132,7 @@
 * 3.00  vyc   04/04/18   Add interlaced support
 *                        Add new memory format BGR8
 *                        Add interrupt handler for ap_ready
+*       ag    10/16/26   Add frame queue
 * </pre>
 *
 ******************************************************************************/
@@ -133,6 +145,7 @@ extern "C" {
 
 #include "xvidc.h"
 #include "xv_frmbufrd.h"
+#include "xvidc_frmq.h"
 
 /************************** Constant Definitions *****************************/
 #define XVFRMBUFRD_IRQ_DONE_MASK            (0x01)
@@ -195,6 +208,32 @@ typedef struct {
     XVidC_VideoStream Stream;    /**< Output AXIS */
 }XV_FrmbufRd_l2;
 
+/**
+* Callback type for the frame queue.
+*
+* @param    CallbackRef is the reference given to XVFrmbufRd_FrmQSetCallback().
+* @param    HwFrame is the frame the core reads next.
+*
+* @return   None.
+*
+* @note     Invoked in the frame done interrupt.
+*
+*/
+typedef void (*XVFrmbufRd_FrmQCallback)(void *CallbackRef, u32 HwFrame);
+
+/**
+ * Frame queue of a frame buffer read core.
+ */
+typedef struct {
+    XVidC_FrameQueue Queue;           /**< Ownership of the frames */
+    XV_FrmbufRd_l2 *InstancePtr;      /**< Core the queue works on */
+    u32 HwFrame;                      /**< Frame the core is reading */
+    UINTPTR ChromaOffset;             /**< Offset of the chroma plane in
+                                           a frame, 0 if not used */
+    XVFrmbufRd_FrmQCallback Callback; /**< Frame callback, may be NULL */
+    void *CallbackRef;                /**< Frame callback reference */
+}XVFrmbufRd_FrmQ;
+
 /************************** Macros Definitions *******************************/
 /*****************************************************************************/
 /**
@@ -525,6 +564,19 @@ int XVFrmbufRd_SetCallback(XV_FrmbufRd_l2 *InstancePtr,
 void XVFrmbufRd_InterruptEnable(XV_FrmbufRd_l2 *InstancePtr, u32 IrqMask);
 void XVFrmbufRd_InterruptDisable(XV_FrmbufRd_l2 *InstancePtr, u32 IrqMask);
 
+/* Frame queue related functions */
+int XVFrmbufRd_FrmQInitialize(XVFrmbufRd_FrmQ *FrmQPtr,
+                              XV_FrmbufRd_l2 *InstancePtr,
+                              const UINTPTR *Addr,
+                              u32 NumFrames,
+                              UINTPTR ChromaOffset,
+                              XVidC_FrmQPolicy Policy);
+void XVFrmbufRd_FrmQSetCallback(XVFrmbufRd_FrmQ *FrmQPtr,
+                                XVFrmbufRd_FrmQCallback CallbackFunc,
+                                void *CallbackRef);
+int XVFrmbufRd_FrmQAcquire(XVFrmbufRd_FrmQ *FrmQPtr, u32 *Index);
+void XVFrmbufRd_FrmQRelease(XVFrmbufRd_FrmQ *FrmQPtr, u32 Index);
+
 #ifdef __cplusplus
 }
 #endif
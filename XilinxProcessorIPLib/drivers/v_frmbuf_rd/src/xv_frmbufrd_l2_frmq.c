@@ -0,0 +1,227 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * Use of the Software is limited solely to applications:
+ * (a) running on a Xilinx device, or
+ * (b) that interact with a Xilinx device through a bus or interconnect.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xv_frmbufrd_l2_frmq.c
+* @addtogroup v_frmbuf_rd_v2_0
+* @{
+*
+* The functions in this file run a frame queue on the frame buffer read core.
+* Please see xv_frmbufrd_l2.h for more details.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.00  ag    10/16/26   Initial Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xv_frmbufrd_l2.h"
+
+/************************** Function Prototypes ******************************/
+static int XVFrmbufRd_FrmQSetFrame(XVFrmbufRd_FrmQ *FrmQPtr, u32 Index);
+static void XVFrmbufRd_FrmQDoneCallback(void *CallbackRef);
+
+/*****************************************************************************/
+/**
+*
+* This function sets up a frame queue on the core, programs the first frame
+* and installs the frame done callback. The core is started by the
+* application with XVFrmbufRd_Start() after enabling the done interrupt.
+*
+* @param    FrmQPtr is a pointer to the frame queue to set up.
+* @param    InstancePtr is a pointer to the core instance.
+* @param    Addr is the array of frame buffer addresses. The first frame is
+*           read until another one is queued and should be filled before
+*           the core is started.
+* @param    NumFrames is the number of frames, at least 2.
+* @param    ChromaOffset is the offset of the chroma plane in each frame for
+*           semi-planar memory formats, 0 otherwise.
+* @param    Policy is XVIDC_FRMQ_FIFO to show every queued frame, or
+*           XVIDC_FRMQ_LATEST to skip to the newest one.
+*
+* @return   XST_SUCCESS or the error of XVFrmbufRd_SetBufferAddr().
+*
+* @note     All addresses must be aligned as required by
+*           XVFrmbufRd_SetBufferAddr().
+*
+******************************************************************************/
+int XVFrmbufRd_FrmQInitialize(XVFrmbufRd_FrmQ *FrmQPtr,
+                              XV_FrmbufRd_l2 *InstancePtr,
+                              const UINTPTR *Addr,
+                              u32 NumFrames,
+                              UINTPTR ChromaOffset,
+                              XVidC_FrmQPolicy Policy)
+{
+  u32 Index;
+  int Status;
+
+  /* Verify arguments */
+  Xil_AssertNonvoid(FrmQPtr != NULL);
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(Addr != NULL);
+  Xil_AssertNonvoid(NumFrames >= 2);
+
+  FrmQPtr->InstancePtr  = InstancePtr;
+  FrmQPtr->ChromaOffset = ChromaOffset;
+  FrmQPtr->Callback     = NULL;
+  FrmQPtr->CallbackRef  = NULL;
+  XVidC_FrmQInit(&FrmQPtr->Queue, Addr, NumFrames, Policy);
+
+  /* Queue the first frame and hand it to the core */
+  (void)XVidC_FrmQAcquireWrite(&FrmQPtr->Queue, &Index);
+  XVidC_FrmQPublish(&FrmQPtr->Queue, Index);
+  (void)XVidC_FrmQAcquireRead(&FrmQPtr->Queue, &FrmQPtr->HwFrame);
+  Status = XVFrmbufRd_FrmQSetFrame(FrmQPtr, FrmQPtr->HwFrame);
+  if(Status != XST_SUCCESS) {
+    return(Status);
+  }
+
+  return(XVFrmbufRd_SetCallback(InstancePtr, XVFRMBUFRD_HANDLER_DONE,
+                                (void *)XVFrmbufRd_FrmQDoneCallback,
+                                (void *)FrmQPtr));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs a callback invoked in the frame done interrupt after
+* the next frame has been programmed.
+*
+* @param    FrmQPtr is a pointer to the frame queue.
+* @param    CallbackFunc is the callback function, NULL for none.
+* @param    CallbackRef is passed to the callback function.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_FrmQSetCallback(XVFrmbufRd_FrmQ *FrmQPtr,
+                                XVFrmbufRd_FrmQCallback CallbackFunc,
+                                void *CallbackRef)
+{
+  Xil_AssertVoid(FrmQPtr != NULL);
+
+  FrmQPtr->CallbackRef = CallbackRef;
+  FrmQPtr->Callback    = CallbackFunc;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function acquires a free frame to fill without waiting.
+*
+* @param    FrmQPtr is a pointer to the frame queue.
+* @param    Index is set to the acquired frame, its address is
+*           XVidC_FrmQGetAddr(&FrmQPtr->Queue, Index).
+*
+* @return   XST_SUCCESS, or XST_DEVICE_BUSY if no frame is free.
+*
+* @note     The frame must be queued with XVFrmbufRd_FrmQRelease().
+*
+******************************************************************************/
+int XVFrmbufRd_FrmQAcquire(XVFrmbufRd_FrmQ *FrmQPtr, u32 *Index)
+{
+  Xil_AssertNonvoid(FrmQPtr != NULL);
+
+  return(XVidC_FrmQAcquireWrite(&FrmQPtr->Queue, Index));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a filled frame for display.
+*
+* @param    FrmQPtr is a pointer to the frame queue.
+* @param    Index is the frame returned by XVFrmbufRd_FrmQAcquire().
+*
+* @return   None.
+*
+* @note     The data of the frame must be visible to the core, i.e. flushed
+*           from the data cache.
+*
+******************************************************************************/
+void XVFrmbufRd_FrmQRelease(XVFrmbufRd_FrmQ *FrmQPtr, u32 Index)
+{
+  Xil_AssertVoid(FrmQPtr != NULL);
+
+  XVidC_FrmQPublish(&FrmQPtr->Queue, Index);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs the buffer addresses of a frame into the core.
+*
+******************************************************************************/
+static int XVFrmbufRd_FrmQSetFrame(XVFrmbufRd_FrmQ *FrmQPtr, u32 Index)
+{
+  UINTPTR Addr = XVidC_FrmQGetAddr(&FrmQPtr->Queue, Index);
+  int Status;
+
+  Status = XVFrmbufRd_SetBufferAddr(FrmQPtr->InstancePtr, Addr);
+  if((Status == XST_SUCCESS) && (FrmQPtr->ChromaOffset != 0)) {
+    Status = XVFrmbufRd_SetChromaBufferAddr(FrmQPtr->InstancePtr,
+                                            Addr + FrmQPtr->ChromaOffset);
+  }
+  return(Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the frame done callback of the frame queue. It runs before
+* the interrupt handler restarts the core: if a frame is queued it is
+* programmed and the frame just read is freed, otherwise the core reads the
+* same frame again.
+*
+******************************************************************************/
+static void XVFrmbufRd_FrmQDoneCallback(void *CallbackRef)
+{
+  XVFrmbufRd_FrmQ *FrmQPtr = (XVFrmbufRd_FrmQ *)CallbackRef;
+  u32 Next;
+
+  if(XVidC_FrmQAcquireRead(&FrmQPtr->Queue, &Next) == XST_SUCCESS) {
+    (void)XVFrmbufRd_FrmQSetFrame(FrmQPtr, Next);
+    XVidC_FrmQRelease(&FrmQPtr->Queue, FrmQPtr->HwFrame);
+    FrmQPtr->HwFrame = Next;
+  }
+
+  if(FrmQPtr->Callback) {
+    FrmQPtr->Callback(FrmQPtr->CallbackRef, FrmQPtr->HwFrame);
+  }
+}
+/** @} */
@@ -100,6 +100,16 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Frame Queue </b>
+*
+* XVFrmbufWr_FrmQInitialize() hands the core a set of frame buffers tracked by
+* a frame queue (see xvidc_frmq.h). In the frame done interrupt the completed
+* frame is published and the core is given the next free frame; when there is
+* none the core writes the same frame again. The application acquires
+* completed frames with XVFrmbufWr_FrmQAcquire() and hands them back with
+* XVFrmbufWr_FrmQRelease(), neither of which waits. The frame queue installs
+* the frame done callback, only the done interrupt must be enabled.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -121,6 +131,7 @@
 * 3.00  vyc   04/04/18   Add interlaced support
 *                        Add new memory format BGR8
 *                        Add interrupt handler for ap_ready
+*       ag    10/16/26   Add frame queue
 * </pre>
 *
 ******************************************************************************/
@@ -133,6 +144,7 @@ extern "C" {
 
 #include "xvidc.h"
 #include "xv_frmbufwr.h"
+#include "xvidc_frmq.h"
 
 /************************** Constant Definitions *****************************/
 #define XVFRMBUFWR_IRQ_DONE_MASK            (0x01)
@@ -195,6 +207,32 @@ typedef struct {
     XVidC_VideoStream Stream;    /**< Input AXIS */
 }XV_FrmbufWr_l2;
 
+/**
+* Callback type for the frame queue.
+*
+* @param    CallbackRef is the reference given to XVFrmbufWr_FrmQSetCallback().
+* @param    HwFrame is the frame the core writes next.
+*
+* @return   None.
+*
+* @note     Invoked in the frame done interrupt.
+*
+*/
+typedef void (*XVFrmbufWr_FrmQCallback)(void *CallbackRef, u32 HwFrame);
+
+/**
+ * Frame queue of a frame buffer write core.
+ */
+typedef struct {
+    XVidC_FrameQueue Queue;           /**< Ownership of the frames */
+    XV_FrmbufWr_l2 *InstancePtr;      /**< Core the queue works on */
+    u32 HwFrame;                      /**< Frame the core is writing */
+    UINTPTR ChromaOffset;             /**< Offset of the chroma plane in
+                                           a frame, 0 if not used */
+    XVFrmbufWr_FrmQCallback Callback; /**< Frame callback, may be NULL */
+    void *CallbackRef;                /**< Frame callback reference */
+}XVFrmbufWr_FrmQ;
+
 /************************** Macros Definitions *******************************/
 /*****************************************************************************/
 /**
@@ -478,6 +516,19 @@ int XVFrmbufWr_SetCallback(XV_FrmbufWr_l2 *InstancePtr,
 void XVFrmbufWr_InterruptEnable(XV_FrmbufWr_l2 *InstancePtr, u32 IrqMask);
 void XVFrmbufWr_InterruptDisable(XV_FrmbufWr_l2 *InstancePtr, u32 IrqMask);
 
+/* Frame queue related functions */
+int XVFrmbufWr_FrmQInitialize(XVFrmbufWr_FrmQ *FrmQPtr,
+                              XV_FrmbufWr_l2 *InstancePtr,
+                              const UINTPTR *Addr,
+                              u32 NumFrames,
+                              UINTPTR ChromaOffset,
+                              XVidC_FrmQPolicy Policy);
+void XVFrmbufWr_FrmQSetCallback(XVFrmbufWr_FrmQ *FrmQPtr,
+                                XVFrmbufWr_FrmQCallback CallbackFunc,
+                                void *CallbackRef);
+int XVFrmbufWr_FrmQAcquire(XVFrmbufWr_FrmQ *FrmQPtr, u32 *Index);
+void XVFrmbufWr_FrmQRelease(XVFrmbufWr_FrmQ *FrmQPtr, u32 Index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,428 @@
+/*******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * Use of the Software is limited solely to applications:
+ * (a) running on a Xilinx device, or
+ * (b) that interact with a Xilinx device through a bus or interconnect.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+*******************************************************************************/
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_frmq.c
+ * @addtogroup video_common_v4_3
+ * @{
+ *
+ * Contains the frame queue functions. See xvidc_frmq.h for a description of
+ * the frame states and policies.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -----------------------------------------------
+ * 4.3   ag   10/16/26 Initial release.
+ * </pre>
+ *
+*******************************************************************************/
+
+/******************************* Include Files ********************************/
+
+#include "xvidc_frmq.h"
+#if defined(__MICROBLAZE__)
+#include "mb_interface.h"
+#elif !defined(__GNUC__)
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions ******************************/
+
+#define XVIDC_FRMQ_MSR_IE	0x00000002U	/* MicroBlaze interrupt enable */
+
+/**************************** Function Prototypes *****************************/
+
+static u32 XVidC_FrmQCas(volatile u32 *State, u32 Old, u32 New);
+static int XVidC_FrmQFindReady(const XVidC_FrameQueue *Queue, u32 Newest,
+		u32 *Index);
+
+/**************************** Function Definitions ****************************/
+
+/******************************************************************************/
+/**
+ * Initialize a frame queue with all frames free.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Addr is an array of NumFrames frame buffer addresses.
+ * @param	NumFrames is the number of frames, at most
+ *		XVIDC_FRMQ_MAX_FRAMES.
+ * @param	Policy is the policy of the queue when the consumer falls
+ *		behind.
+ *
+ * @return	None.
+ *
+ * @note	Neither side may use the queue while it is initialized.
+ *
+*******************************************************************************/
+void XVidC_FrmQInit(XVidC_FrameQueue *Queue, const UINTPTR *Addr,
+		u32 NumFrames, XVidC_FrmQPolicy Policy)
+{
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(Queue != NULL);
+	Xil_AssertVoid(Addr != NULL);
+	Xil_AssertVoid((NumFrames > 0) && (NumFrames <= XVIDC_FRMQ_MAX_FRAMES));
+	Xil_AssertVoid(Policy <= XVIDC_FRMQ_LATEST);
+
+	for (Index = 0; Index < NumFrames; Index++) {
+		Queue->Addr[Index] = Addr[Index];
+		Queue->State[Index] = XVIDC_FRMQ_FREE;
+		Queue->Seq[Index] = 0;
+	}
+	Queue->NumFrames = NumFrames;
+	Queue->Policy = Policy;
+	Queue->NextSeq = 0;
+	Queue->Published = 0;
+	Queue->Overwritten = 0;
+	Queue->Skipped = 0;
+}
+
+/******************************************************************************/
+/**
+ * Acquire a frame for writing. A free frame is taken if there is one. Under
+ * XVIDC_FRMQ_LATEST the oldest ready frame is taken otherwise, and counted as
+ * overwritten.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is set to the index of the acquired frame.
+ *
+ * @return
+ *		- XST_SUCCESS if a frame was acquired.
+ *		- XST_DEVICE_BUSY if all frames are in use.
+ *
+ * @note	Producer side only. The frame must be handed back with
+ *		XVidC_FrmQPublish() or XVidC_FrmQCancelWrite().
+ *
+*******************************************************************************/
+int XVidC_FrmQAcquireWrite(XVidC_FrameQueue *Queue, u32 *Index)
+{
+	u32 Frame;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Queue != NULL);
+	Xil_AssertNonvoid(Index != NULL);
+
+	for (Frame = 0; Frame < Queue->NumFrames; Frame++) {
+		if ((Queue->State[Frame] == XVIDC_FRMQ_FREE) &&
+		    XVidC_FrmQCas(&Queue->State[Frame], XVIDC_FRMQ_FREE,
+				XVIDC_FRMQ_WRITING)) {
+			*Index = Frame;
+			return XST_SUCCESS;
+		}
+	}
+
+	if (Queue->Policy == XVIDC_FRMQ_LATEST) {
+		/* A failed swap means the consumer took the frame, look again */
+		while (XVidC_FrmQFindReady(Queue, FALSE, &Frame) ==
+				XST_SUCCESS) {
+			if (XVidC_FrmQCas(&Queue->State[Frame],
+					XVIDC_FRMQ_READY, XVIDC_FRMQ_WRITING)) {
+				Queue->Overwritten++;
+				*Index = Frame;
+				return XST_SUCCESS;
+			}
+		}
+	}
+
+	return XST_DEVICE_BUSY;
+}
+
+/******************************************************************************/
+/**
+ * Publish a frame the producer has completed, making it ready for the
+ * consumer.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is the index of a frame acquired for writing.
+ *
+ * @return	None.
+ *
+ * @note	Producer side only.
+ *
+*******************************************************************************/
+void XVidC_FrmQPublish(XVidC_FrameQueue *Queue, u32 Index)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(Queue != NULL);
+	Xil_AssertVoid(Index < Queue->NumFrames);
+	Xil_AssertVoid(Queue->State[Index] == XVIDC_FRMQ_WRITING);
+
+	/* The sequence is in place before the swap makes the frame visible */
+	Queue->Seq[Index] = Queue->NextSeq;
+	Queue->NextSeq++;
+	(void)XVidC_FrmQCas(&Queue->State[Index], XVIDC_FRMQ_WRITING,
+			XVIDC_FRMQ_READY);
+	Queue->Published++;
+}
+
+/******************************************************************************/
+/**
+ * Hand back a frame acquired for writing without publishing it.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is the index of a frame acquired for writing.
+ *
+ * @return	None.
+ *
+ * @note	Producer side only.
+ *
+*******************************************************************************/
+void XVidC_FrmQCancelWrite(XVidC_FrameQueue *Queue, u32 Index)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(Queue != NULL);
+	Xil_AssertVoid(Index < Queue->NumFrames);
+	Xil_AssertVoid(Queue->State[Index] == XVIDC_FRMQ_WRITING);
+
+	(void)XVidC_FrmQCas(&Queue->State[Index], XVIDC_FRMQ_WRITING,
+			XVIDC_FRMQ_FREE);
+}
+
+/******************************************************************************/
+/**
+ * Record that the producer writes a frame again because no other frame was
+ * available, losing its previous content. The frame stays acquired for
+ * writing.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is the index of a frame acquired for writing.
+ *
+ * @return	None.
+ *
+ * @note	Producer side only. This is for video DMA engines that can not
+ *		be held back.
+ *
+*******************************************************************************/
+void XVidC_FrmQRewrite(XVidC_FrameQueue *Queue, u32 Index)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(Queue != NULL);
+	Xil_AssertVoid(Index < Queue->NumFrames);
+	Xil_AssertVoid(Queue->State[Index] == XVIDC_FRMQ_WRITING);
+
+	Queue->Overwritten++;
+}
+
+/******************************************************************************/
+/**
+ * Acquire a ready frame for reading. Under XVIDC_FRMQ_FIFO this is the
+ * oldest ready frame. Under XVIDC_FRMQ_LATEST it is the newest one, and the
+ * older ready frames are freed and counted as skipped.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is set to the index of the acquired frame.
+ *
+ * @return
+ *		- XST_SUCCESS if a frame was acquired.
+ *		- XST_NO_DATA if no frame is ready.
+ *
+ * @note	Consumer side only. The frame must be handed back with
+ *		XVidC_FrmQRelease().
+ *
+*******************************************************************************/
+int XVidC_FrmQAcquireRead(XVidC_FrameQueue *Queue, u32 *Index)
+{
+	u32 Newest;
+	u32 Frame;
+	u32 Other;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Queue != NULL);
+	Xil_AssertNonvoid(Index != NULL);
+
+	Newest = (Queue->Policy == XVIDC_FRMQ_LATEST) ? TRUE : FALSE;
+
+	/* A failed swap means the producer took the frame back, look again */
+	do {
+		if (XVidC_FrmQFindReady(Queue, Newest, &Frame) !=
+				XST_SUCCESS) {
+			return XST_NO_DATA;
+		}
+	} while (!XVidC_FrmQCas(&Queue->State[Frame], XVIDC_FRMQ_READY,
+				XVIDC_FRMQ_READING));
+
+	if (Newest) {
+		for (Other = 0; Other < Queue->NumFrames; Other++) {
+			if ((Queue->State[Other] == XVIDC_FRMQ_READY) &&
+			    ((s32)(Queue->Seq[Other] - Queue->Seq[Frame]) < 0) &&
+			    XVidC_FrmQCas(&Queue->State[Other],
+					XVIDC_FRMQ_READY, XVIDC_FRMQ_FREE)) {
+				Queue->Skipped++;
+			}
+		}
+	}
+
+	*Index = Frame;
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * Release a frame the consumer is done with, making it free.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is the index of a frame acquired for reading.
+ *
+ * @return	None.
+ *
+ * @note	Consumer side only.
+ *
+*******************************************************************************/
+void XVidC_FrmQRelease(XVidC_FrameQueue *Queue, u32 Index)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(Queue != NULL);
+	Xil_AssertVoid(Index < Queue->NumFrames);
+	Xil_AssertVoid(Queue->State[Index] == XVIDC_FRMQ_READING);
+
+	(void)XVidC_FrmQCas(&Queue->State[Index], XVIDC_FRMQ_READING,
+			XVIDC_FRMQ_FREE);
+}
+
+/******************************************************************************/
+/**
+ * Get the number of frames ready for the consumer.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ *
+ * @return	The number of ready frames, which may change at any time.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u32 XVidC_FrmQNumReady(const XVidC_FrameQueue *Queue)
+{
+	u32 Frame;
+	u32 Count = 0;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Queue != NULL);
+
+	for (Frame = 0; Frame < Queue->NumFrames; Frame++) {
+		if (Queue->State[Frame] == XVIDC_FRMQ_READY) {
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+/******************************************************************************/
+/**
+ * Atomically change the state of a frame from Old to New.
+ *
+ * @param	State is a pointer to the state of the frame.
+ * @param	Old is the expected state.
+ * @param	New is the state to set.
+ *
+ * @return	TRUE if the state was Old and is now New, FALSE otherwise.
+ *
+ * @note	MicroBlaze and compilers without atomic builtins mask
+ *		interrupts instead, which is enough with a single processor.
+ *
+*******************************************************************************/
+static u32 XVidC_FrmQCas(volatile u32 *State, u32 Old, u32 New)
+{
+#if defined(__GNUC__) && !defined(__MICROBLAZE__)
+	return __atomic_compare_exchange_n(State, &Old, New, 0,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ? TRUE : FALSE;
+#else
+	u32 Done = FALSE;
+#if defined(__MICROBLAZE__)
+	u32 Msr = mfmsr();
+
+	mtmsr(Msr & ~XVIDC_FRMQ_MSR_IE);
+#else
+	u32 Mask = mfcpsr();
+
+	mtcpsr(Mask | 0xC0U);
+#endif
+	if (*State == Old) {
+		*State = New;
+		Done = TRUE;
+	}
+#if defined(__MICROBLAZE__)
+	mtmsr(Msr);
+#else
+	mtcpsr(Mask);
+#endif
+	return Done;
+#endif
+}
+
+/******************************************************************************/
+/**
+ * Find the oldest or the newest ready frame.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Newest selects the newest (TRUE) or oldest (FALSE) frame.
+ * @param	Index is set to the index of the frame found.
+ *
+ * @return	XST_SUCCESS if a ready frame was found, XST_NO_DATA otherwise.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static int XVidC_FrmQFindReady(const XVidC_FrameQueue *Queue, u32 Newest,
+		u32 *Index)
+{
+	u32 Frame;
+	u32 Found = Queue->NumFrames;
+	s32 Age;
+
+	for (Frame = 0; Frame < Queue->NumFrames; Frame++) {
+		if (Queue->State[Frame] != XVIDC_FRMQ_READY) {
+			continue;
+		}
+		if (Found == Queue->NumFrames) {
+			Found = Frame;
+			continue;
+		}
+		/* Sequence numbers wrap, compare their distance */
+		Age = (s32)(Queue->Seq[Frame] - Queue->Seq[Found]);
+		if ((Newest && (Age > 0)) || (!Newest && (Age < 0))) {
+			Found = Frame;
+		}
+	}
+
+	if (Found == Queue->NumFrames) {
+		return XST_NO_DATA;
+	}
+
+	*Index = Found;
+	return XST_SUCCESS;
+}
+/** @} */
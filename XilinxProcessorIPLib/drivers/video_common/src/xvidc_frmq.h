@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * Use of the Software is limited solely to applications:
+ * (a) running on a Xilinx device, or
+ * (b) that interact with a Xilinx device through a bus or interconnect.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+*******************************************************************************/
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_frmq.h
+ * @addtogroup video_common_v4_3
+ * @{
+ *
+ * Contains the frame queue, which tracks the ownership of a set of frame
+ * buffers shared by a producer and a consumer of video frames. Either side
+ * may be a video DMA engine serviced in its frame done interrupt, or the
+ * processor or an accelerator. Each frame is in one of four states:
+ *
+ *	FREE -> WRITING -> READY -> READING -> FREE
+ *
+ * The producer acquires a frame for writing and publishes it when it is
+ * complete; the consumer acquires a published frame for reading and releases
+ * it when done. Every transition is an atomic compare and swap on the state
+ * of a single frame, so the two sides never wait for each other and never
+ * touch the same frame: a frame is not torn.
+ *
+ * Two policies decide what happens when the consumer is slower than the
+ * producer:
+ *   - XVIDC_FRMQ_FIFO hands ready frames to the consumer in order. When all
+ *     frames are in use the producer gets none, a video DMA engine then
+ *     overwrites the frame it is writing.
+ *   - XVIDC_FRMQ_LATEST hands the newest ready frame to the consumer and
+ *     frees the older ones. When no frame is free the producer reuses the
+ *     oldest ready frame.
+ *
+ * With three frames and XVIDC_FRMQ_LATEST this is triple buffering. More
+ * frames with XVIDC_FRMQ_FIFO absorb a consumer which occasionally takes
+ * longer than a frame period, without losing frames.
+ *
+ * There must be only one producer and one consumer.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -----------------------------------------------
+ * 4.3   ag   10/16/26 Initial release.
+ * </pre>
+ *
+*******************************************************************************/
+
+#ifndef XVIDC_FRMQ_H_
+/* Prevent circular inclusions by using protection macros. */
+#define XVIDC_FRMQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/******************************* Include Files ********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ******************************/
+
+#define XVIDC_FRMQ_MAX_FRAMES	32	/**< Frames in a queue at most. */
+
+/****************************** Type Definitions ******************************/
+
+/**
+ * State of a frame in the queue.
+ */
+typedef enum {
+	XVIDC_FRMQ_FREE = 0,	/**< Owned by neither side. */
+	XVIDC_FRMQ_WRITING,	/**< Being filled by the producer. */
+	XVIDC_FRMQ_READY,	/**< Complete, waiting for the consumer. */
+	XVIDC_FRMQ_READING	/**< Being used by the consumer. */
+} XVidC_FrmQState;
+
+/**
+ * Policy of the queue when the consumer falls behind.
+ */
+typedef enum {
+	XVIDC_FRMQ_FIFO = 0,	/**< Ready frames are consumed in order. */
+	XVIDC_FRMQ_LATEST	/**< Only the newest ready frame is consumed. */
+} XVidC_FrmQPolicy;
+
+/**
+ * The frame queue. Its members are only to be accessed through the
+ * functions below, the counters may be read at any time.
+ */
+typedef struct {
+	UINTPTR Addr[XVIDC_FRMQ_MAX_FRAMES];	/**< Frame buffer addresses. */
+	volatile u32 State[XVIDC_FRMQ_MAX_FRAMES]; /**< XVidC_FrmQState of
+							each frame. */
+	volatile u32 Seq[XVIDC_FRMQ_MAX_FRAMES]; /**< Order in which the
+							frames were published. */
+	u32 NumFrames;			/**< Number of frames. */
+	XVidC_FrmQPolicy Policy;	/**< Policy of the queue. */
+	u32 NextSeq;			/**< Sequence of the next published
+						frame, producer only. */
+	volatile u32 Published;		/**< Frames published. */
+	volatile u32 Overwritten;	/**< Frames the producer wrote over
+						before they were consumed. */
+	volatile u32 Skipped;		/**< Ready frames freed by the consumer
+						under XVIDC_FRMQ_LATEST. */
+} XVidC_FrameQueue;
+
+/**************************** Function Prototypes *****************************/
+
+void XVidC_FrmQInit(XVidC_FrameQueue *Queue, const UINTPTR *Addr,
+		u32 NumFrames, XVidC_FrmQPolicy Policy);
+
+/* Producer side. */
+int XVidC_FrmQAcquireWrite(XVidC_FrameQueue *Queue, u32 *Index);
+void XVidC_FrmQPublish(XVidC_FrameQueue *Queue, u32 Index);
+void XVidC_FrmQCancelWrite(XVidC_FrameQueue *Queue, u32 Index);
+void XVidC_FrmQRewrite(XVidC_FrameQueue *Queue, u32 Index);
+
+/* Consumer side. */
+int XVidC_FrmQAcquireRead(XVidC_FrameQueue *Queue, u32 *Index);
+void XVidC_FrmQRelease(XVidC_FrameQueue *Queue, u32 Index);
+
+u32 XVidC_FrmQNumReady(const XVidC_FrameQueue *Queue);
+
+/*************************** Macros (Inline Functions) ************************/
+
+/******************************************************************************/
+/**
+ * Get the buffer address of a frame.
+ *
+ * @param	Queue is a pointer to the frame queue.
+ * @param	Index is the frame index returned by an acquire function.
+ *
+ * @return	The frame buffer address.
+ *
+ * @note	C-style signature:
+ *		UINTPTR XVidC_FrmQGetAddr(XVidC_FrameQueue *Queue, u32 Index)
+ *
+*******************************************************************************/
+#define XVidC_FrmQGetAddr(Queue, Index)	((Queue)->Addr[(Index)])
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XVIDC_FRMQ_H_ */
+/** @} */
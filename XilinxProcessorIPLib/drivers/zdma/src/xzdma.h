@@ -76,6 +76,21 @@
 * functions by using XZDma_SetCallBack API. In this version Descriptor done
 * option is disabled.
 *
+* <b> Job Queue </b>
+* An XZDma_Queue spreads memory copy and fill jobs over several ZDMA
+* channels, which may belong to both the FPD and the LPD DMA. Channels are
+* added with XZDma_QueueAddChannel() and jobs are submitted with
+* XZDma_QueueSubmit(); each job has its own completion handler. While a chain
+* of copy jobs runs on a channel, the next chain is linked in a second
+* descriptor bank, so the channel is restarted from the interrupt handler
+* with a few register writes. Use XZDma_QueueIsIdle() to wait for all jobs.
+*
+* <b> Memory Copy Offload </b>
+* XZDma_MemCopy() and XZDma_MemFill() copy and fill memory with a channel and
+* wait for the result. They match the Xil_MemDmaOps operations of the BSP, so
+* a channel dedicated to them can be registered with Xil_MemRegisterDma() to
+* take the large requests of Xil_MemCpy() and Xil_MemSet().
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -129,6 +144,11 @@
 * 1.5   adk     11/22/17 Added peripheral test app support for ZDMA driver.
 *		12/11/17 Fixed peripheral test app generation issues when dma
 *			 buffers are configured on OCM memory(CR#990806).
+*       ag      10/16/26 Added the job queue, XZDma_QueueInitialize(),
+*                        XZDma_QueueAddChannel(), XZDma_QueueSubmit() and
+*                        XZDma_QueueIsIdle().
+*       ag      10/16/26 Added XZDma_MemCopy() and XZDma_MemFill() to offload
+*                        Xil_MemCpy() and Xil_MemSet() to a channel.
 * </pre>
 *
 ******************************************************************************/
@@ -149,6 +169,9 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+#define XZDMA_QUEUE_MAX_CHANNELS	(16U)	/**< Channels of one job queue,
+						  *  8 FPD and 8 LPD */
+
 
 /**************************** Type Definitions *******************************/
 
@@ -365,6 +388,81 @@ typedef struct {
 				  *  this transfer only for SG mode */
 } XZDma_Transfer;
 
+/** @name ZDMA job types
+ * @{
+ */
+typedef enum {
+	XZDMA_JOB_COPY,		/**< Copy from source to destination */
+	XZDMA_JOB_FILL,		/**< Fill destination with a pattern */
+} XZDma_JobType;
+/*@}*/
+
+typedef struct XZDma_JobStruct XZDma_Job;
+
+/******************************************************************************/
+/**
+* Callback type for completion of a queued job.
+*
+* @param 	CallBackRef is the callback reference of the job.
+* @param	JobPtr is a pointer to the completed job.
+* @param	Status is XST_SUCCESS, or XST_DMA_ERROR if the channel reported
+*		an error while running the job.
+*******************************************************************************/
+typedef void (*XZDma_JobHandler) (void *CallBackRef, XZDma_Job *JobPtr,
+					s32 Status);
+
+/******************************************************************************/
+/**
+*
+* This typedef contains the fields of a job for the ZDMA job queue.
+*/
+struct XZDma_JobStruct {
+	XZDma_JobType Type;	/**< Copy or fill */
+	XZDma_Transfer Data;	/**< Addresses, size and coherency, the
+				  *  source is not used by fill jobs */
+	u32 Pattern[4];		/**< Data written by fill jobs */
+	XZDma_JobHandler Handler;	/**< Completion callback */
+	void *CallBackRef;	/**< To be passed to the handler */
+	XZDma_Job *Next;	/**< Used by the queue */
+};
+
+/******************************************************************************/
+/**
+*
+* This typedef contains the state of one channel of a ZDMA job queue.
+*/
+typedef struct {
+	XZDma *InstancePtr;	/**< ZDMA channel */
+	struct XZDma_QueueStruct *QueuePtr;	/**< Queue of the channel */
+	XZDma_LlDscr *SrcDscr[2];	/**< Source descriptors per bank */
+	XZDma_LlDscr *DstDscr[2];	/**< Destination descriptors per bank */
+	u32 BankSize;		/**< Jobs per descriptor bank */
+	u32 RunBank;		/**< Bank of the running chain */
+	XZDma_Job *RunHead;	/**< Jobs being run */
+	u32 RunCnt;		/**< Number of jobs being run */
+	XZDma_Job *StageHead;	/**< Jobs linked in the other bank */
+	XZDma_Job *StageTail;	/**< Last job linked in the other bank */
+	u32 StageCnt;		/**< Number of jobs linked in the other bank */
+} XZDma_QueueChan;
+
+/******************************************************************************/
+/**
+*
+* The ZDMA job queue. A pointer to it is passed to the XZDma_Queue*
+* functions.
+*/
+typedef struct XZDma_QueueStruct {
+	XZDma_QueueChan Chan[XZDMA_QUEUE_MAX_CHANNELS];	/**< Channels */
+	u32 ChanCnt;		/**< Number of channels */
+	XZDma_Job *PendHead;	/**< Oldest job waiting for a channel */
+	XZDma_Job *PendTail;	/**< Newest job waiting for a channel */
+	u32 PendCnt;		/**< Number of jobs waiting */
+	u32 Submitted;		/**< Jobs submitted */
+	u32 Completed;		/**< Jobs completed */
+	u32 Chains;		/**< Chains of jobs started */
+	u32 Errors;		/**< Error interrupts */
+} XZDma_Queue;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -702,6 +800,15 @@ void XZDma_IntrHandler(void *Instance);
 s32 XZDma_SetCallBack(XZDma *InstancePtr, XZDma_Handler HandlerType,
 	void *CallBackFunc, void *CallBackRef);
 
+void XZDma_QueueInitialize(XZDma_Queue *QueuePtr);
+s32 XZDma_QueueAddChannel(XZDma_Queue *QueuePtr, XZDma *InstancePtr,
+				UINTPTR Dscr_MemPtr, u32 NoOfBytes);
+s32 XZDma_QueueSubmit(XZDma_Queue *QueuePtr, XZDma_Job *JobPtr);
+u32 XZDma_QueueIsIdle(XZDma_Queue *QueuePtr);
+
+s32 XZDma_MemCopy(void *CallBackRef, void *Dst, const void *Src, u32 Size);
+s32 XZDma_MemFill(void *CallBackRef, void *Dst, u8 Val, u32 Size);
+
 /*@}*/
 
 #ifdef __cplusplus
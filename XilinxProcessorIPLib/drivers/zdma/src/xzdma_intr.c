@@ -45,6 +45,10 @@
 * Ver   Who     Date     Changes
 * ----- ------  -------- ------------------------------------------------------
 * 1.0   vns     2/27/15  First release
+* 1.5   ag      10/16/26 XZDma_IntrHandler() clears the pending interrupts
+*                        before calling the callbacks, so a done interrupt of
+*                        a transfer started from the done callback is not
+*                        lost.
 * </pre>
 *
 ******************************************************************************/
@@ -104,6 +108,12 @@ void XZDma_IntrHandler(void *Instance)
 	PendingIntr = (u32)(XZDma_IntrGetStatus(InstancePtr));
 	PendingIntr &= (~XZDma_GetIntrMask(InstancePtr));
 
+	/*
+	 * Clear pending interrupt(s) first, a callback may start the next
+	 * transfer, which can complete before this handler returns
+	 */
+	XZDma_IntrClear(InstancePtr, PendingIntr);
+
 	/* ZDMA transfer has completed */
 	ErrorStatus = (PendingIntr) & (XZDMA_IXR_DMA_DONE_MASK);
 	if ((ErrorStatus) != 0U) {
@@ -129,9 +139,6 @@ void XZDma_IntrHandler(void *Instance)
 		}
 		InstancePtr->ErrorHandler(InstancePtr->ErrorRef, ErrorStatus);
 	}
-
-	/* Clear pending interrupt(s) */
-	XZDma_IntrClear(InstancePtr, PendingIntr);
 }
 
 /*****************************************************************************/
@@ -0,0 +1,246 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_mem.c
+* @addtogroup zdma_v1_5
+* @{
+*
+* This file contains polled memory copy and fill functions of a ZDMA channel,
+* with the signature of the Xil_MemDmaOps operations of the standalone BSP,
+* so that Xil_MemCpy() and Xil_MemSet() can hand large requests to ZDMA:
+*
+* <pre>
+*	static Xil_MemDmaOps MemDma = {
+*		XZDma_MemCopy, XZDma_MemFill, &ZDmaInstance, 0x10000U
+*	};
+*	Xil_MemRegisterDma(&MemDma);
+* </pre>
+*
+* The channel must be dedicated to this use, with its interrupts disabled.
+*
+* Please see xzdma.h for more details of the driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.5   ag      10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xzdma.h"
+
+/************************** Constant Definitions *****************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+static s32 XZDma_MemRun(XZDma *InstancePtr, XZDma_Transfer *Data);
+
+/************************** Variable Definitions *****************************/
+
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function copies memory with a ZDMA channel in simple mode and waits
+* for the copy to complete.
+*
+* @param	CallBackRef is a pointer to the XZDma instance of the channel.
+* @param	Dst is the destination address.
+* @param	Src is the source address.
+* @param	Size is the number of bytes to copy.
+*
+* @return
+*		- XST_SUCCESS if the data is copied.
+*		- XST_DEVICE_BUSY if the channel is in use.
+*		- XST_INVALID_PARAM if Size is 0 or too large for one
+*		transfer.
+*		- XST_FAILURE if the channel reported an error.
+*
+* @note		Unless the channel is cache coherent, both buffers are flushed
+*		from the data cache before the copy and the destination is
+*		invalidated after it.
+*
+******************************************************************************/
+s32 XZDma_MemCopy(void *CallBackRef, void *Dst, const void *Src, u32 Size)
+{
+	XZDma *InstancePtr = (XZDma *)CallBackRef;
+	XZDma_Transfer Data;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+
+	if ((Size == 0U) || (Size > XZDMA_WORD2_SIZE_MASK)) {
+		return XST_INVALID_PARAM;
+	}
+	if (InstancePtr->ChannelState != XZDMA_IDLE) {
+		return XST_DEVICE_BUSY;
+	}
+
+	if ((InstancePtr->IsSgDma != FALSE) ||
+	    (InstancePtr->Mode != XZDMA_NORMAL_MODE)) {
+		(void)XZDma_SetMode(InstancePtr, FALSE, XZDMA_NORMAL_MODE);
+	}
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((UINTPTR)Src, Size);
+		Xil_DCacheFlushRange((UINTPTR)Dst, Size);
+	}
+
+	Data.SrcAddr = (UINTPTR)Src;
+	Data.DstAddr = (UINTPTR)Dst;
+	Data.Size = Size;
+	Data.SrcCoherent = (u8)InstancePtr->Config.IsCacheCoherent;
+	Data.DstCoherent = (u8)InstancePtr->Config.IsCacheCoherent;
+	Data.Pause = 0U;
+
+	return XZDma_MemRun(InstancePtr, &Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function fills memory with a byte value with a ZDMA channel in simple
+* write only mode and waits for the fill to complete.
+*
+* @param	CallBackRef is a pointer to the XZDma instance of the channel.
+* @param	Dst is the destination address, aligned to 16 bytes.
+* @param	Val is the value to write.
+* @param	Size is the number of bytes to fill, a non zero multiple of
+*		16.
+*
+* @return
+*		- XST_SUCCESS if the memory is filled.
+*		- XST_DEVICE_BUSY if the channel is in use.
+*		- XST_INVALID_PARAM if Dst or Size is not as required.
+*		- XST_FAILURE if the channel reported an error.
+*
+* @note		Unless the channel is cache coherent, the destination is
+*		flushed from the data cache before the fill and invalidated
+*		after it.
+*
+******************************************************************************/
+s32 XZDma_MemFill(void *CallBackRef, void *Dst, u8 Val, u32 Size)
+{
+	XZDma *InstancePtr = (XZDma *)CallBackRef;
+	XZDma_Transfer Data;
+	u32 Pattern[4];
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+
+	if ((Size == 0U) || (Size > XZDMA_WORD2_SIZE_MASK) ||
+	    ((Size & 0xFU) != 0U) ||
+	    (((UINTPTR)Dst & 0xFU) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+	if (InstancePtr->ChannelState != XZDMA_IDLE) {
+		return XST_DEVICE_BUSY;
+	}
+
+	if ((InstancePtr->IsSgDma != FALSE) ||
+	    (InstancePtr->Mode != XZDMA_WRONLY_MODE)) {
+		(void)XZDma_SetMode(InstancePtr, FALSE, XZDMA_WRONLY_MODE);
+	}
+	Pattern[0] = (u32)Val * 0x01010101U;
+	Pattern[1] = Pattern[0];
+	Pattern[2] = Pattern[0];
+	Pattern[3] = Pattern[0];
+	XZDma_WOData(InstancePtr, Pattern);
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((UINTPTR)Dst, Size);
+	}
+
+	Data.SrcAddr = 0U;
+	Data.DstAddr = (UINTPTR)Dst;
+	Data.Size = Size;
+	Data.SrcCoherent = 0U;
+	Data.DstCoherent = (u8)InstancePtr->Config.IsCacheCoherent;
+	Data.Pause = 0U;
+
+	return XZDma_MemRun(InstancePtr, &Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function starts a simple mode transfer and polls the interrupt
+* status until it is done.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	Data is a pointer to the transfer.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the channel reported an error.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 XZDma_MemRun(XZDma *InstancePtr, XZDma_Transfer *Data)
+{
+	u32 Status;
+
+	XZDma_IntrClear(InstancePtr, XZDMA_IXR_ALL_INTR_MASK);
+	(void)XZDma_Start(InstancePtr, Data, 1U);
+
+	do {
+		Status = XZDma_IntrGetStatus(InstancePtr);
+	} while ((Status & (XZDMA_IXR_DMA_DONE_MASK | XZDMA_IXR_ERR_MASK)) ==
+		 0U);
+
+	XZDma_IntrClear(InstancePtr, Status);
+	InstancePtr->ChannelState = XZDMA_IDLE;
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheInvalidateRange(Data->DstAddr, Data->Size);
+	}
+
+	return ((Status & XZDMA_IXR_ERR_MASK) != 0U) ? XST_FAILURE :
+		XST_SUCCESS;
+}
+/** @} */
@@ -0,0 +1,654 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_queue.c
+* @addtogroup zdma_v1_5
+* @{
+*
+* This file contains the ZDMA job queue. A queue spreads memory copy and fill
+* jobs over any number of ZDMA channels, of the FPD (GDMA) and LPD (ADMA)
+* instances alike, and calls a handler per job when it completes.
+*
+* Copy jobs are run in scatter gather mode from linked list descriptors. The
+* descriptor memory of each channel is split in two banks: while the chain of
+* one bank runs, newly submitted jobs are linked into the other. When the
+* running chain is done, the interrupt handler only has to program the start
+* address of the prepared chain and enable the channel. Fill jobs are run
+* alone in simple write only mode.
+*
+* Please see xzdma.h for more details of the driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.5   ag      10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xzdma.h"
+#include "xil_exception.h"
+#include "xpseudo_asm.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Descriptors per job, one source and one destination */
+#define XZDMA_QUEUE_DSCR_PER_JOB	(2U)
+
+/* Descriptor banks per channel */
+#define XZDMA_QUEUE_BANKS		(2U)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * The queue is shared by the submitting context and the interrupt handlers
+ * of its channels. IRQs are masked while it is updated and the previous mask
+ * is restored afterwards, so the queue may also be used from the handlers.
+ */
+#define XZDMA_QUEUE_LOCK(Saved)		\
+	{					\
+		(Saved) = mfcpsr();		\
+		Xil_ExceptionDisable();		\
+	}
+
+#define XZDMA_QUEUE_UNLOCK(Saved)	mtcpsr(Saved)
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+static void XZDma_QueueDoneHandler(void *CallBackRef);
+static void XZDma_QueueErrorHandler(void *CallBackRef, u32 ErrorMask);
+static void XZDma_QueueChanDone(XZDma_QueueChan *ChanPtr, s32 Status);
+static void XZDma_QueueDispatch(XZDma_QueueChan *ChanPtr);
+static void XZDma_QueueStage(XZDma_QueueChan *ChanPtr, XZDma_Job *JobPtr);
+static void XZDma_QueueStartChain(XZDma_QueueChan *ChanPtr);
+static void XZDma_QueueStartFill(XZDma_QueueChan *ChanPtr, XZDma_Job *JobPtr);
+static XZDma_Job *XZDma_QueuePopPending(XZDma_Queue *QueuePtr);
+
+/************************** Variable Definitions *****************************/
+
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a ZDMA job queue without channels.
+*
+* @param	QueuePtr is a pointer to the XZDma_Queue instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XZDma_QueueInitialize(XZDma_Queue *QueuePtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	(void)memset((void *)QueuePtr, 0, sizeof(XZDma_Queue));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a ZDMA channel to a job queue. The done and error
+* callbacks of the channel are taken over by the queue and its done and error
+* interrupts are enabled. The application connects XZDma_IntrHandler() of the
+* channel to the interrupt system as usual.
+*
+* @param	QueuePtr is a pointer to the XZDma_Queue instance.
+* @param	InstancePtr is a pointer to the initialized XZDma instance of
+*		the channel. The channel must be idle.
+* @param	Dscr_MemPtr is a pointer to the memory for the descriptors of
+*		the channel. It should be aligned to 64 bytes.
+* @param	NoOfBytes specifies the number of bytes allocated for
+*		descriptors. Each job needs 64 bytes in each of the two banks,
+*		so 128 bytes per job that may be linked into one chain.
+*
+* @return
+*		- XST_SUCCESS if the channel is added.
+*		- XST_INVALID_PARAM if the memory is too small for one job.
+*		- XST_FAILURE if the queue is full or the channel is busy.
+*
+* @note		Channels can only be added while the queue is idle.
+*
+******************************************************************************/
+s32 XZDma_QueueAddChannel(XZDma_Queue *QueuePtr, XZDma *InstancePtr,
+				UINTPTR Dscr_MemPtr, u32 NoOfBytes)
+{
+	XZDma_QueueChan *ChanPtr;
+	u32 BankSize;
+	UINTPTR Addr;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+				(u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid(Dscr_MemPtr != 0x00);
+
+	BankSize = NoOfBytes / (XZDMA_QUEUE_BANKS * XZDMA_QUEUE_DSCR_PER_JOB *
+				(u32)sizeof(XZDma_LlDscr));
+	if (BankSize == 0U) {
+		return XST_INVALID_PARAM;
+	}
+	if ((QueuePtr->ChanCnt >= XZDMA_QUEUE_MAX_CHANNELS) ||
+	    (InstancePtr->ChannelState != XZDMA_IDLE)) {
+		return XST_FAILURE;
+	}
+
+	ChanPtr = &QueuePtr->Chan[QueuePtr->ChanCnt];
+	(void)memset((void *)ChanPtr, 0, sizeof(XZDma_QueueChan));
+	ChanPtr->InstancePtr = InstancePtr;
+	ChanPtr->QueuePtr = QueuePtr;
+	ChanPtr->BankSize = BankSize;
+
+	/* Source and destination descriptors of bank 0, then of bank 1 */
+	Addr = Dscr_MemPtr;
+	ChanPtr->SrcDscr[0] = (XZDma_LlDscr *)Addr;
+	Addr += BankSize * sizeof(XZDma_LlDscr);
+	ChanPtr->DstDscr[0] = (XZDma_LlDscr *)Addr;
+	Addr += BankSize * sizeof(XZDma_LlDscr);
+	ChanPtr->SrcDscr[1] = (XZDma_LlDscr *)Addr;
+	Addr += BankSize * sizeof(XZDma_LlDscr);
+	ChanPtr->DstDscr[1] = (XZDma_LlDscr *)Addr;
+
+	/* Jobs are staged in the bank other than RunBank */
+	ChanPtr->RunBank = 1U;
+
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_DONE,
+			(void *)XZDma_QueueDoneHandler, (void *)ChanPtr);
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_ERROR,
+			(void *)XZDma_QueueErrorHandler, (void *)ChanPtr);
+	XZDma_EnableIntr(InstancePtr,
+			(XZDMA_IXR_DMA_DONE_MASK | XZDMA_IXR_ERR_MASK));
+
+	QueuePtr->ChanCnt++;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function submits a job to a ZDMA job queue. A copy job is started at
+* once on an idle channel, or else linked into the chain prepared on the
+* busy channel with the fewest jobs waiting. A fill job is started on an idle
+* channel. Jobs that find no room wait in the queue in submission order.
+*
+* When the job completes, its handler is called from the interrupt handler of
+* the channel that ran it, with XST_SUCCESS or XST_DMA_ERROR. Jobs run on
+* different channels may complete in any order.
+*
+* @param	QueuePtr is a pointer to the XZDma_Queue instance.
+* @param	JobPtr is a pointer to the job. The fields of the structure are:
+*		- Type - XZDMA_JOB_COPY or XZDMA_JOB_FILL
+*		- Data - Source and destination address, size in bytes and
+*		  coherency, as for XZDma_Start(). The source is not used by
+*		  fill jobs, whose destination address and size should be
+*		  multiples of 16 bytes.
+*		- Pattern - Data written by fill jobs, all four words on the
+*		  FPD DMA and the first two on the LPD DMA.
+*		- Handler, CallBackRef - Completion handler and its argument.
+*		The job belongs to the queue until its handler is called.
+*
+* @return
+*		- XST_SUCCESS if the job is queued.
+*		- XST_INVALID_PARAM if the size of the job is not valid.
+*
+* @note		This function may be called from job handlers.
+*
+******************************************************************************/
+s32 XZDma_QueueSubmit(XZDma_Queue *QueuePtr, XZDma_Job *JobPtr)
+{
+	XZDma_QueueChan *ChanPtr;
+	XZDma_QueueChan *BestPtr = NULL;
+	u32 Saved;
+	u32 Index;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(JobPtr != NULL);
+	Xil_AssertNonvoid((JobPtr->Type == XZDMA_JOB_COPY) ||
+				(JobPtr->Type == XZDMA_JOB_FILL));
+	Xil_AssertNonvoid(JobPtr->Handler != NULL);
+
+	if ((JobPtr->Data.Size == 0U) ||
+	    (JobPtr->Data.Size > XZDMA_WORD2_SIZE_MASK)) {
+		return XST_INVALID_PARAM;
+	}
+	JobPtr->Next = NULL;
+
+	XZDMA_QUEUE_LOCK(Saved);
+
+	QueuePtr->Submitted++;
+	for (Index = 0U; Index < QueuePtr->ChanCnt; Index++) {
+		ChanPtr = &QueuePtr->Chan[Index];
+		if (ChanPtr->RunCnt == 0U) {
+			BestPtr = ChanPtr;
+			break;
+		}
+		if ((JobPtr->Type == XZDMA_JOB_COPY) &&
+		    (ChanPtr->StageCnt < ChanPtr->BankSize) &&
+		    ((BestPtr == NULL) ||
+		     (ChanPtr->StageCnt < BestPtr->StageCnt))) {
+			BestPtr = ChanPtr;
+		}
+	}
+
+	if (BestPtr == NULL) {
+		/* Wait for a channel */
+		if (QueuePtr->PendTail == NULL) {
+			QueuePtr->PendHead = JobPtr;
+		} else {
+			QueuePtr->PendTail->Next = JobPtr;
+		}
+		QueuePtr->PendTail = JobPtr;
+		QueuePtr->PendCnt++;
+	} else if (JobPtr->Type == XZDMA_JOB_FILL) {
+		XZDma_QueueStartFill(BestPtr, JobPtr);
+	} else {
+		XZDma_QueueStage(BestPtr, JobPtr);
+		if (BestPtr->RunCnt == 0U) {
+			XZDma_QueueStartChain(BestPtr);
+		}
+	}
+
+	XZDMA_QUEUE_UNLOCK(Saved);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells whether all jobs submitted to a ZDMA job queue have
+* completed.
+*
+* @param	QueuePtr is a pointer to the XZDma_Queue instance.
+*
+* @return	TRUE if no job is waiting or running, FALSE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XZDma_QueueIsIdle(XZDma_Queue *QueuePtr)
+{
+	u32 Index;
+	u32 IsIdle = TRUE;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+
+	if (QueuePtr->PendCnt != 0U) {
+		IsIdle = FALSE;
+	}
+	for (Index = 0U; Index < QueuePtr->ChanCnt; Index++) {
+		if (QueuePtr->Chan[Index].RunCnt != 0U) {
+			IsIdle = FALSE;
+		}
+	}
+
+	return IsIdle;
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function is the done callback of the channels of a queue.
+*
+* @param	CallBackRef is the XZDma_QueueChan of the channel.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_QueueDoneHandler(void *CallBackRef)
+{
+	XZDma_QueueChan *ChanPtr = (XZDma_QueueChan *)CallBackRef;
+	s32 Status = XST_SUCCESS;
+
+	if ((XZDma_ReadReg(ChanPtr->InstancePtr->Config.BaseAddress,
+			XZDMA_CH_STS_OFFSET) & XZDMA_STS_ALL_MASK) ==
+			XZDMA_STS_DONE_ERR_MASK) {
+		Status = XST_DMA_ERROR;
+	}
+
+	XZDma_QueueChanDone(ChanPtr, Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function is the error callback of the channels of a queue. AXI
+* errors end the running chain, whose jobs complete with XST_DMA_ERROR. When
+* the done callback has already completed the chain and started the next one
+* the channel is busy again and only its state is restored.
+*
+* @param	CallBackRef is the XZDma_QueueChan of the channel.
+* @param	ErrorMask is a bit mask indicating the cause of the error.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_QueueErrorHandler(void *CallBackRef, u32 ErrorMask)
+{
+	XZDma_QueueChan *ChanPtr = (XZDma_QueueChan *)CallBackRef;
+	XZDma *InstancePtr = ChanPtr->InstancePtr;
+
+	ChanPtr->QueuePtr->Errors++;
+
+	if ((XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_STS_OFFSET) & XZDMA_STS_ALL_MASK) ==
+			XZDMA_STS_BUSY_MASK) {
+		InstancePtr->ChannelState = XZDMA_BUSY;
+		return;
+	}
+
+	if (((ErrorMask & (XZDMA_IXR_AXI_WR_DATA_MASK |
+		XZDMA_IXR_AXI_RD_DATA_MASK | XZDMA_IXR_AXI_RD_DST_DSCR_MASK |
+		XZDMA_IXR_AXI_RD_SRC_DSCR_MASK)) != 0x00U) &&
+	    (ChanPtr->RunCnt != 0U)) {
+		XZDma_QueueChanDone(ChanPtr, XST_DMA_ERROR);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function completes the jobs run by a channel. The next chain,
+* if one is prepared, is started before the job handlers are called so the
+* channel idles as little as possible.
+*
+* @param	ChanPtr is a pointer to the queue channel.
+* @param	Status is the completion status of the jobs.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_QueueChanDone(XZDma_QueueChan *ChanPtr, s32 Status)
+{
+	XZDma_Queue *QueuePtr = ChanPtr->QueuePtr;
+	XZDma_Job *JobPtr;
+	XZDma_Job *NextPtr;
+	u32 Saved;
+
+	XZDMA_QUEUE_LOCK(Saved);
+
+	JobPtr = ChanPtr->RunHead;
+	QueuePtr->Completed += ChanPtr->RunCnt;
+	ChanPtr->RunHead = NULL;
+	ChanPtr->RunCnt = 0U;
+
+	if (ChanPtr->StageCnt != 0U) {
+		XZDma_QueueStartChain(ChanPtr);
+	}
+	XZDma_QueueDispatch(ChanPtr);
+
+	XZDMA_QUEUE_UNLOCK(Saved);
+
+	while (JobPtr != NULL) {
+		NextPtr = JobPtr->Next;
+		JobPtr->Handler(JobPtr->CallBackRef, JobPtr, Status);
+		JobPtr = NextPtr;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function gives waiting jobs to a channel: a job to run if the
+* channel is idle, then copy jobs to link into its prepared chain.
+*
+* @param	ChanPtr is a pointer to the queue channel.
+*
+* @return	None.
+*
+* @note		Called with the queue locked.
+*
+******************************************************************************/
+static void XZDma_QueueDispatch(XZDma_QueueChan *ChanPtr)
+{
+	XZDma_Queue *QueuePtr = ChanPtr->QueuePtr;
+	XZDma_Job *JobPtr;
+
+	if ((ChanPtr->RunCnt == 0U) && (QueuePtr->PendHead != NULL)) {
+		JobPtr = XZDma_QueuePopPending(QueuePtr);
+		if (JobPtr->Type == XZDMA_JOB_FILL) {
+			XZDma_QueueStartFill(ChanPtr, JobPtr);
+		} else {
+			XZDma_QueueStage(ChanPtr, JobPtr);
+			while ((QueuePtr->PendHead != NULL) &&
+			       (QueuePtr->PendHead->Type == XZDMA_JOB_COPY) &&
+			       (ChanPtr->StageCnt < ChanPtr->BankSize)) {
+				XZDma_QueueStage(ChanPtr,
+					XZDma_QueuePopPending(QueuePtr));
+			}
+			XZDma_QueueStartChain(ChanPtr);
+		}
+	}
+
+	/* Prepare the next chain while this one runs */
+	while ((QueuePtr->PendHead != NULL) &&
+	       (QueuePtr->PendHead->Type == XZDMA_JOB_COPY) &&
+	       (ChanPtr->StageCnt < ChanPtr->BankSize)) {
+		XZDma_QueueStage(ChanPtr, XZDma_QueuePopPending(QueuePtr));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function links a copy job into the chain prepared in the
+* staging bank of a channel. The previous last descriptor pair is pointed at
+* the new one, which ends the chain.
+*
+* @param	ChanPtr is a pointer to the queue channel.
+* @param	JobPtr is a pointer to the copy job.
+*
+* @return	None.
+*
+* @note		Called with the queue locked and room in the staging bank.
+*
+******************************************************************************/
+static void XZDma_QueueStage(XZDma_QueueChan *ChanPtr, XZDma_Job *JobPtr)
+{
+	u32 Bank = ChanPtr->RunBank ^ 1U;
+	XZDma_LlDscr *SrcPtr = &ChanPtr->SrcDscr[Bank][ChanPtr->StageCnt];
+	XZDma_LlDscr *DstPtr = &ChanPtr->DstDscr[Bank][ChanPtr->StageCnt];
+	u32 Value;
+
+	if (ChanPtr->StageCnt != 0U) {
+		(SrcPtr - 1)->Cntl &= ~XZDMA_WORD3_CMD_MASK;
+		(SrcPtr - 1)->NextDscr = (u64)(UINTPTR)SrcPtr;
+		(DstPtr - 1)->NextDscr = (u64)(UINTPTR)DstPtr;
+	}
+
+	Value = XZDMA_WORD3_CMD_STOP_MASK;
+	if (JobPtr->Data.SrcCoherent == TRUE) {
+		Value |= XZDMA_WORD3_COHRNT_MASK;
+	}
+	SrcPtr->Address = (u64)JobPtr->Data.SrcAddr;
+	SrcPtr->Size = JobPtr->Data.Size & XZDMA_WORD2_SIZE_MASK;
+	SrcPtr->Cntl = Value;
+	SrcPtr->NextDscr = 0U;
+	SrcPtr->Reserved = 0U;
+
+	Value = 0U;
+	if (JobPtr->Data.DstCoherent == TRUE) {
+		Value |= XZDMA_WORD3_COHRNT_MASK;
+	}
+	DstPtr->Address = (u64)JobPtr->Data.DstAddr;
+	DstPtr->Size = JobPtr->Data.Size & XZDMA_WORD2_SIZE_MASK;
+	DstPtr->Cntl = Value;
+	DstPtr->NextDscr = 0U;
+	DstPtr->Reserved = 0U;
+
+	if (ChanPtr->StageTail == NULL) {
+		ChanPtr->StageHead = JobPtr;
+	} else {
+		ChanPtr->StageTail->Next = JobPtr;
+	}
+	ChanPtr->StageTail = JobPtr;
+	ChanPtr->StageCnt++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function starts the chain prepared in the staging bank of an
+* idle channel. The whole bank is flushed at once, and the other bank becomes
+* the staging bank.
+*
+* @param	ChanPtr is a pointer to the queue channel.
+*
+* @return	None.
+*
+* @note		Called with the queue locked.
+*
+******************************************************************************/
+static void XZDma_QueueStartChain(XZDma_QueueChan *ChanPtr)
+{
+	XZDma *InstancePtr = ChanPtr->InstancePtr;
+	u32 Bank = ChanPtr->RunBank ^ 1U;
+	UINTPTR SrcAddr = (UINTPTR)ChanPtr->SrcDscr[Bank];
+	UINTPTR DstAddr = (UINTPTR)ChanPtr->DstDscr[Bank];
+
+	if (!InstancePtr->Config.IsCacheCoherent) {
+		Xil_DCacheFlushRange(SrcAddr,
+			ChanPtr->StageCnt * sizeof(XZDma_LlDscr));
+		Xil_DCacheFlushRange(DstAddr,
+			ChanPtr->StageCnt * sizeof(XZDma_LlDscr));
+	}
+
+	if ((InstancePtr->IsSgDma != TRUE) ||
+	    (InstancePtr->Mode != XZDMA_NORMAL_MODE)) {
+		(void)XZDma_SetMode(InstancePtr, TRUE, XZDMA_NORMAL_MODE);
+	}
+
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_SRC_START_LSB_OFFSET, (SrcAddr & XZDMA_WORD0_LSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_SRC_START_MSB_OFFSET,
+		(((u64)SrcAddr >> XZDMA_WORD1_MSB_SHIFT) & XZDMA_WORD1_MSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_DST_START_LSB_OFFSET, (DstAddr & XZDMA_WORD0_LSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_DST_START_MSB_OFFSET,
+		(((u64)DstAddr >> XZDMA_WORD1_MSB_SHIFT) & XZDMA_WORD1_MSB_MASK));
+
+	ChanPtr->RunHead = ChanPtr->StageHead;
+	ChanPtr->RunCnt = ChanPtr->StageCnt;
+	ChanPtr->RunBank = Bank;
+	ChanPtr->StageHead = NULL;
+	ChanPtr->StageTail = NULL;
+	ChanPtr->StageCnt = 0U;
+	ChanPtr->QueuePtr->Chains++;
+
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress, XZDMA_CH_IEN_OFFSET,
+			(InstancePtr->IntrMask & XZDMA_IXR_ALL_INTR_MASK));
+	InstancePtr->ChannelState = XZDMA_BUSY;
+	XZDma_EnableCh(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function starts a fill job on an idle channel in simple write
+* only mode.
+*
+* @param	ChanPtr is a pointer to the queue channel.
+* @param	JobPtr is a pointer to the fill job.
+*
+* @return	None.
+*
+* @note		Called with the queue locked.
+*
+******************************************************************************/
+static void XZDma_QueueStartFill(XZDma_QueueChan *ChanPtr, XZDma_Job *JobPtr)
+{
+	XZDma *InstancePtr = ChanPtr->InstancePtr;
+
+	if ((InstancePtr->IsSgDma != FALSE) ||
+	    (InstancePtr->Mode != XZDMA_WRONLY_MODE)) {
+		(void)XZDma_SetMode(InstancePtr, FALSE, XZDMA_WRONLY_MODE);
+	}
+	XZDma_WOData(InstancePtr, JobPtr->Pattern);
+
+	ChanPtr->RunHead = JobPtr;
+	ChanPtr->RunCnt = 1U;
+
+	(void)XZDma_Start(InstancePtr, &JobPtr->Data, 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function takes the oldest waiting job of a queue.
+*
+* @param	QueuePtr is a pointer to the XZDma_Queue instance.
+*
+* @return	The job, which must exist.
+*
+* @note		Called with the queue locked.
+*
+******************************************************************************/
+static XZDma_Job *XZDma_QueuePopPending(XZDma_Queue *QueuePtr)
+{
+	XZDma_Job *JobPtr = QueuePtr->PendHead;
+
+	QueuePtr->PendHead = JobPtr->Next;
+	if (QueuePtr->PendHead == NULL) {
+		QueuePtr->PendTail = NULL;
+	}
+	QueuePtr->PendCnt--;
+	JobPtr->Next = NULL;
+
+	return JobPtr;
+}
+/** @} */
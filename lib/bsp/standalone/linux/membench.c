@@ -0,0 +1,236 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file membench.c
+* Host micro-benchmark of the BSP memory copy and set functions
+*
+* Builds ../src/common/xil_mem.c for the host and reports MB/s of Xil_MemCpy
+* and Xil_MemSet against the first release of Xil_MemCpy, a word loop, and
+* against the C library. Each copy is checked against memcpy first.
+*
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "xil_types.h"
+#include "xil_mem.h"
+
+#define BUF_SIZE	(4U * 1024U * 1024U)
+#define MIN_BYTES	(64U * 1024U * 1024U)	/* Bytes moved per measurement */
+
+static const char options[] = "s:h";
+static char help_msg[] =
+"Usage: membench [options]\n"
+"\n"
+"Options:\n"
+"\t-s <bytes>\tMeasure this size only\n"
+"\t-h\t\tHelp\n";
+
+static const u32 sizes[] = {
+	16U, 64U, 256U, 1024U, 4096U, 16384U, 65536U, 262144U, 1048576U,
+	4194304U
+};
+
+/* Xil_MemCpy as first released, the baseline */
+static void XilMemCpyRef(void *dst, const void *src, u32 cnt)
+{
+	char *d = (char *)dst;
+	const char *s = src;
+
+	while (cnt >= sizeof (int)) {
+		*(int *)d = *(int *)s;
+		d += sizeof (int);
+		s += sizeof (int);
+		cnt -= sizeof (int);
+	}
+	while (cnt > 0U) {
+		*d = *s;
+		d += 1U;
+		s += 1U;
+		cnt -= 1U;
+	}
+}
+
+static void XilMemSetRef(void *dst, s32 val, u32 cnt)
+{
+	u8 *d = dst;
+
+	while (cnt > 0U) {
+		*d = (u8)val;
+		d += 1U;
+		cnt -= 1U;
+	}
+}
+
+static void LibcMemCpy(void *dst, const void *src, u32 cnt)
+{
+	memcpy(dst, src, cnt);
+}
+
+static void LibcMemSet(void *dst, s32 val, u32 cnt)
+{
+	memset(dst, val, cnt);
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static double bench_cpy(void (*fn)(void *, const void *, u32), u8 *dst,
+			const u8 *src, u32 size)
+{
+	u32 iter = (MIN_BYTES / size) + 1U;
+	u32 i;
+	double t;
+
+	fn(dst, src, size);
+	t = now();
+	for (i = 0U; i < iter; i++)
+		fn(dst, src, size);
+	t = now() - t;
+	return ((double)size * iter) / t / 1e6;
+}
+
+static double bench_set(void (*fn)(void *, s32, u32), u8 *dst, u32 size)
+{
+	u32 iter = (MIN_BYTES / size) + 1U;
+	u32 i;
+	double t;
+
+	fn(dst, 0x5A, size);
+	t = now();
+	for (i = 0U; i < iter; i++)
+		fn(dst, (s32)i, size);
+	t = now() - t;
+	return ((double)size * iter) / t / 1e6;
+}
+
+static int check(u8 *dst, u8 *ref, const u8 *src, u32 size, u32 doff,
+		 u32 soff)
+{
+	memset(dst, 0xEE, size + 128U);
+	memset(ref, 0xEE, size + 128U);
+	Xil_MemCpy(dst + doff, src + soff, size);
+	memcpy(ref + doff, src + soff, size);
+	if (memcmp(dst, ref, size + 128U) != 0)
+		return -1;
+
+	Xil_MemSet(dst + doff, 0xA5, size);
+	memset(ref + doff, 0xA5, size);
+	return (memcmp(dst, ref, size + 128U) != 0) ? -1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	static const u32 offs[][2] = { {0U, 0U}, {1U, 1U}, {4U, 0U}, {3U, 1U} };
+	u8 *src, *dst, *ref;
+	u32 only = 0U;
+	u32 i, j;
+	int c;
+
+	while ((c = getopt(argc, argv, options)) != -1) {
+		switch (c) {
+		case 's':
+			only = (u32)strtoul(optarg, NULL, 0);
+			if ((only == 0U) || (only > BUF_SIZE)) {
+				fprintf(stderr, "size out of range\n");
+				return 1;
+			}
+			break;
+		default:
+			printf("%s", help_msg);
+			return (c == 'h') ? 0 : 1;
+		}
+	}
+
+	src = aligned_alloc(64, BUF_SIZE + 128U);
+	dst = aligned_alloc(64, BUF_SIZE + 128U);
+	ref = aligned_alloc(64, BUF_SIZE + 128U);
+	if ((src == NULL) || (dst == NULL) || (ref == NULL)) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (i = 0U; i < BUF_SIZE + 128U; i++)
+		src[i] = (u8)(i * 7U + 3U);
+
+	for (i = 0U; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		for (j = 0U; j < sizeof(offs) / sizeof(offs[0]); j++) {
+			if ((sizes[i] + 8U <= BUF_SIZE) &&
+			    (check(dst, ref, src, sizes[i] + j, offs[j][0],
+				   offs[j][1]) != 0)) {
+				fprintf(stderr, "mismatch: size %u dst+%u src+%u\n",
+					sizes[i] + j, offs[j][0], offs[j][1]);
+				return 1;
+			}
+		}
+	}
+
+	printf("%10s %7s | %10s %10s %10s | %10s %10s %10s\n", "bytes",
+	       "dst/src", "cpy ref", "Xil_MemCpy", "memcpy", "set bytes",
+	       "Xil_MemSet", "memset");
+	for (i = 0U; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		u32 size = (only != 0U) ? only : sizes[i];
+
+		for (j = 0U; j < sizeof(offs) / sizeof(offs[0]); j++) {
+			u8 *d = dst + offs[j][0];
+			const u8 *s = src + offs[j][1];
+
+			printf("%10u %3u/%-3u | %10.1f %10.1f %10.1f",
+			       size, offs[j][0], offs[j][1],
+			       bench_cpy(XilMemCpyRef, d, s, size),
+			       bench_cpy(Xil_MemCpy, d, s, size),
+			       bench_cpy(LibcMemCpy, d, s, size));
+			if (offs[j][1] == 0U)
+				printf(" | %10.1f %10.1f %10.1f\n",
+				       bench_set(XilMemSetRef, d, size),
+				       bench_set(Xil_MemSet, d, size),
+				       bench_set(LibcMemSet, d, size));
+			else
+				printf("\n");
+		}
+		if (only != 0U)
+			break;
+	}
+
+	free(src);
+	free(dst);
+	free(ref);
+	return 0;
+}
@@ -0,0 +1,504 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file profsym.c
+* Host symbolizer of the BSP sampling profiler
+*
+* Reads sample buffers written by ../src/arm/common/xil_prof.c, either as
+* raw memory saved by the debugger or as Xil_ProfDump() output in a console
+* log, and attributes the samples to the functions of the ELF file: the PC
+* gives the function that was running, the link register its caller.
+*
+******************************************************************************/
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xil_types.h"
+#include "xil_prof.h"
+
+#define HDR_SIZE	32U
+#define LINE_MAX	4096
+
+typedef struct {
+	unsigned long long Addr;
+	unsigned long long Size;
+	const char *Name;
+} Sym;
+
+typedef struct {
+	Sym *Syms;
+	size_t NumSyms;
+	char *Image;		/* ELF file, the names point into it */
+} Elf;
+
+typedef struct {
+	size_t Func;
+	size_t Caller;
+} Pair;
+
+static const char options[] = "+e:cn:h";
+static char help_msg[] =
+"Usage: profsym [options] -e app.elf file... [-e app2.elf file...]\n"
+"\n"
+"Each file is a raw sample buffer saved from target memory, or a console\n"
+"log holding Xil_ProfDump() output. -e gives the ELF file of the buffers\n"
+"that follow it, so buffers of several processors running different\n"
+"applications can be given together.\n"
+"\n"
+"Options:\n"
+"\t-e <elf>\tELF file of the following buffers\n"
+"\t-c\t\tAlso list the callers of each function, from the LR\n"
+"\t-n <rows>\tFunctions listed per buffer, default 30\n"
+"\t-h\t\tHelp\n";
+
+static int show_callers;
+static size_t max_rows = 30;
+
+static u32 get32(const unsigned char *p)
+{
+	return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) |
+	       ((u32)p[3] << 24);
+}
+
+static int cmp_sym(const void *a, const void *b)
+{
+	const Sym *x = a, *y = b;
+
+	if (x->Addr != y->Addr)
+		return x->Addr < y->Addr ? -1 : 1;
+	return 0;
+}
+
+static char *read_file(const char *path, size_t *len)
+{
+	FILE *f = fopen(path, "rb");
+	char *buf;
+	long n;
+
+	if (f == NULL) {
+		perror(path);
+		return NULL;
+	}
+	fseek(f, 0, SEEK_END);
+	n = ftell(f);
+	rewind(f);
+	buf = malloc((size_t)n + 1);
+	if (buf == NULL || fread(buf, 1, (size_t)n, f) != (size_t)n) {
+		fprintf(stderr, "%s: read failed\n", path);
+		free(buf);
+		fclose(f);
+		return NULL;
+	}
+	buf[n] = '\0';
+	fclose(f);
+	*len = (size_t)n;
+	return buf;
+}
+
+/* Collect the function symbols of a little endian ELF32 or ELF64 file */
+static int load_elf(const char *path, Elf *elf)
+{
+	size_t len, i, j, shnum, shoff, shentsize;
+	unsigned char *img;
+	int is64;
+
+	memset(elf, 0, sizeof(*elf));
+	elf->Image = read_file(path, &len);
+	if (elf->Image == NULL)
+		return -1;
+	img = (unsigned char *)elf->Image;
+	if (len < EI_NIDENT || memcmp(img, ELFMAG, SELFMAG) != 0 ||
+	    img[EI_DATA] != ELFDATA2LSB) {
+		fprintf(stderr, "%s: not a little endian ELF file\n", path);
+		return -1;
+	}
+	is64 = img[EI_CLASS] == ELFCLASS64;
+	if (is64) {
+		const Elf64_Ehdr *eh = (const Elf64_Ehdr *)img;
+
+		shoff = eh->e_shoff;
+		shnum = eh->e_shnum;
+		shentsize = eh->e_shentsize;
+	} else {
+		const Elf32_Ehdr *eh = (const Elf32_Ehdr *)img;
+
+		shoff = eh->e_shoff;
+		shnum = eh->e_shnum;
+		shentsize = eh->e_shentsize;
+	}
+	if (shoff + shnum * shentsize > len) {
+		fprintf(stderr, "%s: truncated ELF file\n", path);
+		return -1;
+	}
+
+	for (i = 0; i < shnum; i++) {
+		size_t off, size, entsize, stroff, link;
+		u32 type;
+
+		if (is64) {
+			const Elf64_Shdr *sh =
+				(const Elf64_Shdr *)(img + shoff + i * shentsize);
+
+			type = sh->sh_type;
+			off = sh->sh_offset;
+			size = sh->sh_size;
+			entsize = sh->sh_entsize;
+			link = sh->sh_link;
+			stroff = ((const Elf64_Shdr *)(img + shoff +
+				   link * shentsize))->sh_offset;
+		} else {
+			const Elf32_Shdr *sh =
+				(const Elf32_Shdr *)(img + shoff + i * shentsize);
+
+			type = sh->sh_type;
+			off = sh->sh_offset;
+			size = sh->sh_size;
+			entsize = sh->sh_entsize;
+			link = sh->sh_link;
+			stroff = ((const Elf32_Shdr *)(img + shoff +
+				   link * shentsize))->sh_offset;
+		}
+		if (type != SHT_SYMTAB || entsize == 0 || off + size > len)
+			continue;
+
+		elf->Syms = realloc(elf->Syms, (elf->NumSyms + size / entsize) *
+				    sizeof(Sym));
+		if (elf->Syms == NULL) {
+			perror("realloc");
+			exit(1);
+		}
+		for (j = 0; j < size / entsize; j++) {
+			unsigned long long value, symsize;
+			unsigned info, shndx, name;
+
+			if (is64) {
+				const Elf64_Sym *s = (const Elf64_Sym *)
+					(img + off + j * entsize);
+
+				value = s->st_value;
+				symsize = s->st_size;
+				info = s->st_info;
+				shndx = s->st_shndx;
+				name = s->st_name;
+			} else {
+				const Elf32_Sym *s = (const Elf32_Sym *)
+					(img + off + j * entsize);
+
+				value = s->st_value;
+				symsize = s->st_size;
+				info = s->st_info;
+				shndx = s->st_shndx;
+				name = s->st_name;
+			}
+			if (ELF32_ST_TYPE(info) != STT_FUNC ||
+			    shndx == SHN_UNDEF)
+				continue;
+			/* Thumb functions have bit 0 set */
+			elf->Syms[elf->NumSyms].Addr = value & ~1ULL;
+			elf->Syms[elf->NumSyms].Size = symsize;
+			elf->Syms[elf->NumSyms].Name =
+				elf->Image + stroff + name;
+			elf->NumSyms++;
+		}
+	}
+	if (elf->NumSyms == 0) {
+		fprintf(stderr, "%s: no function symbols\n", path);
+		return -1;
+	}
+	qsort(elf->Syms, elf->NumSyms, sizeof(Sym), cmp_sym);
+	return 0;
+}
+
+/* Index of the function holding addr, NumSyms if none */
+static size_t lookup(const Elf *elf, unsigned long long addr)
+{
+	size_t lo = 0, hi = elf->NumSyms;
+
+	while (hi - lo > 1) {
+		size_t mid = (lo + hi) / 2;
+
+		if (elf->Syms[mid].Addr <= addr)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	if (addr < elf->Syms[lo].Addr ||
+	    (elf->Syms[lo].Size != 0 &&
+	     addr >= elf->Syms[lo].Addr + elf->Syms[lo].Size))
+		return elf->NumSyms;
+	return lo;
+}
+
+static int cmp_pair(const void *a, const void *b)
+{
+	const Pair *x = a, *y = b;
+
+	if (x->Func != y->Func)
+		return x->Func < y->Func ? -1 : 1;
+	if (x->Caller != y->Caller)
+		return x->Caller < y->Caller ? -1 : 1;
+	return 0;
+}
+
+static const unsigned long *sort_counts;
+
+static int cmp_count(const void *a, const void *b)
+{
+	size_t x = *(const size_t *)a, y = *(const size_t *)b;
+
+	if (sort_counts[x] != sort_counts[y])
+		return sort_counts[x] > sort_counts[y] ? -1 : 1;
+	return x < y ? -1 : (x > y);
+}
+
+static const char *func_name(const Elf *elf, size_t f)
+{
+	return f < elf->NumSyms ? elf->Syms[f].Name : "<unknown>";
+}
+
+/* Report one buffer in little endian layout */
+static int report(const unsigned char *buf, size_t len, const Elf *elf,
+		  const char *src)
+{
+	static const char *source[] = { "timer", "pmu" };
+	u32 count, missed, ptr, i;
+	unsigned long *self;
+	size_t *order, nfunc = elf->NumSyms + 1, row, npairs = 0;
+	Pair *pairs;
+
+	if (len < HDR_SIZE || get32(buf) != XIL_PROF_MAGIC) {
+		fprintf(stderr, "%s: no sample buffer found\n", src);
+		return -1;
+	}
+	if ((get32(buf + 4) & 0xFFFFU) != XIL_PROF_VERSION) {
+		fprintf(stderr, "%s: unsupported version %u\n", src,
+			get32(buf + 4) & 0xFFFFU);
+		return -1;
+	}
+	ptr = buf[7];
+	count = get32(buf + 12);
+	missed = get32(buf + 16);
+	if ((ptr != 4 && ptr != 8) || len < HDR_SIZE + (size_t)count * 2 * ptr) {
+		fprintf(stderr, "%s: buffer truncated or corrupt\n", src);
+		return -1;
+	}
+
+	self = calloc(nfunc, sizeof(*self));
+	order = malloc(nfunc * sizeof(*order));
+	pairs = malloc(((size_t)count + 1) * sizeof(*pairs));
+	if (self == NULL || order == NULL || pairs == NULL) {
+		perror("malloc");
+		exit(1);
+	}
+
+	for (i = 0; i < count; i++) {
+		const unsigned char *s = buf + HDR_SIZE + (size_t)i * 2 * ptr;
+		unsigned long long pc = get32(s), lr = get32(s + ptr);
+		size_t f, c;
+
+		if (ptr == 8) {
+			pc |= (unsigned long long)get32(s + 4) << 32;
+			lr |= (unsigned long long)get32(s + ptr + 4) << 32;
+		}
+		f = lookup(elf, pc & ~1ULL);
+		self[f]++;
+		/* The LR points after the call, step back into the caller.
+		 * Once a function has made calls of its own the LR no longer
+		 * leads to its caller, which shows as the function itself.
+		 */
+		if (lr < 2ULL)
+			continue;
+		c = lookup(elf, (lr & ~1ULL) - 1ULL);
+		if (c != f && c < elf->NumSyms) {
+			pairs[npairs].Func = f;
+			pairs[npairs].Caller = c;
+			npairs++;
+		}
+	}
+
+	printf("%s: cpu %u, %u samples, %u missed, period %u (%s)\n", src,
+	       buf[6], count, missed, get32(buf + 24),
+	       get32(buf + 20) < 2 ? source[get32(buf + 20)] : "?");
+	if (count == 0)
+		goto out;
+
+	for (row = 0; row < nfunc; row++)
+		order[row] = row;
+	sort_counts = self;
+	qsort(order, nfunc, sizeof(*order), cmp_count);
+	qsort(pairs, npairs, sizeof(*pairs), cmp_pair);
+
+	printf("   self%%   samples  function\n");
+	for (row = 0; row < nfunc && row < max_rows && self[order[row]]; row++) {
+		size_t f = order[row], p;
+
+		printf("%7.2f%% %9lu  %s\n", 100.0 * self[f] / count, self[f],
+		       func_name(elf, f));
+		if (!show_callers)
+			continue;
+		for (p = 0; p < npairs; ) {
+			size_t q = p;
+
+			while (q < npairs && pairs[q].Func == pairs[p].Func &&
+			       pairs[q].Caller == pairs[p].Caller)
+				q++;
+			if (pairs[p].Func == f)
+				printf("%19lu  <- %s\n", (unsigned long)(q - p),
+				       func_name(elf, pairs[p].Caller));
+			p = q;
+		}
+	}
+	printf("\n");
+out:
+	free(self);
+	free(order);
+	free(pairs);
+	return 0;
+}
+
+/* Convert the hex words of each Xil_ProfDump() block in a log */
+static int report_log(const char *text, const Elf *elf, const char *src)
+{
+	unsigned char *buf = NULL;
+	size_t len = 0, max = 0;
+	int in = 0, found = 0;
+	const char *line = text;
+
+	while (*line != '\0') {
+		const char *next = strchr(line, '\n');
+		const char *p = line;
+		char *end;
+
+		next = next ? next + 1 : line + strlen(line);
+		if (strncmp(line, "xil_prof begin", 14) == 0) {
+			in = 1;
+			len = 0;
+		} else if (strncmp(line, "xil_prof end", 12) == 0) {
+			if (in && report(buf, len, elf, src) == 0)
+				found++;
+			in = 0;
+		} else if (in) {
+			for (;;) {
+				unsigned long w = strtoul(p, &end, 16);
+
+				if (end == p || end > next)
+					break;
+				if (len + 4 > max) {
+					max = max ? max * 2 : 65536;
+					buf = realloc(buf, max);
+					if (buf == NULL) {
+						perror("realloc");
+						exit(1);
+					}
+				}
+				buf[len++] = (unsigned char)w;
+				buf[len++] = (unsigned char)(w >> 8);
+				buf[len++] = (unsigned char)(w >> 16);
+				buf[len++] = (unsigned char)(w >> 24);
+				p = end;
+			}
+		}
+		line = next;
+	}
+	free(buf);
+
+	if (!found) {
+		fprintf(stderr, "%s: no sample buffer found\n", src);
+		return -1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	Elf elf;
+	int have_elf = 0, ret = 0, c;
+	char *end;
+
+	memset(&elf, 0, sizeof(elf));
+	/* Options and files are handled in order, -e applies to what follows */
+	while (optind < argc) {
+		c = getopt(argc, argv, options);
+		if (c == -1) {
+			const char *path = argv[optind++];
+			size_t len;
+			char *data;
+
+			if (!have_elf) {
+				fprintf(stderr, "%s: no ELF file given\n", path);
+				return 1;
+			}
+			data = read_file(path, &len);
+			if (data == NULL)
+				return 1;
+			if (len >= 4 && get32((unsigned char *)data) ==
+			    XIL_PROF_MAGIC)
+				ret |= report((unsigned char *)data, len, &elf,
+					      path);
+			else
+				ret |= report_log(data, &elf, path);
+			free(data);
+			continue;
+		}
+		switch (c) {
+		case 'e':
+			free(elf.Syms);
+			free(elf.Image);
+			if (load_elf(optarg, &elf) != 0)
+				return 1;
+			have_elf = 1;
+			break;
+		case 'c':
+			show_callers = 1;
+			break;
+		case 'n':
+			max_rows = strtoul(optarg, &end, 0);
+			break;
+		case 'h':
+		default:
+			printf("%s", help_msg);
+			return c == 'h' ? 0 : 1;
+		}
+	}
+	if (!have_elf) {
+		printf("%s", help_msg);
+		return 1;
+	}
+
+	free(elf.Syms);
+	free(elf.Image);
+	return ret ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file tracedecode.c
+* Host decoder of the BSP trace ring
+*
+* Reads rings written by ../src/common/xil_trace.c, either as raw memory
+* saved by the debugger or as Xil_TraceDump() output in a console log, and
+* writes the events as Chrome trace JSON, one thread per processor, for
+* chrome://tracing or ui.perfetto.dev.
+*
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xil_types.h"
+#include "xil_trace.h"
+
+#define HDR_SIZE	32U
+#define ENTRY_SIZE	16U
+#define LINE_MAX	4096
+
+typedef struct {
+	double Us;		/* Time in microseconds */
+	unsigned long long Ticks;
+	unsigned Seq;		/* Order in the input, breaks ties */
+	unsigned Cpu;
+	u32 Event;
+	u32 Arg;
+} Event;
+
+typedef struct {
+	u32 Id;
+	const char *Name;
+	const char *Cat;
+} EventName;
+
+static const EventName names[] = {
+	{ XIL_TRACE_ID_SCUGIC_IRQ, "irq", "scugic" },
+	{ XIL_TRACE_ID_AXIDMA_TOHW, "axidma_tohw", "axidma" },
+	{ XIL_TRACE_ID_AXIDMA_FROMHW, "axidma_fromhw", "axidma" },
+	{ XIL_TRACE_ID_EMACPS_ISR, "emacps_isr", "emacps" },
+	{ XIL_TRACE_ID_EMACPS_TOHW, "emacps_tohw", "emacps" },
+	{ XIL_TRACE_ID_EMACPS_FROMHW_TX, "emacps_fromhw_tx", "emacps" },
+	{ XIL_TRACE_ID_EMACPS_FROMHW_RX, "emacps_fromhw_rx", "emacps" },
+	{ XIL_TRACE_ID_SDPS_CMD, "sdps_cmd", "sdps" },
+	{ XIL_TRACE_ID_SDPS_READ, "sdps_read", "sdps" },
+	{ XIL_TRACE_ID_SDPS_WRITE, "sdps_write", "sdps" },
+};
+
+static const char options[] = "o:h";
+static char help_msg[] =
+"Usage: tracedecode [options] file...\n"
+"\n"
+"Each file is a raw ring saved from target memory, or a console log\n"
+"holding Xil_TraceDump() output. Rings of several processors may be given.\n"
+"\n"
+"Options:\n"
+"\t-o <file>\tWrite the JSON to file instead of stdout\n"
+"\t-h\t\tHelp\n";
+
+static Event *events;
+static size_t num_events;
+static size_t max_events;
+static unsigned cpu_seen[256];
+
+static u32 get32(const unsigned char *p)
+{
+	return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) |
+	       ((u32)p[3] << 24);
+}
+
+static unsigned long long get64(const unsigned char *p)
+{
+	return (unsigned long long)get32(p) |
+	       ((unsigned long long)get32(p + 4) << 32);
+}
+
+/* Append the entries of a ring in little endian layout, oldest first */
+static int add_ring(const unsigned char *buf, size_t len, const char *src)
+{
+	u32 mask, head, num, first, i, cpu, bits;
+	unsigned long long tps, prev = 0, full = 0;
+	const unsigned char *e;
+
+	if (len < HDR_SIZE || get32(buf) != XIL_TRACE_MAGIC) {
+		fprintf(stderr, "%s: no trace ring found\n", src);
+		return -1;
+	}
+	if ((get32(buf + 4) & 0xFFFFU) != XIL_TRACE_VERSION) {
+		fprintf(stderr, "%s: unsupported version %u\n", src,
+			get32(buf + 4) & 0xFFFFU);
+		return -1;
+	}
+	cpu = buf[6];
+	bits = buf[7];
+	mask = get32(buf + 8);
+	head = get32(buf + 12);
+	tps = get64(buf + 16);
+	if ((mask & (mask + 1U)) != 0U ||
+	    len < HDR_SIZE + ((size_t)mask + 1U) * ENTRY_SIZE) {
+		fprintf(stderr, "%s: ring truncated or corrupt\n", src);
+		return -1;
+	}
+
+	num = head <= mask ? head : mask + 1U;
+	first = head - num;
+	cpu_seen[cpu] = 1;
+
+	for (i = 0; i < num; i++) {
+		Event *ev;
+
+		if (num_events == max_events) {
+			max_events = max_events ? max_events * 2 : 4096;
+			events = realloc(events, max_events * sizeof(*events));
+			if (events == NULL) {
+				perror("realloc");
+				exit(1);
+			}
+		}
+		e = buf + HDR_SIZE + (size_t)((first + i) & mask) * ENTRY_SIZE;
+		ev = &events[num_events];
+
+		/* Extend a 32 bit clock, entries are close to time order */
+		if (bits == 32U) {
+			u32 t = (u32)get64(e);
+
+			if (i == 0)
+				full = t;
+			else
+				full += (long long)(int)(t - (u32)prev);
+			prev = t;
+			ev->Ticks = full;
+		} else {
+			ev->Ticks = get64(e);
+		}
+		ev->Us = tps ? (double)ev->Ticks * 1e6 / (double)tps :
+			       (double)ev->Ticks;
+		ev->Seq = (unsigned)num_events;
+		ev->Cpu = cpu;
+		ev->Event = get32(e + 8);
+		ev->Arg = get32(e + 12);
+		num_events++;
+	}
+
+	fprintf(stderr, "%s: cpu %u, %u of %u events, %u overwritten\n", src,
+		cpu, num, head, first);
+	return 0;
+}
+
+/* Convert the hex words of each Xil_TraceDump() block in a log */
+static int add_log(FILE *f, const char *src)
+{
+	char line[LINE_MAX];
+	unsigned char *buf = NULL;
+	size_t len = 0, max = 0;
+	int in = 0, found = 0;
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		char *p = line, *end;
+
+		if (strstr(line, "xil_trace begin") != NULL) {
+			in = 1;
+			len = 0;
+			continue;
+		}
+		if (strstr(line, "xil_trace end") != NULL) {
+			if (in && add_ring(buf, len, src) == 0)
+				found++;
+			in = 0;
+			continue;
+		}
+		if (!in)
+			continue;
+		for (;;) {
+			unsigned long w = strtoul(p, &end, 16);
+
+			if (end == p)
+				break;
+			if (len + 4 > max) {
+				max = max ? max * 2 : 65536;
+				buf = realloc(buf, max);
+				if (buf == NULL) {
+					perror("realloc");
+					exit(1);
+				}
+			}
+			buf[len++] = (unsigned char)w;
+			buf[len++] = (unsigned char)(w >> 8);
+			buf[len++] = (unsigned char)(w >> 16);
+			buf[len++] = (unsigned char)(w >> 24);
+			p = end;
+		}
+	}
+	free(buf);
+
+	if (!found) {
+		fprintf(stderr, "%s: no trace ring found\n", src);
+		return -1;
+	}
+	return 0;
+}
+
+static int add_file(const char *path)
+{
+	unsigned char magic[4];
+	unsigned char *buf;
+	long len;
+	int ret;
+	FILE *f = fopen(path, "rb");
+
+	if (f == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	if (fread(magic, 1, 4, f) != 4 || get32(magic) != XIL_TRACE_MAGIC) {
+		rewind(f);
+		ret = add_log(f, path);
+		fclose(f);
+		return ret;
+	}
+
+	fseek(f, 0, SEEK_END);
+	len = ftell(f);
+	rewind(f);
+	buf = malloc((size_t)len);
+	if (buf == NULL || fread(buf, 1, (size_t)len, f) != (size_t)len) {
+		fprintf(stderr, "%s: read failed\n", path);
+		free(buf);
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+	ret = add_ring(buf, (size_t)len, path);
+	free(buf);
+	return ret;
+}
+
+static int cmp_event(const void *a, const void *b)
+{
+	const Event *x = a, *y = b;
+
+	if (x->Ticks != y->Ticks)
+		return x->Ticks < y->Ticks ? -1 : 1;
+	return x->Seq < y->Seq ? -1 : (x->Seq > y->Seq);
+}
+
+static void event_name(u32 id, const char **name, const char **cat)
+{
+	static char buf[32], cbuf[32];
+	size_t i;
+
+	for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		if (names[i].Id == id) {
+			*name = names[i].Name;
+			*cat = names[i].Cat;
+			return;
+		}
+	}
+	snprintf(buf, sizeof(buf), "event_0x%04x", (unsigned)id);
+	if (id >= XIL_TRACE_ID_USER)
+		snprintf(cbuf, sizeof(cbuf), "user");
+	else
+		snprintf(cbuf, sizeof(cbuf), "class_0x%02x", (unsigned)id >> 8);
+	*name = buf;
+	*cat = cbuf;
+}
+
+static void write_json(FILE *out)
+{
+	static const char ph[] = { 'i', 'B', 'E', 'C' };
+	double base;
+	size_t i;
+	unsigned cpu;
+	int sep = 0;
+
+	qsort(events, num_events, sizeof(*events), cmp_event);
+	base = num_events ? events[0].Us : 0.0;
+
+	fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	for (cpu = 0; cpu < 256; cpu++) {
+		if (!cpu_seen[cpu])
+			continue;
+		fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+			"\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"cpu %u\"}}",
+			sep ? ",\n" : "", cpu, cpu);
+		sep = 1;
+	}
+	for (i = 0; i < num_events; i++) {
+		const Event *ev = &events[i];
+		u32 phase = (ev->Event & XIL_TRACE_PH_MASK) >>
+			    XIL_TRACE_PH_SHIFT;
+		const char *name, *cat;
+
+		event_name(ev->Event & XIL_TRACE_ID_MASK, &name, &cat);
+		fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\","
+			"\"ts\":%.3f,\"pid\":0,\"tid\":%u,", sep ? ",\n" : "",
+			name, cat, ph[phase], ev->Us - base, ev->Cpu);
+		if (phase == XIL_TRACE_PH_COUNTER)
+			fprintf(out, "\"args\":{\"value\":%u}}",
+				(unsigned)ev->Arg);
+		else if (phase == XIL_TRACE_PH_INSTANT)
+			fprintf(out, "\"s\":\"t\",\"args\":{\"arg\":\"0x%x\"}}",
+				(unsigned)ev->Arg);
+		else
+			fprintf(out, "\"args\":{\"arg\":\"0x%x\"}}",
+				(unsigned)ev->Arg);
+		sep = 1;
+	}
+	fprintf(out, "\n]}\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *out_path = NULL;
+	FILE *out = stdout;
+	int c, i;
+
+	while ((c = getopt(argc, argv, options)) != -1) {
+		switch (c) {
+		case 'o':
+			out_path = optarg;
+			break;
+		case 'h':
+		default:
+			printf("%s", help_msg);
+			return c == 'h' ? 0 : 1;
+		}
+	}
+	if (optind >= argc) {
+		printf("%s", help_msg);
+		return 1;
+	}
+
+	for (i = optind; i < argc; i++) {
+		if (add_file(argv[i]) != 0)
+			return 1;
+	}
+
+	if (out_path != NULL) {
+		out = fopen(out_path, "w");
+		if (out == NULL) {
+			perror(out_path);
+			return 1;
+		}
+	}
+	write_json(out);
+	if (out != stdout)
+		fclose(out);
+
+	free(events);
+	return 0;
+}
@@ -44,6 +44,8 @@
 * 6.0   mus  27/07/16 Consolidated vectors for a53,a9 and r5 processor
 *                     and added UndefinedException for a53 32 bit and r5
 *                     processor
+* 6.6   ag   10/16/26 Added IRQInterruptedContext, written by the GCC IRQ
+*                     vectors, for the sampling profiler
 * </pre>
 *
 * @note
@@ -71,6 +73,12 @@ typedef struct {
 
 extern XExc_VectorTableEntry XExc_VectorTable[];
 
+/*
+ * PC and LR of the code interrupted by the last IRQ, written by the IRQ
+ * vector before IRQInterrupt is called
+ */
+UINTPTR IRQInterruptedContext[2];
+
 /************************** Function Prototypes ******************************/
 
 
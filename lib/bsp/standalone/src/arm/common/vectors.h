@@ -42,6 +42,7 @@
 * ----- ---- -------- ---------------------------------------------------
 * 1.00a ecm  10/20/10 Initial version, moved over from bsp area
 * 6.0   mus  07/27/16 Consolidated vectors for a9,a53 and r5 processors
+* 6.6   ag   10/16/26 Added IRQInterruptedContext
 * </pre>
 *
 * @note
@@ -67,6 +68,11 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/************************** Variable Definitions *****************************/
+
+/** PC and LR of the code interrupted by the last IRQ */
+extern UINTPTR IRQInterruptedContext[2];
+
 /************************** Function Prototypes ******************************/
 
 void FIQInterrupt(void);
@@ -0,0 +1,378 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_prof.c
+*
+* This file contains the sampling profiler. See xil_prof.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+*      ag   10/16/26 The PMU source samples on the last event counter,
+*                     counting processor cycles, and leaves the cycle counter
+*                     to xil_perf.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_prof.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+#include "vectors.h"
+#if defined (__aarch64__)
+#include "bspconfig.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#if defined (__aarch64__) || defined (ARMA53_32)
+#define XIL_PROF_HAS_TIMER
+#endif
+
+#define XIL_PROF_CNTV_ENABLE	0x00000001U	/* Timer enabled, unmasked */
+#define XIL_PROF_PMCR_E		0x00000001U	/* Enable all counters */
+#define XIL_PROF_PMCR_N_SHIFT	11U		/* Number of event counters */
+#define XIL_PROF_PMCR_N_MASK	0x1FU
+#define XIL_PROF_EV_CPU_CYCLES	0x11U		/* Cycles, ARMv7 and ARMv8 */
+#define XIL_PROF_MDCR_SPME	0x00020000U	/* Count in Secure state */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#if defined (__ICCARM__)
+#define XIL_PROF_MFCP(Reg, Val)	mfcp(Reg, Val)
+#elif !defined (__aarch64__)
+#define XIL_PROF_MFCP(Reg, Val)	((Val) = mfcp(Reg))
+#endif
+
+/************************** Variable Definitions *****************************/
+
+static Xil_ProfBuffer *XilProfBuffer;
+static u32 XilProfCounter;	/* Event counter of the PMU source */
+
+/************************** Function Prototypes ******************************/
+
+static void Xil_ProfReload(Xil_ProfBuffer *Buf);
+
+/*****************************************************************************/
+/**
+* @brief    This function sets up a sample buffer and the sample source.
+*           Sampling begins with Xil_ProfStart().
+*
+* @param    Mem: buffer memory, aligned to 8 bytes.
+*
+* @param    Size: size of the buffer memory in bytes.
+*
+* @param    Source: XIL_PROF_SRC_TIMER or XIL_PROF_SRC_PMU.
+*
+* @param    Period: sample period, in system counter ticks for the timer and
+*           in processor cycles for the PMU.
+*
+* @return   - XST_SUCCESS if the buffer is set up.
+*           - XST_INVALID_PARAM if the memory is misaligned or too small, or
+*           the source is not available on the processor.
+*
+* @note     The PMU source counts cycles on the last event counter of the
+*           processor, with an overflow interrupt every Period cycles.
+*
+*****************************************************************************/
+s32 Xil_ProfInit(void *Mem, u32 Size, u32 Source, u32 Period)
+{
+	Xil_ProfBuffer *Buf = (Xil_ProfBuffer *)Mem;
+	u32 Reg = 0U;
+
+	if ((Mem == NULL) || (((UINTPTR)Mem & 7U) != 0U) ||
+	    (Size < (sizeof(Xil_ProfBuffer) + (2U * sizeof(UINTPTR)))) ||
+	    (Period == 0U)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+#if defined (XIL_PROF_HAS_TIMER)
+	if ((Source != XIL_PROF_SRC_TIMER) && (Source != XIL_PROF_SRC_PMU)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+#else
+	if (Source != XIL_PROF_SRC_PMU) {
+		return (s32)XST_INVALID_PARAM;
+	}
+#endif
+	if (Source == XIL_PROF_SRC_PMU) {
+#if defined (__aarch64__)
+		Reg = (u32)mfcp(PMCR_EL0);
+#else
+		XIL_PROF_MFCP(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+#endif
+		Reg = (Reg >> XIL_PROF_PMCR_N_SHIFT) & XIL_PROF_PMCR_N_MASK;
+		if (Reg == 0U) {
+			return (s32)XST_INVALID_PARAM;
+		}
+	}
+
+	Xil_ProfStop();
+	XilProfBuffer = NULL;
+	if (Source == XIL_PROF_SRC_PMU) {
+		XilProfCounter = Reg - 1U;
+	}
+
+#if defined (__aarch64__)
+	Reg = (u32)mfcp(MPIDR_EL1);
+#else
+	XIL_PROF_MFCP(XREG_CP15_MULTI_PROC_AFFINITY, Reg);
+#endif
+
+	Buf->Magic = XIL_PROF_MAGIC;
+	Buf->Version = (u16)XIL_PROF_VERSION;
+	Buf->Cpu = (u8)(Reg & 0xFFU);
+	Buf->PtrBytes = (u8)sizeof(UINTPTR);
+	Buf->Size = (Size - (u32)sizeof(Xil_ProfBuffer)) /
+		    (2U * (u32)sizeof(UINTPTR));
+	Buf->Count = 0U;
+	Buf->Missed = 0U;
+	Buf->Source = Source;
+	Buf->Period = Period;
+	Buf->Reserved = 0U;
+
+	if (Source == XIL_PROF_SRC_PMU) {
+#if defined (__aarch64__)
+#if EL3==1
+		mtcp(MDCR_EL3, mfcp(MDCR_EL3) | XIL_PROF_MDCR_SPME);
+#endif
+		mtcp(PMSELR_EL0, (u64)XilProfCounter);
+		isb();
+		/* Filter bits left clear, every exception level counts */
+		mtcp(PMXEVTYPER_EL0, (u64)XIL_PROF_EV_CPU_CYCLES);
+		mtcp(PMCR_EL0, mfcp(PMCR_EL0) | XIL_PROF_PMCR_E);
+		mtcp(PMCNTENSET_EL0, (u64)1U << XilProfCounter);
+#else
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, XilProfCounter);
+		isb();
+		mtcp(XREG_CP15_EVENT_TYPE_SEL, XIL_PROF_EV_CPU_CYCLES);
+		XIL_PROF_MFCP(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+		mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg | XIL_PROF_PMCR_E);
+		mtcp(XREG_CP15_COUNT_ENABLE_SET, 1U << XilProfCounter);
+#endif
+	}
+
+	XilProfBuffer = Buf;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function starts sampling. The interrupt of the source must
+*           be connected to Xil_ProfIntrHandler() and enabled.
+*
+*****************************************************************************/
+void Xil_ProfStart(void)
+{
+	Xil_ProfBuffer *Buf = XilProfBuffer;
+
+	if (Buf == NULL) {
+		return;
+	}
+
+	Xil_ProfReload(Buf);
+	if (Buf->Source == XIL_PROF_SRC_PMU) {
+#if defined (__aarch64__)
+		mtcp(PMINTENSET_EL1, (u64)1U << XilProfCounter);
+#else
+		mtcp(XREG_CP15_INTR_ENABLE_SET, 1U << XilProfCounter);
+#endif
+	} else {
+#if defined (__aarch64__)
+		mtcp(CNTV_CTL_EL0, (u64)XIL_PROF_CNTV_ENABLE);
+#elif defined (XIL_PROF_HAS_TIMER)
+		mtcp(XREG_CP15_CNTV_CTL, XIL_PROF_CNTV_ENABLE);
+#endif
+	}
+	isb();
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function stops sampling and writes the buffer back to
+*           memory, for the debugger to read.
+*
+*****************************************************************************/
+void Xil_ProfStop(void)
+{
+	Xil_ProfBuffer *Buf = XilProfBuffer;
+
+	if (Buf == NULL) {
+		return;
+	}
+
+	if (Buf->Source == XIL_PROF_SRC_PMU) {
+#if defined (__aarch64__)
+		mtcp(PMINTENCLR_EL1, (u64)1U << XilProfCounter);
+		mtcp(PMOVSCLR_EL0, (u64)1U << XilProfCounter);
+#else
+		mtcp(XREG_CP15_INTR_ENABLE_CLR, 1U << XilProfCounter);
+		mtcp(XREG_CP15_V_FLAG_STATUS, 1U << XilProfCounter);
+#endif
+	} else {
+#if defined (__aarch64__)
+		mtcp(CNTV_CTL_EL0, 0U);
+#elif defined (XIL_PROF_HAS_TIMER)
+		mtcp(XREG_CP15_CNTV_CTL, 0U);
+#endif
+	}
+	isb();
+
+	Xil_DCacheFlushRange((INTPTR)Buf, sizeof(Xil_ProfBuffer) +
+			     (Buf->Size * 2U * sizeof(UINTPTR)));
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function is the interrupt handler of the sample source. It
+*           records the PC and LR of the interrupted code and rearms the
+*           source.
+*
+* @param    CallBackRef: unused.
+*
+*****************************************************************************/
+void Xil_ProfIntrHandler(void *CallBackRef)
+{
+	Xil_ProfBuffer *Buf = XilProfBuffer;
+	UINTPTR *Sample;
+	u32 Count;
+
+	(void)CallBackRef;
+
+	if (Buf == NULL) {
+		return;
+	}
+
+	Xil_ProfReload(Buf);
+
+	Count = Buf->Count;
+	if (Count < Buf->Size) {
+		Sample = (UINTPTR *)(void *)(Buf + 1) + (2U * Count);
+		Sample[0] = IRQInterruptedContext[0];
+		Sample[1] = IRQInterruptedContext[1];
+		Buf->Count = Count + 1U;
+	} else {
+		Buf->Missed++;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function returns the buffer set up by Xil_ProfInit(), or
+*           NULL.
+*
+*****************************************************************************/
+Xil_ProfBuffer *Xil_ProfGetBuffer(void)
+{
+	return XilProfBuffer;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function prints the recorded part of the buffer with
+*           xil_printf, as hexadecimal 32 bit words, eight to a line,
+*           between "xil_prof begin" and "xil_prof end" lines. The host tool
+*           reads this from a captured console log.
+*
+* @note     Stop sampling first.
+*
+*****************************************************************************/
+void Xil_ProfDump(void)
+{
+	Xil_ProfBuffer *Buf = XilProfBuffer;
+	const u32 *Word;
+	u32 Num;
+	u32 Index;
+
+	if (Buf == NULL) {
+		return;
+	}
+
+	Word = (const u32 *)(const void *)Buf;
+	Num = ((u32)sizeof(Xil_ProfBuffer) +
+	       (Buf->Count * 2U * (u32)sizeof(UINTPTR))) / 4U;
+
+	xil_printf("xil_prof begin\r\n");
+	for (Index = 0U; Index < Num; Index++) {
+		xil_printf("%08x", Word[Index]);
+		xil_printf((((Index + 1U) & 7U) == 0U) ? "\r\n" : " ");
+	}
+	xil_printf("xil_prof end\r\n");
+}
+
+/*****************************************************************************/
+/**
+*
+* Arm the source for the next sample, acknowledging its interrupt. The event
+* counter selection of the interrupted code is kept.
+*
+*****************************************************************************/
+static void Xil_ProfReload(Xil_ProfBuffer *Buf)
+{
+	u32 Sel = 0U;
+
+	if (Buf->Source == XIL_PROF_SRC_PMU) {
+#if defined (__aarch64__)
+		mtcp(PMOVSCLR_EL0, (u64)1U << XilProfCounter);
+		Sel = (u32)mfcp(PMSELR_EL0);
+		mtcp(PMSELR_EL0, (u64)XilProfCounter);
+		isb();
+		mtcp(PMXEVCNTR_EL0, (u64)(0U - Buf->Period));
+		mtcp(PMSELR_EL0, (u64)Sel);
+#else
+		mtcp(XREG_CP15_V_FLAG_STATUS, 1U << XilProfCounter);
+		XIL_PROF_MFCP(XREG_CP15_EVENT_CNTR_SEL, Sel);
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, XilProfCounter);
+		isb();
+		mtcp(XREG_CP15_PERF_MONITOR_COUNT, 0U - Buf->Period);
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, Sel);
+#endif
+	} else {
+#if defined (__aarch64__)
+		mtcp(CNTV_TVAL_EL0, (u64)Buf->Period);
+#elif defined (XIL_PROF_HAS_TIMER)
+		mtcp(XREG_CP15_CNTV_TVAL, Buf->Period);
+#endif
+	}
+	isb();
+}
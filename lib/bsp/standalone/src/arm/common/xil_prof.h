@@ -0,0 +1,149 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_prof.h
+*
+* @addtogroup arm_prof_apis Sampling Profiler APIs
+*
+* The xil_prof.h file contains a statistical profiler. A periodic interrupt
+* records the PC and the link register of the code it interrupts into a
+* buffer; the profsym host tool in the linux directory of the BSP attributes
+* the samples to functions, and their callers, of the ELF file. Unlike the
+* -pg profiling library, the application is not instrumented.
+*
+* The interrupt comes from one of two sources:
+* - XIL_PROF_SRC_TIMER, the virtual timer of the generic timer, on the
+*   Cortex-A53 (AArch64 and AArch32). Period is in ticks of the system
+*   counter. Its interrupt is PPI XIL_PROF_VTIMER_INTR_ID.
+* - XIL_PROF_SRC_PMU, the overflow of a PMU event counter counting
+*   processor cycles, on the Cortex-A53, Cortex-R5 and Cortex-A9. Period is
+*   in processor cycles. The interrupt is the PMU interrupt of the processor
+*   in the SoC. This source takes the last event counter of the processor
+*   and leaves the cycle counter alone, so xil_perf can be used along with
+*   it with one event fewer than the processor has counters.
+*
+* The application connects Xil_ProfIntrHandler() to the interrupt with the
+* interrupt controller driver and enables it, for example
+*
+* <pre>
+*	Xil_ProfInit(Buf, sizeof(Buf), XIL_PROF_SRC_TIMER, 10000U);
+*	XScuGic_Connect(&Gic, XIL_PROF_VTIMER_INTR_ID,
+*			(Xil_ExceptionHandler)Xil_ProfIntrHandler, NULL);
+*	XScuGic_Enable(&Gic, XIL_PROF_VTIMER_INTR_ID);
+*	Xil_ProfStart();
+*	... code to profile ...
+*	Xil_ProfStop();
+*	Xil_ProfDump();
+* </pre>
+*
+* The interrupted PC and LR are recorded by the GCC IRQ vectors of the BSP.
+* Each processor has its own buffer, tagged with the processor number, so
+* profiles of all processors can be taken at once. Recording stops when the
+* buffer is full; later samples are only counted.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+*      ag   10/16/26 The PMU source uses the last event counter.
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_PROF_H	/* prevent circular inclusions */
+#define XIL_PROF_H	/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_PROF_MAGIC		0x46525058U	/**< "XPRF" */
+#define XIL_PROF_VERSION	1U
+
+/**
+ * @name Sample sources
+ * @{
+ */
+#define XIL_PROF_SRC_TIMER	0U	/**< Generic timer, Cortex-A53 */
+#define XIL_PROF_SRC_PMU	1U	/**< PMU event counter overflow */
+/*@}*/
+
+#define XIL_PROF_VTIMER_INTR_ID	27U	/**< Virtual timer PPI */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Buffer header, followed in memory by the samples, each the PC and the LR
+ * as PtrBytes wide words. This is the layout read by the host tool, it only
+ * changes along with XIL_PROF_VERSION.
+ */
+typedef struct {
+	u32 Magic;		/**< XIL_PROF_MAGIC */
+	u16 Version;		/**< XIL_PROF_VERSION */
+	u8 Cpu;			/**< Processor number */
+	u8 PtrBytes;		/**< Bytes of a PC, 4 or 8 */
+	u32 Size;		/**< Samples the buffer holds */
+	volatile u32 Count;	/**< Samples recorded */
+	volatile u32 Missed;	/**< Samples lost, buffer full */
+	u32 Source;		/**< XIL_PROF_SRC_* */
+	u32 Period;		/**< Sample period */
+	u32 Reserved;
+} Xil_ProfBuffer;
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_ProfInit(void *Mem, u32 Size, u32 Source, u32 Period);
+void Xil_ProfStart(void);
+void Xil_ProfStop(void);
+void Xil_ProfIntrHandler(void *CallBackRef);
+Xil_ProfBuffer *Xil_ProfGetBuffer(void);
+void Xil_ProfDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup arm_prof_apis".
+*/
@@ -45,6 +45,12 @@
 * 5.5	pkp	 04/15/16 Updated the Xil_DCacheInvalidate,
 *					  Xil_DCacheInvalidateLine and Xil_DCacheInvalidateRange
 *					  functions description for proper explaination
+* 6.6	ag   10/16/26 Xil_DCacheFlushRange and Xil_DCacheInvalidateRange no
+*					  longer select a cache level and wait per cache line.
+*					  Lines are maintained by MVA to the PoC with one dsb and
+*					  one interrupt masked window per chunk of lines, and
+*					  ranges above the L2 cache size fall back to set/way
+*					  maintenance of the whole D cache.
 *
 ******************************************************************************/
 
@@ -64,6 +70,20 @@
 
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * The D cache range functions mask interrupts for at most
+ * XIL_CACHE_RANGE_CHUNK_LINES cache lines at a time. Ranges longer than
+ * XIL_CACHE_RANGE_SETWAY_LIMIT bytes, the size of the L2 cache, are handled
+ * by set/way on the whole D cache instead, as that takes fewer operations.
+ * Both can be overridden from the compiler flags.
+ */
+#ifndef XIL_CACHE_RANGE_CHUNK_LINES
+#define XIL_CACHE_RANGE_CHUNK_LINES	128U
+#endif
+#ifndef XIL_CACHE_RANGE_SETWAY_LIMIT
+#define XIL_CACHE_RANGE_SETWAY_LIMIT	0x100000U
+#endif
+
 extern s32  _stack_end;
 extern s32  __undef_stack;
 
@@ -293,48 +313,62 @@ void Xil_DCacheInvalidateLine(u32 adr)
 * 			a line belonging to another OS. This could lead to the other OS
 * 			crashing because of the loss of essential data. Hence, such
 * 			operations are promoted to clean and invalidate to avoid such
-*			corruption.
+*			corruption. Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes
+*			are cleaned and invalidated with the whole D cache of this CPU.
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 {
 	const u32 cacheline = 64U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
 	u32 tempadr = adr;
 	u32 tempend;
 	u32 currmask;
+
+	if (len == 0U) {
+		return;
+	}
+	if (len > XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		/* Lines are cleaned as well anyway, see the note above */
+		Xil_DCacheFlush();
+		return;
+	}
+
+	end = tempadr + len;
+	tempadr &= ~(cacheline - 1U);
+	tempend = end & ~(cacheline - 1U);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
-	if (len != 0U) {
-		end = tempadr + len;
-		tempend = end;
 
-		if ((tempadr & (cacheline-1U)) != 0U) {
-			tempadr &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempadr);
+	/* Partial lines at either end may hold data outside the range */
+	if (tempadr != (u32)adr) {
+		mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC, tempadr);
+		tempadr += cacheline;
+	}
+	if ((tempend != end) && (tempend >= tempadr)) {
+		mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC, tempend);
+	}
+
+	while (tempadr < tempend) {
+		chunkend = ((tempend - tempadr) > chunksize) ?
+			(tempadr + chunksize) : tempend;
+		/* MVA operations reach the PoC, no cache level is selected */
+		while (tempadr < chunkend) {
+			mtcp(XREG_CP15_INVAL_DC_LINE_MVA_POC, tempadr);
 			tempadr += cacheline;
 		}
-		if ((tempend & (cacheline-1U)) != 0U) {
-			tempend &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempend);
-		}
-
-		while (tempadr < tempend) {
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(XREG_CP15_CACHE_SIZE_SEL,0x0);
-			/* Invalidate Data cache line */
-			mtcp(XREG_CP15_INVAL_DC_LINE_MVA_POC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
+		if (tempadr < tempend) {
+			/* Complete the chunk and let pending interrupts in */
 			dsb();
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(XREG_CP15_CACHE_SIZE_SEL,0x2);
-			/* Invalidate Data cache line */
-			mtcp(XREG_CP15_INVAL_DC_LINE_MVA_POC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
-			dsb();
-			tempadr += cacheline;
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
+	/* Wait for invalidate to complete */
+	dsb();
 	mtcpsr(currmask);
 }
 
@@ -488,48 +522,50 @@ void Xil_DCacheFlushLine(u32 adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes are
+*			flushed with the whole D cache of this CPU.
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 {
 	const u32 cacheline = 64U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
 	u32 tempadr = adr;
-	u32 tempend;
 	u32 currmask;
+
+	if (len == 0U) {
+		return;
+	}
+	if (len > XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		Xil_DCacheFlush();
+		return;
+	}
+
+	end = tempadr + len;
+	tempadr &= ~(cacheline - 1U);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
-	if (len != 0U) {
-		end = tempadr + len;
-		tempend = end;
 
-		if ((tempadr & (cacheline-1U)) != 0U) {
-			tempadr &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempadr);
+	while (tempadr < end) {
+		chunkend = ((end - tempadr) > chunksize) ?
+			(tempadr + chunksize) : end;
+		/* MVA operations reach the PoC, no cache level is selected */
+		while (tempadr < chunkend) {
+			mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC, tempadr);
 			tempadr += cacheline;
 		}
-		if ((tempend & (cacheline-1U)) != 0U) {
-			tempend &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempend);
-		}
-
-		while (tempadr < tempend) {
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(XREG_CP15_CACHE_SIZE_SEL,0x0);
-			/* Invalidate Data cache line */
-			mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
-			dsb();
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(XREG_CP15_CACHE_SIZE_SEL,0x2);
-			/* Invalidate Data cache line */
-			mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
+		if (tempadr < end) {
+			/* Complete the chunk and let pending interrupts in */
 			dsb();
-			tempadr += cacheline;
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
+	/* Wait for flush to complete */
+	dsb();
 	mtcpsr(currmask);
 }
 
@@ -46,6 +46,7 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 5.2	pkp  	 28/05/15 First release
+* 6.6   ag       10/16/26 Added generic timer registers
 * </pre>
 *
 ******************************************************************************/
@@ -315,7 +316,9 @@ extern "C" {
 #define USER_PRIV_THREAD_PID			"p15, 0, %0, c13,  c0, 4"
 
 /* C14 Register Defines */
-/* not used */
+#define XREG_CP15_CNTFRQ			"p15, 0, %0, c14,  c0, 0"
+#define XREG_CP15_CNTV_TVAL			"p15, 0, %0, c14,  c3, 0"
+#define XREG_CP15_CNTV_CTL			"p15, 0, %0, c14,  c3, 1"
 
 /* C15 Register Defines */
 #define XREG_CP15_POWER_CTRL			"p15, 0, %0, c15,  c0, 0"
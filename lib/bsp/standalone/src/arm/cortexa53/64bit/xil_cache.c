@@ -72,6 +72,12 @@
 *					  results into abort if accessed from EL1 non secure privilege
 *					  level. Updated Xil_ConfigureL1Prefetch function to access
 *					  CPUACTLR_EL1 only for EL3.
+* 6.6  ag   10/16/26  Xil_DCacheFlushRange and Xil_DCacheInvalidateRange no
+*					  longer select a cache level and wait per cache line.
+*					  Lines are maintained by VA to the PoC with one dsb and
+*					  one interrupt masked window per chunk of lines, and
+*					  ranges above the L2 cache size fall back to set/way
+*					  maintenance of the whole D cache.
 *
 * </pre>
 *
@@ -92,6 +98,20 @@
 /************************** Variable Definitions *****************************/
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * The D cache range functions mask interrupts for at most
+ * XIL_CACHE_RANGE_CHUNK_LINES cache lines at a time. Ranges longer than
+ * XIL_CACHE_RANGE_SETWAY_LIMIT bytes, the size of the L2 cache, are handled
+ * by set/way on the whole D cache instead, as that takes fewer operations.
+ * Both can be overridden from the compiler flags.
+ */
+#ifndef XIL_CACHE_RANGE_CHUNK_LINES
+#define XIL_CACHE_RANGE_CHUNK_LINES	128U
+#endif
+#ifndef XIL_CACHE_RANGE_SETWAY_LIMIT
+#define XIL_CACHE_RANGE_SETWAY_LIMIT	0x100000U
+#endif
+
 /****************************************************************************/
 /**
 * @brief	Enable the Data cache.
@@ -418,48 +438,62 @@ void Xil_DCacheInvalidateLine(INTPTR adr)
 * 			a line belonging to another OS. This could lead to the other OS
 * 			crashing because of the loss of essential data. Hence, such
 * 			operations are promoted to clean and invalidate which avoids such
-*			corruption.
+*			corruption. Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes
+*			are cleaned and invalidated with the whole D cache of this CPU.
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR  adr, INTPTR len)
 {
-	const INTPTR cacheline = 64U;
+	const INTPTR cacheline = 64;
+	const INTPTR chunksize = cacheline * (INTPTR)XIL_CACHE_RANGE_CHUNK_LINES;
 	INTPTR end;
+	INTPTR chunkend;
 	INTPTR tempadr = adr;
 	INTPTR tempend;
 	u32 currmask;
+
+	if (len <= 0) {
+		return;
+	}
+	if (len > (INTPTR)XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		/* Lines are cleaned as well anyway, see the note above */
+		Xil_DCacheFlush();
+		return;
+	}
+
+	end = tempadr + len;
+	tempadr &= ~(cacheline - 1);
+	tempend = end & ~(cacheline - 1);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
-	if (len != 0U) {
-		end = tempadr + len;
-		tempend = end;
 
-		if ((tempadr & (cacheline-1U)) != 0U) {
-			tempadr &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempadr);
+	/* Partial lines at either end may hold data outside the range */
+	if (tempadr != adr) {
+		mtcpdc(CIVAC, tempadr);
+		tempadr += cacheline;
+	}
+	if ((tempend != end) && (tempend >= tempadr)) {
+		mtcpdc(CIVAC, tempend);
+	}
+
+	while (tempadr < tempend) {
+		chunkend = ((tempend - tempadr) > chunksize) ?
+			(tempadr + chunksize) : tempend;
+		/* VA operations reach the PoC, no cache level is selected */
+		while (tempadr < chunkend) {
+			mtcpdc(IVAC, tempadr);
 			tempadr += cacheline;
 		}
-		if ((tempend & (cacheline-1U)) != 0U) {
-			tempend &= (~(cacheline - 1U));
-			Xil_DCacheFlushLine(tempend);
-		}
-
-		while (tempadr < tempend) {
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(CSSELR_EL1,0x0);
-			/* Invalidate Data cache line */
-			mtcpdc(IVAC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
+		if (tempadr < tempend) {
+			/* Complete the chunk and let pending interrupts in */
 			dsb();
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(CSSELR_EL1,0x2);
-			/* Invalidate Data cache line */
-			mtcpdc(IVAC,(tempadr & (~0x3F)));
-			/* Wait for invalidate to complete */
-			dsb();
-			tempadr += cacheline;
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
+	/* Wait for invalidate to complete */
+	dsb();
 	mtcpsr(currmask);
 }
 
@@ -608,48 +642,50 @@ void Xil_DCacheFlushLine(INTPTR  adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes are
+*			flushed with the whole D cache of this CPU.
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR  adr, INTPTR len)
 {
-	const u32 cacheline = 64U;
+	const INTPTR cacheline = 64;
+	const INTPTR chunksize = cacheline * (INTPTR)XIL_CACHE_RANGE_CHUNK_LINES;
 	INTPTR end;
+	INTPTR chunkend;
 	INTPTR tempadr = adr;
-	INTPTR tempend;
 	u32 currmask;
+
+	if (len <= 0) {
+		return;
+	}
+	if (len > (INTPTR)XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		Xil_DCacheFlush();
+		return;
+	}
+
+	end = tempadr + len;
+	tempadr &= ~(cacheline - 1);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
-	if (len != 0x00000000U) {
-		end = tempadr + len;
-		tempend = end;
-		if ((tempadr & (0x3F)) != 0) {
-			tempadr &= ~(0x3F);
-			Xil_DCacheFlushLine(tempadr);
+
+	while (tempadr < end) {
+		chunkend = ((end - tempadr) > chunksize) ?
+			(tempadr + chunksize) : end;
+		/* VA operations reach the PoC, no cache level is selected */
+		while (tempadr < chunkend) {
+			mtcpdc(CIVAC, tempadr);
 			tempadr += cacheline;
 		}
-		if ((tempend & (0x3F)) != 0) {
-			tempend &= ~(0x3F);
-			Xil_DCacheFlushLine(tempend);
-		}
-
-		while (tempadr < tempend) {
-			/* Select cache level 0 and D cache in CSSR */
-			mtcp(CSSELR_EL1,0x0);
-			/* Flush Data cache line */
-			mtcpdc(CIVAC,(tempadr & (~0x3F)));
-			/* Wait for flush to complete */
+		if (tempadr < end) {
+			/* Complete the chunk and let pending interrupts in */
 			dsb();
-			/* Select cache level 1 and D cache in CSSR */
-			mtcp(CSSELR_EL1,0x2);
-			/* Flush Data cache line */
-			mtcpdc(CIVAC,(tempadr & (~0x3F)));
-			/* Wait for flush to complete */
-			dsb();
-			tempadr += cacheline;
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
-
+	/* Wait for flush to complete */
+	dsb();
 	mtcpsr(currmask);
 }
 
@@ -45,6 +45,13 @@
 * ----- ---- -------- ---------------------------------------------------
 * 5.00 	pkp  05/29/14 First release
 * 6.02  pkp	 01/22/17 Added support for EL1 non-secure
+* 6.6   ag   10/16/26 Added Xil_SetTlbAttributesRange, which sets attributes
+*                     with 4KB granularity below 4GB by splitting 2MB blocks
+*                     into level 3 tables, and maintains only the affected
+*                     cache lines and TLB entries.
+*      ag   10/16/26 Break before make when a 2MB block is replaced by a
+*                     level 3 table or back, and give a level 3 table back to
+*                     the pool also when Xil_SetTlbAttributes replaces it.
 * </pre>
 *
 * @note
@@ -59,6 +66,7 @@
 #include "xpseudo_asm.h"
 #include "xil_types.h"
 #include "xil_mmu.h"
+#include "xstatus.h"
 #include "bspconfig.h"
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -69,13 +77,42 @@
 #define BLOCK_SIZE_2MB 0x200000U
 #define BLOCK_SIZE_1GB 0x40000000U
 #define ADDRESS_LIMIT_4GB 0x100000000UL
+#define PAGE_SIZE_4KB 0x1000U
+
+#define DESC_VALID 0x1UL	/* Descriptor is valid */
+#define DESC_TABLE 0x2UL	/* Table (level 0-2) or page (level 3) */
+#define DESC_ADDR_MASK 0x0000FFFFFFFFF000UL	/* Output/table address */
+
+/*
+ * Number of 4KB level 3 tables available to Xil_SetTlbAttributesRange.
+ * Each one maps a 2MB block below 4GB with 4KB pages.
+ */
+#ifndef XIL_MMU_L3_TABLES
+#define XIL_MMU_L3_TABLES 4U
+#endif
+
+/*
+ * Xil_SetTlbAttributesRange invalidates the TLB entry of each changed page
+ * or block by VA, or the whole TLB when it changes more entries than this.
+ */
+#ifndef XIL_MMU_TLBI_VA_LIMIT
+#define XIL_MMU_TLBI_VA_LIMIT 64U
+#endif
 
 /************************** Variable Definitions *****************************/
 
 extern INTPTR MMUTableL1;
 extern INTPTR MMUTableL2;
 
+static u64 MMUTableL3[XIL_MMU_L3_TABLES][PAGE_SIZE_4KB / sizeof(u64)]
+	__attribute__ ((aligned(PAGE_SIZE_4KB)));
+static u8 MMUTableL3Used[XIL_MMU_L3_TABLES];
+
 /************************** Function Prototypes ******************************/
+
+static u64 *Xil_MmuL3Table(u64 Desc);
+static void Xil_MmuBreakBlock(u64 *L2Ptr, u32 Index, UINTPTR Va);
+
 /*****************************************************************************/
 /**
 * brief		It sets the memory attributes for a section, in the translation
@@ -92,7 +129,10 @@ extern INTPTR MMUTableL2;
 * @return	None.
 *
 * @note		The MMU and D-cache need not be disabled before changing an
-*			translation table attribute.
+*			translation table attribute. A 2MB block split into 4KB
+*			pages by Xil_SetTlbAttributesRange is unmapped for a moment
+*			while it is replaced, so the code and stack in use must not
+*			be in it.
 *
 ******************************************************************************/
 void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib)
@@ -106,6 +146,10 @@ void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib)
 		block_size = BLOCK_SIZE_2MB;
 		section = Addr / block_size;
 		ptr = &MMUTableL2 + section;
+		if (Xil_MmuL3Table((u64)*ptr) != NULL) {
+			Xil_MmuBreakBlock((u64 *)(UINTPTR)&MMUTableL2,
+				(u32)section, (UINTPTR)section * block_size);
+		}
 	}
 	/* if region is greater than 4GB MMUTable level 1 need to be modified */
 	else{
@@ -127,3 +171,326 @@ void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib)
     isb(); /* synchronize context on this processor */
 
 }
+
+/*****************************************************************************/
+/**
+* Return the level 3 table an MMUTableL2 entry points to, or NULL if the
+* entry is a block or fault entry.
+*
+******************************************************************************/
+static u64 *Xil_MmuL3Table(u64 Desc)
+{
+	u32 Index;
+
+	if ((Desc & (DESC_VALID | DESC_TABLE)) != (DESC_VALID | DESC_TABLE)) {
+		return NULL;
+	}
+	for (Index = 0U; Index < XIL_MMU_L3_TABLES; Index++) {
+		if ((Desc & DESC_ADDR_MASK) == (UINTPTR)MMUTableL3[Index]) {
+			return MMUTableL3[Index];
+		}
+	}
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+* Take a level 3 table from the pool and fill it with 4KB pages that map the
+* 2MB block described by Desc with the same attributes, so that installing
+* the table in place of the block leaves every translation unchanged.
+*
+******************************************************************************/
+static u64 *Xil_MmuSplitBlock(u64 Desc)
+{
+	u64 *Table = NULL;
+	u64 Attrib;
+	UINTPTR Pa;
+	u32 Index;
+
+	for (Index = 0U; Index < XIL_MMU_L3_TABLES; Index++) {
+		if (MMUTableL3Used[Index] == 0U) {
+			MMUTableL3Used[Index] = 1U;
+			Table = MMUTableL3[Index];
+			break;
+		}
+	}
+	if (Table == NULL) {
+		return NULL;
+	}
+
+	Pa = Desc & DESC_ADDR_MASK & ~((u64)BLOCK_SIZE_2MB - 1U);
+	Attrib = Desc & ~DESC_ADDR_MASK;
+	if ((Attrib & DESC_VALID) != 0U) {
+		Attrib |= DESC_TABLE;
+	}
+	for (Index = 0U; Index < (BLOCK_SIZE_2MB / PAGE_SIZE_4KB); Index++) {
+		Table[Index] = (Pa + ((UINTPTR)Index * PAGE_SIZE_4KB)) | Attrib;
+	}
+	return Table;
+}
+
+/*****************************************************************************/
+/**
+* Invalidate the TLB entries of NumPages 4KB pages from Va, or the whole TLB
+* for more than XIL_MMU_TLBI_VA_LIMIT pages.
+*
+******************************************************************************/
+static void Xil_MmuTlbiRange(UINTPTR Va, u32 NumPages)
+{
+	UINTPTR Page;
+	u32 Index;
+
+	if (NumPages > XIL_MMU_TLBI_VA_LIMIT) {
+		if (EL3 == 1)
+			mtcptlbi(ALLE3);
+		else if (EL1_NONSECURE == 1)
+			mtcptlbi(VMALLE1);
+		return;
+	}
+	for (Index = 0U; Index < NumPages; Index++) {
+		Page = (Va + ((UINTPTR)Index * PAGE_SIZE_4KB)) >> 12U;
+		if (EL3 == 1)
+			mtcptlbiva(VAE3, Page);
+		else if (EL1_NONSECURE == 1)
+			mtcptlbiva(VAAE1, Page);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Break the MMUTableL2 entry Index, which maps the 2MB block at Va, before a
+* block is replaced by a level 3 table or the other way round: write a fault
+* entry, invalidate the TLB entries of the whole block and give the level 3
+* table the entry pointed to back to the pool. The caller then writes the new
+* descriptor.
+*
+******************************************************************************/
+static void Xil_MmuBreakBlock(u64 *L2Ptr, u32 Index, UINTPTR Va)
+{
+	u64 *Table = Xil_MmuL3Table(L2Ptr[Index]);
+
+	L2Ptr[Index] = 0U;
+	dsb();
+	if (Table != NULL) {
+		Xil_MmuTlbiRange(Va, BLOCK_SIZE_2MB / PAGE_SIZE_4KB);
+		MMUTableL3Used[(Table - MMUTableL3[0]) /
+			(PAGE_SIZE_4KB / sizeof(u64))] = 0U;
+	} else {
+		Xil_MmuTlbiRange(Va, 1U);
+	}
+	dsb();
+}
+
+/*****************************************************************************/
+/**
+* Return the memory attribute index of a valid descriptor that maps cacheable
+* normal memory, or 0 (non-cacheable) otherwise. See MAIR_EL3 in boot.S.
+*
+******************************************************************************/
+static u32 Xil_MmuCacheAttr(u64 Desc)
+{
+	u32 AttrIndx = (u32)(Desc >> 2U) & 0x7U;
+
+	if (((Desc & DESC_VALID) == 0U) || ((AttrIndx != 1U) && (AttrIndx != 4U))) {
+		return 0U;
+	}
+	return AttrIndx;
+}
+
+/*****************************************************************************/
+/**
+* Queue the TLB invalidation of NumPages 4KB pages from Va. Once more than
+* XIL_MMU_TLBI_VA_LIMIT are queued the whole TLB is invalidated instead.
+*
+******************************************************************************/
+static void Xil_MmuQueueTlbi(UINTPTR *VaList, u32 *NumVa, UINTPTR Va,
+			     u32 NumPages)
+{
+	u32 Index;
+
+	if ((*NumVa + NumPages) > XIL_MMU_TLBI_VA_LIMIT) {
+		*NumVa = XIL_MMU_TLBI_VA_LIMIT + 1U;
+		return;
+	}
+	for (Index = 0U; Index < NumPages; Index++) {
+		VaList[*NumVa] = Va + ((UINTPTR)Index * PAGE_SIZE_4KB);
+		*NumVa += 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief	It sets the memory attributes for an address range, in the
+*			translation table. Below 4GB the attributes are set with 4KB
+*			granularity: a 2MB block the range covers only in part is split
+*			into 4KB pages, using a level 3 table from a pool of
+*			XIL_MMU_L3_TABLES tables, and a block the range covers in full
+*			is set as a whole. At and above 4GB the range is set in 1GB
+*			blocks, so it must be 1GB aligned there.
+*
+* @param	Addr: 64-bit start address of the range, 4KB aligned.
+* @param	Size: Size of the range in bytes, a multiple of 4KB.
+* @param	attrib: Attribute for the specified memory region. xil_mmu.h
+*			contains commonly used memory attributes definitions which can be
+*			utilized for this function.
+*
+* @return	- XST_SUCCESS if the attributes are set.
+*			- XST_INVALID_PARAM if the range is not aligned as required.
+*			- XST_FAILURE if the range needs more level 3 tables than
+*			  are left in the pool. No attribute is changed then.
+*
+* @note		Unlike Xil_SetTlbAttributes, only the cache lines of the range
+*			are flushed, and only when its cacheability changes, and only
+*			the TLB entries of the changed pages and blocks are
+*			invalidated. A 2MB block whose pages all get the same
+*			attributes again is not merged back. A 2MB block that is
+*			split, or set as a whole after it was split, is unmapped for
+*			a moment while it is replaced, so the code and stack in use
+*			must not be in it. The function is not reentrant.
+*
+******************************************************************************/
+s32 Xil_SetTlbAttributesRange(UINTPTR Addr, u64 Size, u64 attrib)
+{
+	u64 *L2Ptr = (u64 *)(UINTPTR)&MMUTableL2;
+	u64 *L1Ptr = (u64 *)(UINTPTR)&MMUTableL1;
+	u64 *Table;
+	u64 Desc;
+	UINTPTR TlbiVa[XIL_MMU_TLBI_VA_LIMIT];
+	UINTPTR Va;
+	UINTPTR End;
+	UINTPTR BlockEnd;
+	u32 NumTlbi = 0U;
+	u32 NumSplit = 0U;
+	u32 NumFree = 0U;
+	u32 Flush = 0U;
+	u32 Unmapped = 0U;
+	u32 Index;
+
+	if ((Size == 0U) || ((Addr & (PAGE_SIZE_4KB - 1U)) != 0U) ||
+	    ((Size & (PAGE_SIZE_4KB - 1U)) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+	End = Addr + Size;
+	if ((End > ADDRESS_LIMIT_4GB) &&
+	    ((((Addr > ADDRESS_LIMIT_4GB) ? Addr : ADDRESS_LIMIT_4GB) |
+	      End) & (BLOCK_SIZE_1GB - 1U)) != 0U) {
+		return XST_INVALID_PARAM;
+	}
+
+	/*
+	 * Look at the current mappings first: count the blocks to split, so
+	 * that the range is set in full or not at all, and find out whether
+	 * the cacheability of any of it changes.
+	 */
+	for (Va = Addr; Va < End; ) {
+		if (Va < ADDRESS_LIMIT_4GB) {
+			Desc = L2Ptr[Va / BLOCK_SIZE_2MB];
+			BlockEnd = (Va & ~((UINTPTR)BLOCK_SIZE_2MB - 1U)) +
+				BLOCK_SIZE_2MB;
+			Table = Xil_MmuL3Table(Desc);
+			if (Table != NULL) {
+				Desc = Table[(Va & (BLOCK_SIZE_2MB - 1U)) /
+					PAGE_SIZE_4KB];
+				BlockEnd = Va + PAGE_SIZE_4KB;
+			} else if ((Va & (BLOCK_SIZE_2MB - 1U)) != 0U ||
+				   (BlockEnd > End)) {
+				NumSplit++;
+			}
+		} else {
+			Desc = L1Ptr[Va / BLOCK_SIZE_1GB];
+			BlockEnd = Va + BLOCK_SIZE_1GB;
+		}
+		if ((Desc & DESC_VALID) == 0U) {
+			Unmapped = 1U;
+		}
+		if (Xil_MmuCacheAttr(Desc) != Xil_MmuCacheAttr(attrib)) {
+			Flush |= Xil_MmuCacheAttr(Desc);
+		}
+		Va = BlockEnd;
+	}
+	for (Index = 0U; Index < XIL_MMU_L3_TABLES; Index++) {
+		if (MMUTableL3Used[Index] == 0U) {
+			NumFree++;
+		}
+	}
+	if (NumSplit > NumFree) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Write back and drop the cached data of the range before it stops
+	 * being cacheable, and again once the new mapping is in use below, as
+	 * speculative accesses may fill lines through the old mapping until
+	 * its TLB entries are gone. Maintenance by VA would fault on unmapped
+	 * parts.
+	 */
+	if (Flush != 0U) {
+		if (Unmapped != 0U) {
+			Xil_DCacheFlush();
+		} else {
+			Xil_DCacheFlushRange((INTPTR)Addr, (INTPTR)Size);
+		}
+	}
+
+	Va = Addr;
+	while ((Va < End) && (Va < ADDRESS_LIMIT_4GB)) {
+		Index = Va / BLOCK_SIZE_2MB;
+		BlockEnd = (Va & ~((UINTPTR)BLOCK_SIZE_2MB - 1U)) + BLOCK_SIZE_2MB;
+		Table = Xil_MmuL3Table(L2Ptr[Index]);
+
+		if (((Va & (BLOCK_SIZE_2MB - 1U)) == 0U) && (BlockEnd <= End)) {
+			/* Whole block, a level 3 table is no longer needed */
+			if (Table != NULL) {
+				Xil_MmuBreakBlock(L2Ptr, Index, Va);
+			} else {
+				Xil_MmuQueueTlbi(TlbiVa, &NumTlbi, Va, 1U);
+			}
+			L2Ptr[Index] = Va | attrib;
+			Va = BlockEnd;
+			continue;
+		}
+
+		if (Table == NULL) {
+			/*
+			 * The pages map the block with its own attributes, so
+			 * only the pages changed below differ from the block.
+			 */
+			Table = Xil_MmuSplitBlock(L2Ptr[Index]);
+			Xil_MmuBreakBlock(L2Ptr, Index,
+				Va & ~((UINTPTR)BLOCK_SIZE_2MB - 1U));
+			L2Ptr[Index] = (UINTPTR)Table | DESC_VALID | DESC_TABLE;
+		}
+		for (; (Va < BlockEnd) && (Va < End); Va += PAGE_SIZE_4KB) {
+			Table[(Va & (BLOCK_SIZE_2MB - 1U)) / PAGE_SIZE_4KB] = Va |
+				(((attrib & DESC_VALID) != 0U) ?
+				 (attrib | DESC_TABLE) : attrib);
+			Xil_MmuQueueTlbi(TlbiVa, &NumTlbi, Va, 1U);
+		}
+	}
+	for (; Va < End; Va += BLOCK_SIZE_1GB) {
+		L1Ptr[Va / BLOCK_SIZE_1GB] = Va | attrib;
+		Xil_MmuQueueTlbi(TlbiVa, &NumTlbi, Va, 1U);
+	}
+
+	/* Translation table walks are cacheable, a barrier is enough */
+	dsb();
+	if (NumTlbi > XIL_MMU_TLBI_VA_LIMIT) {
+		Xil_MmuTlbiRange(Addr, NumTlbi);
+	} else {
+		for (Index = 0U; Index < NumTlbi; Index++) {
+			Xil_MmuTlbiRange(TlbiVa[Index], 1U);
+		}
+	}
+	dsb(); /* ensure completion of the TLB invalidation */
+	isb(); /* synchronize context on this processor */
+
+	if (Flush != 0U) {
+		if ((attrib & DESC_VALID) == 0U) {
+			Xil_DCacheFlush();
+		} else {
+			Xil_DCacheFlushRange((INTPTR)Addr, (INTPTR)Size);
+		}
+	}
+
+	return XST_SUCCESS;
+}
@@ -46,6 +46,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 5.00 	pkp  05/29/14 First release
+* 6.6   ag   10/16/26 Added Xil_SetTlbAttributesRange
 * </pre>
 *
 * @note
@@ -102,6 +103,7 @@ extern "C" {
 /************************** Function Prototypes ******************************/
 
 void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib);
+s32 Xil_SetTlbAttributesRange(UINTPTR Addr, u64 Size, u64 attrib);
 
 #ifdef __cplusplus
 }
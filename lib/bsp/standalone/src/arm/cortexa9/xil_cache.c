@@ -98,6 +98,12 @@
 * 6.6    asa 16/01/18 Changes made in Xil_L1DCacheInvalidate and Xil_L2CacheInvalidate
 *					  routines to ensure the stack data flushed only when the respective
 *					  caches are enabled. This fixes CR-992023.
+* 6.6    ag  10/16/26 Xil_DCacheFlushRange and Xil_DCacheInvalidateRange work
+*					  on chunks of cache lines, with one L2 cache sync and one
+*					  interrupt masked window per chunk instead of a sync per
+*					  line. Xil_DCacheFlushRange cleans L1 before L2 for each
+*					  chunk, and flushes the whole D cache for ranges above
+*					  the L2 cache size.
 *
 * </pre>
 *
@@ -121,6 +127,20 @@
 
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * The D cache range functions mask interrupts and sync the L2 cache once per
+ * XIL_CACHE_RANGE_CHUNK_LINES cache lines. Xil_DCacheFlushRange flushes the
+ * whole D cache, L1 by set/way and L2 by way, instead for ranges longer than
+ * XIL_CACHE_RANGE_SETWAY_LIMIT bytes, the size of the L2 cache. Both can be
+ * overridden from the compiler flags.
+ */
+#ifndef XIL_CACHE_RANGE_CHUNK_LINES
+#define XIL_CACHE_RANGE_CHUNK_LINES	128U
+#endif
+#ifndef XIL_CACHE_RANGE_SETWAY_LIMIT
+#define XIL_CACHE_RANGE_SETWAY_LIMIT	0x80000U
+#endif
+
 #ifdef __GNUC__
 	extern s32  _stack_end;
 	extern s32  __undef_stack;
@@ -333,9 +353,14 @@ void Xil_DCacheInvalidateLine(u32 adr)
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 {
 	const u32 cacheline = 32U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
 	u32 tempadr = adr;
 	u32 tempend;
+#ifndef USE_AMP
+	u32 lineadr;
+#endif
 	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
@@ -378,21 +403,34 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 		}
 
 		while (tempadr < tempend) {
+			chunkend = ((tempend - tempadr) > chunksize) ?
+				(tempadr + chunksize) : tempend;
 #ifndef USE_AMP
-			/* Invalidate L2 cache line */
-			*L2CCOffset = tempadr;
+			/* Invalidate L2 cache lines, then sync once */
+			for (lineadr = tempadr; lineadr < chunkend;
+			     lineadr += cacheline) {
+				*L2CCOffset = lineadr;
+			}
 			Xil_L2CacheSync();
 #endif
 
-	/* Invalidate L1 Data cache line */
+			/* Invalidate L1 Data cache lines */
+			while (tempadr < chunkend) {
 #if defined (__GNUC__) || defined (__ICCARM__)
-			asm_cp15_inval_dc_line_mva_poc(tempadr);
+				asm_cp15_inval_dc_line_mva_poc(tempadr);
 #else
-			{ volatile register u32 Reg
-				__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
-			  Reg = tempadr; }
+				{ volatile register u32 Reg
+					__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
+				  Reg = tempadr; }
 #endif
-			tempadr += cacheline;
+				tempadr += cacheline;
+			}
+			if (tempadr < tempend) {
+				/* Complete the chunk and let pending interrupts in */
+				dsb();
+				mtcpsr(currmask);
+				mtcpsr(currmask | IRQ_FIQ_MASK);
+			}
 		}
 	}
 
@@ -473,44 +511,69 @@ void Xil_DCacheFlushLine(u32 adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes are
+*			flushed with the whole D cache.
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 {
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
+	u32 lineadr;
 	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
 
+	if (len == 0U) {
+		return;
+	}
+	if (len > XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		Xil_DCacheFlush();
+		return;
+	}
+
+	/* Back the starting address up to the start of a cache line
+	 * perform cache operations until adr+len
+	 */
+	end = LocalAddr + len;
+	LocalAddr &= ~(cacheline - 1U);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
 
-	if (len != 0U) {
-		/* Back the starting address up to the start of a cache line
-		 * perform cache operations until adr+len
-		 */
-		end = LocalAddr + len;
-		LocalAddr &= ~(cacheline - 1U);
-
-		while (LocalAddr < end) {
+	while (LocalAddr < end) {
+		chunkend = ((end - LocalAddr) > chunksize) ?
+			(LocalAddr + chunksize) : end;
 
-	/* Flush L1 Data cache line */
+		/* Flush L1 Data cache lines */
+		for (lineadr = LocalAddr; lineadr < chunkend;
+		     lineadr += cacheline) {
 #if defined (__GNUC__) || defined (__ICCARM__)
-			asm_cp15_clean_inval_dc_line_mva_poc(LocalAddr);
+			asm_cp15_clean_inval_dc_line_mva_poc(lineadr);
 #else
 			{ volatile register u32 Reg
 				__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
-			  Reg = LocalAddr; }
+			  Reg = lineadr; }
 #endif
+		}
+		/* L1 write backs must reach L2 before it is flushed */
+		dsb();
 #ifndef USE_AMP
-			/* Flush L2 cache line */
-			*L2CCOffset = LocalAddr;
-			Xil_L2CacheSync();
+		/* Flush L2 cache lines, then sync once */
+		for (lineadr = LocalAddr; lineadr < chunkend;
+		     lineadr += cacheline) {
+			*L2CCOffset = lineadr;
+		}
+		Xil_L2CacheSync();
 #endif
-			LocalAddr += cacheline;
+		LocalAddr = lineadr;
+		if (LocalAddr < end) {
+			/* Let pending interrupts in between chunks */
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
 	dsb();
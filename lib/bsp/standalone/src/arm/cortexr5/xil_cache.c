@@ -43,6 +43,12 @@
 * ----- ---- -------- -----------------------------------------------
 * 5.00 	pkp  02/20/14 First release
 * 6.2   mus  01/27/17 Updated to support IAR compiler
+* 6.6   ag   10/16/26 Xil_DCacheFlushRange and Xil_DCacheInvalidateRange mask
+*                     interrupts one chunk of cache lines at a time, and
+*                     Xil_DCacheFlushRange flushes the whole D cache by
+*                     set/way for ranges above the D cache size. The
+*                     partial first line of an invalidated range is no
+*                     longer maintained twice.
 * </pre>
 *
 ******************************************************************************/
@@ -61,6 +67,20 @@
 
 #define IRQ_FIQ_MASK 0xC0	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * The D cache range functions mask interrupts for at most
+ * XIL_CACHE_RANGE_CHUNK_LINES cache lines at a time. Xil_DCacheFlushRange
+ * flushes the whole D cache by set/way instead for ranges longer than
+ * XIL_CACHE_RANGE_SETWAY_LIMIT bytes, the size of the D cache. Both can be
+ * overridden from the compiler flags.
+ */
+#ifndef XIL_CACHE_RANGE_CHUNK_LINES
+#define XIL_CACHE_RANGE_CHUNK_LINES	128U
+#endif
+#ifndef XIL_CACHE_RANGE_SETWAY_LIMIT
+#define XIL_CACHE_RANGE_SETWAY_LIMIT	0x8000U
+#endif
+
 #if defined (__GNUC__)
 extern s32  _stack_end;
 extern s32  __undef_stack;
@@ -213,37 +233,46 @@ void Xil_DCacheInvalidateLine(INTPTR adr)
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 {
 	const u32 cacheline = 32U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
 	u32 tempadr = adr;
 	u32 tempend;
 	u32 currmask;
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
+	if (len == 0U) {
+		return;
+	}
 
-	if (len != 0U) {
-		end = tempadr + len;
-		tempend = end;
-		/* Select L1 Data cache in CSSR */
-		mtcp(XREG_CP15_CACHE_SIZE_SEL, 0U);
+	end = tempadr + len;
+	tempadr &= ~(cacheline - 1U);
+	tempend = end & ~(cacheline - 1U);
 
-		if ((tempadr & (cacheline-1U)) != 0U) {
-			tempadr &= (~(cacheline - 1U));
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
 
-			Xil_DCacheFlushLine(tempadr);
-		}
-		if ((tempend & (cacheline-1U)) != 0U) {
-			tempend &= (~(cacheline - 1U));
+	/* Partial lines at either end may hold data outside the range */
+	if (tempadr != (u32)adr) {
+		asm_clean_inval_dc_line_mva_poc(tempadr);
+		tempadr += cacheline;
+	}
+	if ((tempend != end) && (tempend >= tempadr)) {
+		asm_clean_inval_dc_line_mva_poc(tempend);
+	}
 
-			Xil_DCacheFlushLine(tempend);
+	while (tempadr < tempend) {
+		chunkend = ((tempend - tempadr) > chunksize) ?
+			(tempadr + chunksize) : tempend;
+		while (tempadr < chunkend) {
+			/* Invalidate Data cache line */
+			asm_inval_dc_line_mva_poc(tempadr);
+			tempadr += cacheline;
 		}
-
-		while (tempadr < tempend) {
-
-		/* Invalidate Data cache line */
-		asm_inval_dc_line_mva_poc(tempadr);
-
-		tempadr += cacheline;
+		if (tempadr < tempend) {
+			/* Complete the chunk and let pending interrupts in */
+			dsb();
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
 		}
 	}
 
@@ -361,30 +390,50 @@ void Xil_DCacheFlushLine(INTPTR adr)
 *
 * @return	None.
 *
+* @note		Ranges longer than XIL_CACHE_RANGE_SETWAY_LIMIT bytes are
+*			flushed with the whole D cache.
+*
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 {
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
+	const u32 chunksize = cacheline * XIL_CACHE_RANGE_CHUNK_LINES;
 	u32 end;
+	u32 chunkend;
 	u32 currmask;
 
+	if (len == 0x00000000U) {
+		return;
+	}
+	if (len > XIL_CACHE_RANGE_SETWAY_LIMIT) {
+		Xil_DCacheFlush();
+		return;
+	}
+
+	/* Back the starting address up to the start of a cache line
+	 * perform cache operations until adr+len
+	 */
+	end = LocalAddr + len;
+	LocalAddr &= ~(cacheline - 1U);
+
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
 
-	if (len != 0x00000000U) {
-		/* Back the starting address up to the start of a cache line
-		 * perform cache operations until adr+len
-		 */
-		end = LocalAddr + len;
-		LocalAddr &= ~(cacheline - 1U);
-
-		while (LocalAddr < end) {
+	while (LocalAddr < end) {
+		chunkend = ((end - LocalAddr) > chunksize) ?
+			(LocalAddr + chunksize) : end;
+		while (LocalAddr < chunkend) {
 			/* Flush Data cache line */
 			asm_clean_inval_dc_line_mva_poc(LocalAddr);
-
 			LocalAddr += cacheline;
 		}
+		if (LocalAddr < end) {
+			/* Complete the chunk and let pending interrupts in */
+			dsb();
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+		}
 	}
 	dsb();
 	mtcpsr(currmask);
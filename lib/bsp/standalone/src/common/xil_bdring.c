@@ -0,0 +1,557 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_bdring.c
+*
+* This file contains the buffer descriptor ring engine shared by the scatter
+* gather DMA drivers. See xil_bdring.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_bdring.h"
+#include "xil_assert.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xstatus.h"
+#if defined (__MICROBLAZE__)
+#include "mb_interface.h"
+#else
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/* Number of BDs XBdRing_FromHw() invalidates at a time ahead of its walk */
+#define XBDRING_INVALIDATE_CHUNK	8U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Orders the BD and counter updates of one side against the other side.
+ * Ordering BD updates against the register write that hands them to hardware
+ * takes the stronger DATA_SYNC.
+ */
+#if defined (__MICROBLAZE__)
+#define XBDRING_SYNC()	mbar(1)
+#else
+#define XBDRING_SYNC()	dmb()
+#endif
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+* Set up a BD ring over BdCount BDs, Separation bytes apart, starting at
+* BaseBdAddr. The BD memory itself is left to the driver to initialize.
+*
+* @param	RingPtr is the ring to set up.
+* @param	BaseBdAddr is the virtual address of the first BD.
+* @param	Separation is the number of bytes between adjacent BDs.
+* @param	BdCount is the number of BDs in the ring.
+* @param	Ops is the descriptor layout of the driver.
+* @param	Owner is passed to the operations in Ops.
+* @param	Flags is a combination of XBDRING_FLAG_* values.
+*
+* @return
+*		- XST_SUCCESS if the ring was set up
+*		- XST_INVALID_PARAM if BdCount or Separation is 0
+*		- XST_DMA_SG_LIST_ERROR if the BD space wraps around address 0
+*
+******************************************************************************/
+s32 XBdRing_Create(XBdRing *RingPtr, UINTPTR BaseBdAddr, u32 Separation,
+		   u32 BdCount, const XBdRing_Ops *Ops, void *Owner, u32 Flags)
+{
+	Xil_AssertNonvoid(RingPtr != NULL);
+	Xil_AssertNonvoid(Ops != NULL);
+	Xil_AssertNonvoid(Ops->BdStatus != NULL);
+
+	/* Leave an unusable ring behind on failure */
+	RingPtr->AllCnt = 0U;
+	XBdRing_Reset(RingPtr);
+
+	if ((BdCount == 0U) || (Separation == 0U)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+	if (BaseBdAddr > (BaseBdAddr + ((UINTPTR)Separation * BdCount) - 1U)) {
+		return (s32)XST_DMA_SG_LIST_ERROR;
+	}
+
+	RingPtr->BaseBdAddr = BaseBdAddr;
+	RingPtr->HighBdAddr = BaseBdAddr +
+				((UINTPTR)Separation * (BdCount - 1U));
+	RingPtr->Separation = Separation;
+	RingPtr->Flags = Flags;
+	RingPtr->Ops = Ops;
+	RingPtr->Owner = Owner;
+	XBdRing_ClearStats(RingPtr);
+	RingPtr->AllCnt = BdCount;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Return all BDs of a ring to the free group, with the group heads at the
+* first BD. Hardware must not be using the ring.
+*
+* @param	RingPtr is the ring to reset.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_Reset(XBdRing *RingPtr)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->FreeIdx = 0U;
+	RingPtr->PreIdx = 0U;
+	RingPtr->HwTailIdx = 0U;
+	RingPtr->HwIdx = 0U;
+	RingPtr->PostIdx = 0U;
+	RingPtr->Allocated = 0U;
+	RingPtr->Committed = 0U;
+	RingPtr->Retired = 0U;
+	RingPtr->Freed = 0U;
+}
+
+/*****************************************************************************/
+/**
+* Move the heads of all BD groups back to the first BD, keeping the number of
+* BDs in each group. For use when hardware is restarted at the first BD of a
+* ring whose BDs are all in one group, such as a receive ring with every BD
+* given to hardware. Hardware must not be using the ring.
+*
+* @param	RingPtr is the ring to rewind.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_Rewind(XBdRing *RingPtr)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->FreeIdx = 0U;
+	RingPtr->PreIdx = 0U;
+	RingPtr->HwTailIdx = 0U;
+	RingPtr->HwIdx = 0U;
+	RingPtr->PostIdx = 0U;
+}
+
+/*****************************************************************************/
+/**
+* Allocate NumBd contiguous BDs from the free group for the caller to fill
+* in. Producer side.
+*
+* @param	RingPtr is the ring to work on.
+* @param	NumBd is the number of BDs to allocate.
+* @param	BdSetPtr returns the first BD of the set.
+*
+* @return
+*		- XST_SUCCESS if the BDs were allocated
+*		- XST_FAILURE if there are fewer than NumBd free BDs
+*
+******************************************************************************/
+s32 XBdRing_Alloc(XBdRing *RingPtr, u32 NumBd, UINTPTR *BdSetPtr)
+{
+	Xil_AssertNonvoid(RingPtr != NULL);
+	Xil_AssertNonvoid(BdSetPtr != NULL);
+
+	if (XBdRing_GetFreeCnt(RingPtr) < NumBd) {
+		RingPtr->Stats.AllocFails++;
+		return (s32)XST_FAILURE;
+	}
+	if ((RingPtr->Flags & XBDRING_FLAG_SPSC) != 0U) {
+		/* the consumer is done with the BDs before we reuse them */
+		XBDRING_SYNC();
+	}
+
+	*BdSetPtr = XBdRing_IdxToBd(RingPtr, RingPtr->FreeIdx);
+	RingPtr->FreeIdx = XBdRing_IdxAdd(RingPtr, RingPtr->FreeIdx, NumBd);
+	RingPtr->Allocated += NumBd;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Return the last NumBd allocated BDs, not yet given to hardware, to the
+* free group. Producer side.
+*
+* @param	RingPtr is the ring to work on.
+* @param	NumBd is the number of BDs to return.
+* @param	BdSetPtr is the first of the BDs to return; the set must end
+*		with the last allocated BD.
+*
+* @return
+*		- XST_SUCCESS if the BDs were returned
+*		- XST_FAILURE if NumBd exceeds the pre-work group or the set
+*		does not end with the last allocated BD
+*
+******************************************************************************/
+s32 XBdRing_UnAlloc(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr)
+{
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	if ((XBdRing_GetPreCnt(RingPtr) < NumBd) ||
+	    (XBdRing_IdxAdd(RingPtr, XBdRing_BdToIdx(RingPtr, BdSetPtr),
+			    NumBd) != RingPtr->FreeIdx)) {
+		return (s32)XST_FAILURE;
+	}
+
+	RingPtr->FreeIdx = XBdRing_IdxSub(RingPtr, RingPtr->FreeIdx, NumBd);
+	RingPtr->Allocated -= NumBd;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Give the NumBd BDs at the head of the pre-work group to hardware. Each BD
+* is passed to the BdToHw operation of the driver, then the whole set is
+* flushed from the data cache in at most two ranges. The caller then tells
+* hardware about the new BDs, using XBdRing_GetHwTail() for a tail pointer.
+* Producer side.
+*
+* @param	RingPtr is the ring to work on.
+* @param	NumBd is the number of BDs in the set.
+* @param	BdSetPtr is the first BD of the set.
+*
+* @return
+*		- XST_SUCCESS if the set was given to hardware
+*		- XST_DMA_SG_LIST_ERROR if the set is not at the head of the
+*		pre-work group
+*		- the error returned by BdToHw if it rejected a BD
+*
+******************************************************************************/
+s32 XBdRing_ToHw(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr)
+{
+	u32 Idx;
+	u32 i;
+	u32 Position;
+	u32 HwCnt;
+	s32 Status;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	if (NumBd == 0U) {
+		return (s32)XST_SUCCESS;
+	}
+	if ((XBdRing_GetPreCnt(RingPtr) < NumBd) ||
+	    (BdSetPtr != XBdRing_GetPreHead(RingPtr))) {
+		return (s32)XST_DMA_SG_LIST_ERROR;
+	}
+
+	if (RingPtr->Ops->BdToHw != NULL) {
+		Idx = RingPtr->PreIdx;
+		for (i = 0U; i < NumBd; i++) {
+			Position = ((i == 0U) ? XBDRING_BD_FIRST : 0U) |
+				((i == (NumBd - 1U)) ? XBDRING_BD_END : 0U);
+			Status = RingPtr->Ops->BdToHw(RingPtr->Owner,
+					XBdRing_IdxToBd(RingPtr, Idx), Position);
+			if (Status != (s32)XST_SUCCESS) {
+				return Status;
+			}
+			Idx = XBdRing_IdxAdd(RingPtr, Idx, 1U);
+		}
+	}
+	XBdRing_FlushSpan(RingPtr, RingPtr->PreIdx, NumBd);
+	DATA_SYNC;
+
+	RingPtr->HwTailIdx = XBdRing_IdxAdd(RingPtr, RingPtr->PreIdx,
+					    NumBd - 1U);
+	RingPtr->PreIdx = XBdRing_IdxAdd(RingPtr, RingPtr->PreIdx, NumBd);
+	RingPtr->Committed += NumBd;
+
+	RingPtr->Stats.ToHwCalls++;
+	RingPtr->Stats.BdsToHw += NumBd;
+	HwCnt = XBdRing_GetHwCnt(RingPtr);
+	if (HwCnt > RingPtr->Stats.HwCntMax) {
+		RingPtr->Stats.HwCntMax = HwCnt;
+	}
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Return the BDs at the head of the work group that hardware is done with,
+* up to BdLimit BDs and only whole packets. The BDs are invalidated in the
+* data cache XBDRING_INVALIDATE_CHUNK at a time as the walk reaches them, so
+* the walk stopping at the first BD that is not done leaves the rest of the
+* outstanding BDs alone. Consumer side.
+*
+* With XBDRING_FLAG_DONE_FIRST a packet is done once its first BD is, as
+* reported by BdStatus; otherwise each of its BDs must be done. With
+* XBDRING_FLAG_CYCLIC the BDs stay in the work group and only the head
+* moves on, up to the last BD given to hardware.
+*
+* @param	RingPtr is the ring to work on.
+* @param	BdLimit is the maximum number of BDs to return.
+* @param	BdSetPtr returns the first BD of the set, 0 if none.
+*
+* @return	The number of BDs returned, 0 if hardware has not finished a
+*		packet.
+*
+******************************************************************************/
+u32 XBdRing_FromHw(XBdRing *RingPtr, u32 BdLimit, UINTPTR *BdSetPtr)
+{
+	u32 Limit;
+	u32 Idx;
+	u32 Invalidated = 0U;
+	u32 Chunk;
+	u32 BdCount = 0U;
+	u32 BdPartialCount = 0U;
+	u32 InPacket = 0U;
+	u32 BdStatus;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+	Xil_AssertNonvoid(BdSetPtr != NULL);
+
+	Limit = XBdRing_GetHwCnt(RingPtr);
+	if (((RingPtr->Flags & XBDRING_FLAG_CYCLIC) != 0U) && (Limit != 0U)) {
+		Limit = XBdRing_IdxSub(RingPtr, RingPtr->HwTailIdx,
+				       RingPtr->HwIdx) + 1U;
+	}
+	if (BdLimit < Limit) {
+		Limit = BdLimit;
+	}
+	if (Limit == 0U) {
+		RingPtr->Stats.FromHwEmpty++;
+		*BdSetPtr = 0U;
+		return 0U;
+	}
+
+	Idx = RingPtr->HwIdx;
+	while (BdCount < Limit) {
+		if (BdCount == Invalidated) {
+			Chunk = Limit - BdCount;
+			if (Chunk > XBDRING_INVALIDATE_CHUNK) {
+				Chunk = XBDRING_INVALIDATE_CHUNK;
+			}
+			XBdRing_InvalidateSpan(RingPtr, Idx, Chunk);
+			Invalidated += Chunk;
+		}
+		BdStatus = RingPtr->Ops->BdStatus(RingPtr->Owner,
+					XBdRing_IdxToBd(RingPtr, Idx));
+		if (((BdStatus & XBDRING_BD_DONE) == 0U) &&
+		    ((InPacket == 0U) ||
+		     ((RingPtr->Flags & XBDRING_FLAG_DONE_FIRST) == 0U))) {
+			break;
+		}
+		BdCount++;
+		/* count BDs of a packet until its last one is seen */
+		if ((BdStatus & XBDRING_BD_LAST) != 0U) {
+			BdPartialCount = 0U;
+			InPacket = 0U;
+		} else {
+			BdPartialCount++;
+			InPacket = 1U;
+		}
+		Idx = XBdRing_IdxAdd(RingPtr, Idx, 1U);
+	}
+	BdCount -= BdPartialCount;
+
+	if (BdCount == 0U) {
+		RingPtr->Stats.FromHwEmpty++;
+		*BdSetPtr = 0U;
+		return 0U;
+	}
+
+	*BdSetPtr = XBdRing_IdxToBd(RingPtr, RingPtr->HwIdx);
+	RingPtr->HwIdx = XBdRing_IdxAdd(RingPtr, RingPtr->HwIdx, BdCount);
+	if ((RingPtr->Flags & XBDRING_FLAG_CYCLIC) == 0U) {
+		RingPtr->Retired += BdCount;
+	}
+
+	RingPtr->Stats.FromHwCalls++;
+	RingPtr->Stats.BdsFromHw += BdCount;
+
+	return BdCount;
+}
+
+/*****************************************************************************/
+/**
+* Return NumBd BDs from the head of the post-work group to the free group,
+* in the order they were returned by XBdRing_FromHw(). Consumer side.
+*
+* @param	RingPtr is the ring to work on.
+* @param	NumBd is the number of BDs to free.
+* @param	BdSetPtr is the first BD of the set.
+*
+* @return
+*		- XST_SUCCESS if the BDs were freed
+*		- XST_DMA_SG_LIST_ERROR if the set is not at the head of the
+*		post-work group
+*
+******************************************************************************/
+s32 XBdRing_Free(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr)
+{
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	if (NumBd == 0U) {
+		return (s32)XST_SUCCESS;
+	}
+	if ((XBdRing_GetPostCnt(RingPtr) < NumBd) ||
+	    (BdSetPtr != XBdRing_GetPostHead(RingPtr))) {
+		return (s32)XST_DMA_SG_LIST_ERROR;
+	}
+
+	RingPtr->PostIdx = XBdRing_IdxAdd(RingPtr, RingPtr->PostIdx, NumBd);
+	if ((RingPtr->Flags & XBDRING_FLAG_SPSC) != 0U) {
+		/* all reads of the BDs are done before the producer sees them */
+		XBDRING_SYNC();
+	}
+	RingPtr->Freed += NumBd;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Flush NumBd BDs starting at index Idx from the data cache, as one range or
+* two if the span wraps around the end of the ring. Does nothing for rings
+* with XBDRING_FLAG_NOCACHE.
+*
+* @param	RingPtr is the ring to work on.
+* @param	Idx is the index of the first BD.
+* @param	NumBd is the number of BDs.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_FlushSpan(XBdRing *RingPtr, u32 Idx, u32 NumBd)
+{
+	u32 ToEnd;
+
+	if ((NumBd == 0U) || ((RingPtr->Flags & XBDRING_FLAG_NOCACHE) != 0U)) {
+		return;
+	}
+
+	ToEnd = RingPtr->AllCnt - Idx;
+	if (NumBd <= ToEnd) {
+		Xil_DCacheFlushRange(XBdRing_IdxToBd(RingPtr, Idx),
+				     NumBd * RingPtr->Separation);
+	} else {
+		Xil_DCacheFlushRange(XBdRing_IdxToBd(RingPtr, Idx),
+				     ToEnd * RingPtr->Separation);
+		Xil_DCacheFlushRange(RingPtr->BaseBdAddr,
+				     (NumBd - ToEnd) * RingPtr->Separation);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Invalidate NumBd BDs starting at index Idx in the data cache, as one range
+* or two if the span wraps around the end of the ring. Does nothing for rings
+* with XBDRING_FLAG_NOCACHE.
+*
+* @param	RingPtr is the ring to work on.
+* @param	Idx is the index of the first BD.
+* @param	NumBd is the number of BDs.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_InvalidateSpan(XBdRing *RingPtr, u32 Idx, u32 NumBd)
+{
+	u32 ToEnd;
+
+	if ((NumBd == 0U) || ((RingPtr->Flags & XBDRING_FLAG_NOCACHE) != 0U)) {
+		return;
+	}
+
+	ToEnd = RingPtr->AllCnt - Idx;
+	if (NumBd <= ToEnd) {
+		Xil_DCacheInvalidateRange(XBdRing_IdxToBd(RingPtr, Idx),
+					  NumBd * RingPtr->Separation);
+	} else {
+		Xil_DCacheInvalidateRange(XBdRing_IdxToBd(RingPtr, Idx),
+					  ToEnd * RingPtr->Separation);
+		Xil_DCacheInvalidateRange(RingPtr->BaseBdAddr,
+				(NumBd - ToEnd) * RingPtr->Separation);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Copy the statistics of a ring.
+*
+* @param	RingPtr is the ring to work on.
+* @param	StatsPtr is filled in with the statistics.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_GetStats(XBdRing *RingPtr, XBdRing_Stats *StatsPtr)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = RingPtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+* Clear the statistics of a ring.
+*
+* @param	RingPtr is the ring to work on.
+*
+* @return	None.
+*
+******************************************************************************/
+void XBdRing_ClearStats(XBdRing *RingPtr)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->Stats.ToHwCalls = 0U;
+	RingPtr->Stats.BdsToHw = 0U;
+	RingPtr->Stats.HwCntMax = 0U;
+	RingPtr->Stats.AllocFails = 0U;
+	RingPtr->Stats.FromHwCalls = 0U;
+	RingPtr->Stats.BdsFromHw = 0U;
+	RingPtr->Stats.FromHwEmpty = 0U;
+}
@@ -0,0 +1,266 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_bdring.h
+*
+* @addtogroup common_bdring_apis Buffer Descriptor Ring APIs
+*
+* The xil_bdring.h file contains a buffer descriptor (BD) ring engine shared
+* by the scatter gather DMA drivers (axidma, mcdma, emacps). It implements the
+* BD state machine common to them:
+*
+* <pre>
+*   Alloc         ToHw          FromHw         Free
+*  -------> Pre -------> Hw ---------> Post -------> Free
+*  <-------
+*   UnAlloc
+* </pre>
+*
+* A driver describes its BD layout with an XBdRing_Ops table, whose BdStatus
+* function reports whether hardware is done with a BD and whether the BD ends
+* a packet, and whose optional BdToHw function prepares each BD given to
+* hardware. The engine does the bookkeeping, the cache maintenance, done
+* once per contiguous span of BDs rather than per BD, and keeps statistics.
+*
+* Alloc, UnAlloc and ToHw form the producer side of a ring, FromHw and Free
+* the consumer side. Each side only writes its own state, so with
+* XBDRING_FLAG_SPSC one context may submit BDs while another reaps them
+* without a lock. Calls on the same side must still be serialized.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_BDRING_H	/* prevent circular inclusions */
+#define XIL_BDRING_H	/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+/**
+ * @name BD status, as returned by XBdRing_Ops.BdStatus
+ * @{
+ */
+#define XBDRING_BD_DONE		0x00000001U /**< Hardware is done with it */
+#define XBDRING_BD_LAST		0x00000002U /**< Last BD of a packet */
+/*@}*/
+
+/**
+ * @name Position of a BD in a set, as passed to XBdRing_Ops.BdToHw
+ * @{
+ */
+#define XBDRING_BD_FIRST	0x00000004U /**< First BD of the set */
+#define XBDRING_BD_END		0x00000008U /**< Last BD of the set */
+/*@}*/
+
+/**
+ * @name Ring flags
+ * @{
+ */
+#define XBDRING_FLAG_NOCACHE	0x00000001U /**< BDs are in non-cacheable or
+						 coherent memory */
+#define XBDRING_FLAG_DONE_FIRST	0x00000002U /**< Hardware reports completion
+						 in the first BD of a packet
+						 only */
+#define XBDRING_FLAG_SPSC	0x00000004U /**< Producer and consumer side
+						 run concurrently */
+#define XBDRING_FLAG_CYCLIC	0x00000008U /**< BDs stay with hardware,
+						 FromHw only moves on */
+/*@}*/
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Descriptor layout operations supplied by a driver. Owner is the pointer
+ * given to XBdRing_Create(), BdPtr the virtual address of a BD.
+ */
+typedef struct {
+	/** Return XBDRING_BD_DONE and XBDRING_BD_LAST as they apply to a BD
+	 *  in the hardware group */
+	u32 (*BdStatus)(void *Owner, UINTPTR BdPtr);
+	/** Optional, prepare a BD in XBdRing_ToHw(). Position has
+	 *  XBDRING_BD_FIRST and XBDRING_BD_END set as they apply. Any return
+	 *  other than XST_SUCCESS rejects the whole set. */
+	s32 (*BdToHw)(void *Owner, UINTPTR BdPtr, u32 Position);
+} XBdRing_Ops;
+
+/**
+ * Ring statistics. The ToHw fields are kept by the producer side, the
+ * FromHw fields by the consumer side.
+ */
+typedef struct {
+	u32 ToHwCalls;		/**< Sets given to hardware */
+	u32 BdsToHw;		/**< BDs given to hardware */
+	u32 HwCntMax;		/**< High water mark of BDs with hardware */
+	u32 AllocFails;		/**< Allocations failed for lack of BDs */
+	u32 FromHwCalls;	/**< FromHw calls that returned BDs */
+	u32 BdsFromHw;		/**< BDs returned by hardware */
+	u32 FromHwEmpty;	/**< FromHw calls that found nothing */
+} XBdRing_Stats;
+
+/**
+ * BD ring. Indexes are BD numbers from the start of the ring; the counters
+ * run freely and the number of BDs in each group is their difference.
+ */
+typedef struct {
+	UINTPTR BaseBdAddr;	/**< Virtual address of the first BD */
+	UINTPTR HighBdAddr;	/**< Virtual address of the last BD */
+	u32 Separation;		/**< Bytes between adjacent BDs */
+	u32 AllCnt;		/**< Number of BDs in the ring */
+	u32 Flags;		/**< XBDRING_FLAG_* */
+	const XBdRing_Ops *Ops;	/**< Descriptor layout operations */
+	void *Owner;		/**< First argument of the operations */
+
+	/* producer side */
+	u32 FreeIdx;		/**< First BD of the free group */
+	u32 PreIdx;		/**< First BD of the pre-work group */
+	u32 HwTailIdx;		/**< Last BD given to hardware */
+	volatile u32 Allocated;	/**< BDs allocated */
+	volatile u32 Committed;	/**< BDs given to hardware */
+
+	/* consumer side */
+	u32 HwIdx;		/**< First BD of the work group */
+	u32 PostIdx;		/**< First BD of the post-work group */
+	volatile u32 Retired;	/**< BDs returned by hardware */
+	volatile u32 Freed;	/**< BDs freed */
+
+	XBdRing_Stats Stats;
+} XBdRing;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**
+ * Advance BD index Idx by Num (at most the ring size) BDs, wrapping at the
+ * end of the ring without a branch.
+ */
+#define XBdRing_IdxAdd(RingPtr, Idx, Num)				\
+	(((Idx) + (Num)) - ((RingPtr)->AllCnt &				\
+	(0U - (u32)(((Idx) + (Num)) >= (RingPtr)->AllCnt))))
+
+/** Move BD index Idx back by Num (at most the ring size) BDs */
+#define XBdRing_IdxSub(RingPtr, Idx, Num)				\
+	XBdRing_IdxAdd((RingPtr), (Idx), (RingPtr)->AllCnt - (Num))
+
+/** Virtual address of the BD at index Idx */
+#define XBdRing_IdxToBd(RingPtr, Idx)					\
+	((RingPtr)->BaseBdAddr + ((UINTPTR)(Idx) * (RingPtr)->Separation))
+
+/** Index of the BD at virtual address BdPtr */
+#define XBdRing_BdToIdx(RingPtr, BdPtr)					\
+	((u32)(((UINTPTR)(BdPtr) - (RingPtr)->BaseBdAddr) /		\
+	(RingPtr)->Separation))
+
+/** Virtual address of the BD following BdPtr */
+#define XBdRing_Next(RingPtr, BdPtr)					\
+	(((UINTPTR)(BdPtr) >= (RingPtr)->HighBdAddr) ?			\
+	(RingPtr)->BaseBdAddr :						\
+	((UINTPTR)(BdPtr) + (RingPtr)->Separation))
+
+/** Virtual address of the BD preceding BdPtr */
+#define XBdRing_Prev(RingPtr, BdPtr)					\
+	(((UINTPTR)(BdPtr) <= (RingPtr)->BaseBdAddr) ?			\
+	(RingPtr)->HighBdAddr :						\
+	((UINTPTR)(BdPtr) - (RingPtr)->Separation))
+
+/** Number of BDs in the ring */
+#define XBdRing_GetCnt(RingPtr)		((RingPtr)->AllCnt)
+
+/** Number of BDs that can be allocated */
+#define XBdRing_GetFreeCnt(RingPtr)					\
+	((RingPtr)->AllCnt - ((RingPtr)->Allocated - (RingPtr)->Freed))
+
+/** Number of BDs allocated but not yet given to hardware */
+#define XBdRing_GetPreCnt(RingPtr)					\
+	((RingPtr)->Allocated - (RingPtr)->Committed)
+
+/** Number of BDs given to hardware and not yet returned */
+#define XBdRing_GetHwCnt(RingPtr)					\
+	((RingPtr)->Committed - (RingPtr)->Retired)
+
+/** Number of BDs returned by hardware and not yet freed */
+#define XBdRing_GetPostCnt(RingPtr)					\
+	((RingPtr)->Retired - (RingPtr)->Freed)
+
+/** First BD of the free, pre-work, work and post-work groups */
+#define XBdRing_GetFreeHead(RingPtr)					\
+	XBdRing_IdxToBd((RingPtr), (RingPtr)->FreeIdx)
+#define XBdRing_GetPreHead(RingPtr)					\
+	XBdRing_IdxToBd((RingPtr), (RingPtr)->PreIdx)
+#define XBdRing_GetHwHead(RingPtr)					\
+	XBdRing_IdxToBd((RingPtr), (RingPtr)->HwIdx)
+#define XBdRing_GetPostHead(RingPtr)					\
+	XBdRing_IdxToBd((RingPtr), (RingPtr)->PostIdx)
+
+/** Last BD given to hardware */
+#define XBdRing_GetHwTail(RingPtr)					\
+	XBdRing_IdxToBd((RingPtr), (RingPtr)->HwTailIdx)
+
+/************************** Function Prototypes ******************************/
+
+s32 XBdRing_Create(XBdRing *RingPtr, UINTPTR BaseBdAddr, u32 Separation,
+		   u32 BdCount, const XBdRing_Ops *Ops, void *Owner, u32 Flags);
+void XBdRing_Reset(XBdRing *RingPtr);
+void XBdRing_Rewind(XBdRing *RingPtr);
+s32 XBdRing_Alloc(XBdRing *RingPtr, u32 NumBd, UINTPTR *BdSetPtr);
+s32 XBdRing_UnAlloc(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr);
+s32 XBdRing_ToHw(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr);
+u32 XBdRing_FromHw(XBdRing *RingPtr, u32 BdLimit, UINTPTR *BdSetPtr);
+s32 XBdRing_Free(XBdRing *RingPtr, u32 NumBd, UINTPTR BdSetPtr);
+void XBdRing_FlushSpan(XBdRing *RingPtr, u32 Idx, u32 NumBd);
+void XBdRing_InvalidateSpan(XBdRing *RingPtr, u32 Idx, u32 NumBd);
+void XBdRing_GetStats(XBdRing *RingPtr, XBdRing_Stats *StatsPtr);
+void XBdRing_ClearStats(XBdRing *RingPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup common_bdring_apis".
+*/
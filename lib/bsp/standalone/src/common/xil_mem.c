@@ -33,8 +33,8 @@
 /**
 * @file xil_mem.c
 *
-* This file contains xil mem copy function to use in case of word aligned
-* data copies.
+* This file contains xil mem copy and set functions to use in case of word
+* aligned data copies.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -42,6 +42,9 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 6.6   ag       10/16/26 Xil_MemCpy copies aligned data with wide loads
+*                         and stores, and can hand large copies to a DMA
+*                         engine. Added Xil_MemSet and Xil_MemRegisterDma.
 *
 * </pre>
 *
@@ -50,8 +53,43 @@
 /***************************** Include Files ********************************/
 
 #include "xil_types.h"
+#include "xil_mem.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * XIL_MEM_BLOCK is the number of bytes moved by one iteration of the bulk
+ * loops, which need source and destination aligned to XIL_MEM_ALIGN.
+ */
+#if defined (__aarch64__)
+#define XIL_MEM_ALIGN	16U
+#define XIL_MEM_BLOCK	64U
+#elif defined (__arm__) && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+#define XIL_MEM_ALIGN	8U
+#define XIL_MEM_BLOCK	64U
+#define XIL_MEM_ARM_NEON
+#else
+#define XIL_MEM_ALIGN	4U
+#define XIL_MEM_BLOCK	32U
+#endif
+
+/* Shorter copies do not pay for the alignment fix-up */
+#define XIL_MEM_BULK_MIN	(2U * XIL_MEM_BLOCK)
+
+/* Alignment of the part handed to a DMA engine, a cache line or more */
+#define XIL_MEM_DMA_ALIGN	64U
+
+/************************** Variable Definitions ****************************/
+
+static const Xil_MemDmaOps *XilMemDmaOps = NULL;
+static u32 XilMemDmaThreshold;
+
+/************************** Function Prototypes *****************************/
+
+static void Xil_MemCpyBlocks(u8 *d, const u8 *s, u32 num);
+static void Xil_MemSetBlocks(u8 *d, u32 val, u32 num);
 
-/***************** Inline Functions Definitions ********************/
 /*****************************************************************************/
 /**
 * @brief       This  function copies memory from once location to other.
@@ -62,11 +100,54 @@
 *
 * @param       cnt: 32 bit length of bytes to be copied
 *
+* @note        When source and destination are aligned alike, the copy
+*              is done with the widest loads and stores of the processor,
+*              all of them naturally aligned. Copies of at least the
+*              threshold given to Xil_MemRegisterDma() are handed to the
+*              registered DMA engine. Otherwise memory is copied a word at
+*              a time.
+*
 *****************************************************************************/
 void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
-	char *d = (char*)(void *)dst;
-	const char *s = src;
+	u8 *d = (u8 *)dst;
+	const u8 *s = (const u8 *)src;
+	u32 num;
+
+	if ((cnt >= XIL_MEM_BULK_MIN) &&
+	    ((((UINTPTR)d ^ (UINTPTR)s) & (XIL_MEM_ALIGN - 1U)) == 0U)) {
+		while (((UINTPTR)d & (XIL_MEM_ALIGN - 1U)) != 0U) {
+			*d = *s;
+			d += 1U;
+			s += 1U;
+			cnt -= 1U;
+		}
+
+		/* the DMA part needs at least one aligned block left */
+		num = (u32)(0U - (UINTPTR)d) & (XIL_MEM_DMA_ALIGN - 1U);
+		if ((XilMemDmaOps != NULL) && (XilMemDmaOps->Copy != NULL) &&
+		    (cnt >= XilMemDmaThreshold) &&
+		    (cnt >= (num + XIL_MEM_DMA_ALIGN))) {
+			Xil_MemCpy(d, s, num);
+			if (XilMemDmaOps->Copy(XilMemDmaOps->CallBackRef,
+					d + num, s + num,
+					(cnt - num) & ~(XIL_MEM_DMA_ALIGN - 1U)) ==
+			    (s32)XST_SUCCESS) {
+				num += (cnt - num) & ~(XIL_MEM_DMA_ALIGN - 1U);
+			}
+			d += num;
+			s += num;
+			cnt -= num;
+		}
+
+		num = cnt / XIL_MEM_BLOCK;
+		if (num != 0U) {
+			Xil_MemCpyBlocks(d, s, num);
+			d += num * XIL_MEM_BLOCK;
+			s += num * XIL_MEM_BLOCK;
+			cnt -= num * XIL_MEM_BLOCK;
+		}
+	}
 
 	while (cnt >= sizeof (int)) {
 		*(int*)d = *(int*)s;
@@ -81,3 +162,230 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 		cnt -= 1U;
 	}
 }
+
+/*****************************************************************************/
+/**
+* @brief       This function fills memory with a byte value.
+*
+* @param       dst: pointer pointing to destination memory
+*
+* @param       val: value to be written, converted to u8
+*
+* @param       cnt: 32 bit length of bytes to be written
+*
+* @note        Memory is written with the widest stores of the processor,
+*              all of them naturally aligned. Fills of at least the
+*              threshold given to Xil_MemRegisterDma() are handed to the
+*              registered DMA engine.
+*
+*****************************************************************************/
+void Xil_MemSet(void* dst, s32 val, u32 cnt)
+{
+	u8 *d = (u8 *)dst;
+	u32 word = ((u32)val & 0xFFU) * 0x01010101U;
+	u32 num;
+
+	if (cnt >= XIL_MEM_BULK_MIN) {
+		while (((UINTPTR)d & (XIL_MEM_ALIGN - 1U)) != 0U) {
+			*d = (u8)word;
+			d += 1U;
+			cnt -= 1U;
+		}
+
+		/* the DMA part needs at least one aligned block left */
+		num = (u32)(0U - (UINTPTR)d) & (XIL_MEM_DMA_ALIGN - 1U);
+		if ((XilMemDmaOps != NULL) && (XilMemDmaOps->Fill != NULL) &&
+		    (cnt >= XilMemDmaThreshold) &&
+		    (cnt >= (num + XIL_MEM_DMA_ALIGN))) {
+			Xil_MemSet(d, val, num);
+			if (XilMemDmaOps->Fill(XilMemDmaOps->CallBackRef,
+					d + num, (u8)word,
+					(cnt - num) & ~(XIL_MEM_DMA_ALIGN - 1U)) ==
+			    (s32)XST_SUCCESS) {
+				num += (cnt - num) & ~(XIL_MEM_DMA_ALIGN - 1U);
+			}
+			d += num;
+			cnt -= num;
+		}
+
+		num = cnt / XIL_MEM_BLOCK;
+		if (num != 0U) {
+			Xil_MemSetBlocks(d, word, num);
+			d += num * XIL_MEM_BLOCK;
+			cnt -= num * XIL_MEM_BLOCK;
+		}
+	}
+
+	while ((cnt >= sizeof (u32)) &&
+	       (((UINTPTR)d & (sizeof (u32) - 1U)) == 0U)) {
+		*(u32 *)d = word;
+		d += sizeof (u32);
+		cnt -= sizeof (u32);
+	}
+	while (cnt > 0U) {
+		*d = (u8)word;
+		d += 1U;
+		cnt -= 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       This function registers a DMA engine that Xil_MemCpy and
+*              Xil_MemSet hand large requests to.
+*
+* @param       Ops: pointer to the DMA operations, or NULL to copy and fill
+*              with the processor only. The structure is used in place and
+*              must stay valid while registered.
+*
+* @note        The threshold is read here and raised to 64 bytes if it is
+*              lower. The operations get a destination aligned to 64 bytes
+*              and a non zero length that is a multiple of 64 bytes. They
+*              are responsible for any cache maintenance, and must only
+*              return XST_SUCCESS once the data is in place. On any other
+*              return the processor does the work instead.
+*
+*****************************************************************************/
+void Xil_MemRegisterDma(const Xil_MemDmaOps *Ops)
+{
+	if ((Ops != NULL) && (Ops->Threshold > XIL_MEM_DMA_ALIGN)) {
+		XilMemDmaThreshold = Ops->Threshold;
+	} else {
+		XilMemDmaThreshold = XIL_MEM_DMA_ALIGN;
+	}
+	XilMemDmaOps = Ops;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copy num blocks of XIL_MEM_BLOCK bytes between XIL_MEM_ALIGN aligned
+* buffers.
+*
+*****************************************************************************/
+static void Xil_MemCpyBlocks(u8 *d, const u8 *s, u32 num)
+{
+#if defined (__aarch64__)
+	__asm__ __volatile__(
+		"1:	ldp	q0, q1, [%1], #32\n"
+		"	ldp	q2, q3, [%1], #32\n"
+		"	subs	%w2, %w2, #1\n"
+		"	stp	q0, q1, [%0], #32\n"
+		"	stp	q2, q3, [%0], #32\n"
+		"	b.ne	1b\n"
+		: "+r" (d), "+r" (s), "+r" (num)
+		:
+		: "v0", "v1", "v2", "v3", "cc", "memory");
+#elif defined (XIL_MEM_ARM_NEON)
+	__asm__ __volatile__(
+		"1:	vld1.64	{d0-d3}, [%1]!\n"
+		"	vld1.64	{d4-d7}, [%1]!\n"
+		"	subs	%2, %2, #1\n"
+		"	vst1.64	{d0-d3}, [%0]!\n"
+		"	vst1.64	{d4-d7}, [%0]!\n"
+		"	bne	1b\n"
+		: "+r" (d), "+r" (s), "+r" (num)
+		:
+		: "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7", "cc",
+		  "memory");
+#elif defined (__arm__)
+	__asm__ __volatile__(
+		"1:	ldmia	%1!, {r3-r6}\n"
+		"	stmia	%0!, {r3-r6}\n"
+		"	ldmia	%1!, {r3-r6}\n"
+		"	subs	%2, %2, #1\n"
+		"	stmia	%0!, {r3-r6}\n"
+		"	bne	1b\n"
+		: "+r" (d), "+r" (s), "+r" (num)
+		:
+		: "r3", "r4", "r5", "r6", "cc", "memory");
+#else
+	u32 *dw = (u32 *)(void *)d;
+	const u32 *sw = (const u32 *)(const void *)s;
+	u32 w0, w1, w2, w3;
+
+	do {
+		/* Loads grouped ahead of the stores hide the load latency */
+		w0 = sw[0];
+		w1 = sw[1];
+		w2 = sw[2];
+		w3 = sw[3];
+		dw[0] = w0;
+		dw[1] = w1;
+		dw[2] = w2;
+		dw[3] = w3;
+		w0 = sw[4];
+		w1 = sw[5];
+		w2 = sw[6];
+		w3 = sw[7];
+		dw[4] = w0;
+		dw[5] = w1;
+		dw[6] = w2;
+		dw[7] = w3;
+		dw += 8U;
+		sw += 8U;
+		num -= 1U;
+	} while (num != 0U);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Fill num blocks of XIL_MEM_BLOCK bytes from an XIL_MEM_ALIGN aligned
+* address with the 32 bit value val.
+*
+*****************************************************************************/
+static void Xil_MemSetBlocks(u8 *d, u32 val, u32 num)
+{
+#if defined (__aarch64__)
+	__asm__ __volatile__(
+		"	dup	v0.4s, %w2\n"
+		"1:	stp	q0, q0, [%0], #32\n"
+		"	subs	%w1, %w1, #1\n"
+		"	stp	q0, q0, [%0], #32\n"
+		"	b.ne	1b\n"
+		: "+r" (d), "+r" (num)
+		: "r" (val)
+		: "v0", "cc", "memory");
+#elif defined (XIL_MEM_ARM_NEON)
+	__asm__ __volatile__(
+		"	vdup.32	q0, %2\n"
+		"	vmov	q1, q0\n"
+		"1:	vst1.64	{d0-d3}, [%0]!\n"
+		"	subs	%1, %1, #1\n"
+		"	vst1.64	{d0-d3}, [%0]!\n"
+		"	bne	1b\n"
+		: "+r" (d), "+r" (num)
+		: "r" (val)
+		: "d0", "d1", "d2", "d3", "cc", "memory");
+#elif defined (__arm__)
+	__asm__ __volatile__(
+		"	mov	r3, %2\n"
+		"	mov	r4, %2\n"
+		"	mov	r5, %2\n"
+		"	mov	r6, %2\n"
+		"1:	stmia	%0!, {r3-r6}\n"
+		"	subs	%1, %1, #1\n"
+		"	stmia	%0!, {r3-r6}\n"
+		"	bne	1b\n"
+		: "+r" (d), "+r" (num)
+		: "r" (val)
+		: "r3", "r4", "r5", "r6", "cc", "memory");
+#else
+	u32 *dw = (u32 *)(void *)d;
+
+	do {
+		dw[0] = val;
+		dw[1] = val;
+		dw[2] = val;
+		dw[3] = val;
+		dw[4] = val;
+		dw[5] = val;
+		dw[6] = val;
+		dw[7] = val;
+		dw += 8U;
+		num -= 1U;
+	} while (num != 0U);
+#endif
+}
@@ -46,14 +46,51 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 6.6   ag       10/16/26 Added Xil_MemSet, and Xil_MemRegisterDma to offload
+*                         large copies and fills to a DMA engine.
 *
 * </pre>
 *
 *****************************************************************************/
 
+#ifndef XIL_MEM_H		/* prevent circular inclusions */
+#define XIL_MEM_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * DMA engine operations for Xil_MemCpy and Xil_MemSet, registered with
+ * Xil_MemRegisterDma. Each returns XST_SUCCESS once the data is in place.
+ */
+typedef struct {
+	/** Copy Cnt bytes from Src to Dst */
+	s32 (*Copy)(void *CallBackRef, void *Dst, const void *Src, u32 Cnt);
+	/** Optional, fill Cnt bytes at Dst with Val */
+	s32 (*Fill)(void *CallBackRef, void *Dst, u8 Val, u32 Cnt);
+	void *CallBackRef;	/**< First argument of the operations */
+	u32 Threshold;		/**< Smallest request in bytes to offload,
+				     raised to 64 if lower */
+} Xil_MemDmaOps;
+
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemSet(void* dst, s32 val, u32 cnt);
+void Xil_MemRegisterDma(const Xil_MemDmaOps *Ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
 /**
 * @} End of "addtogroup common_mem_operation_api".
 */
\ No newline at end of file
@@ -0,0 +1,577 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_perf.c
+*
+* This file contains the performance counter APIs. See xil_perf.h for an
+* overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_perf.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#if defined (__MICROBLAZE__)
+#include "mb_interface.h"
+#else
+#include "xpseudo_asm.h"
+#endif
+#if defined (__aarch64__)
+#include "bspconfig.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#if defined (__aarch64__) || defined (__arm__)
+#define XIL_PERF_HAS_PMU
+#endif
+
+#define XIL_PERF_PMCR_E		0x00000001U	/* Enable all counters */
+#define XIL_PERF_PMCR_D		0x00000008U	/* Cycle counter divides by 64 */
+#define XIL_PERF_PMCR_LC	0x00000040U	/* 64 bit cycle counter */
+#define XIL_PERF_PMCR_N_SHIFT	11U		/* Number of event counters */
+#define XIL_PERF_PMCR_N_MASK	0x1FU
+#define XIL_PERF_CNTEN_C	0x80000000U	/* Cycle counter enable */
+#define XIL_PERF_MDCR_SPME	0x00020000U	/* Count in Secure state */
+
+#define XIL_PERF_IRQ_FIQ_MASK	0xC0U	/* Mask IRQ and FIQ interrupts */
+#define XIL_PERF_MSR_IE		0x00000002U	/* MicroBlaze interrupt enable */
+
+/**************************** Type Definitions *******************************/
+
+/* An open region */
+typedef struct {
+	Xil_PerfRegion *Region;
+	Xil_PerfSample Start;
+	u64 ChildCycles;	/* Cycles of regions nested in this one */
+} Xil_PerfFrame;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Begin and End run with interrupts masked, which makes a region begun in
+ * an interrupt handler nest properly in the region it preempts.
+ */
+#if defined (__MICROBLAZE__)
+#define XIL_PERF_LOCK(Mask)						\
+	{ (Mask) = mfmsr(); mtmsr((Mask) & ~XIL_PERF_MSR_IE); }
+#define XIL_PERF_UNLOCK(Mask)	mtmsr(Mask)
+#else
+#define XIL_PERF_LOCK(Mask)						\
+	{ (Mask) = mfcpsr(); mtcpsr((Mask) | XIL_PERF_IRQ_FIQ_MASK); }
+#define XIL_PERF_UNLOCK(Mask)	mtcpsr(Mask)
+#endif
+
+#if defined (__arm__) && defined (__ICCARM__)
+#define XIL_PERF_MFCP(Reg, Val)	mfcp(Reg, Val)
+#elif defined (__arm__)
+#define XIL_PERF_MFCP(Reg, Val)	((Val) = mfcp(Reg))
+#endif
+
+/************************** Variable Definitions *****************************/
+
+static Xil_PerfRegion XilPerfRegions[XIL_PERF_MAX_REGIONS];
+static u32 XilPerfNumRegions;
+static Xil_PerfFrame XilPerfStack[XIL_PERF_MAX_DEPTH];
+static u32 XilPerfDepth;
+static u32 XilPerfEventIds[XIL_PERF_MAX_EVENTS];
+static u32 XilPerfNumEvents;
+static u32 XilPerfUnbalanced;	/* End calls that did not match a Begin */
+static u32 XilPerfDropped;	/* Calls past XIL_PERF_MAX_DEPTH */
+static u64 (*XilPerfClock)(void);
+#if defined (__aarch64__)
+static u64 XilPerfCycleMask = ~(u64)0U;
+#else
+static u64 XilPerfCycleMask = 0xFFFFFFFFU;
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static u32 Xil_PerfReadCounter(u32 Counter);
+static void Xil_PerfU64ToStr(u64 Value, char8 *Str);
+
+/*****************************************************************************/
+/**
+* @brief    This function programs the event counters and enables them,
+*           together with the cycle counter.
+*
+* @param    Events: array of NumEvents event numbers, XIL_PERF_EV_* or any
+*           event number listed in the technical reference manual of the
+*           processor.
+*
+* @param    NumEvents: number of events, at most XIL_PERF_MAX_EVENTS and the
+*           number of event counters of the processor.
+*
+* @return   - XST_SUCCESS if the counters are programmed.
+*           - XST_INVALID_PARAM if there are more events than counters.
+*
+* @note     The accumulated counts of all regions are cleared, as they no
+*           longer match the events. Must not be called with regions open.
+*
+*****************************************************************************/
+s32 Xil_PerfInit(const u32 *Events, u32 NumEvents)
+{
+	u32 Index;
+	u32 Reg;
+
+	if ((NumEvents > XIL_PERF_MAX_EVENTS) ||
+	    (NumEvents > Xil_PerfGetNumCounters()) ||
+	    ((NumEvents != 0U) && (Events == NULL))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	for (Index = 0U; Index < NumEvents; Index++) {
+		XilPerfEventIds[Index] = Events[Index];
+	}
+	XilPerfNumEvents = NumEvents;
+
+#if defined (__aarch64__)
+#if EL3==1
+	/* Secure state is only counted with MDCR_EL3.SPME set */
+	mtcp(MDCR_EL3, mfcp(MDCR_EL3) | XIL_PERF_MDCR_SPME);
+#endif
+	for (Index = 0U; Index < NumEvents; Index++) {
+		mtcp(PMSELR_EL0, (u64)Index);
+		isb();
+		/* Filter bits left clear, every exception level counts */
+		mtcp(PMXEVTYPER_EL0, (u64)XilPerfEventIds[Index]);
+	}
+	mtcp(PMCCFILTR_EL0, 0U);
+	Reg = (u32)mfcp(PMCR_EL0);
+	Reg = (Reg | XIL_PERF_PMCR_E | XIL_PERF_PMCR_LC) & ~XIL_PERF_PMCR_D;
+	mtcp(PMCR_EL0, (u64)Reg);
+	mtcp(PMCNTENSET_EL0,
+	     (u64)(XIL_PERF_CNTEN_C | ((1U << NumEvents) - 1U)));
+	isb();
+#elif defined (__arm__)
+	for (Index = 0U; Index < NumEvents; Index++) {
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, Index);
+		isb();
+		mtcp(XREG_CP15_EVENT_TYPE_SEL, XilPerfEventIds[Index]);
+	}
+	XIL_PERF_MFCP(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	Reg = (Reg | XIL_PERF_PMCR_E) & ~XIL_PERF_PMCR_D;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET,
+	     XIL_PERF_CNTEN_C | ((1U << NumEvents) - 1U));
+	isb();
+#else
+	(void)Reg;
+#endif
+
+	Xil_PerfReset();
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function returns the number of event counters of the
+*           processor.
+*
+* @return   Number of event counters, 0 on a processor without a performance
+*           monitor accessible to software.
+*
+*****************************************************************************/
+u32 Xil_PerfGetNumCounters(void)
+{
+	u32 Reg = 0U;
+
+#if defined (__aarch64__)
+	Reg = (u32)mfcp(PMCR_EL0);
+#elif defined (__arm__)
+	XIL_PERF_MFCP(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+#endif
+
+	return (Reg >> XIL_PERF_PMCR_N_SHIFT) & XIL_PERF_PMCR_N_MASK;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function registers a clock that regions use in place of
+*           the cycle counter.
+*
+* @param    ClockFn: function returning a free running 64 bit count, or NULL
+*           to use the cycle counter of the processor.
+*
+* @note     Must not be called with regions open.
+*
+*****************************************************************************/
+void Xil_PerfSetClock(u64 (*ClockFn)(void))
+{
+	XilPerfClock = ClockFn;
+#if defined (__aarch64__)
+	XilPerfCycleMask = ~(u64)0U;
+#else
+	XilPerfCycleMask = (ClockFn != NULL) ? ~(u64)0U : 0xFFFFFFFFU;
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function returns the region of a name, creating it on first
+*           use.
+*
+* @param    Name: region name. The string is referenced, not copied.
+*
+* @return   Pointer to the region, or NULL if XIL_PERF_MAX_REGIONS regions
+*           already exist.
+*
+* @note     Regions are searched by name, so the pointer is best looked up
+*           once and kept, rather than looked up on every Begin.
+*
+*****************************************************************************/
+Xil_PerfRegion *Xil_PerfRegionGet(const char *Name)
+{
+	Xil_PerfRegion *Region = NULL;
+	u32 Index;
+	u32 Char;
+
+	for (Index = 0U; Index < XilPerfNumRegions; Index++) {
+		Char = 0U;
+		while ((Name[Char] != '\0') &&
+		       (Name[Char] == XilPerfRegions[Index].Name[Char])) {
+			Char++;
+		}
+		if (Name[Char] == XilPerfRegions[Index].Name[Char]) {
+			Region = &XilPerfRegions[Index];
+			break;
+		}
+	}
+
+	if ((Region == NULL) && (XilPerfNumRegions < XIL_PERF_MAX_REGIONS)) {
+		Region = &XilPerfRegions[XilPerfNumRegions];
+		Region->Name = Name;
+		XilPerfNumRegions++;
+	}
+
+	return Region;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function opens a region.
+*
+* @param    Region: region returned by Xil_PerfRegionGet(). NULL is ignored,
+*           so a failed lookup needs no check at the call site.
+*
+* @note     Regions opened past XIL_PERF_MAX_DEPTH are not measured.
+*
+*****************************************************************************/
+void Xil_PerfBegin(Xil_PerfRegion *Region)
+{
+	Xil_PerfFrame *Frame;
+	u32 Mask;
+
+	if (Region == NULL) {
+		return;
+	}
+
+	XIL_PERF_LOCK(Mask);
+	if (XilPerfDepth < XIL_PERF_MAX_DEPTH) {
+		Frame = &XilPerfStack[XilPerfDepth];
+		Frame->Region = Region;
+		Frame->ChildCycles = 0U;
+		Xil_PerfSnapshot(&Frame->Start);
+	} else {
+		XilPerfDropped++;
+	}
+	XilPerfDepth++;
+	XIL_PERF_UNLOCK(Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function closes a region and adds its counts.
+*
+* @param    Region: region given to the matching Xil_PerfBegin(). NULL is
+*           ignored.
+*
+* @note     If Region is not the innermost open region, the regions opened
+*           after it are discarded. If it is not open at all the call only
+*           counts as unbalanced. Both show in Xil_PerfDump().
+*
+*****************************************************************************/
+void Xil_PerfEnd(Xil_PerfRegion *Region)
+{
+	Xil_PerfSample End;
+	Xil_PerfFrame *Frame;
+	u64 Elapsed;
+	u32 Depth;
+	u32 Index;
+	u32 Mask;
+
+	if (Region == NULL) {
+		return;
+	}
+
+	XIL_PERF_LOCK(Mask);
+	Xil_PerfSnapshot(&End);
+
+	if (XilPerfDepth > XIL_PERF_MAX_DEPTH) {
+		/* Begin was past the stack, nothing to account */
+		XilPerfDepth--;
+		XIL_PERF_UNLOCK(Mask);
+		return;
+	}
+
+	Depth = XilPerfDepth;
+	while ((Depth > 0U) && (XilPerfStack[Depth - 1U].Region != Region)) {
+		Depth--;
+	}
+	if (Depth == 0U) {
+		XilPerfUnbalanced++;
+		XIL_PERF_UNLOCK(Mask);
+		return;
+	}
+	if (Depth != XilPerfDepth) {
+		XilPerfUnbalanced++;
+	}
+	Depth--;
+	Frame = &XilPerfStack[Depth];
+
+	Elapsed = (End.Cycles - Frame->Start.Cycles) & XilPerfCycleMask;
+	Region->Calls++;
+	Region->Cycles += Elapsed;
+	Region->SelfCycles += Elapsed - Frame->ChildCycles;
+	if (Elapsed > Region->MaxCycles) {
+		Region->MaxCycles = Elapsed;
+	}
+	for (Index = 0U; Index < XilPerfNumEvents; Index++) {
+		Region->Events[Index] +=
+			(u64)(End.Events[Index] - Frame->Start.Events[Index]);
+	}
+
+	if (Depth > 0U) {
+		XilPerfStack[Depth - 1U].ChildCycles += Elapsed;
+	}
+	XilPerfDepth = Depth;
+	XIL_PERF_UNLOCK(Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function reads the cycle counter, or the registered clock,
+*           and the event counters programmed by Xil_PerfInit().
+*
+* @param    Sample: pointer to the sample to fill.
+*
+* @note     Event counters are 32 bit wide, as is the cycle counter on
+*           32 bit processors; differences of samples are taken modulo
+*           the counter width.
+*
+*****************************************************************************/
+void Xil_PerfSnapshot(Xil_PerfSample *Sample)
+{
+	u32 Index;
+
+	if (XilPerfClock != NULL) {
+		Sample->Cycles = XilPerfClock();
+	} else {
+#if defined (__aarch64__)
+		Sample->Cycles = mfcp(PMCCNTR_EL0);
+#elif defined (__arm__)
+		u32 Reg;
+
+		XIL_PERF_MFCP(XREG_CP15_PERF_CYCLE_COUNTER, Reg);
+		Sample->Cycles = Reg;
+#else
+		Sample->Cycles = 0U;
+#endif
+	}
+
+	for (Index = 0U; Index < XilPerfNumEvents; Index++) {
+		Sample->Events[Index] = Xil_PerfReadCounter(Index);
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function clears the counts of all regions and closes all
+*           open regions.
+*
+*****************************************************************************/
+void Xil_PerfReset(void)
+{
+	Xil_PerfRegion *Region;
+	u32 Index;
+	u32 Event;
+	u32 Mask;
+
+	XIL_PERF_LOCK(Mask);
+	for (Index = 0U; Index < XilPerfNumRegions; Index++) {
+		Region = &XilPerfRegions[Index];
+		Region->Calls = 0U;
+		Region->Cycles = 0U;
+		Region->SelfCycles = 0U;
+		Region->MaxCycles = 0U;
+		for (Event = 0U; Event < XIL_PERF_MAX_EVENTS; Event++) {
+			Region->Events[Event] = 0U;
+		}
+	}
+	XilPerfDepth = 0U;
+	XilPerfUnbalanced = 0U;
+	XilPerfDropped = 0U;
+	XIL_PERF_UNLOCK(Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function prints a table of the regions with xil_printf.
+*           A row holds the calls, the total, own and longest cycles and
+*           the event totals of one region; columns of events are headed by
+*           the event number.
+*
+* @note     The counts are read without stopping the measurement, so a
+*           region closed during the dump may show partly updated.
+*
+*****************************************************************************/
+void Xil_PerfDump(void)
+{
+	Xil_PerfRegion *Region;
+	char8 Str[24];
+	u32 Index;
+	u32 Event;
+
+	xil_printf("%-16s %10s %14s %14s %12s", "region", "calls", "cycles",
+		   "self", "max");
+	for (Event = 0U; Event < XilPerfNumEvents; Event++) {
+		xil_printf("      ev 0x%02x", XilPerfEventIds[Event]);
+	}
+	xil_printf("\r\n");
+
+	for (Index = 0U; Index < XilPerfNumRegions; Index++) {
+		Region = &XilPerfRegions[Index];
+		xil_printf("%-16s %10u", Region->Name, Region->Calls);
+		Xil_PerfU64ToStr(Region->Cycles, Str);
+		xil_printf(" %14s", Str);
+		Xil_PerfU64ToStr(Region->SelfCycles, Str);
+		xil_printf(" %14s", Str);
+		Xil_PerfU64ToStr(Region->MaxCycles, Str);
+		xil_printf(" %12s", Str);
+		for (Event = 0U; Event < XilPerfNumEvents; Event++) {
+			Xil_PerfU64ToStr(Region->Events[Event], Str);
+			xil_printf(" %13s", Str);
+		}
+		xil_printf("\r\n");
+	}
+
+	if ((XilPerfUnbalanced != 0U) || (XilPerfDropped != 0U)) {
+		xil_printf("unbalanced %u, past depth %u\r\n",
+			   XilPerfUnbalanced, XilPerfDropped);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Read event counter Counter. AArch64 has a register per counter, so no
+* selection and synchronization is needed.
+*
+*****************************************************************************/
+static u32 Xil_PerfReadCounter(u32 Counter)
+{
+	u32 Value = 0U;
+
+#if defined (__aarch64__)
+	switch (Counter) {
+	case 0U:
+		Value = (u32)mfcp(PMEVCNTR0_EL0);
+		break;
+	case 1U:
+		Value = (u32)mfcp(PMEVCNTR1_EL0);
+		break;
+	case 2U:
+		Value = (u32)mfcp(PMEVCNTR2_EL0);
+		break;
+	case 3U:
+		Value = (u32)mfcp(PMEVCNTR3_EL0);
+		break;
+	case 4U:
+		Value = (u32)mfcp(PMEVCNTR4_EL0);
+		break;
+	case 5U:
+		Value = (u32)mfcp(PMEVCNTR5_EL0);
+		break;
+	default:
+		mtcp(PMSELR_EL0, (u64)Counter);
+		isb();
+		Value = (u32)mfcp(PMXEVCNTR_EL0);
+		break;
+	}
+#elif defined (__arm__)
+	mtcp(XREG_CP15_EVENT_CNTR_SEL, Counter);
+	isb();
+	XIL_PERF_MFCP(XREG_CP15_PERF_MONITOR_COUNT, Value);
+#else
+	(void)Counter;
+#endif
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* Convert Value to decimal, as xil_printf has no 64 bit conversion on 32 bit
+* processors. Str must hold 21 characters.
+*
+*****************************************************************************/
+static void Xil_PerfU64ToStr(u64 Value, char8 *Str)
+{
+	char8 Digits[20];
+	u32 Num = 0U;
+	u32 Index;
+
+	do {
+		Digits[Num] = (char8)('0' + (s32)(Value % 10U));
+		Value /= 10U;
+		Num++;
+	} while (Value != 0U);
+
+	for (Index = 0U; Index < Num; Index++) {
+		Str[Index] = Digits[Num - 1U - Index];
+	}
+	Str[Num] = '\0';
+}
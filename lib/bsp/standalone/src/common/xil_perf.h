@@ -0,0 +1,202 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_perf.h
+*
+* @addtogroup common_perf_apis Performance Counter APIs
+*
+* The xil_perf.h file contains a processor independent interface to the
+* performance monitor unit (PMU). It programs any event the PMU of the
+* processor can count and accumulates the counts, together with the cycle
+* count, over named code regions.
+*
+* A region is looked up once with Xil_PerfRegionGet() and then measured by
+* bracketing the code with Xil_PerfBegin() and Xil_PerfEnd(). Regions nest:
+* the open regions are kept on a stack, so a region begun in an interrupt
+* handler that preempts another region is accounted correctly. Each region
+* keeps its inclusive counts and, for the cycles, also the count without
+* the regions nested in it. Xil_PerfDump() prints a table of all regions
+* with xil_printf.
+*
+* <pre>
+*	static Xil_PerfRegion *IsrRegion;
+*	const u32 Events[] = { XIL_PERF_EV_L1D_CACHE_REFILL,
+*			       XIL_PERF_EV_BR_MIS_PRED };
+*
+*	Xil_PerfInit(Events, 2U);
+*	IsrRegion = Xil_PerfRegionGet("emac_isr");
+*	...
+*	Xil_PerfBegin(IsrRegion);
+*	... code to measure ...
+*	Xil_PerfEnd(IsrRegion);
+*	...
+*	Xil_PerfDump();
+* </pre>
+*
+* The event counters are used on the Cortex-A53 (PMUv3, AArch64 and AArch32),
+* Cortex-A9 and Cortex-R5, where event numbers are the architectural and
+* implementation defined numbers of the processor technical reference manual.
+* The counters are never reset, only read, so the cycle counter stays usable
+* by other code. Xil_PerfInit() takes over the event counters, it must not
+* be mixed with the Xpm_* APIs of xpm_counter.h. While the sampling profiler
+* of xil_prof.h runs with its PMU source, it owns the last event counter, so
+* Xil_PerfInit() must then be given at most one event fewer than
+* Xil_PerfGetNumCounters() returns.
+*
+* The MicroBlaze performance monitor is only accessible through the debug
+* module, so on MicroBlaze regions count calls and the cycles of a clock
+* registered with Xil_PerfSetClock(), typically an AXI timer. A registered
+* clock takes the place of the cycle counter on any processor.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+*      ag   10/16/26 Documented the use along with the xil_prof PMU source.
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_PERF_H	/* prevent circular inclusions */
+#define XIL_PERF_H	/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+/**
+ * @name Sizes, may be overridden at compile time
+ * @{
+ */
+#ifndef XIL_PERF_MAX_EVENTS
+#define XIL_PERF_MAX_EVENTS	6U	/**< Events counted at a time */
+#endif
+#ifndef XIL_PERF_MAX_REGIONS
+#define XIL_PERF_MAX_REGIONS	16U	/**< Regions that can be created */
+#endif
+#ifndef XIL_PERF_MAX_DEPTH
+#define XIL_PERF_MAX_DEPTH	8U	/**< Regions open at a time */
+#endif
+/*@}*/
+
+/**
+ * @name Common architectural event numbers, ARMv7 and ARMv8
+ * @{
+ */
+#define XIL_PERF_EV_SW_INCR		0x00U /**< Software increment */
+#define XIL_PERF_EV_L1I_CACHE_REFILL	0x01U /**< L1 I cache refill */
+#define XIL_PERF_EV_L1I_TLB_REFILL	0x02U /**< I TLB refill */
+#define XIL_PERF_EV_L1D_CACHE_REFILL	0x03U /**< L1 D cache refill */
+#define XIL_PERF_EV_L1D_CACHE		0x04U /**< L1 D cache access */
+#define XIL_PERF_EV_L1D_TLB_REFILL	0x05U /**< D TLB refill */
+#define XIL_PERF_EV_LD_RETIRED		0x06U /**< Loads executed */
+#define XIL_PERF_EV_ST_RETIRED		0x07U /**< Stores executed */
+#define XIL_PERF_EV_INST_RETIRED	0x08U /**< Instructions executed */
+#define XIL_PERF_EV_EXC_TAKEN		0x09U /**< Exceptions taken */
+#define XIL_PERF_EV_EXC_RETURN		0x0AU /**< Exception returns */
+#define XIL_PERF_EV_PC_WRITE_RETIRED	0x0CU /**< Software changes of PC */
+#define XIL_PERF_EV_BR_IMMED_RETIRED	0x0DU /**< Immediate branches */
+#define XIL_PERF_EV_UNALIGNED_LDST	0x0FU /**< Unaligned accesses */
+#define XIL_PERF_EV_BR_MIS_PRED		0x10U /**< Mispredicted branches */
+#define XIL_PERF_EV_CPU_CYCLES		0x11U /**< Cycles */
+#define XIL_PERF_EV_BR_PRED		0x12U /**< Predictable branches */
+/*@}*/
+
+/**
+ * @name ARMv8 (Cortex-A53) architectural event numbers
+ * @{
+ */
+#define XIL_PERF_EV_MEM_ACCESS		0x13U /**< Data memory access */
+#define XIL_PERF_EV_L1I_CACHE		0x14U /**< L1 I cache access */
+#define XIL_PERF_EV_L1D_CACHE_WB	0x15U /**< L1 D cache write-back */
+#define XIL_PERF_EV_L2D_CACHE		0x16U /**< L2 cache access */
+#define XIL_PERF_EV_L2D_CACHE_REFILL	0x17U /**< L2 cache refill */
+#define XIL_PERF_EV_L2D_CACHE_WB	0x18U /**< L2 cache write-back */
+#define XIL_PERF_EV_BUS_ACCESS		0x19U /**< Bus access */
+#define XIL_PERF_EV_MEMORY_ERROR	0x1AU /**< Local memory error */
+#define XIL_PERF_EV_BUS_CYCLES		0x1DU /**< Bus cycles */
+/*@}*/
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Counts accumulated over a region. Events[] follows the order of the events
+ * given to Xil_PerfInit().
+ */
+typedef struct {
+	const char *Name;		/**< Region name */
+	u32 Calls;			/**< Completed Begin/End pairs */
+	u64 Cycles;			/**< Cycles, inclusive */
+	u64 SelfCycles;			/**< Cycles without nested regions */
+	u64 MaxCycles;			/**< Longest single call */
+	u64 Events[XIL_PERF_MAX_EVENTS];	/**< Event counts, inclusive */
+} Xil_PerfRegion;
+
+/**
+ * Raw counter values, as read by Xil_PerfSnapshot()
+ */
+typedef struct {
+	u64 Cycles;			/**< Cycle counter or registered clock */
+	u32 Events[XIL_PERF_MAX_EVENTS];	/**< Event counters */
+} Xil_PerfSample;
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_PerfInit(const u32 *Events, u32 NumEvents);
+u32 Xil_PerfGetNumCounters(void);
+void Xil_PerfSetClock(u64 (*ClockFn)(void));
+Xil_PerfRegion *Xil_PerfRegionGet(const char *Name);
+void Xil_PerfBegin(Xil_PerfRegion *Region);
+void Xil_PerfEnd(Xil_PerfRegion *Region);
+void Xil_PerfSnapshot(Xil_PerfSample *Sample);
+void Xil_PerfReset(void);
+void Xil_PerfDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup common_perf_apis".
+*/
@@ -0,0 +1,365 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_trace.c
+*
+* This file contains the trace ring. See xil_trace.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_trace.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#if defined (__MICROBLAZE__)
+#include "mb_interface.h"
+#else
+#include "xpseudo_asm.h"
+#include "xtime_l.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_TRACE_MIN_ENTRIES	2U
+
+#if defined (ARMR5)
+#define XIL_TRACE_TIME_BITS	32U
+#ifndef SLEEP_TIMER_BASEADDR
+/* No TTC, the cycle counter is the clock */
+#define XIL_TRACE_CYCLE_CLOCK
+#define XIL_TRACE_PMCR_E	0x00000001U
+#define XIL_TRACE_PMCR_D	0x00000008U
+#define XIL_TRACE_CNTEN_C	0x80000000U
+#endif
+#else
+#define XIL_TRACE_TIME_BITS	64U
+#endif
+
+#define XIL_TRACE_MSR_IE	0x00000002U	/* MicroBlaze interrupt enable */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#if defined (__arm__) && defined (__ICCARM__)
+#define XIL_TRACE_MFCP(Reg, Val)	mfcp(Reg, Val)
+#elif defined (__arm__)
+#define XIL_TRACE_MFCP(Reg, Val)	((Val) = mfcp(Reg))
+#endif
+
+/************************** Variable Definitions *****************************/
+
+static Xil_TraceRing *XilTraceRing;
+static u64 (*XilTraceClock)(void);
+
+/************************** Function Prototypes ******************************/
+
+static u64 Xil_TraceTime(void);
+
+/*****************************************************************************/
+/**
+* @brief    This function sets up a trace ring in memory. Recording starts
+*           with Xil_TraceStart().
+*
+* @param    Mem: ring memory, aligned to 8 bytes.
+*
+* @param    Size: size of the ring memory in bytes. The ring holds the
+*           largest power of two entries that fits after the header.
+*
+* @return   - XST_SUCCESS if the ring is set up.
+*           - XST_INVALID_PARAM if the memory is misaligned or too small.
+*
+*****************************************************************************/
+s32 Xil_TraceInit(void *Mem, u32 Size)
+{
+	Xil_TraceRing *Ring = (Xil_TraceRing *)Mem;
+	u32 Num;
+	u32 Reg = 0U;
+
+	if ((Mem == NULL) || (((UINTPTR)Mem & 7U) != 0U) ||
+	    (Size < (sizeof(Xil_TraceRing) +
+		     (XIL_TRACE_MIN_ENTRIES * sizeof(Xil_TraceEntry))))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	Num = (Size - (u32)sizeof(Xil_TraceRing)) / (u32)sizeof(Xil_TraceEntry);
+	while ((Num & (Num - 1U)) != 0U) {
+		Num &= Num - 1U;
+	}
+
+	XilTraceRing = NULL;
+
+#if defined (__aarch64__)
+	Reg = (u32)mfcp(MPIDR_EL1);
+#elif defined (__arm__)
+	XIL_TRACE_MFCP(XREG_CP15_MULTI_PROC_AFFINITY, Reg);
+#endif
+#if defined (XIL_TRACE_CYCLE_CLOCK)
+	{
+		u32 Pmcr;
+
+		XIL_TRACE_MFCP(XREG_CP15_PERF_MONITOR_CTRL, Pmcr);
+		mtcp(XREG_CP15_PERF_MONITOR_CTRL,
+		     (Pmcr | XIL_TRACE_PMCR_E) & ~XIL_TRACE_PMCR_D);
+		mtcp(XREG_CP15_COUNT_ENABLE_SET, XIL_TRACE_CNTEN_C);
+	}
+#endif
+
+	Ring->Magic = XIL_TRACE_MAGIC;
+	Ring->Version = (u16)XIL_TRACE_VERSION;
+	Ring->Cpu = (u8)(Reg & 0xFFU);
+	Ring->Mask = Num - 1U;
+	Ring->Head = 0U;
+	Ring->Enabled = 0U;
+	Ring->Reserved = 0U;
+	if (XilTraceClock == NULL) {
+		Ring->TimeBits = (u8)XIL_TRACE_TIME_BITS;
+#if defined (XIL_TRACE_CYCLE_CLOCK)
+		Ring->TicksPerSec = XPAR_CPU_CORTEXR5_0_CPU_CLK_FREQ_HZ;
+#elif defined (COUNTS_PER_SECOND)
+		Ring->TicksPerSec = COUNTS_PER_SECOND;
+#else
+		Ring->TicksPerSec = 0U;
+#endif
+	}
+
+	XilTraceRing = Ring;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function registers the clock that timestamps events in
+*           place of the processor timer.
+*
+* @param    ClockFn: function returning a free running 64 bit count, or NULL
+*           for the processor timer.
+*
+* @param    TicksPerSec: rate of the clock, or 0 if unknown, in which case
+*           the host tool shows ticks as microseconds.
+*
+* @note     Call before Xil_TraceInit(), or with recording stopped.
+*
+*****************************************************************************/
+void Xil_TraceSetClock(u64 (*ClockFn)(void), u64 TicksPerSec)
+{
+	XilTraceClock = ClockFn;
+	if (XilTraceRing != NULL) {
+		XilTraceRing->TimeBits = (u8)((ClockFn != NULL) ?
+					      64U : XIL_TRACE_TIME_BITS);
+		XilTraceRing->TicksPerSec = TicksPerSec;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function starts recording events.
+*
+*****************************************************************************/
+void Xil_TraceStart(void)
+{
+	if (XilTraceRing != NULL) {
+		XilTraceRing->Enabled = 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function stops recording events and writes the ring back
+*           to memory, for the debugger to read.
+*
+*****************************************************************************/
+void Xil_TraceStop(void)
+{
+	Xil_TraceRing *Ring = XilTraceRing;
+
+	if (Ring != NULL) {
+		Ring->Enabled = 0U;
+		Xil_DCacheFlushRange((INTPTR)Ring, sizeof(Xil_TraceRing) +
+				     ((Ring->Mask + 1U) *
+				      sizeof(Xil_TraceEntry)));
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function records an event. It is normally called through
+*           the XIL_TRACE_* macros.
+*
+* @param    Id: event id, XIL_TRACE_ID_*.
+*
+* @param    Phase: XIL_TRACE_PH_*.
+*
+* @param    Arg: event argument.
+*
+* @note     The timestamp is taken before the slot is reserved, so an event
+*           of a preempting interrupt handler can precede an earlier event
+*           in the ring; the host tool orders entries by time.
+*
+*****************************************************************************/
+void Xil_TraceEvent(u32 Id, u32 Phase, u32 Arg)
+{
+	Xil_TraceRing *Ring = XilTraceRing;
+	Xil_TraceEntry *Entry;
+	u64 Time;
+	u32 Slot;
+
+	if ((Ring == NULL) || (Ring->Enabled == 0U)) {
+		return;
+	}
+
+	Time = Xil_TraceTime();
+
+#if defined (__GNUC__) && !defined (__MICROBLAZE__)
+	Slot = __atomic_fetch_add(&Ring->Head, 1U, __ATOMIC_RELAXED);
+#elif defined (__MICROBLAZE__)
+	{
+		u32 Msr = mfmsr();
+
+		mtmsr(Msr & ~XIL_TRACE_MSR_IE);
+		Slot = Ring->Head;
+		Ring->Head = Slot + 1U;
+		mtmsr(Msr);
+	}
+#else
+	{
+		u32 Mask = mfcpsr();
+
+		mtcpsr(Mask | 0xC0U);
+		Slot = Ring->Head;
+		Ring->Head = Slot + 1U;
+		mtcpsr(Mask);
+	}
+#endif
+
+	Entry = (Xil_TraceEntry *)(void *)(Ring + 1) + (Slot & Ring->Mask);
+	Entry->Time = Time;
+	Entry->Arg = Arg;
+	Entry->Event = (Id & XIL_TRACE_ID_MASK) |
+		       ((Phase << XIL_TRACE_PH_SHIFT) & XIL_TRACE_PH_MASK);
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function returns the ring set up by Xil_TraceInit(), or
+*           NULL.
+*
+*****************************************************************************/
+Xil_TraceRing *Xil_TraceGetRing(void)
+{
+	return XilTraceRing;
+}
+
+/*****************************************************************************/
+/**
+* @brief    This function prints the ring with xil_printf, header and
+*           entries as hexadecimal 32 bit words, eight to a line, between
+*           "xil_trace begin" and "xil_trace end" lines. The host tool reads
+*           this from a captured console log.
+*
+* @note     Stop recording first, or entries written during the dump may
+*           show torn.
+*
+*****************************************************************************/
+void Xil_TraceDump(void)
+{
+	Xil_TraceRing *Ring = XilTraceRing;
+	const u32 *Word;
+	u32 Num;
+	u32 Index;
+
+	if (Ring == NULL) {
+		return;
+	}
+
+	Word = (const u32 *)(const void *)Ring;
+	Num = ((u32)sizeof(Xil_TraceRing) +
+	       ((Ring->Mask + 1U) * (u32)sizeof(Xil_TraceEntry))) / 4U;
+
+	xil_printf("xil_trace begin\r\n");
+	for (Index = 0U; Index < Num; Index++) {
+		if (((Index + 1U) & 7U) == 0U) {
+			xil_printf("%08x\r\n", Word[Index]);
+		} else {
+			xil_printf("%08x ", Word[Index]);
+		}
+	}
+	xil_printf("xil_trace end\r\n");
+}
+
+/*****************************************************************************/
+/**
+*
+* Read the clock of the timestamps.
+*
+*****************************************************************************/
+static u64 Xil_TraceTime(void)
+{
+#if defined (__MICROBLAZE__)
+	return (XilTraceClock != NULL) ? XilTraceClock() : 0U;
+#else
+	u64 Time;
+
+	if (XilTraceClock != NULL) {
+		Time = XilTraceClock();
+	} else {
+#if defined (__aarch64__)
+		Time = mfcp(CNTPCT_EL0);
+#elif defined (XIL_TRACE_CYCLE_CLOCK)
+		u32 Reg;
+
+		XIL_TRACE_MFCP(XREG_CP15_PERF_CYCLE_COUNTER, Reg);
+		Time = Reg;
+#else
+		XTime Now;
+
+		XTime_GetTime(&Now);
+		Time = (u64)Now;
+#endif
+	}
+
+	return Time;
+#endif
+}
@@ -0,0 +1,214 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_trace.h
+*
+* @addtogroup common_trace_apis Trace Ring APIs
+*
+* The xil_trace.h file contains a binary event trace meant to stay enabled
+* in driver hot paths. Events are written to a ring in memory given to
+* Xil_TraceInit(), each one a 16 byte entry holding a timestamp, an event
+* id, a phase and a 32 bit argument. When the ring is full the oldest
+* entries are overwritten.
+*
+* Each processor running the BSP has its own ring, so a slot is reserved
+* with a single atomic increment and no lock is taken; events from
+* interrupt handlers preempting other events are safe. The timestamp is
+* the generic timer on the Cortex-A53 and the global timer on the
+* Cortex-A9. The Cortex-R5 uses the TTC sleep timer when the BSP has one
+* and the cycle counter otherwise. MicroBlaze, and any processor, can
+* register a clock with Xil_TraceSetClock().
+*
+* Trace points are placed with the XIL_TRACE_BEGIN, XIL_TRACE_END,
+* XIL_TRACE_INSTANT and XIL_TRACE_COUNTER macros, which compile to nothing
+* unless XIL_TRACE_ENABLE is defined, typically in the BSP extra compiler
+* flags. XIL_TRACE_CLASSES then selects the driver classes built in, one
+* bit per class; user events, ids from XIL_TRACE_ID_USER, are always built
+* in. The scugic, axidma, emacps and sdps drivers have trace points in
+* their interrupt, buffer descriptor and command paths.
+*
+* The ring is read with the debugger, flushed to memory by
+* Xil_TraceStop(), or printed by Xil_TraceDump(). The tracedecode host tool
+* in the linux directory of the BSP turns either into a Chrome trace JSON
+* file for chrome://tracing or Perfetto.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ag   10/16/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_TRACE_H	/* prevent circular inclusions */
+#define XIL_TRACE_H	/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_TRACE_MAGIC		0x43525458U	/**< "XTRC" */
+#define XIL_TRACE_VERSION	1U
+
+/**
+ * @name Event phases
+ * @{
+ */
+#define XIL_TRACE_PH_INSTANT	0U	/**< Point in time */
+#define XIL_TRACE_PH_BEGIN	1U	/**< Start of a duration */
+#define XIL_TRACE_PH_END	2U	/**< End of a duration */
+#define XIL_TRACE_PH_COUNTER	3U	/**< Argument is a counter value */
+/*@}*/
+
+/**
+ * @name Event fields, XIL_TRACE_PH_* in the phase bits
+ * @{
+ */
+#define XIL_TRACE_ID_MASK	0x0000FFFFU
+#define XIL_TRACE_PH_SHIFT	16U
+#define XIL_TRACE_PH_MASK	0x00030000U
+/*@}*/
+
+/**
+ * @name Event ids, the class in bits 15:8
+ * @{
+ */
+#define XIL_TRACE_ID_SCUGIC_IRQ		0x0100U	/**< Interrupt handler,
+						     argument the id */
+#define XIL_TRACE_ID_AXIDMA_TOHW	0x0200U	/**< BDs submitted */
+#define XIL_TRACE_ID_AXIDMA_FROMHW	0x0201U	/**< BDs completed */
+#define XIL_TRACE_ID_EMACPS_ISR		0x0300U	/**< Interrupt, argument
+						     the status */
+#define XIL_TRACE_ID_EMACPS_TOHW	0x0301U	/**< BDs submitted */
+#define XIL_TRACE_ID_EMACPS_FROMHW_TX	0x0302U	/**< Tx BDs completed */
+#define XIL_TRACE_ID_EMACPS_FROMHW_RX	0x0303U	/**< Rx BDs completed */
+#define XIL_TRACE_ID_SDPS_CMD		0x0400U	/**< Command, argument
+						     the command */
+#define XIL_TRACE_ID_SDPS_READ		0x0401U	/**< Read, argument the
+						     block count */
+#define XIL_TRACE_ID_SDPS_WRITE		0x0402U	/**< Write, argument the
+						     block count */
+#define XIL_TRACE_ID_USER		0x8000U	/**< First user id */
+/*@}*/
+
+#ifndef XIL_TRACE_CLASSES
+#define XIL_TRACE_CLASSES	0xFFFFFFFFU	/**< Driver classes built in */
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Trace entry
+ */
+typedef struct {
+	u64 Time;		/**< Timestamp in clock ticks */
+	u32 Event;		/**< Id and phase */
+	u32 Arg;		/**< Argument */
+} Xil_TraceEntry;
+
+/**
+ * Ring header, followed in memory by the entries. This is the layout read
+ * by the host tool, it only changes along with XIL_TRACE_VERSION.
+ */
+typedef struct {
+	u32 Magic;		/**< XIL_TRACE_MAGIC */
+	u16 Version;		/**< XIL_TRACE_VERSION */
+	u8 Cpu;			/**< Processor number */
+	u8 TimeBits;		/**< Width of the clock, 32 or 64 */
+	u32 Mask;		/**< Number of entries - 1 */
+	volatile u32 Head;	/**< Entries written, free running */
+	u64 TicksPerSec;	/**< Clock rate, 0 if unknown */
+	volatile u32 Enabled;	/**< Events are recorded */
+	u32 Reserved;
+} Xil_TraceRing;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#ifdef XIL_TRACE_ENABLE
+/** Whether events of Id are built in */
+#define XIL_TRACE_ON(Id)						\
+	(((u32)(Id) >= XIL_TRACE_ID_USER) ||				\
+	((((u32)XIL_TRACE_CLASSES >> (((u32)(Id) >> 8U) & 0x1FU)) &	\
+	1U) != 0U))
+
+#define XIL_TRACE_EVENT(Id, Phase, Arg)					\
+	{								\
+		if (XIL_TRACE_ON(Id)) {					\
+			Xil_TraceEvent((u32)(Id), (Phase), (u32)(Arg));	\
+		}							\
+	}
+#else
+#define XIL_TRACE_EVENT(Id, Phase, Arg)
+#endif
+
+/** Record the start of a duration */
+#define XIL_TRACE_BEGIN(Id, Arg)					\
+	XIL_TRACE_EVENT((Id), XIL_TRACE_PH_BEGIN, (Arg))
+/** Record the end of a duration */
+#define XIL_TRACE_END(Id, Arg)						\
+	XIL_TRACE_EVENT((Id), XIL_TRACE_PH_END, (Arg))
+/** Record a point in time */
+#define XIL_TRACE_INSTANT(Id, Arg)					\
+	XIL_TRACE_EVENT((Id), XIL_TRACE_PH_INSTANT, (Arg))
+/** Record a counter value, such as a queue depth */
+#define XIL_TRACE_COUNTER(Id, Value)					\
+	XIL_TRACE_EVENT((Id), XIL_TRACE_PH_COUNTER, (Value))
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_TraceInit(void *Mem, u32 Size);
+void Xil_TraceSetClock(u64 (*ClockFn)(void), u64 TicksPerSec);
+void Xil_TraceStart(void);
+void Xil_TraceStop(void);
+void Xil_TraceEvent(u32 Id, u32 Phase, u32 Arg);
+Xil_TraceRing *Xil_TraceGetRing(void);
+void Xil_TraceDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup common_trace_apis".
+*/
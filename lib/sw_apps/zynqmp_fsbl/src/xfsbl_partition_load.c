@@ -61,6 +61,8 @@
 *                     we are using IV from authenticated header(copied to
 *                     internal memory), using same way for non authenticated
 *                     case as well.
+*       ag   10/16/26 Enabled double buffering of chunks while decrypting
+*                     bitstream in DDR less systems.
 *
 * </pre>
 *
@@ -1507,6 +1509,12 @@ static u32 XFsbl_PartitionValidation(XFsblPs * FsblInstancePtr,
 			XSecure_AesSetChunkConfig(&SecureAes, ReadBuffer,
 					READ_BUFFER_SIZE,
 					FsblInstancePtr->DeviceOps.DeviceCopy);
+			/*
+			 * Boot device copies do not use the CSU DMA, copy
+			 * the next chunk while the current one is decrypted
+			 */
+			XSecure_AesSetChunkDoubleBuffer(&SecureAes,
+					XSECURE_CSU_AES_DOUBLE_BUFFER_ENABLED);
 
 			/**
 			 * In case of DDR less system, pass the partition source
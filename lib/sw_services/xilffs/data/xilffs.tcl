@@ -36,6 +36,8 @@
 # ----- ----  -------  -----------------------------------------------
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
+# 3.8   ag    10/16/26 Generate sector cache settings
+#       ag    10/16/26 Generate fast seek settings
 #
 ##############################################################################
 
@@ -118,6 +120,9 @@ proc xgen_opts_file {libhandle} {
 	set use_strfunc [common::get_property CONFIG.use_strfunc $libhandle]
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
+	set cache_sectors [common::get_property CONFIG.cache_sectors $libhandle]
+	set read_ahead_max [common::get_property CONFIG.read_ahead_max $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -195,6 +200,21 @@ proc xgen_opts_file {libhandle} {
 		if {$proc_type != "microblaze" && $word_access == true} {
 			puts $file_handle "\#define FILE_SYSTEM_WORD_ACCESS"
 		}
+		if {$cache_sectors < 0} {
+			puts "WARNING : Invalid cache_sectors, disabling the \
+					sector cache\n"
+			set cache_sectors 0
+		}
+		puts $file_handle "\#define FILE_SYSTEM_CACHE_SECTORS $cache_sectors"
+		if {$read_ahead_max < 0} {
+			puts "WARNING : Invalid read_ahead_max, disabling \
+					read-ahead\n"
+			set read_ahead_max 0
+		}
+		puts $file_handle "\#define FILE_SYSTEM_READ_AHEAD_MAX $read_ahead_max"
+		if {$use_fastseek == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+		}
 	} else {
 		error  "ERROR: Invalid interface selected \n"
 	}
@@ -0,0 +1,450 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffbench.c
+* Host benchmark of the FAT file system library on the RAM disk interface
+*
+* Builds ../src/ff.c and ../src/diskio.c with FILE_SYSTEM_INTERFACE_RAM on a
+* host buffer, formats it and runs sequential, random, create/delete,
+* directory and logging workloads. Besides the rate, each workload reports the commands
+* and sectors that reached the drive, read from disk_ioctl with
+* CTRL_GET_CACHE_STATS, which is what decides the speed on an SD card.
+*
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "xil_types.h"
+#include "ff.h"
+#include "diskio.h"
+
+#define DRV		"0:"
+#define BUF_MAX		(1024U * 1024U)	/* Largest sequential buffer */
+#define RND_SIZE	4096U
+#define SCAN_PASSES	10U
+#define LOG_CHUNK	65536U	/* Data written to the log per record */
+#define LOG_META	512U	/* Data written to the index per record */
+#define CLMT_SIZE	1024U	/* Items of the fast seek link map table */
+
+#ifndef FILE_SYSTEM_CACHE_SECTORS
+#define FILE_SYSTEM_CACHE_SECTORS	0U
+#endif
+
+static const char options[] = "f:n:o:c:w:h";
+static char help_msg[] =
+"Usage: ffbench [options]\n"
+"\n"
+"Options:\n"
+"\t-f <MB>\t\tSize of the sequential and random test file (default 32)\n"
+"\t-n <files>\tFiles to create, delete and scan (default 2000)\n"
+"\t-o <ops>\tRandom 4 KB operations (default 4096)\n"
+"\t-c <bytes>\tCluster size given to f_mkfs (default 4096)\n"
+"\t-w <list>\tWorkloads: s sequential, r random, c create/delete,\n"
+"\t\t\td directory, l logging (default srcdl)\n"
+"\t-h\t\tHelp\n";
+
+static const u32 buf_sizes[] = {
+	512U, 4096U, 32768U, 131072U, 1048576U
+};
+
+u8 FfBenchDisk[RAMFS_SIZE] __attribute__ ((aligned(64)));
+
+static FATFS fs;
+static FIL fil;
+static FIL fil_meta;
+static u8 buf[BUF_MAX] __attribute__ ((aligned(64)));
+#if _USE_FASTSEEK
+static DWORD clmt[CLMT_SIZE];
+#endif
+
+static double t_begin;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static void check(FRESULT res, const char *what)
+{
+	if (res != FR_OK) {
+		fprintf(stderr, "%s failed: %d\n", what, (int)res);
+		exit(1);
+	}
+}
+
+/* Access fil through the link map table; a too fragmented file stays in
+ * normal seek mode */
+static void fast_seek(void)
+{
+#if _USE_FASTSEEK
+	FRESULT res;
+
+	fil.cltbl = clmt;
+	clmt[0] = CLMT_SIZE;
+	res = f_lseek(&fil, CREATE_LINKMAP);
+	if (res == FR_NOT_ENOUGH_CORE) {
+		fil.cltbl = NULL;
+		res = FR_OK;
+	}
+	check(res, "f_lseek");
+#endif
+}
+
+static u32 rnd(void)
+{
+	static u32 x = 2463534242U;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+static void phase_begin(void)
+{
+	disk_ioctl(0U, (BYTE)CTRL_CLEAR_CACHE_STATS, NULL);
+	t_begin = now();
+}
+
+/* Report amount/s and what reached the drive since phase_begin() */
+static void phase_end(const char *name, u32 param, double amount,
+		      const char *unit)
+{
+	double t = now() - t_begin;
+	DISK_CACHE_STATS st;
+	DWORD lookups;
+
+	disk_ioctl(0U, (BYTE)CTRL_GET_CACHE_STATS, &st);
+	lookups = st.Hits + st.Misses;
+	printf("%-16s %8u %10.1f %-8s | %8lu %9lu %8lu %9lu | %5.1f%%\n",
+	       name, param, amount / t, unit,
+	       (unsigned long)st.DrvReads, (unsigned long)st.DrvReadSectors,
+	       (unsigned long)st.DrvWrites, (unsigned long)st.DrvWriteSectors,
+	       (lookups != 0U) ? (100.0 * st.Hits / lookups) : 0.0);
+}
+
+static void bench_seq(u32 size)
+{
+	UINT bw;
+	u32 i, ofs;
+
+	for (i = 0U; i < sizeof(buf_sizes) / sizeof(buf_sizes[0]); i++) {
+		u32 bs = buf_sizes[i];
+
+		phase_begin();
+		check(f_open(&fil, DRV "/seq.bin", FA_CREATE_ALWAYS | FA_WRITE),
+		      "f_open");
+		fast_seek();
+		for (ofs = 0U; ofs < size; ofs += bs) {
+			/* Stamp each buffer with its offset for the read back */
+			memcpy(buf, &ofs, sizeof(ofs));
+			check(f_write(&fil, buf, bs, &bw), "f_write");
+			if (bw != bs) {
+				fprintf(stderr, "disk full\n");
+				exit(1);
+			}
+		}
+		check(f_close(&fil), "f_close");
+		phase_end("seq write", bs, (double)size / 1e6, "MB/s");
+
+		phase_begin();
+		check(f_open(&fil, DRV "/seq.bin", FA_READ), "f_open");
+		fast_seek();
+		for (ofs = 0U; ofs < size; ofs += bs) {
+			check(f_read(&fil, buf, bs, &bw), "f_read");
+			if ((bw != bs) || (memcmp(buf, &ofs, sizeof(ofs)) != 0)) {
+				fprintf(stderr, "read back mismatch at %u\n", ofs);
+				exit(1);
+			}
+		}
+		check(f_close(&fil), "f_close");
+		phase_end("seq read", bs, (double)size / 1e6, "MB/s");
+	}
+	check(f_unlink(DRV "/seq.bin"), "f_unlink");
+}
+
+static void bench_rnd(u32 size, u32 ops)
+{
+	u32 blocks = size / RND_SIZE;
+	UINT bw;
+	u32 i, ofs;
+
+	check(f_open(&fil, DRV "/rnd.bin", FA_CREATE_ALWAYS | FA_WRITE),
+	      "f_open");
+	for (ofs = 0U; ofs < size; ofs += RND_SIZE) {
+		memcpy(buf, &ofs, sizeof(ofs));
+		check(f_write(&fil, buf, RND_SIZE, &bw), "f_write");
+	}
+	check(f_close(&fil), "f_close");
+
+	phase_begin();
+	check(f_open(&fil, DRV "/rnd.bin", FA_READ), "f_open");
+	fast_seek();
+	for (i = 0U; i < ops; i++) {
+		ofs = (rnd() % blocks) * RND_SIZE;
+		check(f_lseek(&fil, ofs), "f_lseek");
+		check(f_read(&fil, buf, RND_SIZE, &bw), "f_read");
+		if (memcmp(buf, &ofs, sizeof(ofs)) != 0) {
+			fprintf(stderr, "random read mismatch at %u\n", ofs);
+			exit(1);
+		}
+	}
+	check(f_close(&fil), "f_close");
+	phase_end("random read", RND_SIZE, (double)ops, "ops/s");
+
+	phase_begin();
+	check(f_open(&fil, DRV "/rnd.bin", FA_READ | FA_WRITE), "f_open");
+	fast_seek();
+	for (i = 0U; i < ops; i++) {
+		ofs = (rnd() % blocks) * RND_SIZE;
+		memcpy(buf, &ofs, sizeof(ofs));
+		check(f_lseek(&fil, ofs), "f_lseek");
+		check(f_write(&fil, buf, RND_SIZE, &bw), "f_write");
+	}
+	check(f_close(&fil), "f_close");
+	phase_end("random write", RND_SIZE, (double)ops, "ops/s");
+
+	check(f_unlink(DRV "/rnd.bin"), "f_unlink");
+}
+
+/*
+ * A recorder appending to a log and to its index in turn, which interleaves
+ * the clusters of both files unless the log is preallocated with f_expand.
+ * The log is read back in 1 MB requests.
+ */
+static void bench_log(u32 size, BYTE expand)
+{
+	const char *wname = (expand != 0U) ? "log expand wr" : "log append wr";
+	const char *rname = (expand != 0U) ? "log expand rd" : "log append rd";
+	u32 len = (size / 2U) - ((size / 2U) % LOG_CHUNK);
+	UINT bw;
+	u32 ofs, i;
+
+	phase_begin();
+	check(f_open(&fil, DRV "/log.bin", FA_CREATE_ALWAYS | FA_WRITE),
+	      "f_open");
+	check(f_open(&fil_meta, DRV "/log.idx", FA_CREATE_ALWAYS | FA_WRITE),
+	      "f_open");
+	fast_seek();
+	if (expand != 0U)
+		check(f_expand(&fil, len, 1U), "f_expand");
+	for (ofs = 0U; ofs < len; ofs += LOG_CHUNK) {
+		memcpy(buf, &ofs, sizeof(ofs));
+		check(f_write(&fil, buf, LOG_CHUNK, &bw), "f_write");
+		check(f_write(&fil_meta, buf, LOG_META, &bw), "f_write");
+		if (bw != LOG_META) {
+			fprintf(stderr, "disk full\n");
+			exit(1);
+		}
+	}
+	check(f_close(&fil_meta), "f_close");
+	check(f_close(&fil), "f_close");
+	phase_end(wname, LOG_CHUNK, (double)len / 1e6, "MB/s");
+
+	phase_begin();
+	check(f_open(&fil, DRV "/log.bin", FA_READ), "f_open");
+	fast_seek();
+	for (ofs = 0U; ofs < len; ofs += BUF_MAX) {
+		check(f_read(&fil, buf, BUF_MAX, &bw), "f_read");
+		for (i = 0U; i < bw; i += LOG_CHUNK) {
+			u32 exp = ofs + i;
+
+			if (memcmp(buf + i, &exp, sizeof(exp)) != 0) {
+				fprintf(stderr, "log mismatch at %u\n", exp);
+				exit(1);
+			}
+		}
+	}
+	check(f_close(&fil), "f_close");
+	phase_end(rname, BUF_MAX, (double)len / 1e6, "MB/s");
+
+	check(f_unlink(DRV "/log.idx"), "f_unlink");
+	check(f_unlink(DRV "/log.bin"), "f_unlink");
+}
+
+static void file_name(char *name, const char *dir, u32 i)
+{
+	sprintf(name, DRV "/%s/F%07u.DAT", dir, i);
+}
+
+static void create_files(const char *dir, u32 files, u32 len)
+{
+	char name[32];
+	UINT bw;
+	u32 i;
+
+	for (i = 0U; i < files; i++) {
+		file_name(name, dir, i);
+		check(f_open(&fil, name, FA_CREATE_NEW | FA_WRITE), "f_open");
+		if (len != 0U)
+			check(f_write(&fil, buf, len, &bw), "f_write");
+		check(f_close(&fil), "f_close");
+	}
+}
+
+static void delete_files(const char *dir, u32 files)
+{
+	char name[32];
+	u32 i;
+
+	for (i = 0U; i < files; i++) {
+		file_name(name, dir, i);
+		check(f_unlink(name), "f_unlink");
+	}
+}
+
+static void bench_create(u32 files)
+{
+	check(f_mkdir(DRV "/cd"), "f_mkdir");
+
+	phase_begin();
+	create_files("cd", files, 100U);
+	phase_end("create+write", files, (double)files, "files/s");
+
+	phase_begin();
+	delete_files("cd", files);
+	phase_end("delete", files, (double)files, "files/s");
+
+	check(f_unlink(DRV "/cd"), "f_unlink");
+}
+
+static void bench_dir(u32 files)
+{
+	char name[32];
+	FILINFO fno;
+	DIR dir;
+	u32 entries = 0U;
+	u32 i;
+
+	check(f_mkdir(DRV "/dir"), "f_mkdir");
+	create_files("dir", files, 0U);
+
+	phase_begin();
+	for (i = 0U; i < SCAN_PASSES; i++) {
+		check(f_opendir(&dir, DRV "/dir"), "f_opendir");
+		for (;;) {
+			check(f_readdir(&dir, &fno), "f_readdir");
+			if (fno.fname[0] == '\0')
+				break;
+			entries++;
+		}
+		check(f_closedir(&dir), "f_closedir");
+	}
+	phase_end("dir scan", files, (double)entries, "ents/s");
+	if (entries != files * SCAN_PASSES) {
+		fprintf(stderr, "scan found %u entries\n", entries / SCAN_PASSES);
+		exit(1);
+	}
+
+	phase_begin();
+	for (i = 0U; i < files; i++) {
+		file_name(name, "dir", i);
+		check(f_stat(name, &fno), "f_stat");
+	}
+	phase_end("dir lookup", files, (double)files, "ops/s");
+
+	delete_files("dir", files);
+	check(f_unlink(DRV "/dir"), "f_unlink");
+}
+
+int main(int argc, char **argv)
+{
+	const char *work = "srcdl";
+	u32 size = 32U;
+	u32 files = 2000U;
+	u32 ops = 4096U;
+	u32 au = 4096U;
+	int c;
+
+	while ((c = getopt(argc, argv, options)) != -1) {
+		switch (c) {
+		case 'f':
+			size = (u32)strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			files = (u32)strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			ops = (u32)strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			au = (u32)strtoul(optarg, NULL, 0);
+			break;
+		case 'w':
+			work = optarg;
+			break;
+		default:
+			printf("%s", help_msg);
+			return (c == 'h') ? 0 : 1;
+		}
+	}
+	if ((size == 0U) || (size > (RAMFS_SIZE / 2U) >> 20)) {
+		fprintf(stderr, "file size out of range\n");
+		return 1;
+	}
+	size <<= 20;
+
+	check(f_mount(&fs, DRV, 0U), "f_mount");
+	check(f_mkfs(DRV, 0U, au), "f_mkfs");
+	check(f_mount(&fs, DRV, 1U), "f_mount");
+
+	printf("disk %u MB, cluster %u bytes, _FS_TINY %d, _USE_FASTSEEK %d, "
+	       "cache %u sectors\n", RAMFS_SIZE >> 20, fs.csize * 512U,
+	       _FS_TINY, _USE_FASTSEEK, (u32)FILE_SYSTEM_CACHE_SECTORS);
+	printf("%-16s %8s %10s %-8s | %8s %9s %8s %9s | %6s\n", "workload",
+	       "size", "rate", "", "rd cmds", "rd sect", "wr cmds", "wr sect",
+	       "hits");
+
+	if (strchr(work, 's') != NULL)
+		bench_seq(size);
+	if (strchr(work, 'r') != NULL)
+		bench_rnd(size, ops);
+	if (strchr(work, 'c') != NULL)
+		bench_create(files);
+	if (strchr(work, 'd') != NULL)
+		bench_dir(files);
+	if (strchr(work, 'l') != NULL) {
+		bench_log(size, 0U);
+		bench_log(size, 1U);
+	}
+
+	check(f_mount(NULL, DRV, 0U), "f_mount");
+	return 0;
+}
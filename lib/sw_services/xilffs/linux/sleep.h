@@ -0,0 +1,2 @@
+/* Host stand-in for the BSP sleep.h */
+#include <unistd.h>
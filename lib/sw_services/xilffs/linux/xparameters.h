@@ -0,0 +1,20 @@
+/*
+ * xilffs settings of the host build. They stand in for the xparameters.h
+ * generated into the BSP; see data/xilffs.tcl for their meaning.
+ */
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+extern unsigned char FfBenchDisk[];
+
+#define FILE_SYSTEM_INTERFACE_RAM
+#define RAMFS_SIZE			(128U * 1024U * 1024U)
+#define RAMFS_START_ADDR		FfBenchDisk
+
+#define FILE_SYSTEM_USE_MKFS
+#define FILE_SYSTEM_NUM_LOGIC_VOL	2
+#define FILE_SYSTEM_USE_STRFUNC		0
+#define FILE_SYSTEM_SET_FS_RPATH	0
+#define FILE_SYSTEM_WORD_ACCESS
+
+#endif
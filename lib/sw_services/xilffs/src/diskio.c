@@ -54,6 +54,31 @@
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
 *
+*		Sector cache:
+*		In SDK, set "cache_sectors" to a non-zero number of 512 byte
+*		sectors to place a write-back cache between the file system
+*		and the drive. The cache is shared by both drives and evicts
+*		the least recently used sector. Dirty sectors are written to
+*		the drive on eviction and on CTRL_SYNC, which the file system
+*		issues from f_sync and f_close; contiguous dirty sectors go
+*		out as one multi-block write.
+*		Sequential reads are detected per drive and trigger a
+*		read-ahead window that doubles on each miss up to
+*		"read_ahead_max" sectors. Requests longer than that window
+*		bypass the cache. Hit, miss, read-ahead, write-back and
+*		eviction counts of a drive, and the commands and sectors
+*		issued to it, are returned by disk_ioctl with
+*		CTRL_GET_CACHE_STATS.
+*
+*		Contiguous extents:
+*		A multi-sector request is moved with one multi-block command
+*		per XSDPS_ASYNC_MAX_BLKCNT sectors through the ADMA2 table of
+*		the driver instance. Longer requests on a word aligned buffer
+*		use a descriptor table of this layer instead and are moved
+*		with one command per DISK_SG_MAX_BLKCNT sectors, so a file
+*		extent read or written by the file system in one call
+*		streams to the card without being split.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -81,6 +106,11 @@
 * 3.4   sk   06/09/16 Added support for mkfs.
 * 3.8   mj   07/31/17 Added support for RAM based FATfs.
 *       mn   12/04/17 Resolve errors in XilFFS for ARMCC compiler
+*       ag   10/16/26 Added write-back sector cache with read-ahead
+*                     and CTRL_GET_CACHE_STATS.
+*                     Count commands and sectors issued to the drive.
+*                     Move long contiguous extents with one multi-block
+*                     command per descriptor table.
 *
 * </pre>
 *
@@ -96,6 +126,7 @@
 #endif
 #include "sleep.h"
 #include "xil_printf.h"
+#include "xil_mem.h"
 
 #define HIGH_SPEED_SUPPORT	0x01U
 #define WIDTH_4_BIT_SUPPORT	0x4U
@@ -108,6 +139,13 @@
 #define EXT_CSD_DEVICE_TYPE_HIGH_SPEED	0x3
 #define SD_CD_DELAY		10000U
 
+#ifdef FILE_SYSTEM_INTERFACE_SD
+/* Descriptors of the extent table of each drive, 64KB each */
+#define DISK_SG_DESC_NUM	128U
+#define DISK_SG_MAX_BLKCNT	((DISK_SG_DESC_NUM * XSDPS_DESC_MAX_LENGTH) / \
+					XSDPS_BLK_SIZE_512_MASK)
+#endif
+
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 #include "xparameters.h"
 
@@ -118,6 +156,44 @@ static char *dataramfs = NULL;
 #define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
 #endif
 
+#ifndef FILE_SYSTEM_CACHE_SECTORS
+#define FILE_SYSTEM_CACHE_SECTORS	0U
+#endif
+#ifndef FILE_SYSTEM_READ_AHEAD_MAX
+#define FILE_SYSTEM_READ_AHEAD_MAX	8U
+#endif
+
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+#define CACHE_SECTOR_SIZE	512U
+
+/* Read-ahead may take at most half of the cache */
+#if FILE_SYSTEM_READ_AHEAD_MAX > (FILE_SYSTEM_CACHE_SECTORS / 2U)
+#define CACHE_RA_MAX	(FILE_SYSTEM_CACHE_SECTORS / 2U)
+#else
+#define CACHE_RA_MAX	FILE_SYSTEM_READ_AHEAD_MAX
+#endif
+
+/* Requests of more sectors than this go straight to the drive */
+#if CACHE_RA_MAX > 0U
+#define CACHE_RUN_MAX	CACHE_RA_MAX
+#else
+#define CACHE_RUN_MAX	1U
+#endif
+
+/* Staging buffer for read-ahead and coalesced write-back */
+#define CACHE_STAGE_SECTORS	(2U * CACHE_RUN_MAX)
+
+#define CACHE_VALID	0x01U
+#define CACHE_DIRTY	0x02U
+
+typedef struct {
+	DWORD Sector;		/* Cached sector number (LBA) */
+	u32 Stamp;		/* Time of last use, for LRU eviction */
+	BYTE Drv;		/* Physical drive number */
+	BYTE Flags;		/* CACHE_VALID, CACHE_DIRTY */
+} CacheLine;
+#endif
+
 /*--------------------------------------------------------------------------
 
 	Public Functions
@@ -136,6 +212,14 @@ static u32 CardDetect;
 static u32 WriteProtect;
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static XSdPs_Adma2Descriptor DiskSgTbl[2][DISK_SG_DESC_NUM];
+#pragma data_alignment = 4
+#else
+static XSdPs_Adma2Descriptor DiskSgTbl[2][DISK_SG_DESC_NUM]
+						__attribute__ ((aligned(32)));
 #endif
 
 #ifdef __ICCARM__
@@ -145,6 +229,49 @@ static u8 ExtCsd[512];
 #else
 static u8 ExtCsd[512] __attribute__ ((aligned(32)));
 #endif
+#endif
+
+static DISK_CACHE_STATS CacheStats[2];
+
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+static CacheLine Cache[FILE_SYSTEM_CACHE_SECTORS];
+static u32 CacheClock;
+static DWORD RaNext[2];		/* Sector that continues a sequential read */
+static DWORD RaWin[2];		/* Current read-ahead window in sectors */
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static u8 CacheData[FILE_SYSTEM_CACHE_SECTORS][CACHE_SECTOR_SIZE];
+#pragma data_alignment = 32
+static u8 CacheStage[CACHE_STAGE_SECTORS][CACHE_SECTOR_SIZE];
+#pragma data_alignment = 4
+#else
+static u8 CacheData[FILE_SYSTEM_CACHE_SECTORS][CACHE_SECTOR_SIZE]
+						__attribute__ ((aligned(32)));
+static u8 CacheStage[CACHE_STAGE_SECTORS][CACHE_SECTOR_SIZE]
+						__attribute__ ((aligned(32)));
+#endif
+#endif
+
+static DRESULT DiskRawRead(BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+static DRESULT DiskRawWrite(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count);
+static DRESULT DiskSync(BYTE pdrv);
+#ifdef FILE_SYSTEM_INTERFACE_SD
+static DRESULT DiskSdXfer(BYTE pdrv, BYTE *buff, DWORD sector, UINT count,
+				u8 IsRead);
+#endif
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+static DWORD DiskSectorCount(BYTE pdrv);
+static s32 CacheFind(BYTE pdrv, DWORD sector);
+static s32 CacheAlloc(BYTE pdrv, DWORD sector);
+static DRESULT CacheWriteRun(BYTE pdrv, DWORD sector);
+static DRESULT CacheWriteBack(s32 Idx);
+static void CacheInvalidate(BYTE pdrv);
+static DRESULT CacheRead(BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+static DRESULT CacheWrite(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count);
+#endif
 
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status							*/
@@ -173,8 +300,10 @@ DSTATUS disk_status (
 )
 {
 	DSTATUS s = Stat[pdrv];
+#ifdef FILE_SYSTEM_INTERFACE_SD
 	u32 StatusReg;
 	u32 DelayCount = 0;
+#endif
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 		if (SdInstance[pdrv].Config.BaseAddress == (u32)0) {
@@ -262,8 +391,8 @@ DSTATUS disk_initialize (
 )
 {
 	DSTATUS s;
-	s32 Status;
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status;
 	XSdPs_Config *SdConfig;
 #endif
 
@@ -333,6 +462,11 @@ DSTATUS disk_initialize (
 	Stat[pdrv] = s;
 #endif
 
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+	/* Whatever was cached belongs to the previous medium */
+	CacheInvalidate(pdrv);
+#endif
+
 	return s;
 }
 
@@ -356,21 +490,19 @@ DSTATUS disk_initialize (
 *		STA_NOINIT	Drive not initialized
 *		RES_ERROR	Read not successful
 *
-* @note
+* @note		With the sector cache enabled, sectors are served from the
+*		cache where present and misses may be read together with a
+*		read-ahead window.
 *
 ******************************************************************************/
 DRESULT disk_read (
 		BYTE pdrv,	/* Physical drive number (0) */
 		BYTE *buff,	/* Pointer to the data buffer to store read data */
 		DWORD sector,	/* Start sector number (LBA) */
-		UINT count	/* Sector count (1..128) */
+		UINT count	/* Sector count */
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 
@@ -381,23 +513,12 @@ DRESULT disk_read (
 		return RES_PARERR;
 	}
 
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	/* Convert LBA to byte address if needed */
-	if ((SdInstance[pdrv].HCS) == 0U) {
-		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
-	}
-
-	Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
-		return RES_ERROR;
-	}
-#endif
-
-#ifdef FILE_SYSTEM_INTERFACE_RAM
-	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+	return CacheRead(pdrv, buff, sector, count);
+#else
+	CacheStats[pdrv].Misses += (DWORD)count;
+	return DiskRawRead(pdrv, buff, sector, count);
 #endif
-
-    return RES_OK;
 }
 
 /*-----------------------------------------------------------------------*/
@@ -411,9 +532,22 @@ DRESULT disk_ioctl (
 )
 {
 	DRESULT res = RES_OK;
-
+	static const DISK_CACHE_STATS CacheStatsZero;
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	void *LocBuff = buff;
+#endif
+
+	/* Cache counters are kept for both interfaces */
+	if (cmd == (BYTE)CTRL_GET_CACHE_STATS) {
+		*(DISK_CACHE_STATS *)buff = CacheStats[pdrv];
+		return RES_OK;
+	}
+	if (cmd == (BYTE)CTRL_CLEAR_CACHE_STATS) {
+		CacheStats[pdrv] = CacheStatsZero;
+		return RES_OK;
+	}
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
 	if ((disk_status(pdrv) & STA_NOINIT) != 0U) {	/* Check if card is in the socket */
 		return RES_NOTRDY;
 	}
@@ -421,7 +555,7 @@ DRESULT disk_ioctl (
 	res = RES_ERROR;
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
-			res = RES_OK;
+			res = DiskSync(pdrv);
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -443,9 +577,10 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+		res = DiskSync(pdrv);
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
-		*(WORD *)buff = BLOCKSIZE;
+		*(DWORD *)buff = BLOCKSIZE;
 		break;
 	case (BYTE)GET_SECTOR_SIZE:
 		*(WORD *)buff = SECTORSIZE;
@@ -501,21 +636,18 @@ DWORD get_fattime (void)
 *		STA_NOINIT	Drive not initialized
 *		RES_ERROR	Read not successful
 *
-* @note
+* @note		With the sector cache enabled, short writes stay in the
+*		cache until they are evicted or CTRL_SYNC is issued.
 *
 ******************************************************************************/
 DRESULT disk_write (
 	BYTE pdrv,			/* Physical drive nmuber (0..) */
 	const BYTE *buff,	/* Data to be written */
 	DWORD sector,		/* Sector address (LBA) */
-	UINT count			/* Number of sectors to write (1..128) */
+	UINT count			/* Number of sectors to write */
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 	if ((s & STA_NOINIT) != 0U) {
@@ -525,17 +657,67 @@ DRESULT disk_write (
 		return RES_PARERR;
 	}
 
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+	return CacheWrite(pdrv, buff, sector, count);
+#else
+	return DiskRawWrite(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors from the drive, bypassing the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_ERROR otherwise.
+*
+******************************************************************************/
+static DRESULT DiskRawRead(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	CacheStats[pdrv].DrvReads++;
+	CacheStats[pdrv].DrvReadSectors += (DWORD)count;
+
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	/* Convert LBA to byte address if needed */
-	if ((SdInstance[pdrv].HCS) == 0U) {
-		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+	if (DiskSdXfer(pdrv, buff, sector, count, 1U) != RES_OK) {
+		return RES_ERROR;
 	}
+#endif
 
-	Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
+#ifdef FILE_SYSTEM_INTERFACE_RAM
+	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
+#endif
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the drive, bypassing the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_ERROR otherwise.
+*
+******************************************************************************/
+static DRESULT DiskRawWrite(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count)
+{
+	CacheStats[pdrv].DrvWrites++;
+	CacheStats[pdrv].DrvWriteSectors += (DWORD)count;
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+	if (DiskSdXfer(pdrv, (BYTE *)buff, sector, count, 0U) != RES_OK) {
 		return RES_ERROR;
 	}
-
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
@@ -544,3 +726,485 @@ DRESULT disk_write (
 
 	return RES_OK;
 }
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+/*****************************************************************************/
+/**
+*
+* Moves a contiguous range of sectors between the card and a buffer. Up to
+* XSDPS_ASYNC_MAX_BLKCNT sectors go through the table of the driver
+* instance; longer ranges on a word aligned buffer go through the DiskSgTbl
+* table of the drive, DISK_SG_MAX_BLKCNT sectors per command.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer
+* @param	sector - Start sector number
+* @param	count - Sector count
+* @param	IsRead - 1 to read from the card, 0 to write to it
+*
+* @return	RES_OK on success, RES_ERROR otherwise.
+*
+******************************************************************************/
+static DRESULT DiskSdXfer(BYTE pdrv, BYTE *buff, DWORD sector, UINT count,
+				u8 IsRead)
+{
+	XSdPs_IoVec Vec;
+	s32 Status;
+	DWORD NextSector = sector;
+	DWORD LocSector;
+	BYTE *LocBuff = buff;
+	UINT Remain = count;
+	UINT Chunk;
+	UINT ChunkMax;
+
+	if ((((UINTPTR)buff) & 0x3U) == 0U) {
+		ChunkMax = (UINT)DISK_SG_MAX_BLKCNT;
+	} else {
+		ChunkMax = (UINT)XSDPS_ASYNC_MAX_BLKCNT;
+	}
+
+	while (Remain > 0U) {
+		Chunk = (Remain < ChunkMax) ? Remain : ChunkMax;
+
+		/* Convert LBA to byte address if needed */
+		LocSector = NextSector;
+		if ((SdInstance[pdrv].HCS) == 0U) {
+			LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+		}
+
+		if (Chunk <= (UINT)XSDPS_ASYNC_MAX_BLKCNT) {
+			if (IsRead != 0U) {
+				Status = XSdPs_ReadPolled(&SdInstance[pdrv],
+					(u32)LocSector, (u32)Chunk, LocBuff);
+			} else {
+				Status = XSdPs_WritePolled(&SdInstance[pdrv],
+					(u32)LocSector, (u32)Chunk, LocBuff);
+			}
+		} else {
+			Vec.Base = LocBuff;
+			Vec.Length = (u32)Chunk * XSDPS_BLK_SIZE_512_MASK;
+			if (IsRead != 0U) {
+				Status = XSdPs_ReadPolledV(&SdInstance[pdrv],
+					(u32)LocSector, &Vec, 1U, DiskSgTbl[pdrv],
+					DISK_SG_DESC_NUM);
+			} else {
+				Status = XSdPs_WritePolledV(&SdInstance[pdrv],
+					(u32)LocSector, &Vec, 1U, DiskSgTbl[pdrv],
+					DISK_SG_DESC_NUM);
+			}
+		}
+		if (Status != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+
+		LocBuff += (u32)Chunk * XSDPS_BLK_SIZE_512_MASK;
+		NextSector += (DWORD)Chunk;
+		Remain -= Chunk;
+	}
+
+	return RES_OK;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Writes all dirty cached sectors of a drive to the drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK on success, RES_ERROR otherwise.
+*
+******************************************************************************/
+static DRESULT DiskSync(BYTE pdrv)
+{
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+	DRESULT res;
+	DWORD Lowest;
+	s32 Idx;
+	u32 Found;
+
+	do {
+		/* Flush in ascending sector order, one dirty run at a time */
+		Found = 0U;
+		Lowest = 0U;
+		for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+			if ((Cache[Idx].Drv == pdrv) &&
+			    ((Cache[Idx].Flags & CACHE_DIRTY) != 0U) &&
+			    ((Found == 0U) || (Cache[Idx].Sector < Lowest))) {
+				Lowest = Cache[Idx].Sector;
+				Found = 1U;
+			}
+		}
+		if (Found != 0U) {
+			res = CacheWriteRun(pdrv, Lowest);
+			if (res != RES_OK) {
+				return res;
+			}
+		}
+	} while (Found != 0U);
+#else
+	(void)pdrv;
+#endif
+
+	return RES_OK;
+}
+
+#if FILE_SYSTEM_CACHE_SECTORS > 0U
+/*****************************************************************************/
+/**
+*
+* Returns the number of sectors on the drive, used to stop read-ahead at
+* the end of the medium.
+*
+******************************************************************************/
+static DWORD DiskSectorCount(BYTE pdrv)
+{
+#ifdef FILE_SYSTEM_INTERFACE_SD
+	return (DWORD)SdInstance[pdrv].SectorCount;
+#else
+	(void)pdrv;
+	return (DWORD)SECTORCNT;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Looks up a sector in the cache.
+*
+* @return	Index of the cache line holding the sector, or -1.
+*
+******************************************************************************/
+static s32 CacheFind(BYTE pdrv, DWORD sector)
+{
+	s32 Idx;
+
+	for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+		if (((Cache[Idx].Flags & CACHE_VALID) != 0U) &&
+		    (Cache[Idx].Sector == sector) && (Cache[Idx].Drv == pdrv)) {
+			return Idx;
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Takes a free cache line, or evicts the least recently used one, and tags
+* it with the sector. The line is returned without data and not yet valid.
+*
+* @return	Index of the cache line, or -1 if writing back the evicted
+*		line failed.
+*
+******************************************************************************/
+static s32 CacheAlloc(BYTE pdrv, DWORD sector)
+{
+	s32 Idx;
+	s32 Victim = 0;
+	u32 Age = 0U;
+
+	for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+		if ((Cache[Idx].Flags & CACHE_VALID) == 0U) {
+			Victim = Idx;
+			break;
+		}
+		/* Unsigned difference keeps working across clock wrap */
+		if ((CacheClock - Cache[Idx].Stamp) >= Age) {
+			Age = CacheClock - Cache[Idx].Stamp;
+			Victim = Idx;
+		}
+	}
+
+	if ((Cache[Victim].Flags & CACHE_VALID) != 0U) {
+		if (((Cache[Victim].Flags & CACHE_DIRTY) != 0U) &&
+		    (CacheWriteBack(Victim) != RES_OK)) {
+			return -1;
+		}
+		CacheStats[Cache[Victim].Drv].Evictions++;
+	}
+
+	Cache[Victim].Drv = pdrv;
+	Cache[Victim].Sector = sector;
+	Cache[Victim].Flags = 0U;
+	Cache[Victim].Stamp = ++CacheClock;
+
+	return Victim;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the run of consecutive dirty sectors starting at a dirty cached
+* sector to the drive with one command, and marks them clean.
+*
+******************************************************************************/
+static DRESULT CacheWriteRun(BYTE pdrv, DWORD sector)
+{
+	s32 Line[CACHE_STAGE_SECTORS];
+	const BYTE *Src;
+	DRESULT res;
+	UINT Cnt = 0U;
+	UINT Index;
+	s32 Idx;
+
+	while (Cnt < CACHE_STAGE_SECTORS) {
+		Idx = CacheFind(pdrv, sector + Cnt);
+		if ((Idx < 0) || ((Cache[Idx].Flags & CACHE_DIRTY) == 0U)) {
+			break;
+		}
+		Line[Cnt] = Idx;
+		Cnt++;
+	}
+
+	if (Cnt == 1U) {
+		Src = CacheData[Line[0]];
+	} else {
+		for (Index = 0U; Index < Cnt; Index++) {
+			Xil_MemCpy(CacheStage[Index], CacheData[Line[Index]],
+					CACHE_SECTOR_SIZE);
+		}
+		Src = CacheStage[0];
+	}
+
+	res = DiskRawWrite(pdrv, Src, sector, Cnt);
+	if (res != RES_OK) {
+		return res;
+	}
+
+	for (Index = 0U; Index < Cnt; Index++) {
+		Cache[Line[Index]].Flags &= (BYTE)~CACHE_DIRTY;
+	}
+	CacheStats[pdrv].WriteBacks += (DWORD)Cnt;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back a dirty cache line before eviction, together with the dirty
+* sectors around it so that the run goes out as one command.
+*
+******************************************************************************/
+static DRESULT CacheWriteBack(s32 Idx)
+{
+	BYTE Drv = Cache[Idx].Drv;
+	DWORD Start = Cache[Idx].Sector;
+	UINT Cnt = 1U;
+	s32 Prev;
+
+	while ((Cnt < CACHE_STAGE_SECTORS) && (Start > 0U)) {
+		Prev = CacheFind(Drv, Start - 1U);
+		if ((Prev < 0) || ((Cache[Prev].Flags & CACHE_DIRTY) == 0U)) {
+			break;
+		}
+		Start--;
+		Cnt++;
+	}
+
+	return CacheWriteRun(Drv, Start);
+}
+
+/*****************************************************************************/
+/**
+*
+* Drops all cached sectors of a drive, dirty ones included, and resets its
+* read-ahead state.
+*
+******************************************************************************/
+static void CacheInvalidate(BYTE pdrv)
+{
+	s32 Idx;
+
+	for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+		if (Cache[Idx].Drv == pdrv) {
+			Cache[Idx].Flags = 0U;
+		}
+	}
+	RaNext[pdrv] = 0U;
+	RaWin[pdrv] = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the cache.
+*
+* Runs of missing sectors are read with one command. When the request
+* continues the previous one and its last run is a miss, the read is
+* extended by the read-ahead window, which doubles on every such miss up
+* to CACHE_RA_MAX and closes on the first non-sequential request.
+* Requests longer than CACHE_RUN_MAX go straight to the drive and do not
+* displace cached sectors.
+*
+******************************************************************************/
+static DRESULT CacheRead(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	s32 Line[CACHE_STAGE_SECTORS];
+	DRESULT res = RES_OK;
+	DWORD Total;
+	UINT Index = 0U;
+	UINT Run;
+	UINT Ahead;
+	UINT Cnt;
+	UINT Num;
+	BYTE *Dst;
+	s32 Idx;
+	u32 Seq;
+
+	Seq = (sector == RaNext[pdrv]) ? 1U : 0U;
+	if (Seq == 0U) {
+		RaWin[pdrv] = 0U;
+	}
+	RaNext[pdrv] = sector + count;
+
+	if (count > CACHE_RUN_MAX) {
+		res = DiskRawRead(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+		CacheStats[pdrv].Misses += (DWORD)count;
+
+		/* Cached sectors may be newer than the drive */
+		for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+			if (((Cache[Idx].Flags & CACHE_DIRTY) != 0U) &&
+			    (Cache[Idx].Drv == pdrv) &&
+			    ((Cache[Idx].Sector - sector) < (DWORD)count)) {
+				Xil_MemCpy(buff + ((Cache[Idx].Sector - sector) *
+						CACHE_SECTOR_SIZE), CacheData[Idx],
+						CACHE_SECTOR_SIZE);
+			}
+		}
+		return RES_OK;
+	}
+
+	while (Index < count) {
+		Idx = CacheFind(pdrv, sector + Index);
+		if (Idx >= 0) {
+			Xil_MemCpy(buff + (Index * CACHE_SECTOR_SIZE),
+					CacheData[Idx], CACHE_SECTOR_SIZE);
+			Cache[Idx].Stamp = ++CacheClock;
+			CacheStats[pdrv].Hits++;
+			Index++;
+			continue;
+		}
+
+		Run = 1U;
+		while (((Index + Run) < count) &&
+		       (CacheFind(pdrv, sector + Index + Run) < 0)) {
+			Run++;
+		}
+
+		/*
+		 * Read-ahead only covers sectors that are not cached, so no
+		 * line is evicted and refilled with stale data in between.
+		 */
+		Ahead = 0U;
+		if ((Seq != 0U) && ((Index + Run) == count) &&
+		    (CACHE_RA_MAX > 0U)) {
+			RaWin[pdrv] = (RaWin[pdrv] == 0U) ? 2U : (RaWin[pdrv] * 2U);
+			if (RaWin[pdrv] > CACHE_RA_MAX) {
+				RaWin[pdrv] = CACHE_RA_MAX;
+			}
+			Total = DiskSectorCount(pdrv);
+			while ((Ahead < RaWin[pdrv]) &&
+			       ((sector + count + Ahead) < Total) &&
+			       (CacheFind(pdrv, sector + count + Ahead) < 0)) {
+				Ahead++;
+			}
+		}
+
+		/*
+		 * Take the lines before reading: evictions write back through
+		 * CacheStage, which then holds the read data. The lines are
+		 * marked valid so that they are not taken twice.
+		 */
+		Cnt = Run + Ahead;
+		for (Num = 0U; Num < Cnt; Num++) {
+			Line[Num] = CacheAlloc(pdrv, sector + Index + Num);
+			if (Line[Num] < 0) {
+				res = RES_ERROR;
+				break;
+			}
+			Cache[Line[Num]].Flags = CACHE_VALID;
+		}
+
+		Dst = (Ahead != 0U) ? CacheStage[0] :
+				(buff + (Index * CACHE_SECTOR_SIZE));
+		if (res == RES_OK) {
+			res = DiskRawRead(pdrv, Dst, sector + Index, Cnt);
+		}
+		if (res != RES_OK) {
+			while (Num > 0U) {
+				Num--;
+				Cache[Line[Num]].Flags = 0U;
+			}
+			return res;
+		}
+
+		if (Ahead != 0U) {
+			Xil_MemCpy(buff + (Index * CACHE_SECTOR_SIZE), Dst,
+					Run * CACHE_SECTOR_SIZE);
+		}
+		for (Num = 0U; Num < Cnt; Num++) {
+			Xil_MemCpy(CacheData[Line[Num]],
+					Dst + (Num * CACHE_SECTOR_SIZE),
+					CACHE_SECTOR_SIZE);
+		}
+		CacheStats[pdrv].Misses += (DWORD)Run;
+		CacheStats[pdrv].ReadAheads += (DWORD)Ahead;
+		Index += Run;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the cache. Short requests are only copied into the
+* cache and marked dirty. Longer requests go straight to the drive and drop
+* the cached copies they overwrite.
+*
+******************************************************************************/
+static DRESULT CacheWrite(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count)
+{
+	DRESULT res;
+	UINT Index;
+	s32 Idx;
+
+	if (count > CACHE_RUN_MAX) {
+		res = DiskRawWrite(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+		for (Idx = 0; Idx < (s32)FILE_SYSTEM_CACHE_SECTORS; Idx++) {
+			if ((Cache[Idx].Drv == pdrv) &&
+			    ((Cache[Idx].Sector - sector) < (DWORD)count)) {
+				Cache[Idx].Flags = 0U;
+			}
+		}
+		return RES_OK;
+	}
+
+	for (Index = 0U; Index < count; Index++) {
+		Idx = CacheFind(pdrv, sector + Index);
+		if (Idx < 0) {
+			Idx = CacheAlloc(pdrv, sector + Index);
+			if (Idx < 0) {
+				return RES_ERROR;
+			}
+		}
+		Xil_MemCpy(CacheData[Idx], buff + (Index * CACHE_SECTOR_SIZE),
+				CACHE_SECTOR_SIZE);
+		Cache[Idx].Flags = CACHE_VALID | CACHE_DIRTY;
+		Cache[Idx].Stamp = ++CacheClock;
+	}
+
+	return RES_OK;
+}
+#endif
@@ -1193,11 +1193,154 @@ DWORD clmt_clust (	/* <2:Error, >=2:Cluster number */
 	}
 	return cl + *tbl;	/* Return the cluster number */
 }
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Create the link map table of a file                    */
+/*-----------------------------------------------------------------------*/
+
+static
+FRESULT create_linkmap (	/* FR_OK, FR_NOT_ENOUGH_CORE, FR_INT_ERR or FR_DISK_ERR */
+	FIL* fp,		/* Pointer to the file object, fp->cltbl points the table */
+	DWORD tlen,		/* Number of items of the table */
+	BYTE full		/* 1:Count the required items of a too small table, 0:Stop there */
+)
+{
+	DWORD cl, pcl, ncl, tcl, ulen, *tbl;
+
+
+	tbl = fp->cltbl + 1;
+	ulen = 2U;					/* Required table size */
+	cl = fp->sclust;			/* Top of the chain */
+	if (cl != 0U) {
+		do {
+			/* Get a fragment */
+			tcl = cl; ncl = 0U; ulen += 2U;	/* Top, length and used items */
+			do {
+				pcl = cl; ncl++;
+				cl = get_fat(fp->fs, cl);
+				if (cl <= 1U) {
+					return FR_INT_ERR;
+				}
+				if (cl == 0xFFFFFFFFU) {
+					return FR_DISK_ERR;
+				}
+			} while (cl == (pcl + 1U));
+			if (ulen <= tlen) {		/* Store the length and top of the fragment */
+				*tbl++ = ncl; *tbl++ = tcl;
+			} else if (full == 0U) {
+				break;				/* Table overflowed, the caller falls back to normal seek */
+			}
+		} while (cl < fp->fs->n_fatent);	/* Repeat until end of chain */
+	}
+	*fp->cltbl = ulen;	/* Number of items used */
+	if (ulen > tlen) {
+		return FR_NOT_ENOUGH_CORE;	/* Given table size is smaller than required */
+	}
+	*tbl = 0U;		/* Terminate table */
+
+	return FR_OK;
+}
+
+
+
+
+#if !_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Add a cluster to the end of the file link map table    */
+/*-----------------------------------------------------------------------*/
+
+static
+void clmt_append (
+	FIL* fp,		/* Pointer to the file object */
+	DWORD clst		/* Cluster# appended to the chain of the file */
+)
+{
+	DWORD ulen, *tbl;
+
+
+	if (fp->cltsz == 0U) {	/* Only a table built by CREATE_LINKMAP is maintained */
+		return;
+	}
+	tbl = fp->cltbl;
+	ulen = tbl[0];
+	if ((ulen > 2U) && ((tbl[ulen - 2U] + tbl[ulen - 3U]) == clst)) {
+		tbl[ulen - 3U]++;			/* Stretch the last fragment */
+	} else if ((ulen + 2U) <= fp->cltsz) {
+		tbl[ulen - 1U] = 1U;		/* Add a fragment */
+		tbl[ulen] = clst;
+		tbl[ulen + 1U] = 0U;
+		tbl[0] = ulen + 2U;
+	} else {
+		fp->cltbl = 0;				/* Too fragmented, back to normal seek mode */
+		fp->cltsz = 0U;
+	}
+}
+#endif
 #endif	/* _USE_FASTSEEK */
 
 
 
 
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Get contiguous sectors following the current cluster   */
+/*-----------------------------------------------------------------------*/
+
+static
+UINT clust_run (	/* Number of sectors following the current cluster contiguously */
+	FIL* fp,		/* Pointer to the file object */
+	DWORD ofs,		/* File offset of the cluster following fp->clust */
+	UINT nsect,		/* Number of sectors wanted */
+	BYTE stretch	/* 1: Stretch the cluster chain at its end */
+)
+{
+	DWORD clst;
+	UINT n = 0U;
+
+#if !_USE_FASTSEEK
+	(void)ofs;
+#endif
+
+	while (n < nsect) {
+#if _USE_FASTSEEK
+		if (fp->cltbl) {
+			clst = clmt_clust(fp, ofs + (n * SS(fp->fs)));	/* Get cluster# from the CLMT */
+#if !_FS_READONLY
+			if ((clst == 0U) && (stretch != 0U) && (fp->cltsz != 0U)) {
+				clst = create_chain(fp->fs, fp->clust);
+				if (clst >= 2U) {
+					clmt_append(fp, clst);
+				}
+			}
+#endif
+		}
+		else
+#endif
+		{
+#if !_FS_READONLY
+			if (stretch != 0U) {
+				clst = create_chain(fp->fs, fp->clust);	/* Follow or stretch the chain */
+			} else
+#endif
+			{
+				clst = get_fat(fp->fs, fp->clust);	/* Follow the chain */
+			}
+		}
+		if (clst != (fp->clust + 1U)) {
+			break;	/* End of the run, the caller follows the chain from here */
+		}
+		fp->clust = clst;
+		n += ((nsect - n) < (UINT)fp->fs->csize) ? (nsect - n) : (UINT)fp->fs->csize;
+	}
+
+	return n;
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Set directory index                              */
 /*-----------------------------------------------------------------------*/
@@ -1244,8 +1387,8 @@ FRESULT dir_sdi (
 	}
 	dp->clust = clst;	/* Current cluster# */
 	if (sect == ((DWORD)0U)) {return FR_INT_ERR;}
-	dp->sect = sect + ((DWORD)idx / ((DWORD)SS(dp->fs) / (DWORD)SZ_DIR));					/* Sector# of the directory entry */
-	dp->dir = dp->fs->win + ((idx % (SS(dp->fs) / SZ_DIR)) * SZ_DIR);	/* Ptr to the entry in the sector */
+	dp->sect = sect + ((DWORD)LocalDirectory / ((DWORD)SS(dp->fs) / (DWORD)SZ_DIR));					/* Sector# of the directory entry */
+	dp->dir = dp->fs->win + ((LocalDirectory % (SS(dp->fs) / SZ_DIR)) * SZ_DIR);	/* Ptr to the entry in the sector */
 
 	return FR_OK;
 }
@@ -2695,7 +2838,7 @@ FRESULT f_mount (
 	if (vol < 0) {return FR_INVALID_DRIVE;}
 	cfs = FatFs[vol];					/* Pointer to fs object */
 
-	if (cfs != 0U) {
+	if (cfs != NULL) {
 #if _FS_LOCK
 		clear_lock(cfs);
 #endif
@@ -2707,7 +2850,7 @@ FRESULT f_mount (
 		cfs->fs_type = 0U;				/* Clear old fs object */
 	}
 
-	if (fs != 0U) {
+	if (fs != NULL) {
 		fs->fs_type = 0U;				/* Clear new fs object */
 #if _FS_REENTRANT						/* Create sync object for the new volume */
 		if ((!ff_cre_syncobj((BYTE)vol, &fs->sobj)) != 0U) {
@@ -2859,11 +3002,12 @@ FRESULT f_open (
 			fp->fsize = LD_DWORD(dir+DIR_FileSize);	/* File size */
 			fp->fptr = 0U;						/* File pointer */
 			fp->dsect = 0U;
+			fp->fs = dj.fs;	 					/* Validate file object */
+			fp->id = fp->fs->id;
 #if _USE_FASTSEEK
 			fp->cltbl = 0;						/* Normal seek mode */
+			fp->cltsz = 0U;
 #endif
-			fp->fs = dj.fs;	 					/* Validate file object */
-			fp->id = fp->fs->id;
 		}
 	}
 
@@ -2938,9 +3082,12 @@ FRESULT f_read (
 			cc = btr / SS(fp->fs);				/* When remaining bytes >= sector size, */
 			if (cc != 0U) {							/* Read maximum contiguous sectors directly */
 				if ((csect + cc) > fp->fs->csize) {	/* Clip at cluster boundary */
+					rcnt = cc;
 					cc = (UINT)(fp->fs->csize - csect);
+					/* Extend over the following clusters while they are contiguous */
+					cc += clust_run(fp, fp->fptr + (cc * SS(fp->fs)), rcnt - cc, 0U);
 				}
-				if (disk_read(fp->fs->drv, rbuff, sect, (BYTE)cc) != RES_OK) {
+				if (disk_read(fp->fs->drv, rbuff, sect, cc) != RES_OK) {
 					ABORT(fp->fs, FR_DISK_ERR);
 				}
 #if !_FS_READONLY && _FS_MINIMIZE <= 2			/* Replace one of the read sectors with cached data if it contains a dirty sector */
@@ -3043,8 +3190,15 @@ FRESULT f_write (
 					}
 				} else {					/* Middle or end of the file */
 #if _USE_FASTSEEK
-					if (fp->cltbl)
+					if (fp->cltbl) {
 						clst = clmt_clust(fp, fp->fptr);	/* Get cluster# from the CLMT */
+						if ((clst == 0U) && (fp->cltsz != 0U)) {	/* Stretch the chain beyond the table */
+							clst = create_chain(fp->fs, fp->clust);
+							if (clst >= 2U) {
+								clmt_append(fp, clst);
+							}
+						}
+					}
 					else
 #endif
 						clst = create_chain(fp->fs, fp->clust);	/* Follow or stretch cluster chain on the FAT */
@@ -3061,6 +3215,9 @@ FRESULT f_write (
 				fp->clust = clst;			/* Update current cluster */
 				if (fp->sclust == 0U) {
 					fp->sclust = clst;	/* Set start cluster if the first write */
+#if _USE_FASTSEEK
+					clmt_append(fp, clst);
+#endif
 				}
 			}
 #if _FS_TINY
@@ -3083,9 +3240,12 @@ FRESULT f_write (
 			cc = LocBtw / SS(fp->fs);			/* When remaining bytes >= sector size, */
 			if (cc != 0U) {						/* Write maximum contiguous sectors directly */
 				if ((csect + cc) > fp->fs->csize) {	/* Clip at cluster boundary */
+					wcnt = cc;
 					cc = (UINT)(fp->fs->csize - csect);
+					/* Extend over the following clusters while they are contiguous or can be allocated so */
+					cc += clust_run(fp, fp->fptr + (cc * SS(fp->fs)), wcnt - cc, 1U);
 				}
-				if (disk_write(fp->fs->drv, wbuff, sect, (BYTE)cc) != RES_OK) {
+				if (disk_write(fp->fs->drv, wbuff, sect, cc) != RES_OK) {
 					ABORT(fp->fs, FR_DISK_ERR);
 				}
 #if _FS_MINIMIZE <= 2
@@ -3405,6 +3565,9 @@ FRESULT f_lseek (
 {
 	FRESULT res;
 	DWORD LocOfs = ofs;
+#if _USE_FASTSEEK && !_FS_READONLY
+	DWORD *cltbl = 0;
+#endif
 
 	res = validate(fp);					/* Check validity of the object */
 	if (res != FR_OK) {
@@ -3415,38 +3578,25 @@ FRESULT f_lseek (
 	}
 
 #if _USE_FASTSEEK
+#if !_FS_READONLY
+	if ((fp->cltsz != 0U) && (ofs != CREATE_LINKMAP) &&
+		(ofs > fp->fsize) && ((fp->flag & FA_WRITE) != (BYTE)0U)) {
+		cltbl = fp->cltbl;	/* Expand the file in normal seek mode, then rebuild the table */
+		fp->cltbl = 0;
+	}
+#endif
 	if (fp->cltbl) {	/* Fast seek */
-		DWORD cl, pcl, ncl, tcl, dsc, tlen, ulen, *tbl;
+		DWORD dsc, tlen;
 
 		if (ofs == CREATE_LINKMAP) {	/* Create CLMT */
-			tbl = fp->cltbl;
-			tlen = *tbl++; ulen = 2;	/* Given table size and required table size */
-			cl = fp->sclust;			/* Top of the chain */
-			if (cl) {
-				do {
-					/* Get a fragment */
-					tcl = cl; ncl = 0; ulen += 2;	/* Top, length and used items */
-					do {
-						pcl = cl; ncl++;
-						cl = get_fat(fp->fs, cl);
-						if (cl <= 1) {
-							ABORT(fp->fs, FR_INT_ERR);
-						}
-						if (cl == 0xFFFFFFFF) {
-							ABORT(fp->fs, FR_DISK_ERR);
-						}
-					} while (cl == pcl + 1);
-					if (ulen <= tlen) {		/* Store the length and top of the fragment */
-						*tbl++ = ncl; *tbl++ = tcl;
-					}
-				} while (cl < fp->fs->n_fatent);	/* Repeat until end of chain */
+			tlen = *fp->cltbl;
+			fp->cltsz = 0U;
+			res = create_linkmap(fp, tlen, 1U);
+			if ((res == FR_INT_ERR) || (res == FR_DISK_ERR)) {
+				ABORT(fp->fs, res);
 			}
-			*fp->cltbl = ulen;	/* Number of items used */
-			if (ulen <= tlen) {
-				*tbl = 0;		/* Terminate table */
-			}
-			else {
-				res = FR_NOT_ENOUGH_CORE;	/* Given table size is smaller than required */
+			if (res == FR_OK) {
+				fp->cltsz = tlen;	/* Kept up to date as the chain changes */
 			}
 
 		} else {						/* Fast seek */
@@ -3455,7 +3605,7 @@ FRESULT f_lseek (
 			}
 			fp->fptr = LocOfs;				/* Set file pointer */
 			if (LocOfs) {
-				fp->clust = clmt_clust(fp, ofs - 1);
+				fp->clust = clmt_clust(fp, LocOfs - 1);
 				dsc = clust2sect(fp->fs, fp->clust);
 				if ((!dsc) != 0U) {
 					ABORT(fp->fs, FR_INT_ERR);
@@ -3573,6 +3723,20 @@ FRESULT f_lseek (
 			fp->fsize = fp->fptr;
 			fp->flag |= FA__WRITTEN;
 		}
+#if _USE_FASTSEEK
+		if (cltbl != 0) {
+			fp->cltbl = cltbl;
+			res = create_linkmap(fp, fp->cltsz, 0U);
+			if ((res == FR_INT_ERR) || (res == FR_DISK_ERR)) {
+				ABORT(fp->fs, res);
+			}
+			if (res != FR_OK) {
+				fp->cltbl = 0;	/* Too fragmented, stay in normal seek mode */
+				fp->cltsz = 0U;
+				res = FR_OK;
+			}
+		}
+#endif
 #endif
 	}
 
@@ -3889,6 +4053,16 @@ FRESULT f_truncate (
 					fp->flag &= ~FA__DIRTY;
 				}
 			}
+#endif
+#if _USE_FASTSEEK
+			if ((res == FR_OK) && (fp->cltsz != 0U)) {	/* Drop the removed clusters from the table */
+				res = create_linkmap(fp, fp->cltsz, 0U);
+				if (res == FR_NOT_ENOUGH_CORE) {
+					fp->cltbl = 0;
+					fp->cltsz = 0U;
+					res = FR_OK;
+				}
+			}
 #endif
 		}
 		if (res != FR_OK) {
@@ -3902,6 +4076,108 @@ FRESULT f_truncate (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Allocate a Contiguous Block to the File                               */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_expand (
+	FIL* fp,		/* Pointer to the file object */
+	DWORD fsz,		/* File size to be expanded to */
+	BYTE opt		/* 0:Find the block and allocate it on the next write, 1:Allocate it now */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD n, clst, stcl, scl, ncl, tcl;
+
+
+	res = validate(fp);						/* Check validity of the object */
+	if (res == FR_OK) {
+		if (fp->err != (BYTE) 0U) {						/* Check error */
+			res = (FRESULT)fp->err;
+		} else {
+			if (((!(fp->flag & FA_WRITE)) != 0U) || (fsz == 0U) ||
+				(fp->fsize != 0U) || (fp->sclust != 0U)) {	/* Check access mode and that the file is empty */
+				res = FR_DENIED;
+			}
+		}
+	}
+	if (res == FR_OK) {
+		fs = fp->fs;
+		n = (DWORD)fs->csize * SS(fs);		/* Cluster size */
+		tcl = (fsz / n) + (((fsz % n) != 0U) ? 1U : 0U);	/* Number of clusters required */
+		stcl = fs->last_clust;				/* Search from the last allocated cluster */
+		if ((stcl < 2U) || (stcl >= fs->n_fatent)) {
+			stcl = 2U;
+		}
+		scl = stcl; clst = stcl; ncl = 0U;
+		for (;;) {							/* Find a contiguous cluster block */
+			n = get_fat(fs, clst);
+			if (n == 1U) {
+				res = FR_INT_ERR; break;
+			}
+			if (n == 0xFFFFFFFFU) {
+				res = FR_DISK_ERR; break;
+			}
+			if (n == 0U) {					/* Is it a free cluster? */
+				ncl++;
+				if (ncl == tcl) {
+					break;					/* Found a block of the required size */
+				}
+			} else {						/* Not free, restart after it */
+				scl = clst + 1U; ncl = 0U;
+			}
+			clst++;
+			if (clst >= fs->n_fatent) {		/* Wrap around, a block cannot span the end */
+				clst = 2U; scl = 2U; ncl = 0U;
+			}
+			if (clst == stcl) {
+				res = FR_DENIED; break;		/* No contiguous block */
+			}
+		}
+		if (res == FR_OK) {
+			if (opt != 0U) {				/* Allocate the block now */
+				for (clst = scl; (res == FR_OK) && (clst < (scl + tcl - 1U)); clst++) {
+					res = put_fat(fs, clst, clst + 1U);
+				}
+				if (res == FR_OK) {
+					res = put_fat(fs, scl + tcl - 1U, 0x0FFFFFFFU);
+				}
+				if (res == FR_OK) {
+					fs->last_clust = scl + tcl - 1U;	/* Update FSINFO */
+					if (fs->free_clust != 0xFFFFFFFFU) {
+						fs->free_clust -= tcl;
+						fs->fsi_flag |= 1U;
+					}
+					fp->sclust = scl;		/* Update the file object */
+					fp->fsize = fsz;
+					fp->flag |= FA__WRITTEN;
+#if _USE_FASTSEEK
+					if (fp->cltsz != 0U) {
+						res = create_linkmap(fp, fp->cltsz, 0U);
+						if (res == FR_NOT_ENOUGH_CORE) {
+							fp->cltbl = 0;	/* Too fragmented, back to normal seek mode */
+							fp->cltsz = 0U;
+							res = FR_OK;
+						}
+					}
+#endif
+				}
+			} else {						/* Let the next allocation start at the block */
+				fs->last_clust = scl - 1U;
+			}
+		}
+		if ((res == FR_INT_ERR) || (res == FR_DISK_ERR)) {
+			fp->err = (FRESULT)res;
+		}
+	}
+
+	LEAVE_FF(fp->fs, res);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Delete a File or Directory                                            */
 /*-----------------------------------------------------------------------*/
@@ -27,6 +27,19 @@ typedef enum {
 	RES_PARERR		/* 4: Invalid Parameter */
 } DRESULT;
 
+/* Sector cache counters of a drive (CTRL_GET_CACHE_STATS) */
+typedef struct {
+	DWORD Hits;			/* Sectors read from the cache */
+	DWORD Misses;		/* Sectors read from the drive on request */
+	DWORD ReadAheads;	/* Sectors read from the drive ahead of request */
+	DWORD WriteBacks;	/* Dirty sectors written to the drive */
+	DWORD Evictions;	/* Cache lines reused for another sector */
+	DWORD DrvReads;		/* Read commands issued to the drive */
+	DWORD DrvReadSectors;	/* Sectors read from the drive */
+	DWORD DrvWrites;	/* Write commands issued to the drive */
+	DWORD DrvWriteSectors;	/* Sectors written to the drive */
+} DISK_CACHE_STATS;
+
 
 /*---------------------------------------*/
 /* Prototypes for disk control functions */
@@ -72,6 +85,10 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define ATA_GET_MODEL		21U	/* Get model name */
 #define ATA_GET_SN			22U	/* Get serial number */
 
+/* Sector cache ioctl command */
+#define CTRL_GET_CACHE_STATS	30U	/* Get cache counters (DISK_CACHE_STATS) */
+#define CTRL_CLEAR_CACHE_STATS	31U	/* Clear cache counters */
+
 #ifdef __cplusplus
 }
 #endif
@@ -132,7 +132,8 @@ typedef struct {
 	BYTE*	dir_ptr;		/* Pointer to the directory entry in the win[] */
 #endif
 #if _USE_FASTSEEK
-	DWORD*	cltbl;			/* Pointer to the cluster link map table (Nulled on file open) */
+	DWORD*	cltbl;			/* Pointer to the cluster link map table (null on file open) */
+	DWORD	cltsz;			/* Size of the table built by CREATE_LINKMAP, kept up to date on write (0:none) */
 #endif
 #if _FS_LOCK
 	UINT	lockid;			/* File lock ID origin from 1 (index of file semaphore table Files[]) */
@@ -237,6 +238,7 @@ FRESULT f_stat (const TCHAR* path, FILINFO* fno);					/* Get file status */
 #if !_FS_READONLY
 FRESULT f_getfree (const TCHAR* path, DWORD* nclst, FATFS** fatfsys);
 FRESULT f_truncate (FIL* fp);										/* Truncate file */
+FRESULT f_expand (FIL* fp, DWORD fsz, BYTE opt);					/* Allocate a contiguous block to the file */
 FRESULT f_unlink (const TCHAR* path);							/* Delete an existing file or directory */
 FRESULT f_mkdir (const TCHAR* path);								/* Create a sub directory */
 FRESULT f_rename (const TCHAR* path_old, const TCHAR* path_new);	/* Rename/Move a file or directory */
@@ -15,7 +15,11 @@ extern "C" {
 / Functions and Buffer Configurations
 /---------------------------------------------------------------------------*/
 
-#define	_FS_TINY		0	/* 0:Normal or 1:Tiny */
+#ifdef FILE_SYSTEM_FS_TINY
+#define	_FS_TINY		1	/* 1:Tiny */
+#else
+#define	_FS_TINY		0	/* 0:Normal */
+#endif
 /* When _FS_TINY is set to 1, it reduces memory consumption _MAX_SS bytes each
 /  file object. For file data transfer, FatFs uses the common sector buffer in
 /  the file system object (FATFS) instead of private sector buffer eliminated
@@ -57,8 +61,16 @@ extern "C" {
 /* To enable f_mkfs() function, set _USE_MKFS to 1 and set _FS_READONLY to 0 */
 
 
-#define	_USE_FASTSEEK	0	/* 0:Disable or 1:Enable */
-/* To enable fast seek feature, set _USE_FASTSEEK to 1. */
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define	_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define	_USE_FASTSEEK	0	/* 0:Disable */
+#endif
+/* To enable fast seek feature, set _USE_FASTSEEK to 1. A cluster link map table
+/  built with f_lseek(fp, CREATE_LINKMAP) is kept up to date as the file grows,
+/  is truncated or is expanded. A file of N fragments needs 2 * N + 2 items; when
+/  the table overflows, fp->cltbl is cleared and the file is accessed in normal
+/  seek mode. */
 
 
 #define _USE_LABEL		0	/* 0:Disable or 1:Enable */
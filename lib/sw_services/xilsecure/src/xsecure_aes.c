@@ -60,6 +60,9 @@
 *       vns 02/19/18 Modified XSecure_AesKeyZero() to clear KUP and AES key
 *                    Added XSecure_AesKeyZero() call in XSecure_AesDecrypt()
 *                    API to clear keys.
+*       ag  10/16/26 Added double buffering of chunks, the device copy of
+*                    one half of the read buffer overlaps the CSU DMA
+*                    transfer of the other half.
 *
 * </pre>
 *
@@ -112,6 +115,8 @@ s32 XSecure_AesInitialize(XSecure_Aes *InstancePtr, XCsuDma *CsuDmaPtr,
 	InstancePtr->Iv = Iv;
 	InstancePtr->Key = Key;
 	InstancePtr->IsChunkingEnabled = XSECURE_CSU_AES_CHUNKING_DISABLED;
+	InstancePtr->IsDoubleBufferEnabled =
+				XSECURE_CSU_AES_DOUBLE_BUFFER_DISABLED;
 
 	return XST_SUCCESS;
 }
@@ -651,6 +656,36 @@ void XSecure_AesSetChunkConfig(XSecure_Aes *InstancePtr, u8 *ReadBuffer,
 	InstancePtr->DeviceCopy = DeviceCopy;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function enables or disables double buffering of chunks.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	DoubleBuffer	Used to enable or disable double buffering.
+ *		 - XSECURE_CSU_AES_DOUBLE_BUFFER_ENABLED
+ *		 - XSECURE_CSU_AES_DOUBLE_BUFFER_DISABLED
+ *
+ * @return	None
+ *
+ * @note	With double buffering the read buffer given to
+ *		XSecure_AesSetChunkConfig() is split in two halves. The device
+ *		copy into one half runs while the CSU DMA feeds the other half
+ *		to the AES engine, through the CSU DMA transfer queue. The
+ *		DeviceCopy function must therefore not use the CSU DMA itself.
+ *		Chunk sizes below 8 bytes are decrypted without double
+ *		buffering.
+ *
+ ******************************************************************************/
+void XSecure_AesSetChunkDoubleBuffer(XSecure_Aes *InstancePtr,
+					u8 DoubleBuffer)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->IsDoubleBufferEnabled = DoubleBuffer;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -807,6 +842,66 @@ void XSecure_AesKeySelNLoad(XSecure_Aes *InstancePtr)
 	XSecure_AesWaitKeyLoad(InstancePtr);
 }
 
+/*****************************************************************************/
+/**
+ *
+ * @brief
+ * This is a helper function to decrypt chunked bitstream block with double
+ * buffering and route to PCAP. Chunks of half the read buffer are queued to
+ * the CSU DMA, the next chunk is copied from the device into one half while
+ * the other half is being decrypted.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
+ * @param	Src 	Pointer to the encrypted bitstream block start.
+ * @param	Len 	Length of bitstream data block in bytes.
+ *
+ * @return	returns XST_SUCCESS if bitstream block is decrypted by AES.
+ *
+ *
+ ******************************************************************************/
+static s32 XSecure_AesChunkDecryptDb(XSecure_Aes *InstancePtr, const u8 *Src,
+					u32 Len)
+{
+	s32 Status = XST_SUCCESS;
+	u32 HalfSize = (InstancePtr->ChunkSize / 2U) & ~(u32)3U;
+	u32 StartAddrByte = (u32)(INTPTR)Src;
+	u32 Index = 0U;
+	u32 Size;
+	u8 *Buffer;
+
+	while (Len != 0U)
+	{
+		Size = (Len < HalfSize) ? Len : HalfSize;
+		Buffer = InstancePtr->ReadBuffer + (Index * HalfSize);
+
+		/* Wait for the CSU DMA to release this half of the buffer */
+		XCsuDma_QueueWait(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+							1U);
+
+		Status = InstancePtr->DeviceCopy(StartAddrByte,
+					(UINTPTR)Buffer, Size);
+		if (XST_SUCCESS != Status)
+		{
+			Status = XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+			break;
+		}
+
+		(void)XCsuDma_QueueTransfer(InstancePtr->CsuDmaPtr,
+					XCSUDMA_SRC_CHANNEL, (UINTPTR)Buffer,
+					Size/4U, 0U, NULL, NULL);
+
+		StartAddrByte += Size;
+		Len -= Size;
+		Index ^= 1U;
+	}
+
+	/* Wait for the SRC_DMA to drain and the pcap to be IDLE */
+	XCsuDma_QueueWait(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL, 0U);
+	XSecure_PcapWaitForDone();
+
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  *
@@ -836,6 +931,13 @@ static s32 XSecure_AesChunkDecrypt(XSecure_Aes *InstancePtr, const u8 *Src,
 	u32 Index = 0U;
 	u32 StartAddrByte = (u32)(INTPTR)Src;
 
+	if ((InstancePtr->IsDoubleBufferEnabled ==
+				XSECURE_CSU_AES_DOUBLE_BUFFER_ENABLED) &&
+			(InstancePtr->ChunkSize >= 8U)) {
+		Status = XSecure_AesChunkDecryptDb(InstancePtr, Src, Len);
+		return Status;
+	}
+
 	/*
 	 * Start the chunking process, copy encrypted chunks into OCM and push
 	 * decrypted data to PCAP
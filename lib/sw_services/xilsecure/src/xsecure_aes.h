@@ -84,6 +84,9 @@
 * 3.0   vns  02/19/18 Added error code for key clear
 *                     XSECURE_CSU_AES_KEY_CLEAR_ERROR and timeout macro
 *                     XSECURE_AES_TIMEOUT_MAX
+*       ag   10/16/26 Added XSecure_AesSetChunkDoubleBuffer() to overlap the
+*                     device copy of a chunk with the decryption of the
+*                     previous one.
 *
 * </pre>
 * @endcond
@@ -126,6 +129,9 @@
 #define XSECURE_CSU_AES_CHUNKING_DISABLED (0x0U)
 #define XSECURE_CSU_AES_CHUNKING_ENABLED (0x1U)
 
+#define XSECURE_CSU_AES_DOUBLE_BUFFER_DISABLED (0x0U)
+#define XSECURE_CSU_AES_DOUBLE_BUFFER_ENABLED (0x1U)
+
 #define XSECURE_CSU_AES_KEY_LOAD	(1U << 0)
 					/**< Load AES key from Source */
 
@@ -187,6 +193,8 @@ typedef struct {
 	u32* GcmTagAddr; /**< GCM tag address for decryption */
 	u32  KeySel; /**< Key Source selection */
 	u8 IsChunkingEnabled; /**< Data Chunking enabled/disabled */
+	u8 IsDoubleBufferEnabled; /**< Chunk double buffering
+					enabled/disabled */
 	u8* ReadBuffer; /**< Data Buffer to be used in case of chunking */
 	u32 ChunkSize; /**< Size of one chunk in bytes */
 	u32 (*DeviceCopy) (u32 SrcAddress, UINTPTR DestAddress, u32 Length);
@@ -245,6 +253,10 @@ void XSecure_AesSetChunking(XSecure_Aes *InstancePtr, u8 Chunking);
 /* Configuring Data chunking settings */
 void XSecure_AesSetChunkConfig(XSecure_Aes *InstancePtr, u8 *ReadBuffer,
 		u32 ChunkSize, u32(*DeviceCopy)(u32, UINTPTR, u32));
+
+/* Enable/Disable double buffering of chunks */
+void XSecure_AesSetChunkDoubleBuffer(XSecure_Aes *InstancePtr,
+		u8 DoubleBuffer);
 /** @}
 @endcond */
 
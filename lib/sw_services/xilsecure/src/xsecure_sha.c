@@ -46,6 +46,8 @@
 * 2.2   vns  07/06/17 Added doxygen tags
 * 3.0   vns  01/23/18 Added NIST SHA3 support.
 *                     Added SSS configuration before every CSU DMA transfer
+*       ag   10/16/26 Added XSecure_Sha3UpdateAsync() which queues the data
+*                     to the CSU DMA transfer queue without waiting.
 *
 * </pre>
 *
@@ -227,6 +229,9 @@ void XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(Size != (u32)0x00U);
 
+	/* Complete the data queued by XSecure_Sha3UpdateAsync() */
+	XSecure_Sha3WaitForUpdate(InstancePtr);
+
 	InstancePtr->Sha3Len += Size;
 
 	/* Configure the SSS for SHA3 hashing. */
@@ -243,6 +248,65 @@ void XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 						XCSUDMA_IXR_DONE_MASK);
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function updates hash for new input data block without waiting for
+ * the CSU DMA. The data is queued behind any data given earlier.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Data 		Pointer to the input data for hashing.
+ * @param	Size 		Size of the input data in bytes.
+ *
+ * @return	None
+ *
+ * @note	The data must not be modified until XSecure_Sha3WaitForUpdate()
+ *		or one of the functions calling it has returned. Up to
+ *		XCSUDMA_QUEUE_DEPTH blocks are queued, further calls wait for
+ *		the oldest one.
+ *
+ ******************************************************************************/
+void XSecure_Sha3UpdateAsync(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Size != (u32)0x00U);
+
+	InstancePtr->Sha3Len += Size;
+
+	/* Configure the SSS for SHA3 hashing. */
+	XSecure_SssSetup(XSecure_SssInputSha3(XSECURE_CSU_SSS_SRC_SRC_DMA));
+
+	/* Make room in the queue */
+	XCsuDma_QueueWait(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+					XCSUDMA_QUEUE_DEPTH - 1U);
+
+	(void)XCsuDma_QueueTransfer(InstancePtr->CsuDmaPtr,
+				XCSUDMA_SRC_CHANNEL, (UINTPTR)Data,
+				(u32)Size/4, 0U, NULL, NULL);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits till the data queued by XSecure_Sha3UpdateAsync() has
+ * been transferred to the SHA3 engine.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	None
+ *
+ *
+ ******************************************************************************/
+void XSecure_Sha3WaitForUpdate(XSecure_Sha3 *InstancePtr)
+{
+	/* Asserts validate the input arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	XCsuDma_QueueWait(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL, 0U);
+}
+
 
 /*****************************************************************************/
 /**
@@ -298,6 +362,9 @@ void XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	PartialLen = (PartialLen == 0U)?(XSECURE_SHA3_BLOCK_LEN) :
 		(XSECURE_SHA3_BLOCK_LEN - PartialLen);
 
+	/* Complete the data queued by XSecure_Sha3UpdateAsync() */
+	XSecure_Sha3WaitForUpdate(InstancePtr);
+
 	if (InstancePtr->Sha3PadType == XSECURE_CSU_NIST_SHA3) {
 		XSecure_NistSha3Padd(InstancePtr, XSecure_RsaSha3Array,
 						PartialLen);
@@ -387,6 +454,9 @@ void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	u32 Val = 0U;
 	u32 *HashPtr = (u32 *)Hash;
 
+	/* Complete the data queued by XSecure_Sha3UpdateAsync() */
+	XSecure_Sha3WaitForUpdate(InstancePtr);
+
 	for (Index=0U; Index < 12U; Index++)
 	{
 		Val = XSecure_ReadReg(InstancePtr->BaseAddress,
@@ -53,6 +53,12 @@
 * A pointer to CsuDma instance has to be passed in initialization as CSU
 * DMA will be used for data transfers to SHA module.
 *
+* XSecure_Sha3UpdateAsync() queues the data to the CSU DMA and returns
+* without waiting, so that the next block can be prepared while the current
+* one is hashed. The data must stay unchanged until XSecure_Sha3WaitForUpdate()
+* returns; XSecure_Sha3Update(), XSecure_Sha3Finish() and
+* XSecure_Sha3_ReadHash() wait for the queued data first.
+*
 *
 * @note
 *
@@ -65,6 +71,8 @@
 * 2.0   vns  01/28/17 Added API to read SHA3 hash.
 * 2.2   vns  07/06/17 Added doxygen tags
 * 3.0   vns  01/23/18 Added NIST SHA3 support.
+*       ag   10/16/26 Added XSecure_Sha3UpdateAsync() and
+*                     XSecure_Sha3WaitForUpdate().
 *
 * </pre>
 *
@@ -133,6 +141,9 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr);
 /* Data Transfer */
 void XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 						const u32 Size);
+void XSecure_Sha3UpdateAsync(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size);
+void XSecure_Sha3WaitForUpdate(XSecure_Sha3 *InstancePtr);
 void XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash);
 
 /* Complete SHA digest calculation */